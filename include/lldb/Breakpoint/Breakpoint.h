@@ -205,9 +205,14 @@ public:
     ///
     /// @param[in] changed_modules
     ///    The list of modules to look in for new locations.
+    ///
+    /// @param[in] batch
+    ///    If not NULL, module lookups to share with other breakpoints
+    ///    being resolved in the same modules.
     //------------------------------------------------------------------
     void
-    ResolveBreakpointInModules (ModuleList &changed_modules);
+    ResolveBreakpointInModules (ModuleList &changed_modules,
+                                BreakpointResolverBatch *batch = NULL);
 
 
     //------------------------------------------------------------------
@@ -221,11 +226,15 @@ public:
     ///    If \b true then the modules were loaded, if \b false, unloaded.
     /// @param[in] delete_locations
     ///    If \b true then the modules were unloaded delete any locations in the changed modules.
+    /// @param[in] batch
+    ///    If not NULL, module lookups to share with other breakpoints
+    ///    being updated for the same load event.
     //------------------------------------------------------------------
     void
     ModulesChanged (ModuleList &changed_modules,
                     bool load_event,
-                    bool delete_locations = false);
+                    bool delete_locations = false,
+                    BreakpointResolverBatch *batch = NULL);
 
 
     //------------------------------------------------------------------
@@ -650,6 +659,9 @@ private:
     void
     SendBreakpointChangedEvent (BreakpointEventData *data);
 
+    void
+    UpdateBreakpointSiteConditions ();
+
     DISALLOW_COPY_AND_ASSIGN(Breakpoint);
 };
 
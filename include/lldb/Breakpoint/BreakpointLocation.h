@@ -25,6 +25,7 @@
 #include "lldb/Core/UserID.h"
 #include "lldb/Host/Mutex.h"
 #include "lldb/Target/Process.h"
+#include "lldb/Expression/AgentExpression.h"
 #include "lldb/Expression/ClangUserExpression.h"
 
 namespace lldb_private {
@@ -182,6 +183,25 @@ public:
     bool
     ConditionSaysStop (ExecutionContext &exe_ctx, Error &error);
 
+    //------------------------------------------------------------------
+    /// Get the condition compiled to bytecode, so a process plug-in can
+    /// hand it off to be evaluated where the breakpoint is hit.
+    ///
+    /// @return
+    ///    The bytecode, or NULL if the condition hasn't been compiled
+    ///    for the current process, has changed since it was compiled,
+    ///    or lldb needs to see every hit of this location (to count
+    ///    down an ignore count).
+    //------------------------------------------------------------------
+    const AgentExpression *
+    GetConditionBytecode ();
+
+    //------------------------------------------------------------------
+    /// Tell the process the conditions it can evaluate for this
+    /// location's breakpoint site may have changed.
+    //------------------------------------------------------------------
+    void
+    UpdateBreakpointSiteConditions ();
 
     //------------------------------------------------------------------
     /// Set the valid thread to be checked when the breakpoint is hit.
@@ -345,6 +365,22 @@ protected:
     bool
     IgnoreCountShouldStop();
 
+    //------------------------------------------------------------------
+    /// Try to evaluate the condition with its compiled bytecode.
+    ///
+    /// @param[out] should_stop
+    ///     The result of the condition, valid only if we return true.
+    ///
+    /// @return
+    ///     \b true if the bytecode gave an answer, \b false if the
+    ///     condition needs to go through the expression parser.
+    //------------------------------------------------------------------
+    bool
+    BytecodeConditionSaysStop (ExecutionContext &exe_ctx,
+                               const char *condition_text,
+                               size_t condition_hash,
+                               bool &should_stop);
+
 private:
 
     //------------------------------------------------------------------
@@ -388,6 +424,8 @@ private:
     ClangUserExpression::ClangUserExpressionSP m_user_expression_sp; ///< The compiled expression to use in testing our condition.
     Mutex m_condition_mutex; ///< Guards parsing and evaluation of the condition, which could be evaluated by multiple processes.
     size_t m_condition_hash; ///< For testing whether the condition source code changed.
+    AgentExpression m_condition_bytecode; ///< The condition compiled to bytecode, if it was simple enough.
+    size_t m_condition_bytecode_hash; ///< The condition source code m_condition_bytecode was compiled from.
 
     void
     SendBreakpointLocationChangedEvent (lldb::BreakpointEventType eventKind);
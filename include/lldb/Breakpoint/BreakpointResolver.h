@@ -76,6 +76,17 @@ public:
     void
     SetBreakpoint (Breakpoint *bkpt);
 
+    //------------------------------------------------------------------
+    /// Resolvers that support it use \a batch to share module lookups
+    /// with the other breakpoints being resolved at the same time.  The
+    /// batch only lives for one update, so set it back to NULL after.
+    //------------------------------------------------------------------
+    void
+    SetBatch (BreakpointResolverBatch *batch)
+    {
+        m_batch = batch;
+    }
+
     //------------------------------------------------------------------
     /// In response to this method the resolver scans all the modules in the breakpoint's
     /// target, and adds any new locations it finds.
@@ -142,6 +153,7 @@ protected:
     void SetSCMatchesByLine (SearchFilter &filter, SymbolContextList &sc_list, bool skip_prologue, const char *log_ident);
     
     Breakpoint *m_breakpoint;  // This is the breakpoint we add locations to.
+    BreakpointResolverBatch *m_batch;  // Lookups shared with other breakpoints, if resolving several at once.
 
 private:
     // Subclass identifier (for llvm isa/dyn_cast)
@@ -0,0 +1,126 @@
+//===-- BreakpointResolverBatch.h -------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef liblldb_BreakpointResolverBatch_h_
+#define liblldb_BreakpointResolverBatch_h_
+
+// C Includes
+// C++ Includes
+#include <map>
+#include <vector>
+
+// Other libraries and framework includes
+// Project includes
+#include "lldb/lldb-private.h"
+#include "lldb/Core/ConstString.h"
+#include "lldb/Symbol/SymbolContext.h"
+
+namespace lldb_private {
+
+//----------------------------------------------------------------------
+/// @class BreakpointResolverBatch BreakpointResolverBatch.h "lldb/Breakpoint/BreakpointResolverBatch.h"
+/// @brief Shares module lookups between breakpoints resolved together.
+///
+/// When a batch of modules is loaded, every breakpoint is resolved in
+/// every new module.  File and line resolvers would each walk all the
+/// compile units of each module looking for their file, and name
+/// resolvers that share a name would each repeat the same lookup.
+///
+/// A batch is handed to each resolver while the breakpoints of one
+/// BreakpointList are updated.  The first file and line resolver to ask
+/// about a module gets the module's compile units indexed by the base
+/// names of their files, in one pass, and every resolver after it only
+/// visits the compile units that mention its file.  Function lookups
+/// are remembered per module, name and options.
+//----------------------------------------------------------------------
+class BreakpointResolverBatch
+{
+public:
+    BreakpointResolverBatch ();
+
+    ~BreakpointResolverBatch ();
+
+    //------------------------------------------------------------------
+    /// Same as Module::FindFunctions (with no namespace and \a append
+    /// set), but only asks the module once for each set of arguments.
+    //------------------------------------------------------------------
+    size_t
+    FindFunctions (const lldb::ModuleSP &module_sp,
+                   const ConstString &name,
+                   uint32_t name_type_mask,
+                   bool include_symbols,
+                   bool include_inlines,
+                   SymbolContextList &sc_list);
+
+    //------------------------------------------------------------------
+    /// Find the indexes of the compile units in \a module_sp that could
+    /// have line table entries for \a file_spec.
+    ///
+    /// @param[in] check_inlines
+    ///     If \b false, only compile units whose own file has the base
+    ///     name of \a file_spec are returned.  If \b true, compile units
+    ///     that have it among their support files are returned too.
+    ///
+    /// @param[out] cu_indexes
+    ///     The compile unit indexes, in increasing order.  It is a
+    ///     superset of the matches: the directories aren't compared.
+    //------------------------------------------------------------------
+    void
+    FindCompileUnitIndexes (const lldb::ModuleSP &module_sp,
+                            const FileSpec &file_spec,
+                            bool check_inlines,
+                            std::vector<uint32_t> &cu_indexes);
+
+protected:
+    struct FunctionLookup
+    {
+        Module *m_module;
+        ConstString m_name;
+        uint32_t m_name_type_mask;
+        bool m_include_symbols;
+        bool m_include_inlines;
+
+        bool
+        operator < (const FunctionLookup &rhs) const;
+    };
+
+    typedef std::map<FunctionLookup, SymbolContextList> FunctionLookupMap;
+    typedef std::map<ConstString, std::vector<uint32_t> > FileNameToCUIndexes;
+
+    struct ModuleFileIndex
+    {
+        ModuleFileIndex () :
+            m_cu_files (),
+            m_support_files (),
+            m_indexed_support_files (false)
+        {
+        }
+
+        FileNameToCUIndexes m_cu_files;         ///< Base name of each compile unit's own file to the compile unit.
+        FileNameToCUIndexes m_support_files;    ///< Base name of every support file to the compile units using it.
+        bool m_indexed_support_files;           ///< Support files are only parsed if a resolver checks inlines.
+    };
+
+    typedef std::map<Module *, ModuleFileIndex> ModuleFileIndexMap;
+
+    ModuleFileIndex &
+    GetModuleFileIndex (const lldb::ModuleSP &module_sp, bool check_inlines);
+
+    FunctionLookupMap m_function_lookups;
+    ModuleFileIndexMap m_file_indexes;
+    uint32_t m_num_function_lookups;
+    uint32_t m_num_cached_function_lookups;
+
+private:
+    DISALLOW_COPY_AND_ASSIGN (BreakpointResolverBatch);
+};
+
+} // namespace lldb_private
+
+#endif  // liblldb_BreakpointResolverBatch_h_
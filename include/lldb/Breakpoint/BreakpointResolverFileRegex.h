@@ -15,6 +15,7 @@
 // Other libraries and framework includes
 // Project includes
 #include "lldb/Breakpoint/BreakpointResolver.h"
+#include "lldb/Symbol/SymbolContext.h"
 
 namespace lldb_private {
 
@@ -34,6 +35,13 @@ public:
     virtual
     ~BreakpointResolverFileRegex ();
 
+    virtual void
+    ResolveBreakpoint (SearchFilter &filter);
+
+    virtual void
+    ResolveBreakpointInModules (SearchFilter &filter,
+                                ModuleList &modules);
+
     virtual Searcher::CallbackReturn
     SearchCallback (SearchFilter &filter,
                     SymbolContext &context,
@@ -57,7 +65,18 @@ public:
 
 protected:
     friend class Breakpoint;
+
+    //------------------------------------------------------------------
+    /// The search only collects the compile units that pass the filter.
+    /// Once it is done, this reads and searches their source files, on
+    /// several threads if there are many, and then adds locations for
+    /// the matching lines.
+    //------------------------------------------------------------------
+    void
+    ResolveCollectedCompUnits (SearchFilter &filter);
+
     RegularExpression m_regex; // This is the line expression that we are looking for.
+    SymbolContextList m_comp_units; // The compile units found by the current search.
 
 private:
     DISALLOW_COPY_AND_ASSIGN(BreakpointResolverFileRegex);
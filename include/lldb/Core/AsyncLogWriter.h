@@ -0,0 +1,185 @@
+//===-- AsyncLogWriter.h ----------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef liblldb_AsyncLogWriter_h_
+#define liblldb_AsyncLogWriter_h_
+
+// C Includes
+// C++ Includes
+#include <atomic>
+#include <deque>
+#include <string>
+#include <vector>
+
+// Other libraries and framework includes
+// Project includes
+#include "lldb/lldb-private.h"
+#include "lldb/Host/Condition.h"
+#include "lldb/Host/Mutex.h"
+
+namespace lldb_private {
+
+//----------------------------------------------------------------------
+/// @class AsyncLogWriter AsyncLogWriter.h "lldb/Core/AsyncLogWriter.h"
+/// @brief Moves the writing of log lines off the threads that log them.
+///
+/// Logging synchronously means every log line costs a write and a
+/// flush on the logging thread, which makes chatty channels like
+/// "gdb-remote packets" slow the session down a lot.
+///
+/// Logs enabled with LLDB_LOG_OPTION_ASYNC hand their formatted lines
+/// to this class instead.  Each logging thread gets its own fixed size
+/// ring of lines that only it pushes to and only the writer pops from,
+/// so logging a line doesn't take any lock.  A single background
+/// thread empties the rings, orders what it found by sequence number
+/// and writes and flushes each stream once per batch.
+///
+/// Logs enabled with LLDB_LOG_OPTION_FLIGHT_RECORDER go through the
+/// same rings, but the writer keeps their most recent lines in memory
+/// and only writes them out when DumpFlightRecorder() is called.
+//----------------------------------------------------------------------
+class AsyncLogWriter
+{
+public:
+    static AsyncLogWriter &
+    GetSharedInstance ();
+
+    //------------------------------------------------------------------
+    /// Queue a formatted log line.  The contents of \a text are moved
+    /// out of it.
+    //------------------------------------------------------------------
+    void
+    Enqueue (const lldb::StreamSP &stream_sp,
+             std::string &text,
+             bool flight_recorder);
+
+    //------------------------------------------------------------------
+    /// Write out everything queued so far, on the calling thread.  Logs
+    /// call this when they are disabled, so no line reaches a stream
+    /// after that.
+    //------------------------------------------------------------------
+    void
+    Flush ();
+
+    //------------------------------------------------------------------
+    /// Write the lines kept by the flight recorder to the streams they
+    /// were logged to, and forget them.
+    ///
+    /// @param[in] wait
+    ///     If false, give up instead of waiting when the writer is busy.
+    ///     Use this when something may have gone wrong in the middle of
+    ///     a write.
+    ///
+    /// @return
+    ///     The number of lines written.
+    //------------------------------------------------------------------
+    size_t
+    DumpFlightRecorder (bool wait = true);
+
+    //------------------------------------------------------------------
+    /// Stop the writer thread after writing out everything queued.
+    //------------------------------------------------------------------
+    void
+    Terminate ();
+
+    //------------------------------------------------------------------
+    /// Get the name of the calling thread.  Reading the name from the
+    /// OS can be expensive (it reads a file in /proc on Linux), so it
+    /// is only done again when the cached name is over a second old.
+    //------------------------------------------------------------------
+    static const char *
+    GetCurrentThreadName ();
+
+protected:
+    struct Record
+    {
+        Record () :
+            m_sequence (0),
+            m_stream_sp (),
+            m_text (),
+            m_flight_recorder (false)
+        {
+        }
+
+        uint64_t m_sequence;
+        lldb::StreamSP m_stream_sp;
+        std::string m_text;
+        bool m_flight_recorder;
+    };
+
+    //------------------------------------------------------------------
+    // A ring of records with a single producer (the thread that owns
+    // it) and a single consumer (whoever holds m_mutex).
+    //------------------------------------------------------------------
+    class ThreadRing
+    {
+    public:
+        static const size_t g_capacity = 1024; // Must be a power of two
+
+        ThreadRing ();
+
+        // Called by the owning thread, returns false if the ring is full.
+        bool
+        Push (Record &record);
+
+        // Called with m_mutex held, returns the number of records popped.
+        size_t
+        Pop (std::vector<Record> &records);
+
+        size_t
+        GetSize () const
+        {
+            return m_head.load (std::memory_order_relaxed) - m_tail.load (std::memory_order_relaxed);
+        }
+
+        std::atomic<bool> m_abandoned; // Set when the owning thread exits
+    private:
+        std::vector<Record> m_records;
+        std::atomic<size_t> m_head;     // Only written by the owning thread
+        std::atomic<size_t> m_tail;     // Only written by the consumer
+    };
+
+    struct ThreadState;
+
+    AsyncLogWriter ();
+
+    ~AsyncLogWriter ();
+
+    static ThreadState *
+    GetCurrentThreadState ();
+
+    static void
+    ThreadStateCleanup (void *p);
+
+    static lldb::thread_result_t
+    WriterThread (lldb::thread_arg_t arg);
+
+    void
+    StartWriterThreadIfNeeded ();
+
+    // Must be called with m_mutex held.
+    void
+    DrainRings ();
+
+    Mutex m_mutex;                          // Held by whoever is draining the rings
+    Condition m_condition;                  // Signaled when a ring is filling up
+    std::vector<ThreadRing *> m_rings;
+    std::deque<Record> m_flight_records;
+    std::atomic<uint64_t> m_next_sequence;
+    lldb::thread_t m_writer_thread;         // Guarded by m_mutex
+    std::atomic<bool> m_writer_running;     // Checked without m_mutex by logging threads
+    bool m_stop_writer;
+
+private:
+    DISALLOW_COPY_AND_ASSIGN (AsyncLogWriter);
+};
+
+} // namespace lldb_private
+
+#endif  // liblldb_AsyncLogWriter_h_
@@ -46,6 +46,8 @@
 #define LLDB_LOG_OPTION_PREPEND_PROC_AND_THREAD (1u << 5)
 #define LLDB_LOG_OPTION_PREPEND_THREAD_NAME     (1U << 6)
 #define LLDB_LOG_OPTION_BACKTRACE               (1U << 7)
+#define LLDB_LOG_OPTION_ASYNC                   (1U << 8)
+#define LLDB_LOG_OPTION_FLIGHT_RECORDER         (1U << 9)
 
 //----------------------------------------------------------------------
 // Logging Functions
@@ -105,6 +107,20 @@ public:
 
     static void
     Terminate ();
+
+    //------------------------------------------------------------------
+    // Write out the lines kept for logs enabled with
+    // LLDB_LOG_OPTION_FLIGHT_RECORDER, returns the number of lines.
+    //------------------------------------------------------------------
+    static size_t
+    DumpFlightRecorder ();
+
+    //------------------------------------------------------------------
+    // Write out the lines queued by logs enabled with
+    // LLDB_LOG_OPTION_ASYNC.  Called when logs are disabled.
+    //------------------------------------------------------------------
+    static void
+    FlushAsyncLogs ();
     
     //------------------------------------------------------------------
     // Auto completion
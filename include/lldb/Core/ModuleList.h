@@ -12,8 +12,11 @@
 
 #include <vector>
 #include <list>
+#include <map>
+#include <unordered_map>
 
 #include "lldb/lldb-private.h"
+#include "lldb/Core/UUID.h"
 #include "lldb/Host/Mutex.h"
 
 namespace lldb_private {
@@ -41,6 +44,11 @@ public:
                        const lldb::ModuleSP& new_module_sp) = 0;
         virtual void
         WillClearList (const ModuleList& module_list) = 0;
+
+        // The number of threads to search the list's modules with (see
+        // the "target.module-query-threads" setting).
+        virtual uint32_t
+        GetNumModuleQueryThreads () const = 0;
         
         virtual
         ~Notifier ()
@@ -557,6 +565,44 @@ protected:
     //------------------------------------------------------------------
     typedef std::vector<lldb::ModuleSP> collection; ///< The module collection type.
 
+    //------------------------------------------------------------------
+    // Indexes of m_modules, so modules can be found by pointer, UUID or
+    // file name without looking at every one of them.  The module
+    // vectors are in the order the modules were appended, which is their
+    // order in m_modules, and hold a module once for each time it is in
+    // m_modules.  They hold plain pointers, a module is only removed from
+    // m_modules when no one else refers to it.
+    //------------------------------------------------------------------
+    typedef std::vector<Module *> ModulePointers;
+
+    struct IndexEntry
+    {
+        uint32_t count;         ///< The number of times the module is in m_modules.
+        UUID uuid;              ///< The UUID the module was indexed by.
+        const char *basename;   ///< The ConstString file name the module was indexed by.
+    };
+
+    typedef std::unordered_map<const Module *, IndexEntry> PointerIndex;
+    typedef std::map<UUID, ModulePointers> UUIDIndex;
+    typedef std::unordered_map<const char *, ModulePointers> BasenameIndex;
+
+    void
+    IndexModule (Module *module);
+
+    void
+    UnindexModule (Module *module);
+
+    void
+    RebuildIndexes ();
+
+    //------------------------------------------------------------------
+    /// Returns the only modules that can match \a module_spec, or NULL
+    /// if the spec has neither a UUID nor a file name to narrow them
+    /// down and all modules have to be checked.
+    //------------------------------------------------------------------
+    const ModulePointers *
+    GetCandidateModules (const ModuleSpec &module_spec) const;
+
     void
     AppendImpl (const lldb::ModuleSP &module_sp, bool use_notifier = true);
     
@@ -568,12 +614,30 @@ protected:
     
     void
     ClearImpl (bool use_notifier = true);
+
+    //------------------------------------------------------------------
+    /// Returns a copy of the modules, so they can be searched by other
+    /// threads without holding m_modules_mutex.
+    //------------------------------------------------------------------
+    collection
+    GetModules () const;
+
+    //------------------------------------------------------------------
+    /// Returns the number of threads to search the modules with.  The
+    /// image list of a target uses the target's setting, other lists
+    /// use the global one.
+    //------------------------------------------------------------------
+    uint32_t
+    GetNumQueryThreads () const;
     
     //------------------------------------------------------------------
     // Member variables.
     //------------------------------------------------------------------
     collection m_modules; ///< The collection of modules.
     mutable Mutex m_modules_mutex;
+    PointerIndex m_pointer_index;
+    UUIDIndex m_uuid_index;
+    BasenameIndex m_basename_index;
 
     Notifier* m_notifier;
     
@@ -18,6 +18,7 @@
 // Other libraries and framework includes
 // Project includes
 #include "lldb/lldb-private.h"
+#include "lldb/Host/FileMonitor.h"
 #include "lldb/Host/FileSpec.h"
 
 namespace lldb_private {
@@ -40,8 +41,10 @@ public:
                             uint32_t context_before,
                             uint32_t context_after,
                             Stream *s);
+        // Only touches this File, so different files can be searched on
+        // different threads at the same time.
         void
-        FindLinesMatchingRegex (RegularExpression& regex, 
+        FindLinesMatchingRegex (const RegularExpression& regex, 
                                 uint32_t start_line, 
                                 uint32_t end_line, 
                                 std::vector<uint32_t> &match_lines);
@@ -58,6 +61,11 @@ public:
         bool
         FileSpecMatches (const FileSpec &file_spec);
 
+        // Same as GetFileSpec().Exists(), without a stat while the file
+        // is being watched.
+        bool
+        Exists ();
+
         const FileSpec &
         GetFileSpec ()
         {
@@ -70,8 +78,34 @@ public:
             return m_source_map_mod_id;
         }
         
+        // The size of the contents last read, or zero if they haven't been.
+        size_t
+        GetByteSize ();
+        
+        const FileSpec &
+        GetOriginalFileSpec ()
+        {
+            return m_file_spec_orig;
+        }
+        
+        // Returns the target whose path map and images were used to find
+        // this file, or NULL if it was found where it was asked for and
+        // can be used with any target.
+        Target *
+        GetTarget () const;
+        
+        // True if this file can be used by a source manager for \a target.
+        bool
+        IsValidForTarget (Target *target) const;
+        
     protected:
 
+        // Read the contents if they haven't been, or the file has changed.
+        // While the file is being watched for changes this doesn't touch
+        // the file system at all.
+        void
+        UpdateIfNeeded ();
+
         bool
         CalculateLineOffsets (uint32_t line = UINT32_MAX);
 
@@ -79,9 +113,12 @@ public:
         FileSpec m_file_spec;       // The actualy file spec being used (if the target has source mappings, this might be different from m_file_spec_orig)
         TimeValue m_mod_time;       // Keep the modification time that this file data is valid for
         uint32_t m_source_map_mod_id; // If the target uses path remappings, be sure to clear our notion of a source file if the path modification ID changes
+        lldb::TargetWP m_target_wp; // The target used to find the file, see GetTarget()
+        bool m_found_with_target;
         lldb::DataBufferSP m_data_sp;
         typedef std::vector<uint32_t> LineOffsets;
         LineOffsets m_offsets;
+        FileMonitor::WatchSP m_watch_sp; // Flagged when m_data_sp goes stale, if the host can watch files
     };
 
 #endif // SWIG
@@ -91,19 +128,28 @@ public:
 #ifndef SWIG
 
    // The SourceFileCache class separates the source manager from the cache of source files, so the 
-   // cache can be stored in the Debugger, but the source managers can be per target.     
+   // cache can be stored in the Debugger, but the source managers can be per target.  Files are found
+   // by the file spec they were asked for with, and the target that was used to find them, if any.
+   // Only the most recently used files are kept.
     class SourceFileCache
     {
     public:
-        SourceFileCache () {}
+        SourceFileCache () : m_file_cache(), m_use_counter(0) {}
         ~SourceFileCache() {}
         
         void AddSourceFile (const FileSP &file_sp);
-        FileSP FindSourceFile (const FileSpec &file_spec) const;
+        FileSP FindSourceFile (const FileSpec &file_spec, Target *target) const;
         
     protected:
-        typedef std::map <FileSpec, FileSP> FileCache;
+        struct Entry
+        {
+            FileSP m_file_sp;
+            mutable uint64_t m_last_use;
+        };
+        typedef std::pair<FileSpec, Target *> FileCacheKey;
+        typedef std::map <FileCacheKey, Entry> FileCache;
         FileCache m_file_cache;
+        mutable uint64_t m_use_counter; // Incremented on each use, to find the least recently used file.
     };
 #endif
 
@@ -168,10 +214,10 @@ public:
                             uint32_t end_line, 
                             std::vector<uint32_t> &match_lines);
 
-protected:
-
     FileSP
     GetFile (const FileSpec &file_spec);
+
+protected:
     
     //------------------------------------------------------------------
     // Classes that inherit from SourceManager can see and modify these
@@ -917,15 +917,51 @@ public:
     virtual bool
     MightHaveChildren();
 
+    //------------------------------------------------------------------
+    /// ValueObjects that are owned by another ValueObject can be
+    /// allocated in the cluster of their parent with
+    /// "new (parent) ValueObjectChild (parent, ...)".  They are then
+    /// freed with the rest of the cluster instead of one by one.
+    //------------------------------------------------------------------
+    static void *
+    operator new (size_t size, ValueObject &parent);
+
+    static void
+    operator delete (void *ptr, ValueObject &parent)
+    {
+        // Only used if a constructor throws, the cluster owns the memory.
+    }
+
+    static void *
+    operator new (size_t size)
+    {
+        return ::operator new (size);
+    }
+
+    static void
+    operator delete (void *ptr)
+    {
+        ::operator delete (ptr);
+    }
+
 protected:
     typedef ClusterManager<ValueObject> ValueObjectManager;
     
+    //------------------------------------------------------------------
+    // Children are looked up by index on every access, so keep them in
+    // a vector indexed by child number instead of a map.  It is only
+    // grown to the highest index actually created, so asking for the
+    // child count of a huge array doesn't allocate anything.  A child
+    // that couldn't be created is remembered as tried, so it isn't
+    // created again on every access.
+    //------------------------------------------------------------------
     class ChildrenManager
     {
     public:
         ChildrenManager() :
-            m_mutex(Mutex::eMutexTypeRecursive),
+            m_mutex(Mutex::eMutexTypeNormal),
             m_children(),
+            m_tried(),
             m_children_count(0)
         {}
         
@@ -933,29 +969,41 @@ protected:
         HasChildAtIndex (size_t idx)
         {
             Mutex::Locker locker(m_mutex);
-            ChildrenIterator iter = m_children.find(idx);
-            ChildrenIterator end = m_children.end();
-            return (iter != end);
+            return idx < m_tried.size() && m_tried[idx];
         }
         
         ValueObject*
         GetChildAtIndex (size_t idx)
         {
             Mutex::Locker locker(m_mutex);
-            ChildrenIterator iter = m_children.find(idx);
-            ChildrenIterator end = m_children.end();
-            if (iter == end)
-                return NULL;
-            else
-                return iter->second;
+            if (idx < m_children.size())
+                return m_children[idx];
+            return NULL;
         }
         
         void
         SetChildAtIndex (size_t idx, ValueObject* valobj)
         {
-            ChildrenPair pair(idx,valobj); // we do not need to be mutex-protected to make a pair
             Mutex::Locker locker(m_mutex);
-            m_children.insert(pair);
+            if (idx >= m_children.size())
+            {
+                // Children are usually created in order, make room for
+                // all of them at once the first time.
+                if (m_children.empty() && idx < m_children_count && m_children_count <= g_max_reserved_children)
+                {
+                    m_children.reserve(m_children_count);
+                    m_tried.reserve(m_children_count);
+                }
+                m_children.resize(idx + 1, NULL);
+                m_tried.resize(idx + 1, false);
+            }
+            // Like the map this replaces, keep the first child set at an
+            // index, even if it is NULL.
+            if (!m_tried[idx])
+            {
+                m_children[idx] = valobj;
+                m_tried[idx] = true;
+            }
         }
         
         void
@@ -976,14 +1024,15 @@ protected:
             m_children_count = 0;
             Mutex::Locker locker(m_mutex);
             m_children.clear();
+            m_tried.clear();
         }
         
     private:
-        typedef std::map<size_t, ValueObject*> ChildrenMap;
-        typedef ChildrenMap::iterator ChildrenIterator;
-        typedef ChildrenMap::value_type ChildrenPair;
+        static const size_t g_max_reserved_children = 64 * 1024;
+        typedef std::vector<ValueObject*> ChildrenVector;
         Mutex m_mutex;
-        ChildrenMap m_children;
+        ChildrenVector m_children;
+        std::vector<bool> m_tried;  // Whether CreateChildAtIndex was called for each index
         size_t m_children_count;
     };
 
@@ -1048,6 +1097,7 @@ protected:
     friend class ClangExpressionVariable; // For SetName
     friend class Target;                  // For SetName
     friend class ValueObjectConstResultImpl;
+    friend class ValueObjectChild;        // For GetDataExtractor on its parent
 
     //------------------------------------------------------------------
     // Constructors and Destructors
@@ -1123,6 +1173,19 @@ protected:
     DataExtractor &
     GetDataExtractor ();
     
+    //------------------------------------------------------------------
+    /// Read all the bytes of an aggregate that lives in memory into
+    /// m_data with a single read, so its children can slice their data
+    /// out of it (see ValueObjectChild::GetDataFromParent) instead of
+    /// each reading their own.  Large aggregates, and ones that can't be
+    /// read in one piece, are left with no data.
+    ///
+    /// @param[in] value
+    ///     The value to read, with the context needed to size it.
+    //------------------------------------------------------------------
+    void
+    ReadAggregateData (ExecutionContext &exe_ctx, const Value &value);
+    
     void
     ClearDynamicTypeInformation ();
     
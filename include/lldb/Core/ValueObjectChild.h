@@ -77,10 +77,29 @@ public:
         return m_is_deref_of_parent;
     }
 
+    //------------------------------------------------------------------
+    /// The number of children, across all processes, whose data was
+    /// taken from the parent's data instead of being read from memory.
+    //------------------------------------------------------------------
+    static uint64_t
+    GetNumMemoryReadsSaved ();
+
 protected:
     virtual bool
     UpdateValue ();
 
+    //------------------------------------------------------------------
+    /// Members of a structure and elements of an array that lives in
+    /// memory are contained in the bytes their parent already read, so
+    /// point m_data into those instead of reading them again.
+    ///
+    /// @return
+    ///     True if m_data was filled in, false if the caller has to read
+    ///     the value itself.
+    //------------------------------------------------------------------
+    bool
+    GetDataFromParent (ValueObject *parent);
+
     virtual ClangASTType
     GetClangTypeImpl ()
     {
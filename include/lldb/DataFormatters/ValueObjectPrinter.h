@@ -265,6 +265,16 @@ public:
     bool
     PrintValueObject ();
     
+    //------------------------------------------------------------------
+    /// The number of memory reads avoided during the last
+    /// PrintValueObject() by taking children's data from their parent.
+    //------------------------------------------------------------------
+    uint64_t
+    GetNumMemoryReadsSaved () const
+    {
+        return m_memory_reads_saved;
+    }
+    
 protected:
     
     // only this class (and subclasses, if any) should ever be concerned with
@@ -385,6 +395,7 @@ private:
     std::string m_value;
     std::string m_summary;
     std::string m_error;
+    uint64_t m_memory_reads_saved;
     
     friend class StringSummaryFormat;
     
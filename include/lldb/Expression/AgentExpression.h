@@ -0,0 +1,200 @@
+//===-- AgentExpression.h ---------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef liblldb_AgentExpression_h_
+#define liblldb_AgentExpression_h_
+
+// C Includes
+// C++ Includes
+#include <vector>
+
+// Other libraries and framework includes
+// Project includes
+#include "lldb/lldb-private.h"
+
+namespace lldb_private {
+
+//----------------------------------------------------------------------
+/// @class AgentExpression AgentExpression.h "lldb/Expression/AgentExpression.h"
+/// @brief A compact, target independent bytecode for simple conditions.
+///
+/// Breakpoint conditions are usually simple comparisons of locals,
+/// members of locals and globals against constants.  Running such a
+/// condition through ClangUserExpression on every hit costs a full
+/// parse on the first hit and an IR interpretation (or a JIT'ed
+/// function call) on every hit after that.
+///
+/// This class lowers those simple conditions once, using the DWARF
+/// locations of the variables involved, into the same stack based
+/// bytecode gdb uses for its "agent expressions".  The resulting
+/// program only reads registers and memory, so it can be evaluated
+/// directly against a frame's register context, or handed off to a
+/// remote stub that understands agent expressions.
+///
+/// Anything the compiler doesn't understand (function calls, floating
+/// point, bitfields, casts, ...) makes Compile() fail, and the caller
+/// is expected to fall back to the full expression parser.
+//----------------------------------------------------------------------
+class AgentExpression
+{
+public:
+    //------------------------------------------------------------------
+    /// Opcodes, numbered as in gdb's agent expression bytecode so the
+    /// compiled form can be sent to a remote stub unchanged.  Operands
+    /// are encoded big endian.
+    //------------------------------------------------------------------
+    enum Opcode
+    {
+        eOpAdd          = 0x02,
+        eOpSub          = 0x03,
+        eOpMul          = 0x04,
+        eOpLogNot       = 0x0e,
+        eOpBitAnd       = 0x0f,
+        eOpBitOr        = 0x10,
+        eOpBitXor       = 0x11,
+        eOpBitNot       = 0x12,
+        eOpEqual        = 0x13,
+        eOpLessSigned   = 0x14,
+        eOpLessUnsigned = 0x15,
+        eOpExt          = 0x16,     ///< 1 byte operand: sign extend from N bits
+        eOpRef8         = 0x17,
+        eOpRef16        = 0x18,
+        eOpRef32        = 0x19,
+        eOpRef64        = 0x1a,
+        eOpIfGoto       = 0x20,     ///< 2 byte operand: absolute bytecode offset
+        eOpGoto         = 0x21,     ///< 2 byte operand: absolute bytecode offset
+        eOpConst8       = 0x22,
+        eOpConst16      = 0x23,
+        eOpConst32      = 0x24,
+        eOpConst64      = 0x25,
+        eOpReg          = 0x26,     ///< 2 byte operand: register number
+        eOpEnd          = 0x27,
+        eOpDup          = 0x28,
+        eOpPop          = 0x29,
+        eOpZeroExt      = 0x2a,     ///< 1 byte operand: zero extend from N bits
+        eOpSwap         = 0x2b
+    };
+
+    AgentExpression ();
+
+    ~AgentExpression ();
+
+    //------------------------------------------------------------------
+    /// Compile a breakpoint condition into bytecode.
+    ///
+    /// @param[in] condition
+    ///     The source text of the condition.
+    ///
+    /// @param[in] exe_ctx
+    ///     The execution context of a stop at the location the condition
+    ///     will be evaluated at.  Variable locations are resolved for
+    ///     the frame's PC, so the result is only valid for that address.
+    ///
+    /// @param[out] error
+    ///     Describes why the condition couldn't be compiled.
+    ///
+    /// @return
+    ///     True if the condition was compiled, false if it needs the
+    ///     full expression parser.
+    //------------------------------------------------------------------
+    bool
+    Compile (const char *condition,
+             ExecutionContext &exe_ctx,
+             Error &error);
+
+    //------------------------------------------------------------------
+    /// Run the bytecode against the registers of the frame in \a exe_ctx
+    /// and the memory of its process.
+    ///
+    /// @param[out] result
+    ///     The value left on top of the stack.
+    ///
+    /// @return
+    ///     True if evaluation completed, false if a register or memory
+    ///     read failed or the bytecode was malformed.
+    //------------------------------------------------------------------
+    bool
+    Evaluate (ExecutionContext &exe_ctx,
+              uint64_t &result,
+              Error &error) const;
+
+    bool
+    IsValid () const
+    {
+        return !m_opcodes.empty();
+    }
+
+    void
+    Clear ();
+
+    const std::vector<uint8_t> &
+    GetOpcodes () const
+    {
+        return m_opcodes;
+    }
+
+    //------------------------------------------------------------------
+    /// Register numbers in the bytecode are in this register kind.
+    //------------------------------------------------------------------
+    lldb::RegisterKind
+    GetRegisterKind () const
+    {
+        return lldb::eRegisterKindLLDB;
+    }
+
+    //------------------------------------------------------------------
+    /// The unique ID of the process whose load addresses were baked
+    /// into the bytecode.
+    //------------------------------------------------------------------
+    uint32_t
+    GetProcessUniqueID () const
+    {
+        return m_process_unique_id;
+    }
+
+    void
+    Dump (Stream *s) const;
+
+    //------------------------------------------------------------------
+    /// Bytecode emission, used by the condition compiler.
+    //------------------------------------------------------------------
+    void
+    AppendOpcode (uint8_t opcode);
+
+    void
+    AppendConstant (uint64_t value);
+
+    void
+    AppendRegister (uint32_t reg_num);
+
+    void
+    AppendExtend (uint8_t opcode, uint32_t bit_size);
+
+    bool
+    AppendMemoryRead (uint32_t byte_size);
+
+    void
+    AppendBytecode (const AgentExpression &rhs);
+
+    // Append a goto or if_goto and return the offset of its operand
+    // so it can be patched with PatchJump once the target is known.
+    size_t
+    AppendJump (uint8_t opcode);
+
+    void
+    PatchJump (size_t operand_offset);
+
+protected:
+    std::vector<uint8_t> m_opcodes;     ///< The bytecode, terminated with eOpEnd once compiled.
+    uint32_t m_process_unique_id;       ///< The process the compiled addresses belong to.
+};
+
+} // namespace lldb_private
+
+#endif  // liblldb_AgentExpression_h_
@@ -333,6 +333,7 @@ private:
     
     lldb::ProcessWP                             m_process_wp;           ///< The process used as the context for the expression.
     Address                                     m_address;              ///< The address the process is stopped in.
+    Block                                      *m_block;                ///< The innermost block containing m_address, the expression can run anywhere in it.
     lldb::addr_t                                m_stack_frame_bottom;   ///< The bottom of the allocated stack frame.
     lldb::addr_t                                m_stack_frame_top;      ///< The top of the allocated stack frame.
     
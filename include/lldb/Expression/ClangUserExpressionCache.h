@@ -0,0 +1,147 @@
+//===-- ClangUserExpressionCache.h ------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef liblldb_ClangUserExpressionCache_h_
+#define liblldb_ClangUserExpressionCache_h_
+
+// C Includes
+// C++ Includes
+#include <map>
+#include <string>
+
+// Other libraries and framework includes
+// Project includes
+#include "lldb/lldb-private.h"
+#include "lldb/Expression/ClangUserExpression.h"
+#include "lldb/Host/Mutex.h"
+
+namespace lldb_private {
+
+//----------------------------------------------------------------------
+/// @class ClangUserExpressionCache ClangUserExpressionCache.h "lldb/Expression/ClangUserExpressionCache.h"
+/// @brief Keeps parsed expressions around so they can be run again.
+///
+/// Parsing an expression builds a Clang compiler instance, imports
+/// every declaration it uses and runs IRForTarget over the result.
+/// When the same text is evaluated over and over in the same lexical
+/// block (IDE watch expressions, scripted loops) none of that changes,
+/// and only the variables need to be materialized again.
+///
+/// Entries are keyed by the expression text, the options that affect
+/// parsing, the process and the innermost Block of the frame.  The
+/// owning Target clears the cache whenever modules or symbols are
+/// loaded or unloaded, since name lookups could then have different
+/// results.
+//----------------------------------------------------------------------
+class ClangUserExpressionCache
+{
+public:
+    ClangUserExpressionCache ();
+
+    ~ClangUserExpressionCache ();
+
+    //------------------------------------------------------------------
+    /// Find a parsed expression that can be run in \a exe_ctx.
+    ///
+    /// @return
+    ///     The expression, or an empty shared pointer if there isn't one
+    ///     or the cached one is still in use by another evaluation.
+    //------------------------------------------------------------------
+    ClangUserExpression::ClangUserExpressionSP
+    Find (ExecutionContext &exe_ctx,
+          const char *expr_cstr,
+          const char *expr_prefix,
+          lldb::LanguageType language,
+          ClangExpression::ResultType desired_type,
+          ExecutionPolicy execution_policy);
+
+    //------------------------------------------------------------------
+    /// Remember a successfully parsed expression, replacing any entry
+    /// with the same key.
+    //------------------------------------------------------------------
+    void
+    Insert (ExecutionContext &exe_ctx,
+            const char *expr_cstr,
+            const char *expr_prefix,
+            lldb::LanguageType language,
+            ClangExpression::ResultType desired_type,
+            ExecutionPolicy execution_policy,
+            const ClangUserExpression::ClangUserExpressionSP &user_expression_sp);
+
+    void
+    Clear ();
+
+    size_t
+    GetSize () const;
+
+    uint64_t
+    GetHitCount () const
+    {
+        return m_hit_count;
+    }
+
+    uint64_t
+    GetMissCount () const
+    {
+        return m_miss_count;
+    }
+
+    //------------------------------------------------------------------
+    /// Expressions that define or use persistent variables ("$foo")
+    /// depend on state the cache key doesn't capture, so they are
+    /// always parsed from scratch.
+    //------------------------------------------------------------------
+    static bool
+    CanCache (const char *expr_cstr);
+
+protected:
+    struct Key
+    {
+        std::string m_text;
+        std::string m_prefix;
+        lldb::LanguageType m_language;
+        ClangExpression::ResultType m_desired_type;
+        ExecutionPolicy m_execution_policy;
+        uint32_t m_process_unique_id;
+        const Block *m_block;
+
+        bool
+        operator < (const Key &rhs) const;
+    };
+
+    struct Entry
+    {
+        ClangUserExpression::ClangUserExpressionSP m_expression_sp;
+        uint64_t m_last_use;
+    };
+
+    typedef std::map<Key, Entry> collection;
+
+    static void
+    MakeKey (ExecutionContext &exe_ctx,
+             const char *expr_cstr,
+             const char *expr_prefix,
+             lldb::LanguageType language,
+             ClangExpression::ResultType desired_type,
+             ExecutionPolicy execution_policy,
+             Key &key);
+
+    mutable Mutex m_mutex;
+    collection m_entries;
+    uint64_t m_use_counter;     ///< Incremented on each use, to find the least recently used entry.
+    uint64_t m_hit_count;
+    uint64_t m_miss_count;
+
+private:
+    DISALLOW_COPY_AND_ASSIGN (ClangUserExpressionCache);
+};
+
+} // namespace lldb_private
+
+#endif  // liblldb_ClangUserExpressionCache_h_
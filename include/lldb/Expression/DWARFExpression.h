@@ -378,6 +378,28 @@ public:
         data = m_data;
         return data.GetByteSize() > 0;
     }
+
+    //------------------------------------------------------------------
+    /// Get the opcodes that describe the location at a given address.
+    ///
+    /// @param[in] loclist_base_load_addr
+    ///     If this is a location list, the load address of the function
+    ///     the location list is relative to.
+    ///
+    /// @param[in] pc
+    ///     The load address to get the location for.
+    ///
+    /// @param[out] data
+    ///     The whole expression for single locations, or the matching
+    ///     location list entry's opcodes.
+    ///
+    /// @return
+    ///     True if a non-empty location was found for \a pc.
+    //------------------------------------------------------------------
+    bool
+    GetExpressionDataAtAddress (lldb::addr_t loclist_base_load_addr,
+                                lldb::addr_t pc,
+                                DataExtractor &data);
     
     bool
     DumpLocationForAddress (Stream *s, 
@@ -0,0 +1,93 @@
+//===-- FileMonitor.h -------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef liblldb_FileMonitor_h_
+#define liblldb_FileMonitor_h_
+#if defined(__cplusplus)
+
+// C Includes
+// C++ Includes
+#include <atomic>
+#include <memory>
+
+// Other libraries and framework includes
+// Project includes
+#include "lldb/lldb-private.h"
+
+namespace lldb_private {
+
+//----------------------------------------------------------------------
+/// @class FileMonitor FileMonitor.h "lldb/Host/FileMonitor.h"
+/// @brief Finds out about changes to files without polling them.
+///
+/// Code that caches the contents of a file normally has to stat it
+/// every time the contents are used, to see if they are still current.
+/// On hosts that can notify us of changes (inotify on Linux), a Watch
+/// is flagged from a background thread when its file is modified,
+/// replaced, moved or deleted, so checking it costs nothing.
+///
+/// Where that isn't supported, or the host has run out of watches,
+/// WatchFile returns an empty pointer and callers have to keep polling.
+//----------------------------------------------------------------------
+class FileMonitor
+{
+public:
+    class Watch
+    {
+    public:
+        ~Watch ();
+
+        //--------------------------------------------------------------
+        /// Returns true once the file has changed since the watch was
+        /// created.  A watch stays changed, make a new one to find out
+        /// about later changes.
+        //--------------------------------------------------------------
+        bool
+        HasChanged () const
+        {
+            return m_changed.load (std::memory_order_acquire);
+        }
+
+        //--------------------------------------------------------------
+        /// Called by the host specific monitor when the file changes.
+        //--------------------------------------------------------------
+        void
+        SetChanged ()
+        {
+            m_changed.store (true, std::memory_order_release);
+        }
+
+        Watch (int watch_descriptor);
+
+    protected:
+
+        int m_watch_descriptor;
+        std::atomic<bool> m_changed;
+
+    private:
+        DISALLOW_COPY_AND_ASSIGN (Watch);
+    };
+
+    typedef std::shared_ptr<Watch> WatchSP;
+
+    //------------------------------------------------------------------
+    /// Start watching \a file_spec for changes.
+    ///
+    /// @return
+    ///     A watch that is flagged when the file changes, or an empty
+    ///     pointer if the file can't be watched.
+    //------------------------------------------------------------------
+    static WatchSP
+    WatchFile (const FileSpec &file_spec);
+};
+
+} // namespace lldb_private
+
+#endif  // #if defined(__cplusplus)
+#endif  // liblldb_FileMonitor_h_
@@ -353,6 +353,20 @@ public:
     TimeValue
     GetModificationTime () const;
 
+    //------------------------------------------------------------------
+    /// Get the modification time of the file, including the fraction of
+    /// a second where the file system has it.
+    ///
+    /// GetModificationTime only has whole seconds.  Use this to tell
+    /// whether a file was rewritten within the same second.
+    ///
+    /// @return
+    ///     The modification time, or an invalid TimeValue if the file
+    ///     doesn't exist.
+    //------------------------------------------------------------------
+    TimeValue
+    GetPreciseModificationTime () const;
+
     //------------------------------------------------------------------
     /// Extract the full path to the file.
     ///
@@ -0,0 +1,61 @@
+//===-- TaskPool.h ----------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef liblldb_TaskPool_h_
+#define liblldb_TaskPool_h_
+#if defined(__cplusplus)
+
+// C Includes
+// C++ Includes
+#include <functional>
+
+// Other libraries and framework includes
+// Project includes
+#include "lldb/lldb-private.h"
+
+namespace lldb_private {
+
+//----------------------------------------------------------------------
+/// @class TaskPool TaskPool.h "lldb/Host/TaskPool.h"
+/// @brief Runs independent pieces of work on a shared pool of threads.
+///
+/// The pool's threads are created the first time they are needed and
+/// then wait for more work for the life of the process.  The calling
+/// thread always works on its own request too, so a task may itself use
+/// the pool without deadlocking, even when every pool thread is busy.
+//----------------------------------------------------------------------
+class TaskPool
+{
+public:
+    //------------------------------------------------------------------
+    /// Call \a callback once for every index in [0, \a count), using up
+    /// to \a max_threads threads including the calling one, and return
+    /// once every call has returned.
+    ///
+    /// @param[in] count
+    ///     The number of indexes to call \a callback with.
+    ///
+    /// @param[in] max_threads
+    ///     The most threads to use. Zero means one per CPU, one means
+    ///     everything is done on the calling thread.
+    ///
+    /// @param[in] callback
+    ///     Called with each index exactly once, in no particular order
+    ///     and from any thread.
+    //------------------------------------------------------------------
+    static void
+    ForEachIndex (size_t count,
+                  uint32_t max_threads,
+                  const std::function<void(size_t)> &callback);
+};
+
+} // namespace lldb_private
+
+#endif  // #if defined(__cplusplus)
+#endif  // liblldb_TaskPool_h_
@@ -14,6 +14,7 @@
 
 #include "lldb/lldb-private.h"
 #include "lldb/Symbol/LineEntry.h"
+#include "lldb/Core/DataExtractor.h"
 #include "lldb/Core/ModuleChild.h"
 #include "lldb/Core/Section.h"
 #include "lldb/Core/RangeMap.h"
@@ -268,6 +269,45 @@ public:
     LineTable *
     LinkLineTable (const FileRangeMap &file_range_map);
 
+    //------------------------------------------------------------------
+    /// Encode the line table entries so they use less memory.
+    ///
+    /// Each entry is stored as the differences from the previous one:
+    /// a byte of flags, the address and line deltas, and the column and
+    /// file index only when they change.  A full copy of every 16th
+    /// entry is kept so lookups can binary search these and decode a
+    /// few entries.  Adding entries afterwards expands the table again.
+    //------------------------------------------------------------------
+    void
+    Compact ();
+
+    //------------------------------------------------------------------
+    /// Get the encoded entries of a compacted line table, for caching
+    /// them.
+    ///
+    /// @param[out] data
+    ///     The encoded entries.
+    ///
+    /// @param[out] num_entries
+    ///     The number of entries encoded in \a data.
+    ///
+    /// @return
+    ///     \b true if the line table is compact and not empty.
+    //------------------------------------------------------------------
+    bool
+    GetCompactData (DataExtractor &data, uint32_t &num_entries) const;
+
+    //------------------------------------------------------------------
+    /// Replace the entries of this line table with ones that
+    /// GetCompactData returned, possibly in an earlier session.
+    ///
+    /// @return
+    ///     \b true if \a data holds \a num_entries valid entries, in
+    ///     which case the line table keeps a reference to it.
+    //------------------------------------------------------------------
+    bool
+    SetCompactData (const DataExtractor &data, uint32_t num_entries);
+
 protected:
 
     struct Entry
@@ -379,16 +419,69 @@ protected:
         Entry *a_entry;
     };
 
+    // A full copy of every k_checkpoint_interval'th entry of a compact
+    // line table.
+    struct Checkpoint
+    {
+        Entry entry;
+        lldb::offset_t next_offset; ///< The offset of the following entry in m_compact_data.
+
+        static bool CheckpointAddressLessThan (const Checkpoint& lhs, lldb::addr_t file_addr)
+        {
+            return lhs.entry.file_addr < file_addr;
+        }
+    };
+
     //------------------------------------------------------------------
     // Types
     //------------------------------------------------------------------
     typedef std::vector<lldb_private::Section*> section_collection; ///< The collection type for the sections.
     typedef std::vector<Entry>                  entry_collection;   ///< The collection type for the line entries.
+    typedef std::vector<Checkpoint>             checkpoint_collection;
+
+    //------------------------------------------------------------------
+    // Reads the entries of the line table in order, whether they are in
+    // m_entries or compact.  Copying a reader is cheap.
+    //------------------------------------------------------------------
+    class EntryReader
+    {
+    public:
+        EntryReader (const LineTable &line_table);
+
+        bool
+        SeekToIndex (uint32_t idx);
+
+        // Move to the next entry, returns false past the last one.
+        bool
+        Next ();
+
+        uint32_t
+        GetIndex () const
+        {
+            return m_idx;
+        }
+
+        const Entry &
+        GetEntry () const
+        {
+            return m_entry;
+        }
+
+    protected:
+        const LineTable &m_line_table;
+        uint32_t m_idx;
+        lldb::offset_t m_offset;
+        Entry m_entry;
+    };
+
     //------------------------------------------------------------------
     // Member variables.
     //------------------------------------------------------------------
     CompileUnit* m_comp_unit;   ///< The compile unit that this line table belongs to.
-    entry_collection m_entries; ///< The collection of line entries in this line table.
+    entry_collection m_entries; ///< The collection of line entries in this line table, unless it is compact.
+    DataExtractor m_compact_data;           ///< The encoded entries of a compact line table.
+    checkpoint_collection m_checkpoints;    ///< Every k_checkpoint_interval'th entry of a compact line table.
+    uint32_t m_num_compact_entries;         ///< The number of entries in m_compact_data.
 
     //------------------------------------------------------------------
     // Helper class
@@ -413,6 +506,33 @@ protected:
     bool
     ConvertEntryAtIndexToLineEntry (uint32_t idx, LineEntry &line_entry);
 
+    bool
+    ConvertEntryToLineEntry (const EntryReader &reader, LineEntry &line_entry);
+
+    bool
+    GetEntryAtIndex (uint32_t idx, Entry &entry) const;
+
+    // The index of the first entry whose address is >= file_addr, or
+    // GetSize() if there is none.
+    uint32_t
+    FindFirstEntryIndexAtOrAfter (lldb::addr_t file_addr) const;
+
+    bool
+    IsCompact () const
+    {
+        return m_num_compact_entries > 0;
+    }
+
+    // Decode the entries of a compact line table back into m_entries.
+    void
+    Expand ();
+
+    static void
+    EncodeEntry (Stream &strm, const Entry &prev_entry, const Entry &entry);
+
+    static bool
+    DecodeEntry (const DataExtractor &data, lldb::offset_t *offset_ptr, Entry &entry);
+
 private:
     DISALLOW_COPY_AND_ASSIGN (LineTable);
 };
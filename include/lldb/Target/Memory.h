@@ -147,6 +147,11 @@ namespace lldb_private {
     // A class that can track allocated memory and give out allocated memory
     // without us having to make an allocate/deallocate call every time we
     // need some memory in a process that is being debugged.
+    //
+    // Memory is taken from the process in large regions that are kept
+    // until the process exits or execs, so expressions (which allocate and
+    // free their scratch memory through here) normally reuse the regions
+    // left behind by earlier ones instead of allocating in the inferior.
     //----------------------------------------------------------------------
     class AllocatedMemoryCache
     {
@@ -99,6 +99,12 @@ public:
     
     void
     SetDetachKeepsStopped (bool keep_stopped);
+
+    bool
+    GetNonStopMode () const;
+
+    void
+    SetNonStopMode (bool non_stop);
 };
 
 typedef std::shared_ptr<ProcessProperties> ProcessPropertiesSP;
@@ -1368,6 +1374,84 @@ protected:
     OptionalBool m_execute;
 };
 
+//----------------------------------------------------------------------
+// SaveCoreOptions
+//
+// Describes which memory Process::SaveCore puts in a core file.  The
+// registers of every thread and the list of loaded modules are always
+// saved.
+//----------------------------------------------------------------------
+class SaveCoreOptions
+{
+public:
+    SaveCoreOptions () :
+        m_skip_read_only_files (false),
+        m_stacks_only (false),
+        m_include_addresses ()
+    {
+    }
+
+    ~SaveCoreOptions ()
+    {
+    }
+
+    void
+    Clear ()
+    {
+        m_skip_read_only_files = false;
+        m_stacks_only = false;
+        m_include_addresses.clear();
+    }
+
+    // Leave out memory that is mapped read only from a file, like the
+    // code of the executable and its shared libraries, since it can be
+    // read from those files.
+    bool
+    GetSkipReadOnlyFiles () const
+    {
+        return m_skip_read_only_files;
+    }
+
+    void
+    SetSkipReadOnlyFiles (bool skip)
+    {
+        m_skip_read_only_files = skip;
+    }
+
+    // Only save the used part of each thread's stack, and the mappings
+    // that contain the addresses added with AppendIncludeAddress.
+    bool
+    GetStacksOnly () const
+    {
+        return m_stacks_only;
+    }
+
+    void
+    SetStacksOnly (bool stacks_only)
+    {
+        m_stacks_only = stacks_only;
+    }
+
+    // Always save the whole memory mapping that contains @a addr, for
+    // example the heap.
+    void
+    AppendIncludeAddress (lldb::addr_t addr)
+    {
+        m_include_addresses.push_back(addr);
+    }
+
+    const std::vector<lldb::addr_t> &
+    GetIncludeAddresses () const
+    {
+        return m_include_addresses;
+    }
+
+protected:
+    bool m_skip_read_only_files;
+    bool m_stacks_only;
+    std::vector<lldb::addr_t> m_include_addresses;
+};
+
 //----------------------------------------------------------------------
 /// @class Process Process.h "lldb/Target/Process.h"
 /// @brief A plug-in interface definition class for debugging a process.
@@ -1772,6 +1856,28 @@ public:
         return error;
     }
 
+    //------------------------------------------------------------------
+    /// Write a core file of the process as it is now.
+    ///
+    /// The process must be stopped.
+    ///
+    /// @param[in] outfile
+    ///     The core file to create.
+    ///
+    /// @param[in] options
+    ///     Which memory to save, see SaveCoreOptions.
+    ///
+    /// @return
+    ///     An error object.
+    //------------------------------------------------------------------
+    virtual Error
+    SaveCore (const FileSpec &outfile, const SaveCoreOptions &options)
+    {
+        Error error;
+        error.SetErrorStringWithFormat("%s does not support saving core files.", GetPluginName().GetCString());
+        return error;
+    }
+
     //------------------------------------------------------------------
     /// Get the dynamic loader plug-in for this process. 
     ///
@@ -2264,6 +2370,20 @@ public:
     virtual Error
     WillResume () { return Error(); }
 
+    //------------------------------------------------------------------
+    /// Called before resuming to ask whether a stop that happened while
+    /// the process was already stopped is waiting to be reported.
+    ///
+    /// If so, the stop is reported instead of resuming, before the
+    /// threads are told they will resume and set up their plans (like
+    /// stepping over the breakpoint they are stopped at).
+    ///
+    /// @return
+    ///     Returns \b true if a stop is waiting to be reported.
+    //------------------------------------------------------------------
+    virtual bool
+    HasPendingStop () { return false; }
+
     //------------------------------------------------------------------
     /// Resumes all of a process's threads as configured using the
     /// Thread run control functions.
@@ -2728,6 +2848,38 @@ public:
                 size_t size,
                 Error &error);
 
+    //------------------------------------------------------------------
+    /// Get process memory without copying it.
+    ///
+    /// Processes that already hold their memory in a buffer, like core
+    /// files that are memory mapped, can point  data at the bytes in
+    /// that buffer instead of copying them. Callers fall back to
+    /// Process::ReadMemory (lldb::addr_t, void *, size_t, Error &) when
+    /// this returns false.
+    ///
+    /// @param[in] vm_addr
+    ///     A virtual load address that indicates where to start reading
+    ///     memory from.
+    ///
+    /// @param[in] size
+    ///     The number of bytes to get.
+    ///
+    /// @param[out] data
+    ///     Set to share the buffer that contains the memory, with the
+    ///     memory at offset zero.
+    ///
+    /// @return
+    ///     True if \a data now contains all \a size bytes, false if
+    ///     the memory has to be read instead.
+    //------------------------------------------------------------------
+    virtual bool
+    GetMemoryData (lldb::addr_t vm_addr,
+                   size_t size,
+                   DataExtractor &data)
+    {
+        return false;
+    }
+
     //------------------------------------------------------------------
     /// Read a NULL terminated string from memory
     ///
@@ -3240,6 +3392,17 @@ public:
         return error;
     }
 
+    //------------------------------------------------------------------
+    /// Called when the owners of \a bp_site, or their conditions, have
+    /// changed.  Process plug-ins that can have their debug stub
+    /// evaluate breakpoint conditions (see
+    /// BreakpointLocation::GetConditionBytecode()) should resend them.
+    //------------------------------------------------------------------
+    virtual void
+    UpdateBreakpointSiteConditions (BreakpointSite *bp_site)
+    {
+    }
+
 
     // This is implemented completely using the lldb::Process API. Subclasses
     // don't need to implement this function unless the standard flow of
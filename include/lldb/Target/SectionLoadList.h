@@ -13,11 +13,13 @@
 // C Includes
 // C++ Includes
 #include <map>
+#include <memory>
 
 // Other libraries and framework includes
 #include "llvm/ADT/DenseMap.h"
 // Project includes
 #include "lldb/lldb-public.h"
+#include "lldb/Core/RangeMap.h"
 #include "lldb/Host/Mutex.h"
 
 namespace lldb_private {
@@ -31,8 +33,9 @@ public:
     SectionLoadList () :
         m_addr_to_sect (),
         m_sect_to_addr (),
-        m_mutex (Mutex::eMutexTypeRecursive)
-
+        m_mutex (Mutex::eMutexTypeRecursive),
+        m_addr_index_mutex (Mutex::eMutexTypeNormal),
+        m_addr_index_sp ()
     {
     }
 
@@ -81,9 +84,30 @@ public:
 protected:
     typedef std::map<lldb::addr_t, lldb::SectionSP> addr_to_sect_collection;
     typedef llvm::DenseMap<const Section *, lldb::addr_t> sect_to_addr_collection;
+    typedef RangeDataVector<lldb::addr_t, lldb::addr_t, lldb::SectionSP> addr_index;
+    typedef std::shared_ptr<const addr_index> addr_index_sp;
+
+    addr_index_sp
+    GetAddressIndex () const;
+
+    // Call with m_mutex locked after changing m_addr_to_sect.
+    void
+    InvalidateAddressIndex ();
+
+    void
+    SetAddressIndex (const addr_index_sp &index_sp) const;
+
     addr_to_sect_collection m_addr_to_sect;
     sect_to_addr_collection m_sect_to_addr;
     mutable Mutex m_mutex;
+    // A sorted array of the ranges in m_addr_to_sect that ResolveLoadAddress
+    // searches without locking m_mutex.  An index is never modified once it
+    // is made, changes to the sections drop it and the next lookup makes a
+    // new one.  m_addr_index_mutex is only held while m_addr_index_sp is
+    // copied or replaced, so lookups don't wait for changes to the
+    // sections.  Take it after m_mutex, never before.
+    mutable Mutex m_addr_index_mutex;
+    mutable addr_index_sp m_addr_index_sp;
 };
 
 } // namespace lldb_private
@@ -164,10 +164,19 @@ public:
 
     bool
     GetUseFastStepping() const;
+
+    bool
+    GetUseFastBreakpointConditions () const;
     
     bool
     GetDisplayExpressionsInCrashlogs () const;
 
+    uint32_t
+    GetModuleQueryThreads () const;
+
+    FileSpec
+    GetCachePath () const;
+
     LoadScriptFromSymFile
     GetLoadScriptFromSymbolFile() const;
 
@@ -445,6 +454,9 @@ public:
     static FileSpecList
     GetDefaultDebugFileSearchPaths ();
 
+    static FileSpec
+    GetDefaultCachePath ();
+
     static ArchSpec
     GetDefaultArchitecture ();
 
@@ -754,6 +766,9 @@ protected:
     virtual void
     WillClearList (const ModuleList& module_list);
 
+    virtual uint32_t
+    GetNumModuleQueryThreads () const;
+
 public:
     
     void
@@ -1092,6 +1107,9 @@ public:
         return m_persistent_variables;
     }
 
+    ClangUserExpressionCache &
+    GetExpressionCache();
+
     //------------------------------------------------------------------
     // Target Stop Hooks
     //------------------------------------------------------------------
@@ -1293,6 +1311,7 @@ protected:
     std::unique_ptr<ClangASTSource> m_scratch_ast_source_ap;
     std::unique_ptr<ClangASTImporter> m_ast_importer_ap;
     ClangPersistentVariables m_persistent_variables;      ///< These are the persistent variables associated with this process for the expression parser.
+    std::unique_ptr<ClangUserExpressionCache> m_expression_cache_ap; ///< Parsed expressions that can be run again in the same context.
 
     std::unique_ptr<SourceManager> m_source_manager_ap;
 
@@ -13,6 +13,9 @@
 #include "lldb/Utility/SharingPtr.h"
 #include "lldb/Host/Mutex.h"
 
+#include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/Support/Allocator.h"
+
 namespace lldb_private {
 
 namespace imp
@@ -45,6 +48,9 @@ class ClusterManager
 public:
     ClusterManager () : 
         m_objects(),
+        m_object_set(),
+        m_allocator(),
+        m_allocated_objects(),
         m_external_ref(0),
         m_mutex(Mutex::eMutexTypeNormal) {}
     
@@ -53,7 +59,12 @@ public:
         size_t n_items = m_objects.size();
         for (size_t i = 0; i < n_items; i++)
         {
-            delete m_objects[i];
+            // Objects that live in m_allocator are only destroyed here,
+            // their memory is released all at once along with the allocator.
+            if (m_allocated_objects.count (m_objects[i]))
+                m_objects[i]->~T();
+            else
+                delete m_objects[i];
         }
         // Decrement refcount should have been called on this ClusterManager,
         // and it should have locked the mutex, now we will unlock it before
@@ -64,10 +75,28 @@ public:
     void ManageObject (T *new_object)
     {
         Mutex::Locker locker (m_mutex);
-        if (!ContainsObject(new_object))
+        if (m_object_set.insert (new_object))
             m_objects.push_back (new_object);
     }
     
+    //------------------------------------------------------------------
+    // Allocate storage for an object of \a size bytes that will be
+    // constructed in place and then passed to ManageObject.  Clusters
+    // tend to hold many small objects that all die together, so they
+    // are carved out of one allocator instead of each being new'ed.
+    // The object must be constructed at the returned address (a type
+    // derived from T through single inheritance), as that is how the
+    // destructor tells them apart from objects it has to delete.  T is
+    // usually abstract, so the storage is aligned for any scalar type.
+    //------------------------------------------------------------------
+    void *Allocate (size_t size)
+    {
+        Mutex::Locker locker (m_mutex);
+        void *storage = m_allocator.Allocate (size, llvm::AlignOf<long double>::Alignment);
+        m_allocated_objects.insert (storage);
+        return storage;
+    }
+    
     typename lldb_private::SharingPtr<T> GetSharedPointer(T *desired_object)
     {
         {
@@ -80,11 +109,9 @@ public:
     
 private:
     
-    bool ContainsObject (const T *desired_object)
+    bool ContainsObject (T *desired_object)
     {
-        typename std::vector<T *>::iterator pos, end = m_objects.end();
-        pos = std::find(m_objects.begin(), end, desired_object);
-        return pos != end;
+        return m_object_set.count (desired_object);
     }
     
     void DecrementRefCount () 
@@ -99,7 +126,10 @@ private:
     
     friend class imp::shared_ptr_refcount<ClusterManager>;
     
-    std::vector<T *> m_objects;
+    std::vector<T *> m_objects;                         // In the order they were added, which is the order they are destroyed in
+    llvm::SmallPtrSet<T *, 16> m_object_set;            // The same objects, to check for membership quickly
+    llvm::BumpPtrAllocator m_allocator;
+    llvm::SmallPtrSet<const void *, 16> m_allocated_objects;    // Storage handed out by Allocate
     int m_external_ref;
     Mutex m_mutex;
 };
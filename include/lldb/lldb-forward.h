@@ -24,6 +24,7 @@ class   Address;
 class   AddressImpl;
 class   AddressRange;
 class   AddressResolver;
+class   AgentExpression;
 class   ArchSpec;
 class   Args;
 class   ASTResultSynthesizer;
@@ -38,6 +39,7 @@ class   BreakpointLocationCollection;
 class   BreakpointLocationList;
 class   BreakpointOptions;
 class   BreakpointResolver;
+class   BreakpointResolverBatch;
 class   BreakpointSite;
 class   BreakpointSiteList;
 class   BroadcastEventSpec;
@@ -60,6 +62,7 @@ class   ClangExpressionVariables;
 class   ClangFunction;
 class   ClangPersistentVariables;
 class   ClangUserExpression;
+class   ClangUserExpressionCache;
 class   ClangUtilityFunction;
 class   CommandInterpreter;
 class   CommandObject;
@@ -169,6 +172,7 @@ class   RegisterLocation;
 class   RegisterLocationList;
 class   RegisterValue;
 class   RegularExpression;
+class   SaveCoreOptions;
 class   Scalar;
 class   ScriptInterpreter;
 class   ScriptInterpreterLocker;
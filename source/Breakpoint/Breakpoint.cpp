@@ -158,6 +158,7 @@ Breakpoint::SetIgnoreCount (uint32_t n)
         
     m_options.SetIgnoreCount(n);
     SendBreakpointChangedEvent (eBreakpointEventTypeIgnoreChanged);
+    UpdateBreakpointSiteConditions ();
 }
 
 void
@@ -291,6 +292,15 @@ Breakpoint::SetCondition (const char *condition)
 {
     m_options.SetCondition (condition);
     SendBreakpointChangedEvent (eBreakpointEventTypeConditionChanged);
+    UpdateBreakpointSiteConditions ();
+}
+
+void
+Breakpoint::UpdateBreakpointSiteConditions ()
+{
+    const size_t num_locations = m_locations.GetSize();
+    for (size_t i = 0; i < num_locations; ++i)
+        m_locations.GetByIndex(i)->UpdateBreakpointSiteConditions ();
 }
 
 const char *
@@ -344,10 +354,14 @@ Breakpoint::ResolveBreakpoint ()
 }
 
 void
-Breakpoint::ResolveBreakpointInModules (ModuleList &module_list)
+Breakpoint::ResolveBreakpointInModules (ModuleList &module_list, BreakpointResolverBatch *batch)
 {
     if (m_resolver_sp)
+    {
+        m_resolver_sp->SetBatch(batch);
         m_resolver_sp->ResolveBreakpointInModules(*m_filter_sp, module_list);
+        m_resolver_sp->SetBatch(NULL);
+    }
 }
 
 void
@@ -361,7 +375,7 @@ Breakpoint::ClearAllBreakpointSites ()
 //----------------------------------------------------------------------
 
 void
-Breakpoint::ModulesChanged (ModuleList &module_list, bool load, bool delete_locations)
+Breakpoint::ModulesChanged (ModuleList &module_list, bool load, bool delete_locations, BreakpointResolverBatch *batch)
 {
     Mutex::Locker modules_mutex(module_list.GetMutex());
     if (load)
@@ -424,7 +438,7 @@ Breakpoint::ModulesChanged (ModuleList &module_list, bool load, bool delete_loca
                 
                 m_locations.StartRecordingNewLocations(new_locations_event->GetBreakpointLocationCollection());
                 
-                ResolveBreakpointInModules(new_modules);
+                ResolveBreakpointInModules(new_modules, batch);
 
                 m_locations.StopRecordingNewLocations();
                 if (new_locations_event->GetBreakpointLocationCollection().GetSize() != 0)
@@ -435,7 +449,7 @@ Breakpoint::ModulesChanged (ModuleList &module_list, bool load, bool delete_loca
                     delete new_locations_event;
             }
             else
-                ResolveBreakpointInModules(new_modules);
+                ResolveBreakpointInModules(new_modules, batch);
             
         }
     }
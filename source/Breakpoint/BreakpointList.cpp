@@ -13,6 +13,7 @@
 // C++ Includes
 // Other libraries and framework includes
 // Project includes
+#include "lldb/Breakpoint/BreakpointResolverBatch.h"
 #include "lldb/Target/Target.h"
 
 using namespace lldb;
@@ -213,8 +214,11 @@ void
 BreakpointList::UpdateBreakpoints (ModuleList& module_list, bool added, bool delete_locations)
 {
     Mutex::Locker locker(m_mutex);
+    // Resolve all the breakpoints against the new modules as one batch, so
+    // that they share the per-module lookups instead of each redoing them.
+    BreakpointResolverBatch batch;
     for (const auto &bp_sp : m_breakpoints)
-        bp_sp->ModulesChanged (module_list, added, delete_locations);
+        bp_sp->ModulesChanged (module_list, added, delete_locations, added ? &batch : NULL);
 
 }
 
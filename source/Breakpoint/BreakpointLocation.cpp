@@ -47,7 +47,10 @@ BreakpointLocation::BreakpointLocation
     m_owner (owner),
     m_options_ap (),
     m_bp_site_sp (),
-    m_condition_mutex ()
+    m_condition_mutex (),
+    m_condition_hash (0),
+    m_condition_bytecode (),
+    m_condition_bytecode_hash (0)
 {
     SetThreadID (tid);
     m_being_created = false;
@@ -238,6 +241,7 @@ BreakpointLocation::SetCondition (const char *condition)
 {
     GetLocationOptions()->SetCondition (condition);
     SendBreakpointLocationChangedEvent (eBreakpointEventTypeConditionChanged);
+    UpdateBreakpointSiteConditions ();
 }
 
 const char *
@@ -259,9 +263,14 @@ BreakpointLocation::ConditionSaysStop (ExecutionContext &exe_ctx, Error &error)
     if (!condition_text)
     {
         m_user_expression_sp.reset();
+        m_condition_bytecode.Clear();
         return false;
     }
     
+    bool bytecode_says_stop = false;
+    if (BytecodeConditionSaysStop (exe_ctx, condition_text, condition_hash, bytecode_says_stop))
+        return bytecode_says_stop;
+
     if (condition_hash != m_condition_hash ||
         !m_user_expression_sp ||
         !m_user_expression_sp->MatchesContext(exe_ctx))
@@ -357,6 +366,104 @@ BreakpointLocation::ConditionSaysStop (ExecutionContext &exe_ctx, Error &error)
     return ret;
 }
 
+bool
+BreakpointLocation::BytecodeConditionSaysStop (ExecutionContext &exe_ctx,
+                                               const char *condition_text,
+                                               size_t condition_hash,
+                                               bool &should_stop)
+{
+    if (!m_owner.GetTarget().GetUseFastBreakpointConditions())
+        return false;
+
+    Log *log = lldb_private::GetLogIfAllCategoriesSet (LIBLLDB_LOG_BREAKPOINTS);
+    Process *process = exe_ctx.GetProcessPtr();
+    if (process == NULL)
+        return false;
+
+    // The bytecode bakes in the load addresses of globals, so it needs
+    // to be recompiled for a new process as well as for a new condition.
+    if (condition_hash != m_condition_bytecode_hash ||
+        m_condition_bytecode.GetProcessUniqueID() != process->GetUniqueID())
+    {
+        m_condition_bytecode_hash = condition_hash;
+        Error compile_error;
+        if (m_condition_bytecode.Compile (condition_text, exe_ctx, compile_error))
+        {
+            if (log)
+            {
+                StreamString bytecode;
+                m_condition_bytecode.Dump (&bytecode);
+                log->Printf ("Compiled condition \"%s\" for breakpoint location %d.%d: %s",
+                             condition_text,
+                             m_owner.GetID(),
+                             GetID(),
+                             bytecode.GetData());
+            }
+            // The process may be able to evaluate the condition itself now.
+            UpdateBreakpointSiteConditions ();
+        }
+        else if (log)
+        {
+            log->Printf ("Condition \"%s\" for breakpoint location %d.%d needs the expression parser: %s",
+                         condition_text,
+                         m_owner.GetID(),
+                         GetID(),
+                         compile_error.AsCString());
+        }
+    }
+
+    if (!m_condition_bytecode.IsValid())
+        return false;
+
+    uint64_t result = 0;
+    Error evaluation_error;
+    if (!m_condition_bytecode.Evaluate (exe_ctx, result, evaluation_error))
+    {
+        if (log)
+            log->Printf ("Bytecode evaluation failed, falling back to the expression parser: %s",
+                         evaluation_error.AsCString());
+        return false;
+    }
+
+    should_stop = result != 0;
+    if (log)
+        log->Printf ("Condition successfully evaluated from bytecode, result is %s.\n",
+                     should_stop ? "true" : "false");
+    return true;
+}
+
+const AgentExpression *
+BreakpointLocation::GetConditionBytecode ()
+{
+    if (!m_condition_bytecode.IsValid() || !IsEnabled())
+        return NULL;
+
+    ProcessSP process_sp (m_owner.GetTarget().GetProcessSP());
+    if (!process_sp || m_condition_bytecode.GetProcessUniqueID() != process_sp->GetUniqueID())
+        return NULL;
+
+    size_t condition_hash;
+    const char *condition_text = GetConditionText (&condition_hash);
+    if (condition_text == NULL || condition_hash != m_condition_bytecode_hash)
+        return NULL;
+
+    // Every hit has to be seen here to count down an ignore count.
+    if (GetIgnoreCount() != 0 || m_owner.GetIgnoreCount() != 0)
+        return NULL;
+
+    return &m_condition_bytecode;
+}
+
+void
+BreakpointLocation::UpdateBreakpointSiteConditions ()
+{
+    if (!m_bp_site_sp)
+        return;
+    ProcessSP process_sp (m_owner.GetTarget().GetProcessSP());
+    if (process_sp)
+        process_sp->UpdateBreakpointSiteConditions (m_bp_site_sp.get());
+}
+
 uint32_t
 BreakpointLocation::GetIgnoreCount ()
 {
@@ -368,6 +475,7 @@ BreakpointLocation::SetIgnoreCount (uint32_t n)
 {
     GetLocationOptions()->SetIgnoreCount(n);
     SendBreakpointLocationChangedEvent (eBreakpointEventTypeIgnoreChanged);
+    UpdateBreakpointSiteConditions ();
 }
 
 void
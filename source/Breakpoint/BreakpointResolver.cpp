@@ -35,6 +35,7 @@ using namespace lldb;
 //----------------------------------------------------------------------
 BreakpointResolver::BreakpointResolver (Breakpoint *bkpt, const unsigned char resolverTy) :
     m_breakpoint (bkpt),
+    m_batch (NULL),
     SubclassID (resolverTy)
 {
 }
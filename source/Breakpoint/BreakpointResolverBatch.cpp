@@ -0,0 +1,180 @@
+//===-- BreakpointResolverBatch.cpp -----------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Breakpoint/BreakpointResolverBatch.h"
+
+// C Includes
+// C++ Includes
+#include <algorithm>
+
+// Other libraries and framework includes
+// Project includes
+#include "lldb/Core/FileSpecList.h"
+#include "lldb/Core/Log.h"
+#include "lldb/Core/Module.h"
+#include "lldb/Symbol/CompileUnit.h"
+
+using namespace lldb;
+using namespace lldb_private;
+
+bool
+BreakpointResolverBatch::FunctionLookup::operator < (const FunctionLookup &rhs) const
+{
+    if (m_module != rhs.m_module)
+        return m_module < rhs.m_module;
+    // Only identity matters here, so compare the uniqued string pointers.
+    if (m_name.GetCString() != rhs.m_name.GetCString())
+        return m_name.GetCString() < rhs.m_name.GetCString();
+    if (m_name_type_mask != rhs.m_name_type_mask)
+        return m_name_type_mask < rhs.m_name_type_mask;
+    if (m_include_symbols != rhs.m_include_symbols)
+        return m_include_symbols < rhs.m_include_symbols;
+    return m_include_inlines < rhs.m_include_inlines;
+}
+
+BreakpointResolverBatch::BreakpointResolverBatch () :
+    m_function_lookups (),
+    m_file_indexes (),
+    m_num_function_lookups (0),
+    m_num_cached_function_lookups (0)
+{
+}
+
+BreakpointResolverBatch::~BreakpointResolverBatch ()
+{
+    Log *log(lldb_private::GetLogIfAllCategoriesSet (LIBLLDB_LOG_BREAKPOINTS));
+    if (log && (m_num_function_lookups > 0 || !m_file_indexes.empty()))
+        log->Printf ("BreakpointResolverBatch: %u function lookups (%u shared), %" PRIu64 " modules' compile units indexed by file",
+                     m_num_function_lookups,
+                     m_num_cached_function_lookups,
+                     (uint64_t)m_file_indexes.size());
+}
+
+size_t
+BreakpointResolverBatch::FindFunctions (const ModuleSP &module_sp,
+                                        const ConstString &name,
+                                        uint32_t name_type_mask,
+                                        bool include_symbols,
+                                        bool include_inlines,
+                                        SymbolContextList &sc_list)
+{
+    if (!module_sp)
+        return 0;
+
+    FunctionLookup lookup;
+    lookup.m_module = module_sp.get();
+    lookup.m_name = name;
+    lookup.m_name_type_mask = name_type_mask;
+    lookup.m_include_symbols = include_symbols;
+    lookup.m_include_inlines = include_inlines;
+
+    ++m_num_function_lookups;
+
+    FunctionLookupMap::iterator pos = m_function_lookups.find (lookup);
+    if (pos == m_function_lookups.end())
+    {
+        pos = m_function_lookups.insert (std::make_pair (lookup, SymbolContextList())).first;
+        const bool append = true;
+        module_sp->FindFunctions (name,
+                                  NULL,
+                                  name_type_mask,
+                                  include_symbols,
+                                  include_inlines,
+                                  append,
+                                  pos->second);
+    }
+    else
+    {
+        ++m_num_cached_function_lookups;
+    }
+
+    // Merge the results the same way Module::FindFunctions does, since the
+    // caller may already have found some of these under another name type.
+    const bool merge_symbol_into_function = true;
+    return sc_list.AppendIfUnique (pos->second, merge_symbol_into_function);
+}
+
+BreakpointResolverBatch::ModuleFileIndex &
+BreakpointResolverBatch::GetModuleFileIndex (const ModuleSP &module_sp, bool check_inlines)
+{
+    std::pair<ModuleFileIndexMap::iterator, bool> result = m_file_indexes.insert (std::make_pair (module_sp.get(), ModuleFileIndex()));
+    ModuleFileIndex &file_index = result.first->second;
+
+    const bool index_cu_files = result.second;
+    const bool index_support_files = check_inlines && !file_index.m_indexed_support_files;
+    if (!index_cu_files && !index_support_files)
+        return file_index;
+
+    const size_t num_comp_units = module_sp->GetNumCompileUnits();
+    for (size_t cu_idx = 0; cu_idx < num_comp_units; cu_idx++)
+    {
+        CompUnitSP cu_sp (module_sp->GetCompileUnitAtIndex (cu_idx));
+        if (!cu_sp)
+            continue;
+
+        if (index_cu_files)
+            file_index.m_cu_files[cu_sp->GetFilename()].push_back (cu_idx);
+
+        if (index_support_files)
+        {
+            const FileSpecList &support_files = cu_sp->GetSupportFiles();
+            const size_t num_files = support_files.GetSize();
+            for (size_t file_idx = 0; file_idx < num_files; file_idx++)
+            {
+                std::vector<uint32_t> &cu_indexes = file_index.m_support_files[support_files.GetFileSpecAtIndex(file_idx).GetFilename()];
+                // A header is usually listed once per CU, but not always.
+                if (cu_indexes.empty() || cu_indexes.back() != cu_idx)
+                    cu_indexes.push_back (cu_idx);
+            }
+        }
+    }
+
+    if (index_support_files)
+        file_index.m_indexed_support_files = true;
+
+    return file_index;
+}
+
+void
+BreakpointResolverBatch::FindCompileUnitIndexes (const ModuleSP &module_sp,
+                                                 const FileSpec &file_spec,
+                                                 bool check_inlines,
+                                                 std::vector<uint32_t> &cu_indexes)
+{
+    cu_indexes.clear();
+    if (!module_sp)
+        return;
+
+    // Without a base name there is nothing to index on, so every compile
+    // unit is a candidate.
+    if (!file_spec.GetFilename())
+    {
+        const size_t num_comp_units = module_sp->GetNumCompileUnits();
+        for (size_t cu_idx = 0; cu_idx < num_comp_units; cu_idx++)
+            cu_indexes.push_back (cu_idx);
+        return;
+    }
+
+    ModuleFileIndex &file_index = GetModuleFileIndex (module_sp, check_inlines);
+
+    FileNameToCUIndexes::const_iterator pos = file_index.m_cu_files.find (file_spec.GetFilename());
+    if (pos != file_index.m_cu_files.end())
+        cu_indexes = pos->second;
+
+    if (check_inlines)
+    {
+        pos = file_index.m_support_files.find (file_spec.GetFilename());
+        if (pos != file_index.m_support_files.end())
+        {
+            cu_indexes.insert (cu_indexes.end(), pos->second.begin(), pos->second.end());
+            std::sort (cu_indexes.begin(), cu_indexes.end());
+            cu_indexes.erase (std::unique (cu_indexes.begin(), cu_indexes.end()), cu_indexes.end());
+        }
+    }
+}
@@ -14,6 +14,7 @@
 // Other libraries and framework includes
 // Project includes
 #include "lldb/Breakpoint/BreakpointLocation.h"
+#include "lldb/Breakpoint/BreakpointResolverBatch.h"
 #include "lldb/Core/Log.h"
 #include "lldb/Core/Module.h"
 #include "lldb/Core/StreamString.h"
@@ -72,10 +73,21 @@ BreakpointResolverFileLine::SearchCallback
     // So we go through the match list and pull out the sets that have the same file spec in their line_entry
     // and treat each set separately.
     
-    const size_t num_comp_units = context.module_sp->GetNumCompileUnits();
-    for (size_t i = 0; i < num_comp_units; i++)
+    // When resolving along with other breakpoints, only look in the compile units the batch
+    // says mention our file, rather than asking each one in turn.
+    std::vector<uint32_t> cu_indexes;
+    if (m_batch)
+        m_batch->FindCompileUnitIndexes (context.module_sp, m_file_spec, m_inlines, cu_indexes);
+    else
     {
-        CompUnitSP cu_sp (context.module_sp->GetCompileUnitAtIndex (i));
+        const size_t num_comp_units = context.module_sp->GetNumCompileUnits();
+        for (size_t i = 0; i < num_comp_units; i++)
+            cu_indexes.push_back (i);
+    }
+
+    for (std::vector<uint32_t>::const_iterator pos = cu_indexes.begin(), end = cu_indexes.end(); pos != end; ++pos)
+    {
+        CompUnitSP cu_sp (context.module_sp->GetCompileUnitAtIndex (*pos));
         if (cu_sp)
         {
             if (filter.CompUnitPasses(*cu_sp))
@@ -11,12 +11,17 @@
 
 // C Includes
 // C++ Includes
+#include <algorithm>
+#include <atomic>
+#include <map>
+
 // Other libraries and framework includes
 // Project includes
 #include "lldb/Breakpoint/BreakpointLocation.h"
 #include "lldb/Core/SourceManager.h"
 #include "lldb/Core/Log.h"
 #include "lldb/Core/StreamString.h"
+#include "lldb/Host/Host.h"
 #include "lldb/Symbol/CompileUnit.h"
 #include "lldb/Target/Target.h"
 #include "lldb/lldb-private-log.h"
@@ -41,6 +46,43 @@ BreakpointResolverFileRegex::~BreakpointResolverFileRegex ()
 {
 }
 
+//----------------------------------------------------------------------
+// A source file to search, and the lines in it that matched.  Each one
+// is only touched by the thread that claimed it.
+//----------------------------------------------------------------------
+struct SourceFileScan
+{
+    SourceManager::FileSP file_sp;
+    std::vector<uint32_t> line_matches;
+};
+
+struct SourceFileScanJob
+{
+    SourceFileScanJob (const RegularExpression &regex, std::vector<SourceFileScan> &scans) :
+        m_regex (regex),
+        m_scans (scans),
+        m_next_scan (0)
+    {
+    }
+
+    const RegularExpression &m_regex;
+    std::vector<SourceFileScan> &m_scans;
+    std::atomic<size_t> m_next_scan;
+};
+
+static lldb::thread_result_t
+ScanSourceFilesThread (lldb::thread_arg_t arg)
+{
+    SourceFileScanJob *job = (SourceFileScanJob *)arg;
+    const size_t num_scans = job->m_scans.size();
+    for (size_t idx = job->m_next_scan++; idx < num_scans; idx = job->m_next_scan++)
+    {
+        SourceFileScan &scan = job->m_scans[idx];
+        scan.file_sp->FindLinesMatchingRegex (job->m_regex, 1, UINT32_MAX, scan.line_matches);
+    }
+    return NULL;
+}
+
 Searcher::CallbackReturn
 BreakpointResolverFileRegex::SearchCallback
 (
@@ -52,29 +94,111 @@ BreakpointResolverFileRegex::SearchCallback
 {
 
     assert (m_breakpoint != NULL);
-    if (!context.target_sp)
+    if (!context.target_sp || !context.comp_unit)
         return eCallbackReturnContinue;
 
-    CompileUnit *cu = context.comp_unit;
-    FileSpec cu_file_spec = *(static_cast<FileSpec *>(cu));
-    std::vector<uint32_t> line_matches;
-    context.target_sp->GetSourceManager().FindLinesMatchingRegex(cu_file_spec, m_regex, 1, UINT32_MAX, line_matches);
-    
-    uint32_t num_matches = line_matches.size();
-    for (uint32_t i = 0; i < num_matches; i++)
+    m_comp_units.Append (context);
+
+    return Searcher::eCallbackReturnContinue;
+}
+
+void
+BreakpointResolverFileRegex::ResolveBreakpoint (SearchFilter &filter)
+{
+    m_comp_units.Clear();
+    BreakpointResolver::ResolveBreakpoint (filter);
+    ResolveCollectedCompUnits (filter);
+}
+
+void
+BreakpointResolverFileRegex::ResolveBreakpointInModules (SearchFilter &filter, ModuleList &modules)
+{
+    m_comp_units.Clear();
+    BreakpointResolver::ResolveBreakpointInModules (filter, modules);
+    ResolveCollectedCompUnits (filter);
+}
+
+void
+BreakpointResolverFileRegex::ResolveCollectedCompUnits (SearchFilter &filter)
+{
+    assert (m_breakpoint != NULL);
+    Log *log(lldb_private::GetLogIfAllCategoriesSet (LIBLLDB_LOG_BREAKPOINTS));
+
+    // Look up the source files here, since the source manager and its cache
+    // aren't thread safe.  Reading the contents is left to the scan.
+    // Several compile units can share a source file, search it only once.
+    // Different file specs can also give back the same File (a bare file
+    // name, or a remapped and an original path), and two threads must
+    // never read the same File, so go by the File itself.
+    const size_t num_comp_units = m_comp_units.GetSize();
+    std::vector<SourceFileScan> scans;
+    std::vector<size_t> cu_scan_indexes;
+    std::map<SourceManager::File *, size_t> file_scan_indexes;
+    SymbolContext sc;
+    for (size_t i = 0; i < num_comp_units; i++)
     {
-        SymbolContextList sc_list;
-        const bool search_inlines = false;
-        const bool exact = false;
-        
-        cu->ResolveSymbolContext (cu_file_spec, line_matches[i], search_inlines, exact, eSymbolContextEverything, sc_list);
-        const bool skip_prologue = true;
-        
-        BreakpointResolver::SetSCMatchesByLine (filter, sc_list, skip_prologue, m_regex.GetText());
+        m_comp_units.GetContextAtIndex (i, sc);
+        FileSpec cu_file_spec = *(static_cast<FileSpec *>(sc.comp_unit));
+        SourceManager::FileSP file_sp (sc.target_sp->GetSourceManager().GetFile (cu_file_spec));
+        std::pair<std::map<SourceManager::File *, size_t>::iterator, bool> result = file_scan_indexes.insert (std::make_pair (file_sp.get(), scans.size()));
+        if (result.second)
+        {
+            scans.push_back (SourceFileScan());
+            scans.back().file_sp = file_sp;
+        }
+        cu_scan_indexes.push_back (result.first->second);
     }
-    assert (m_breakpoint != NULL);        
 
-    return Searcher::eCallbackReturnContinue;
+    // Searching a file is independent of all the others, so spread them
+    // over as many threads as there are cores (including this one).
+    const size_t num_threads = std::min<size_t> (Host::GetNumberCPUS(), scans.size());
+    SourceFileScanJob job (m_regex, scans);
+    std::vector<lldb::thread_t> threads;
+    for (size_t i = 1; i < num_threads; i++)
+    {
+        lldb::thread_t thread = Host::ThreadCreate ("<lldb.breakpoint.source-regex>", ScanSourceFilesThread, &job, NULL);
+        if (IS_VALID_LLDB_HOST_THREAD(thread))
+            threads.push_back (thread);
+    }
+    ScanSourceFilesThread (&job);
+    for (size_t i = 0; i < threads.size(); i++)
+        Host::ThreadJoin (threads[i], NULL, NULL);
+
+    if (log)
+    {
+        uint64_t num_bytes = 0;
+        for (size_t i = 0; i < scans.size(); i++)
+            num_bytes += scans[i].file_sp->GetByteSize();
+        log->Printf ("BreakpointResolverFileRegex: searched %" PRIu64 " source files (%" PRIu64 " bytes) for \"%s\" on %" PRIu64 " threads",
+                     (uint64_t)scans.size(),
+                     num_bytes,
+                     m_regex.GetText(),
+                     (uint64_t)threads.size() + 1);
+    }
+
+    // Adding locations has to be done in order, on this thread.
+    for (size_t i = 0; i < num_comp_units; i++)
+    {
+        m_comp_units.GetContextAtIndex (i, sc);
+        CompileUnit *cu = sc.comp_unit;
+        FileSpec cu_file_spec = *(static_cast<FileSpec *>(cu));
+        const std::vector<uint32_t> &line_matches = scans[cu_scan_indexes[i]].line_matches;
+
+        uint32_t num_matches = line_matches.size();
+        for (uint32_t j = 0; j < num_matches; j++)
+        {
+            SymbolContextList sc_list;
+            const bool search_inlines = false;
+            const bool exact = false;
+            
+            cu->ResolveSymbolContext (cu_file_spec, line_matches[j], search_inlines, exact, eSymbolContextEverything, sc_list);
+            const bool skip_prologue = true;
+            
+            BreakpointResolver::SetSCMatchesByLine (filter, sc_list, skip_prologue, m_regex.GetText());
+        }
+    }
+
+    m_comp_units.Clear();
 }
 
 Searcher::Depth
@@ -14,6 +14,7 @@
 // Other libraries and framework includes
 // Project includes
 #include "lldb/Breakpoint/BreakpointLocation.h"
+#include "lldb/Breakpoint/BreakpointResolverBatch.h"
 #include "lldb/Core/Log.h"
 #include "lldb/Core/Module.h"
 #include "lldb/Core/StreamString.h"
@@ -216,13 +217,21 @@ BreakpointResolverName::SearchCallback
                 for (const LookupInfo &lookup : m_lookups)
                 {
                     const size_t start_func_idx = func_list.GetSize();
-                    context.module_sp->FindFunctions (lookup.lookup_name,
-                                                      NULL,
-                                                      lookup.name_type_mask,
-                                                      include_symbols,
-                                                      include_inlines,
-                                                      append,
-                                                      func_list);
+                    if (m_batch)
+                        m_batch->FindFunctions (context.module_sp,
+                                                lookup.lookup_name,
+                                                lookup.name_type_mask,
+                                                include_symbols,
+                                                include_inlines,
+                                                func_list);
+                    else
+                        context.module_sp->FindFunctions (lookup.lookup_name,
+                                                          NULL,
+                                                          lookup.name_type_mask,
+                                                          include_symbols,
+                                                          include_inlines,
+                                                          append,
+                                                          func_list);
                     const size_t end_func_idx = func_list.GetSize();
 
                     if (start_func_idx < end_func_idx)
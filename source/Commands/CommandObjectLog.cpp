@@ -147,6 +147,8 @@ public:
             case 'p':  log_options |= LLDB_LOG_OPTION_PREPEND_PROC_AND_THREAD;break;
             case 'n':  log_options |= LLDB_LOG_OPTION_PREPEND_THREAD_NAME;    break;
             case 'S':  log_options |= LLDB_LOG_OPTION_BACKTRACE;              break;
+            case 'a':  log_options |= LLDB_LOG_OPTION_ASYNC;                  break;
+            case 'r':  log_options |= LLDB_LOG_OPTION_FLIGHT_RECORDER;        break;
             default:
                 error.SetErrorStringWithFormat ("unrecognized option '%c'", short_option);
                 break;
@@ -224,6 +226,8 @@ CommandObjectLogEnable::CommandOptions::g_option_table[] =
 { LLDB_OPT_SET_1, false, "pid-tid",    'p', OptionParser::eNoArgument,       NULL, 0, eArgTypeNone,       "Prepend all log lines with the process and thread ID that generates the log line." },
 { LLDB_OPT_SET_1, false, "thread-name",'n', OptionParser::eNoArgument,       NULL, 0, eArgTypeNone,       "Prepend all log lines with the thread name for the thread that generates the log line." },
 { LLDB_OPT_SET_1, false, "stack",      'S', OptionParser::eNoArgument,       NULL, 0, eArgTypeNone,       "Append a stack backtrace to each log line." },
+{ LLDB_OPT_SET_1, false, "async",      'a', OptionParser::eNoArgument,       NULL, 0, eArgTypeNone,       "Write log lines from a background thread instead of the thread that logs them." },
+{ LLDB_OPT_SET_1, false, "flight-recorder", 'r', OptionParser::eNoArgument,  NULL, 0, eArgTypeNone,       "Keep the most recent log lines in memory, and only write them out on \"log dump\" or a fatal error." },
 { 0, false, NULL,                       0,  0,                 NULL, 0, eArgTypeNone,       NULL }
 };
 
@@ -302,6 +306,8 @@ protected:
                 else
                     result.AppendErrorWithFormat("Invalid log channel '%s'.\n", args.GetArgumentAtIndex(0));
             }
+            // Don't let lines logged before this reach the stream later.
+            Log::FlushAsyncLogs();
         }
         return result.Succeeded();
     }
@@ -476,6 +482,43 @@ protected:
     }
 };
 
+class CommandObjectLogDump : public CommandObjectParsed
+{
+public:
+    //------------------------------------------------------------------
+    // Constructors and Destructors
+    //------------------------------------------------------------------
+    CommandObjectLogDump(CommandInterpreter &interpreter) :
+        CommandObjectParsed (interpreter,
+                             "log dump",
+                             "Write out the log lines kept in memory by logs enabled with --flight-recorder.",
+                             "log dump")
+    {
+    }
+
+    virtual
+    ~CommandObjectLogDump()
+    {
+    }
+
+protected:
+    virtual bool
+    DoExecute (Args& args,
+             CommandReturnObject &result)
+    {
+        if (args.GetArgumentCount() != 0)
+        {
+            result.AppendErrorWithFormat("Usage: %s\n", m_cmd_syntax.c_str());
+            result.SetStatus(eReturnStatusFailed);
+            return false;
+        }
+        const size_t num_lines = Log::DumpFlightRecorder ();
+        result.AppendMessageWithFormat ("%" PRIu64 " log lines written.\n", (uint64_t)num_lines);
+        result.SetStatus(eReturnStatusSuccessFinishResult);
+        return true;
+    }
+};
+
 //----------------------------------------------------------------------
 // CommandObjectLog constructor
 //----------------------------------------------------------------------
@@ -489,6 +532,7 @@ CommandObjectLog::CommandObjectLog(CommandInterpreter &interpreter) :
     LoadSubCommand ("disable", CommandObjectSP (new CommandObjectLogDisable (interpreter)));
     LoadSubCommand ("list",    CommandObjectSP (new CommandObjectLogList (interpreter)));
     LoadSubCommand ("timers",  CommandObjectSP (new CommandObjectLogTimer (interpreter)));
+    LoadSubCommand ("dump",    CommandObjectSP (new CommandObjectLogDump (interpreter)));
 }
 
 //----------------------------------------------------------------------
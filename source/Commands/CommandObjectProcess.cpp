@@ -1483,6 +1483,143 @@ protected:
     }
 };
 
+//-------------------------------------------------------------------------
+// CommandObjectProcessSaveCore
+//-------------------------------------------------------------------------
+#pragma mark CommandObjectProcessSaveCore
+
+class CommandObjectProcessSaveCore : public CommandObjectParsed
+{
+public:
+    class CommandOptions : public Options
+    {
+    public:
+
+        CommandOptions (CommandInterpreter &interpreter) :
+            Options (interpreter)
+        {
+            OptionParsingStarting ();
+        }
+
+        ~CommandOptions ()
+        {
+        }
+
+        Error
+        SetOptionValue (uint32_t option_idx, const char *option_arg)
+        {
+            Error error;
+            const int short_option = m_getopt_table[option_idx].val;
+
+            switch (short_option)
+            {
+                case 'r':
+                    m_core_options.SetSkipReadOnlyFiles(true);
+                    break;
+                case 's':
+                    m_core_options.SetStacksOnly(true);
+                    break;
+                case 'i':
+                    {
+                        ExecutionContext exe_ctx (m_interpreter.GetExecutionContext());
+                        lldb::addr_t addr = Args::StringToAddress(&exe_ctx, option_arg, LLDB_INVALID_ADDRESS, &error);
+                        if (addr != LLDB_INVALID_ADDRESS)
+                            m_core_options.AppendIncludeAddress(addr);
+                    }
+                    break;
+                default:
+                    error.SetErrorStringWithFormat("invalid short option character '%c'", short_option);
+                    break;
+            }
+            return error;
+        }
+
+        void
+        OptionParsingStarting ()
+        {
+            m_core_options.Clear();
+        }
+
+        const OptionDefinition*
+        GetDefinitions ()
+        {
+            return g_option_table;
+        }
+
+        // Options table: Required for subclasses of Options.
+
+        static OptionDefinition g_option_table[];
+
+        // Instance variables to hold the values for command options.
+        SaveCoreOptions m_core_options;
+    };
+
+    CommandObjectProcessSaveCore (CommandInterpreter &interpreter) :
+        CommandObjectParsed (interpreter,
+                             "process save-core",
+                             "Save the current process as a core file.",
+                             "process save-core [--skip-read-only-files] [--stacks-only [--include-memory <address>]] <filename>",
+                             eFlagRequiresProcess       |
+                             eFlagTryTargetAPILock      |
+                             eFlagProcessMustBeLaunched |
+                             eFlagProcessMustBePaused   ),
+        m_options(interpreter)
+    {
+    }
+
+    ~CommandObjectProcessSaveCore ()
+    {
+    }
+
+    Options *
+    GetOptions ()
+    {
+        return &m_options;
+    }
+
+protected:
+    bool
+    DoExecute (Args& command,
+               CommandReturnObject &result)
+    {
+        Process *process = m_exe_ctx.GetProcessPtr();
+
+        if (command.GetArgumentCount() != 1)
+        {
+            result.AppendErrorWithFormat("'%s' takes one argument:\nUsage: %s\n",
+                                         m_cmd_name.c_str(),
+                                         m_cmd_syntax.c_str());
+            result.SetStatus (eReturnStatusFailed);
+            return false;
+        }
+
+        FileSpec output_file (command.GetArgumentAtIndex(0), true);
+        Error error (process->SaveCore (output_file, m_options.m_core_options));
+        if (error.Success())
+        {
+            result.AppendMessageWithFormat ("Saved core file to %s\n", output_file.GetPath().c_str());
+            result.SetStatus (eReturnStatusSuccessFinishResult);
+        }
+        else
+        {
+            result.AppendErrorWithFormat ("Failed to save core file: %s\n", error.AsCString());
+            result.SetStatus (eReturnStatusFailed);
+        }
+        return result.Succeeded();
+    }
+
+    CommandOptions m_options;
+};
+
+OptionDefinition
+CommandObjectProcessSaveCore::CommandOptions::g_option_table[] =
+{
+{ LLDB_OPT_SET_1 | LLDB_OPT_SET_2, false, "skip-read-only-files", 'r', OptionParser::eNoArgument, NULL, 0, eArgTypeNone, "Leave out memory that is mapped read only from files, like the code of shared libraries, to make the core smaller and quicker to write." },
+{ LLDB_OPT_SET_2, true,  "stacks-only", 's', OptionParser::eNoArgument, NULL, 0, eArgTypeNone, "Only save the registers and the used part of the stack of each thread, and the list of loaded modules, so the threads can be backtraced and symbolicated later." },
+{ LLDB_OPT_SET_2, false, "include-memory", 'i', OptionParser::eRequiredArgument, NULL, 0, eArgTypeAddressOrExpression, "Also save the whole memory mapping that contains this address, like the heap, in a stacks only core.  Can be specified more than once." },
+{ 0, false, NULL, 0, 0, NULL, 0, eArgTypeNone, NULL }
+};
+
 //-------------------------------------------------------------------------
 // CommandObjectProcessStatus
 //-------------------------------------------------------------------------
@@ -1853,6 +1990,7 @@ CommandObjectMultiwordProcess::CommandObjectMultiwordProcess (CommandInterpreter
     LoadSubCommand ("status",      CommandObjectSP (new CommandObjectProcessStatus    (interpreter)));
     LoadSubCommand ("interrupt",   CommandObjectSP (new CommandObjectProcessInterrupt (interpreter)));
     LoadSubCommand ("kill",        CommandObjectSP (new CommandObjectProcessKill      (interpreter)));
+    LoadSubCommand ("save-core",   CommandObjectSP (new CommandObjectProcessSaveCore  (interpreter)));
     LoadSubCommand ("plugin",      CommandObjectSP (new CommandObjectProcessPlugin    (interpreter)));
 }
 
@@ -0,0 +1,341 @@
+//===-- AsyncLogWriter.cpp --------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Core/AsyncLogWriter.h"
+
+// C Includes
+#include <unistd.h>
+
+// C++ Includes
+#include <algorithm>
+#include <set>
+
+// Other libraries and framework includes
+// Project includes
+#include "lldb/Core/Stream.h"
+#include "lldb/Host/Host.h"
+#include "lldb/Host/TimeValue.h"
+
+using namespace lldb;
+using namespace lldb_private;
+
+// The number of lines the flight recorder remembers, across all logs.
+static const size_t g_max_flight_records = 16 * 1024;
+
+// How long the writer sleeps when nobody wakes it up.
+static const uint64_t g_writer_poll_usec = 50 * 1000;
+
+// How long a cached thread name is used before asking the OS again.
+static const uint64_t g_thread_name_max_age_usec = 1000 * 1000;
+
+//----------------------------------------------------------------------
+// Everything the log machinery keeps for a thread.  It is created the
+// first time a thread logs, and deleted when the thread exits.  The
+// ring is handed over to the writer instead, since it may still hold
+// records that haven't been written.
+//----------------------------------------------------------------------
+struct AsyncLogWriter::ThreadState
+{
+    ThreadState () :
+        m_ring (NULL),
+        m_name (),
+        m_name_time ()
+    {
+    }
+
+    ThreadRing *m_ring;
+    std::string m_name;
+    TimeValue m_name_time;
+};
+
+static lldb::thread_key_t g_thread_state_key;
+
+AsyncLogWriter::ThreadRing::ThreadRing () :
+    m_abandoned (false),
+    m_records (g_capacity),
+    m_head (0),
+    m_tail (0)
+{
+}
+
+bool
+AsyncLogWriter::ThreadRing::Push (Record &record)
+{
+    const size_t head = m_head.load (std::memory_order_relaxed);
+    const size_t tail = m_tail.load (std::memory_order_acquire);
+    if (head - tail >= g_capacity)
+        return false;
+    Record &slot = m_records[head & (g_capacity - 1)];
+    slot.m_sequence = record.m_sequence;
+    slot.m_stream_sp = record.m_stream_sp;
+    slot.m_text.swap (record.m_text);
+    slot.m_flight_recorder = record.m_flight_recorder;
+    m_head.store (head + 1, std::memory_order_release);
+    return true;
+}
+
+size_t
+AsyncLogWriter::ThreadRing::Pop (std::vector<Record> &records)
+{
+    const size_t tail = m_tail.load (std::memory_order_relaxed);
+    const size_t head = m_head.load (std::memory_order_acquire);
+    for (size_t i = tail; i != head; ++i)
+    {
+        Record &slot = m_records[i & (g_capacity - 1)];
+        records.push_back (Record());
+        Record &record = records.back();
+        record.m_sequence = slot.m_sequence;
+        record.m_stream_sp.swap (slot.m_stream_sp);
+        record.m_text.swap (slot.m_text);
+        record.m_flight_recorder = slot.m_flight_recorder;
+    }
+    m_tail.store (head, std::memory_order_release);
+    return head - tail;
+}
+
+AsyncLogWriter &
+AsyncLogWriter::GetSharedInstance ()
+{
+    // Never destroyed, threads may still be logging while the process
+    // runs its static destructors.
+    static AsyncLogWriter *g_writer = new AsyncLogWriter();
+    return *g_writer;
+}
+
+AsyncLogWriter::AsyncLogWriter () :
+    m_mutex (Mutex::eMutexTypeNormal),
+    m_condition (),
+    m_rings (),
+    m_flight_records (),
+    m_next_sequence (0),
+    m_writer_thread (LLDB_INVALID_HOST_THREAD),
+    m_writer_running (false),
+    m_stop_writer (false)
+{
+    g_thread_state_key = Host::ThreadLocalStorageCreate (ThreadStateCleanup);
+}
+
+AsyncLogWriter::~AsyncLogWriter ()
+{
+    Terminate ();
+}
+
+AsyncLogWriter::ThreadState *
+AsyncLogWriter::GetCurrentThreadState ()
+{
+    GetSharedInstance();
+    ThreadState *state = (ThreadState *)Host::ThreadLocalStorageGet (g_thread_state_key);
+    if (state == NULL)
+    {
+        state = new ThreadState();
+        Host::ThreadLocalStorageSet (g_thread_state_key, state);
+    }
+    return state;
+}
+
+void
+AsyncLogWriter::ThreadStateCleanup (void *p)
+{
+    ThreadState *state = (ThreadState *)p;
+    // The writer deletes the ring once it is empty.
+    if (state->m_ring)
+        state->m_ring->m_abandoned.store (true, std::memory_order_release);
+    delete state;
+}
+
+const char *
+AsyncLogWriter::GetCurrentThreadName ()
+{
+    ThreadState *state = GetCurrentThreadState ();
+    TimeValue now (TimeValue::Now());
+    if (!state->m_name_time.IsValid() ||
+        now.GetAsMicroSecondsSinceJan1_1970() - state->m_name_time.GetAsMicroSecondsSinceJan1_1970() > g_thread_name_max_age_usec)
+    {
+        state->m_name = Host::GetThreadName (Host::GetCurrentProcessID(), Host::GetCurrentThreadID());
+        state->m_name_time = now;
+    }
+    return state->m_name.c_str();
+}
+
+void
+AsyncLogWriter::Enqueue (const StreamSP &stream_sp, std::string &text, bool flight_recorder)
+{
+    ThreadState *state = GetCurrentThreadState ();
+    if (state->m_ring == NULL)
+    {
+        ThreadRing *ring = new ThreadRing();
+        Mutex::Locker locker (m_mutex);
+        m_rings.push_back (ring);
+        state->m_ring = ring;
+    }
+
+    StartWriterThreadIfNeeded ();
+
+    Record record;
+    record.m_sequence = m_next_sequence++;
+    record.m_stream_sp = stream_sp;
+    record.m_text.swap (text);
+    record.m_flight_recorder = flight_recorder;
+
+    ThreadRing *ring = state->m_ring;
+    while (!ring->Push (record))
+    {
+        // Lines are never dropped, wait for the writer to catch up.
+        m_condition.Signal();
+        ::usleep (1000);
+    }
+
+    if (ring->GetSize() >= ThreadRing::g_capacity / 2)
+        m_condition.Signal();
+}
+
+void
+AsyncLogWriter::StartWriterThreadIfNeeded ()
+{
+    if (m_writer_running.load (std::memory_order_acquire))
+        return;
+    Mutex::Locker locker (m_mutex);
+    if (!IS_VALID_LLDB_HOST_THREAD(m_writer_thread) && !m_stop_writer)
+    {
+        m_writer_thread = Host::ThreadCreate ("<lldb.log.writer>", WriterThread, this, NULL);
+        m_writer_running.store (IS_VALID_LLDB_HOST_THREAD(m_writer_thread), std::memory_order_release);
+    }
+}
+
+lldb::thread_result_t
+AsyncLogWriter::WriterThread (lldb::thread_arg_t arg)
+{
+    AsyncLogWriter *writer = (AsyncLogWriter *)arg;
+    Mutex::Locker locker (writer->m_mutex);
+    while (!writer->m_stop_writer)
+    {
+        TimeValue timeout (TimeValue::Now());
+        timeout.OffsetWithMicroSeconds (g_writer_poll_usec);
+        writer->m_condition.Wait (writer->m_mutex, &timeout, NULL);
+        writer->DrainRings ();
+    }
+    return NULL;
+}
+
+void
+AsyncLogWriter::DrainRings ()
+{
+    std::vector<Record> records;
+    for (size_t i = 0; i < m_rings.size(); )
+    {
+        ThreadRing *ring = m_rings[i];
+        // Check this before popping, a thread can't push anything after
+        // it has exited.
+        const bool abandoned = ring->m_abandoned.load (std::memory_order_acquire);
+        ring->Pop (records);
+        if (abandoned)
+        {
+            delete ring;
+            m_rings.erase (m_rings.begin() + i);
+        }
+        else
+            ++i;
+    }
+
+    if (records.empty())
+        return;
+
+    // Each ring is in order, but lines from different threads have to
+    // be interleaved again.
+    struct RecordLessThan
+    {
+        bool operator() (const Record &lhs, const Record &rhs) const
+        {
+            return lhs.m_sequence < rhs.m_sequence;
+        }
+    };
+    std::sort (records.begin(), records.end(), RecordLessThan());
+
+    std::set<Stream *> written_streams;
+    for (size_t i = 0; i < records.size(); ++i)
+    {
+        Record &record = records[i];
+        if (record.m_flight_recorder)
+        {
+            m_flight_records.push_back (Record());
+            m_flight_records.back().m_sequence = record.m_sequence;
+            m_flight_records.back().m_stream_sp.swap (record.m_stream_sp);
+            m_flight_records.back().m_text.swap (record.m_text);
+            if (m_flight_records.size() > g_max_flight_records)
+                m_flight_records.pop_front();
+        }
+        else if (record.m_stream_sp)
+        {
+            record.m_stream_sp->Write (record.m_text.data(), record.m_text.size());
+            written_streams.insert (record.m_stream_sp.get());
+        }
+    }
+
+    // Flushing can't release the last reference to a stream, the records
+    // still hold them.
+    for (std::set<Stream *>::iterator pos = written_streams.begin(); pos != written_streams.end(); ++pos)
+        (*pos)->Flush();
+}
+
+void
+AsyncLogWriter::Flush ()
+{
+    Mutex::Locker locker (m_mutex);
+    DrainRings ();
+}
+
+size_t
+AsyncLogWriter::DumpFlightRecorder (bool wait)
+{
+    Mutex::Locker locker;
+    if (wait)
+        locker.Lock (m_mutex);
+    else if (!locker.TryLock (m_mutex))
+        return 0;
+
+    DrainRings ();
+
+    std::deque<Record> records;
+    records.swap (m_flight_records);
+    std::set<Stream *> written_streams;
+    for (std::deque<Record>::iterator pos = records.begin(); pos != records.end(); ++pos)
+    {
+        if (pos->m_stream_sp)
+        {
+            pos->m_stream_sp->Write (pos->m_text.data(), pos->m_text.size());
+            written_streams.insert (pos->m_stream_sp.get());
+        }
+    }
+    for (std::set<Stream *>::iterator pos = written_streams.begin(); pos != written_streams.end(); ++pos)
+        (*pos)->Flush();
+    return records.size();
+}
+
+void
+AsyncLogWriter::Terminate ()
+{
+    lldb::thread_t writer_thread = LLDB_INVALID_HOST_THREAD;
+    {
+        Mutex::Locker locker (m_mutex);
+        m_stop_writer = true;
+        writer_thread = m_writer_thread;
+    }
+    if (IS_VALID_LLDB_HOST_THREAD(writer_thread))
+    {
+        m_condition.Signal();
+        Host::ThreadJoin (writer_thread, NULL, NULL);
+    }
+
+    Mutex::Locker locker (m_mutex);
+    DrainRings ();
+    m_writer_thread = LLDB_INVALID_HOST_THREAD;
+    m_writer_running.store (false, std::memory_order_release);
+    // The next asynchronous log line starts a new writer.
+    m_stop_writer = false;
+}
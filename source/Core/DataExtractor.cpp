@@ -1161,6 +1161,39 @@ DataExtractor::PeekCStr (offset_t offset) const
     return (const char *)PeekData (offset, 1);
 }
 
+//----------------------------------------------------------------------
+// Decode a LEB128 number of up to 8 bytes without a loop, by loading
+// the bytes as one little endian word. The caller has to make sure 8
+// bytes can be read from "src", and that the host is little endian.
+//
+// Returns the number of bytes in the number, or zero if it is longer
+// than 8 bytes.
+//----------------------------------------------------------------------
+static inline uint32_t
+DecodeLEB128Word (const uint8_t *src, uint64_t &value)
+{
+    uint64_t word;
+    memcpy (&word, src, sizeof(word));
+    // The last byte of the number is the first one with its high bit clear.
+    const uint64_t stop_bits = ~word & 0x8080808080808080ull;
+    if (stop_bits == 0)
+        return 0;
+    const uint32_t length = (llvm::countTrailingZeros (stop_bits) + 1) / 8;
+    if (length < 8)
+        word &= (1ull << (length * 8)) - 1;
+    // Squeeze the 7 bit groups together.
+    word &= 0x7f7f7f7f7f7f7f7full;
+    value = ((word & 0x000000000000007full)     ) |
+            ((word & 0x0000000000007f00ull) >> 1) |
+            ((word & 0x00000000007f0000ull) >> 2) |
+            ((word & 0x000000007f000000ull) >> 3) |
+            ((word & 0x0000007f00000000ull) >> 4) |
+            ((word & 0x00007f0000000000ull) >> 5) |
+            ((word & 0x007f000000000000ull) >> 6) |
+            ((word & 0x7f00000000000000ull) >> 7);
+    return length;
+}
+
 //----------------------------------------------------------------------
 // Extracts an unsigned LEB128 number from this object's data
 // starting at the offset pointed to by "offset_ptr". The offset
@@ -1180,20 +1213,37 @@ DataExtractor::GetULEB128 (offset_t *offset_ptr) const
     
     if (src < end)
     {
-        uint64_t result = *src++;
-        if (result >= 0x80)
+        // Most numbers (attribute forms, abbreviation codes, small
+        // operands) fit in a single byte.
+        uint64_t result = *src;
+        if (result < 0x80)
         {
-            result &= 0x7f;
-            int shift = 7;
-            while (src < end)
+            *offset_ptr += 1;
+            return result;
+        }
+
+        if (end - src >= 8 && lldb::endian::InlHostByteOrder() == eByteOrderLittle)
+        {
+            const uint32_t length = DecodeLEB128Word (src, result);
+            if (length)
             {
-                uint8_t byte = *src++;
-                result |= (byte & 0x7f) << shift;
-                if ((byte & 0x80) == 0)
-                    break;
-                shift += 7;
+                *offset_ptr += length;
+                return result;
             }
         }
+
+        ++src;
+        result &= 0x7f;
+        int shift = 7;
+        while (src < end)
+        {
+            uint8_t byte = *src++;
+            if (shift < 64)
+                result |= (uint64_t)(byte & 0x7f) << shift;
+            if ((byte & 0x80) == 0)
+                break;
+            shift += 7;
+        }
         *offset_ptr = src - m_start;
         return result;
     }
@@ -1220,29 +1270,47 @@ DataExtractor::GetSLEB128 (offset_t *offset_ptr) const
     
     if (src < end)
     {
-        int64_t result = 0;
-        int shift = 0;
-        int size = sizeof (int64_t) * 8;
-
-        uint8_t byte = 0;
-        int bytecount = 0;
-
-        while (src < end)
+        const int size = sizeof (int64_t) * 8;
+        uint64_t value;
+        int shift;
+        if (*src < 0x80)
         {
-            bytecount++;
-            byte = *src++;
-            result |= (byte & 0x7f) << shift;
-            shift += 7;
-            if ((byte & 0x80) == 0)
-                break;
+            value = *src;
+            shift = 7;
+            *offset_ptr += 1;
+        }
+        else if (end - src >= 8 &&
+                 lldb::endian::InlHostByteOrder() == eByteOrderLittle &&
+                 (shift = DecodeLEB128Word (src, value)) != 0)
+        {
+            *offset_ptr += shift;
+            shift *= 7;
+        }
+        else
+        {
+            value = 0;
+            shift = 0;
+            uint8_t byte = 0;
+            int bytecount = 0;
+
+            while (src < end)
+            {
+                bytecount++;
+                byte = *src++;
+                if (shift < size)
+                    value |= (uint64_t)(byte & 0x7f) << shift;
+                shift += 7;
+                if ((byte & 0x80) == 0)
+                    break;
+            }
+            *offset_ptr += bytecount;
         }
 
-        // Sign bit of byte is 2nd high order bit (0x40)
-        if (shift < size && (byte & 0x40))
-            result |= - (1 << shift);
+        // Sign bit of the last byte is the highest bit decoded
+        if (shift < size && (value & (1ull << (shift - 1))))
+            value |= ~0ull << shift;
 
-        *offset_ptr += bytecount;
-        return result;
+        return (int64_t)value;
     }
     return 0;
 }
@@ -1267,6 +1335,20 @@ DataExtractor::Skip_LEB128 (offset_t *offset_ptr) const
     
     if (src < end)
     {
+        if (end - src >= 8)
+        {
+            uint64_t word;
+            memcpy (&word, src, sizeof(word));
+            const uint64_t stop_bits = ~word & 0x8080808080808080ull;
+            if (stop_bits != 0 && lldb::endian::InlHostByteOrder() == eByteOrderLittle)
+            {
+                // Like the loop below, only count the bytes with the
+                // continuation bit set.
+                const uint32_t length = (llvm::countTrailingZeros (stop_bits) + 1) / 8;
+                *offset_ptr += length;
+                return length - 1;
+            }
+        }
         const uint8_t *src_pos = src;
         while ((src_pos < end) && (*src_pos++ & 0x80))
             ++bytes_consumed;
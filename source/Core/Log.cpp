@@ -15,11 +15,13 @@
 #include <stdlib.h>
 
 // C++ Includes
+#include <atomic>
 #include <map>
 #include <string>
 
 // Other libraries and framework includes
 // Project includes
+#include "lldb/Core/AsyncLogWriter.h"
 #include "lldb/Core/Debugger.h"
 #include "lldb/Core/Log.h"
 #include "lldb/Core/PluginManager.h"
@@ -78,14 +80,16 @@ Log::GetMask() const
 //----------------------------------------------------------------------
 // All logging eventually boils down to this function call. If we have
 // a callback registered, then we call the logging callback. If we have
-// a valid file handle, we also log to the file.
+// a valid file handle, we also log to the file. Asynchronous and flight
+// recorder logs only format the line here, and leave writing it to the
+// AsyncLogWriter.
 //----------------------------------------------------------------------
 void
 Log::PrintfWithFlagsVarArg (uint32_t flags, const char *format, va_list args)
 {
     if (m_stream_sp)
     {
-        static uint32_t g_sequence_id = 0;
+        static std::atomic<uint32_t> g_sequence_id (0);
         StreamString header;
 		// Enabling the thread safe logging actually deadlocks right now.
 		// Need to fix this at some point.
@@ -110,13 +114,25 @@ Log::PrintfWithFlagsVarArg (uint32_t flags, const char *format, va_list args)
         // Add the process and thread if requested
         if (m_options.Test (LLDB_LOG_OPTION_PREPEND_THREAD_NAME))
         {
-            std::string thread_name (Host::GetThreadName (getpid(), Host::GetCurrentThreadID()));
-            if (!thread_name.empty())
-                header.Printf ("%s ", thread_name.c_str());
+            const char *thread_name = AsyncLogWriter::GetCurrentThreadName();
+            if (thread_name[0])
+                header.Printf ("%s ", thread_name);
         }
 
         header.PrintfVarArg (format, args);
-        m_stream_sp->Printf("%s\n", header.GetData());
+        header.EOL();
+
+        if (m_options.AnySet (LLDB_LOG_OPTION_ASYNC | LLDB_LOG_OPTION_FLIGHT_RECORDER))
+        {
+            if (m_options.Test (LLDB_LOG_OPTION_BACKTRACE))
+                Host::Backtrace (header, 1024);
+            AsyncLogWriter::GetSharedInstance().Enqueue (m_stream_sp,
+                                                         header.GetString(),
+                                                         m_options.Test (LLDB_LOG_OPTION_FLIGHT_RECORDER));
+            return;
+        }
+
+        m_stream_sp->Write(header.GetData(), header.GetSize());
         
         if (m_options.Test (LLDB_LOG_OPTION_BACKTRACE))
             Host::Backtrace (*m_stream_sp, 1024);
@@ -250,6 +266,10 @@ Log::FatalError (int err, const char *format, ...)
         PrintfWithFlags (LLDB_LOG_FLAG_ERROR | LLDB_LOG_FLAG_FATAL, "error: %s", arg_msg);
         ::free (arg_msg);
     }
+    // Whatever the flight recorder has is most useful right now.  Don't
+    // wait for it though, a write may have been what went wrong.
+    if (m_options.AnySet (LLDB_LOG_OPTION_ASYNC | LLDB_LOG_OPTION_FLIGHT_RECORDER))
+        AsyncLogWriter::GetSharedInstance().DumpFlightRecorder (false);
     ::exit (err);
 }
 
@@ -419,6 +439,8 @@ Log::DisableAllLogChannels (Stream *feedback_strm)
     LogChannelMapIter channel_pos, channel_end = channel_map.end();
     for (channel_pos = channel_map.begin(); channel_pos != channel_end; ++channel_pos)
         channel_pos->second->Disable (categories, feedback_strm);
+
+    FlushAsyncLogs ();
 }
 
 void
@@ -432,6 +454,19 @@ void
 Log::Terminate ()
 {
     DisableAllLogChannels (NULL);
+    AsyncLogWriter::GetSharedInstance().Terminate();
+}
+
+size_t
+Log::DumpFlightRecorder ()
+{
+    return AsyncLogWriter::GetSharedInstance().DumpFlightRecorder();
+}
+
+void
+Log::FlushAsyncLogs ()
+{
+    AsyncLogWriter::GetSharedInstance().Flush();
 }
 
 void
@@ -11,6 +11,7 @@
 
 // C Includes
 // C++ Includes
+#include <algorithm>
 // Other libraries and framework includes
 // Project includes
 #include "lldb/Core/Log.h"
@@ -18,19 +19,45 @@
 #include "lldb/Core/ModuleSpec.h"
 #include "lldb/Host/Host.h"
 #include "lldb/Host/Symbols.h"
+#include "lldb/Host/TaskPool.h"
 #include "lldb/Symbol/ClangNamespaceDecl.h"
 #include "lldb/Symbol/ObjectFile.h"
+#include "lldb/Symbol/TypeList.h"
 #include "lldb/Symbol/VariableList.h"
+#include "lldb/Target/Target.h"
 
 using namespace lldb;
 using namespace lldb_private;
 
+//----------------------------------------------------------------------
+// The first lookup in a module indexes its symbol table and debug info,
+// which for a program with hundreds of shared libraries takes far longer
+// serially than spread over a few threads. Each module is searched by
+// one thread at a time and writes into its own result list; the callers
+// merge those lists in module order so results don't depend on timing.
+//----------------------------------------------------------------------
+static void
+ForEachModuleInParallel (const std::vector<ModuleSP> &modules,
+                         uint32_t num_threads,
+                         const std::function<void(size_t, Module &)> &callback)
+{
+    TaskPool::ForEachIndex (modules.size(),
+                            num_threads,
+                            [&modules, &callback] (size_t idx)
+                            {
+                                callback (idx, *modules[idx]);
+                            });
+}
+
 //----------------------------------------------------------------------
 // ModuleList constructor
 //----------------------------------------------------------------------
 ModuleList::ModuleList() :
     m_modules(),
     m_modules_mutex (Mutex::eMutexTypeRecursive),
+    m_pointer_index(),
+    m_uuid_index(),
+    m_basename_index(),
     m_notifier(NULL)
 {
 }
@@ -40,16 +67,26 @@ ModuleList::ModuleList() :
 //----------------------------------------------------------------------
 ModuleList::ModuleList(const ModuleList& rhs) :
     m_modules(),
-    m_modules_mutex (Mutex::eMutexTypeRecursive)
+    m_modules_mutex (Mutex::eMutexTypeRecursive),
+    m_pointer_index(),
+    m_uuid_index(),
+    m_basename_index(),
+    m_notifier(NULL)
 {
     Mutex::Locker lhs_locker(m_modules_mutex);
     Mutex::Locker rhs_locker(rhs.m_modules_mutex);
     m_modules = rhs.m_modules;
+    m_pointer_index = rhs.m_pointer_index;
+    m_uuid_index = rhs.m_uuid_index;
+    m_basename_index = rhs.m_basename_index;
 }
 
 ModuleList::ModuleList (ModuleList::Notifier* notifier) :
     m_modules(),
     m_modules_mutex (Mutex::eMutexTypeRecursive),
+    m_pointer_index(),
+    m_uuid_index(),
+    m_basename_index(),
     m_notifier(notifier)
 {
 }
@@ -65,6 +102,9 @@ ModuleList::operator= (const ModuleList& rhs)
         Mutex::Locker lhs_locker(m_modules_mutex);
         Mutex::Locker rhs_locker(rhs.m_modules_mutex);
         m_modules = rhs.m_modules;
+        m_pointer_index = rhs.m_pointer_index;
+        m_uuid_index = rhs.m_uuid_index;
+        m_basename_index = rhs.m_basename_index;
     }
     return *this;
 }
@@ -76,6 +116,95 @@ ModuleList::~ModuleList()
 {
 }
 
+static void
+RemoveOneModulePointer (std::vector<Module *> &modules, Module *module)
+{
+    std::vector<Module *>::iterator pos = std::find (modules.begin(), modules.end(), module);
+    if (pos != modules.end())
+        modules.erase (pos);
+}
+
+void
+ModuleList::IndexModule (Module *module)
+{
+    PointerIndex::iterator pos = m_pointer_index.find (module);
+    if (pos != m_pointer_index.end())
+        ++pos->second.count;
+    else
+    {
+        // Getting the UUID may parse the object file, but every module that
+        // gets into a list has had its object file looked at already.
+        IndexEntry entry;
+        entry.count = 1;
+        entry.uuid = module->GetUUID();
+        entry.basename = module->GetFileSpec().GetFilename().GetCString();
+        pos = m_pointer_index.insert (std::make_pair (module, entry)).first;
+    }
+    if (pos->second.uuid.IsValid())
+        m_uuid_index[pos->second.uuid].push_back (module);
+    m_basename_index[pos->second.basename].push_back (module);
+}
+
+void
+ModuleList::UnindexModule (Module *module)
+{
+    PointerIndex::iterator pos = m_pointer_index.find (module);
+    if (pos == m_pointer_index.end())
+        return;
+
+    if (pos->second.uuid.IsValid())
+    {
+        UUIDIndex::iterator uuid_pos = m_uuid_index.find (pos->second.uuid);
+        if (uuid_pos != m_uuid_index.end())
+        {
+            RemoveOneModulePointer (uuid_pos->second, module);
+            if (uuid_pos->second.empty())
+                m_uuid_index.erase (uuid_pos);
+        }
+    }
+    BasenameIndex::iterator basename_pos = m_basename_index.find (pos->second.basename);
+    if (basename_pos != m_basename_index.end())
+    {
+        RemoveOneModulePointer (basename_pos->second, module);
+        if (basename_pos->second.empty())
+            m_basename_index.erase (basename_pos);
+    }
+    if (--pos->second.count == 0)
+        m_pointer_index.erase (pos);
+}
+
+void
+ModuleList::RebuildIndexes ()
+{
+    m_pointer_index.clear();
+    m_uuid_index.clear();
+    m_basename_index.clear();
+    for (collection::const_iterator pos = m_modules.begin(); pos != m_modules.end(); ++pos)
+        IndexModule (pos->get());
+}
+
+const ModuleList::ModulePointers *
+ModuleList::GetCandidateModules (const ModuleSpec &module_spec) const
+{
+    static const ModulePointers g_no_modules;
+
+    // These are the fields that Module::MatchesModuleSpec requires to
+    // be equal, if they are given.
+    const UUID &uuid = module_spec.GetUUID();
+    if (uuid.IsValid())
+    {
+        UUIDIndex::const_iterator pos = m_uuid_index.find (uuid);
+        return pos != m_uuid_index.end() ? &pos->second : &g_no_modules;
+    }
+    const ConstString &basename = module_spec.GetFileSpec().GetFilename();
+    if (basename)
+    {
+        BasenameIndex::const_iterator pos = m_basename_index.find (basename.GetCString());
+        return pos != m_basename_index.end() ? &pos->second : &g_no_modules;
+    }
+    return NULL;
+}
+
 void
 ModuleList::AppendImpl (const ModuleSP &module_sp, bool use_notifier)
 {
@@ -83,6 +212,7 @@ ModuleList::AppendImpl (const ModuleSP &module_sp, bool use_notifier)
     {
         Mutex::Locker locker(m_modules_mutex);
         m_modules.push_back(module_sp);
+        IndexModule(module_sp.get());
         if (use_notifier && m_notifier)
             m_notifier->ModuleAdded(*this, module_sp);
     }
@@ -106,14 +236,30 @@ ModuleList::ReplaceEquivalent (const ModuleSP &module_sp)
         ModuleSpec equivalent_module_spec (module_sp->GetFileSpec(), module_sp->GetArchitecture());
         equivalent_module_spec.GetPlatformFileSpec() = module_sp->GetPlatformFileSpec();
 
-        size_t idx = 0;
-        while (idx < m_modules.size())
+        const ModulePointers *candidates = GetCandidateModules (equivalent_module_spec);
+        if (candidates)
         {
-            ModuleSP module_sp (m_modules[idx]);
-            if (module_sp->MatchesModuleSpec (equivalent_module_spec))
-                RemoveImpl(m_modules.begin() + idx);
-            else
-                ++idx;
+            // Removing modules changes the candidates, so match them first.
+            collection equivalent_modules;
+            for (ModulePointers::const_iterator pos = candidates->begin(); pos != candidates->end(); ++pos)
+            {
+                if ((*pos)->MatchesModuleSpec (equivalent_module_spec))
+                    equivalent_modules.push_back ((*pos)->shared_from_this());
+            }
+            for (collection::iterator pos = equivalent_modules.begin(); pos != equivalent_modules.end(); ++pos)
+                RemoveImpl(*pos);
+        }
+        else
+        {
+            size_t idx = 0;
+            while (idx < m_modules.size())
+            {
+                ModuleSP module_sp (m_modules[idx]);
+                if (module_sp->MatchesModuleSpec (equivalent_module_spec))
+                    RemoveImpl(m_modules.begin() + idx);
+                else
+                    ++idx;
+            }
         }
         // Now add the new module to the list
         Append(module_sp);
@@ -126,12 +272,8 @@ ModuleList::AppendIfNeeded (const ModuleSP &module_sp)
     if (module_sp)
     {
         Mutex::Locker locker(m_modules_mutex);
-        collection::iterator pos, end = m_modules.end();
-        for (pos = m_modules.begin(); pos != end; ++pos)
-        {
-            if (pos->get() == module_sp.get())
-                return false; // Already in the list
-        }
+        if (m_pointer_index.find (module_sp.get()) != m_pointer_index.end())
+            return false; // Already in the list
         // Only push module_sp on the list if it wasn't already in there.
         Append(module_sp);
         return true;
@@ -164,12 +306,15 @@ ModuleList::RemoveImpl (const ModuleSP &module_sp, bool use_notifier)
     if (module_sp)
     {
         Mutex::Locker locker(m_modules_mutex);
+        if (m_pointer_index.find (module_sp.get()) == m_pointer_index.end())
+            return false;
         collection::iterator pos, end = m_modules.end();
         for (pos = m_modules.begin(); pos != end; ++pos)
         {
             if (pos->get() == module_sp.get())
             {
                 m_modules.erase (pos);
+                UnindexModule (module_sp.get());
                 if (use_notifier && m_notifier)
                     m_notifier->ModuleRemoved(*this, module_sp);
                 return true;
@@ -184,6 +329,7 @@ ModuleList::RemoveImpl (ModuleList::collection::iterator pos, bool use_notifier)
 {
     ModuleSP module_sp(*pos);
     collection::iterator retval = m_modules.erase(pos);
+    UnindexModule (module_sp.get());
     if (use_notifier && m_notifier)
         m_notifier->ModuleRemoved(*this, module_sp);
     return retval;
@@ -212,6 +358,8 @@ ModuleList::RemoveIfOrphaned (const Module *module_ptr)
     if (module_ptr)
     {
         Mutex::Locker locker(m_modules_mutex);
+        if (m_pointer_index.find (module_ptr) == m_pointer_index.end())
+            return false;
         collection::iterator pos, end = m_modules.end();
         for (pos = m_modules.begin(); pos != end; ++pos)
         {
@@ -296,6 +444,9 @@ ModuleList::ClearImpl (bool use_notifier)
     if (use_notifier && m_notifier)
         m_notifier->WillClearList(*this);
     m_modules.clear();
+    m_pointer_index.clear();
+    m_uuid_index.clear();
+    m_basename_index.clear();
 }
 
 Module*
@@ -329,6 +480,21 @@ ModuleList::GetModuleAtIndexUnlocked(size_t idx) const
     return module_sp;
 }
 
+ModuleList::collection
+ModuleList::GetModules () const
+{
+    Mutex::Locker locker(m_modules_mutex);
+    return m_modules;
+}
+
+uint32_t
+ModuleList::GetNumQueryThreads () const
+{
+    if (m_notifier)
+        return m_notifier->GetNumModuleQueryThreads();
+    return Target::GetGlobalProperties()->GetModuleQueryThreads();
+}
+
 size_t
 ModuleList::FindFunctions (const ConstString &name, 
                            uint32_t name_type_mask, 
@@ -352,18 +518,20 @@ ModuleList::FindFunctions (const ConstString &name,
                                               lookup_name_type_mask,
                                               match_name_after_lookup);
     
-        Mutex::Locker locker(m_modules_mutex);
-        collection::const_iterator pos, end = m_modules.end();
-        for (pos = m_modules.begin(); pos != end; ++pos)
+        const collection modules (GetModules());
+        std::vector<SymbolContextList> module_sc_lists (modules.size());
+        ForEachModuleInParallel (modules, GetNumQueryThreads(), [&] (size_t idx, Module &module)
         {
-            (*pos)->FindFunctions (lookup_name,
-                                   NULL,
-                                   lookup_name_type_mask,
-                                   include_symbols,
-                                   include_inlines,
-                                   true,
-                                   sc_list);
-        }
+            module.FindFunctions (lookup_name,
+                                  NULL,
+                                  lookup_name_type_mask,
+                                  include_symbols,
+                                  include_inlines,
+                                  true,
+                                  module_sc_lists[idx]);
+        });
+        for (size_t i = 0; i < module_sc_lists.size(); ++i)
+            sc_list.Append (module_sc_lists[i]);
         
         if (match_name_after_lookup)
         {
@@ -389,12 +557,14 @@ ModuleList::FindFunctions (const ConstString &name,
     }
     else
     {
-        Mutex::Locker locker(m_modules_mutex);
-        collection::const_iterator pos, end = m_modules.end();
-        for (pos = m_modules.begin(); pos != end; ++pos)
+        const collection modules (GetModules());
+        std::vector<SymbolContextList> module_sc_lists (modules.size());
+        ForEachModuleInParallel (modules, GetNumQueryThreads(), [&] (size_t idx, Module &module)
         {
-            (*pos)->FindFunctions (name, NULL, name_type_mask, include_symbols, include_inlines, true, sc_list);
-        }
+            module.FindFunctions (name, NULL, name_type_mask, include_symbols, include_inlines, true, module_sc_lists[idx]);
+        });
+        for (size_t i = 0; i < module_sc_lists.size(); ++i)
+            sc_list.Append (module_sc_lists[i]);
     }
     return sc_list.GetSize() - old_size;
 }
@@ -484,13 +654,17 @@ ModuleList::FindGlobalVariables (const ConstString &name,
                                  size_t max_matches,
                                  VariableList& variable_list) const
 {
+    if (!append)
+        variable_list.Clear();
     size_t initial_size = variable_list.GetSize();
-    Mutex::Locker locker(m_modules_mutex);
-    collection::const_iterator pos, end = m_modules.end();
-    for (pos = m_modules.begin(); pos != end; ++pos)
+    const collection modules (GetModules());
+    std::vector<VariableList> module_variable_lists (modules.size());
+    ForEachModuleInParallel (modules, GetNumQueryThreads(), [&] (size_t idx, Module &module)
     {
-        (*pos)->FindGlobalVariables (name, NULL, append, max_matches, variable_list);
-    }
+        module.FindGlobalVariables (name, NULL, true, max_matches, module_variable_lists[idx]);
+    });
+    for (size_t i = 0; i < module_variable_lists.size(); ++i)
+        variable_list.AddVariables (&module_variable_lists[i]);
     return variable_list.GetSize() - initial_size;
 }
 
@@ -501,13 +675,17 @@ ModuleList::FindGlobalVariables (const RegularExpression& regex,
                                  size_t max_matches,
                                  VariableList& variable_list) const
 {
+    if (!append)
+        variable_list.Clear();
     size_t initial_size = variable_list.GetSize();
-    Mutex::Locker locker(m_modules_mutex);
-    collection::const_iterator pos, end = m_modules.end();
-    for (pos = m_modules.begin(); pos != end; ++pos)
+    const collection modules (GetModules());
+    std::vector<VariableList> module_variable_lists (modules.size());
+    ForEachModuleInParallel (modules, GetNumQueryThreads(), [&] (size_t idx, Module &module)
     {
-        (*pos)->FindGlobalVariables (regex, append, max_matches, variable_list);
-    }
+        module.FindGlobalVariables (regex, true, max_matches, module_variable_lists[idx]);
+    });
+    for (size_t i = 0; i < module_variable_lists.size(); ++i)
+        variable_list.AddVariables (&module_variable_lists[i]);
     return variable_list.GetSize() - initial_size;
 }
 
@@ -518,14 +696,18 @@ ModuleList::FindSymbolsWithNameAndType (const ConstString &name,
                                         SymbolContextList &sc_list,
                                         bool append) const
 {
-    Mutex::Locker locker(m_modules_mutex);
     if (!append)
         sc_list.Clear();
     size_t initial_size = sc_list.GetSize();
     
-    collection::const_iterator pos, end = m_modules.end();
-    for (pos = m_modules.begin(); pos != end; ++pos)
-        (*pos)->FindSymbolsWithNameAndType (name, symbol_type, sc_list);
+    const collection modules (GetModules());
+    std::vector<SymbolContextList> module_sc_lists (modules.size());
+    ForEachModuleInParallel (modules, GetNumQueryThreads(), [&] (size_t idx, Module &module)
+    {
+        module.FindSymbolsWithNameAndType (name, symbol_type, module_sc_lists[idx]);
+    });
+    for (size_t i = 0; i < module_sc_lists.size(); ++i)
+        sc_list.Append (module_sc_lists[i]);
     return sc_list.GetSize() - initial_size;
 }
 
@@ -552,12 +734,24 @@ ModuleList::FindModules (const ModuleSpec &module_spec, ModuleList& matching_mod
     size_t existing_matches = matching_module_list.GetSize();
 
     Mutex::Locker locker(m_modules_mutex);
-    collection::const_iterator pos, end = m_modules.end();
-    for (pos = m_modules.begin(); pos != end; ++pos)
+    const ModulePointers *candidates = GetCandidateModules (module_spec);
+    if (candidates)
     {
-        ModuleSP module_sp(*pos);
-        if (module_sp->MatchesModuleSpec (module_spec))
-            matching_module_list.Append(module_sp);
+        for (ModulePointers::const_iterator pos = candidates->begin(); pos != candidates->end(); ++pos)
+        {
+            if ((*pos)->MatchesModuleSpec (module_spec))
+                matching_module_list.Append((*pos)->shared_from_this());
+        }
+    }
+    else
+    {
+        collection::const_iterator pos, end = m_modules.end();
+        for (pos = m_modules.begin(); pos != end; ++pos)
+        {
+            ModuleSP module_sp(*pos);
+            if (module_sp->MatchesModuleSpec (module_spec))
+                matching_module_list.Append(module_sp);
+        }
     }
     return matching_module_list.GetSize() - existing_matches;
 }
@@ -570,16 +764,8 @@ ModuleList::FindModule (const Module *module_ptr) const
     // Scope for "locker"
     {
         Mutex::Locker locker(m_modules_mutex);
-        collection::const_iterator pos, end = m_modules.end();
-
-        for (pos = m_modules.begin(); pos != end; ++pos)
-        {
-            if ((*pos).get() == module_ptr)
-            {
-                module_sp = (*pos);
-                break;
-            }
-        }
+        if (m_pointer_index.find (module_ptr) != m_pointer_index.end())
+            module_sp = const_cast<Module *>(module_ptr)->shared_from_this();
     }
     return module_sp;
 
@@ -593,16 +779,9 @@ ModuleList::FindModule (const UUID &uuid) const
     if (uuid.IsValid())
     {
         Mutex::Locker locker(m_modules_mutex);
-        collection::const_iterator pos, end = m_modules.end();
-        
-        for (pos = m_modules.begin(); pos != end; ++pos)
-        {
-            if ((*pos)->GetUUID() == uuid)
-            {
-                module_sp = (*pos);
-                break;
-            }
-        }
+        UUIDIndex::const_iterator pos = m_uuid_index.find (uuid);
+        if (pos != m_uuid_index.end())
+            module_sp = pos->second.front()->shared_from_this();
     }
     return module_sp;
 }
@@ -611,15 +790,15 @@ ModuleList::FindModule (const UUID &uuid) const
 size_t
 ModuleList::FindTypes (const SymbolContext& sc, const ConstString &name, bool name_is_fully_qualified, size_t max_matches, TypeList& types) const
 {
-    Mutex::Locker locker(m_modules_mutex);
+    const collection modules (GetModules());
 
     size_t total_matches = 0;
-    collection::const_iterator pos, end = m_modules.end();
+    collection::const_iterator pos, end = modules.end();
     if (sc.module_sp)
     {
         // The symbol context "sc" contains a module so we want to search that
         // one first if it is in our list...
-        for (pos = m_modules.begin(); pos != end; ++pos)
+        for (pos = modules.begin(); pos != end; ++pos)
         {
             if (sc.module_sp.get() == (*pos).get())
             {
@@ -631,10 +810,33 @@ ModuleList::FindTypes (const SymbolContext& sc, const ConstString &name, bool na
         }
     }
     
-    if (total_matches < max_matches)
+    if (total_matches < max_matches && max_matches == UINT32_MAX)
+    {
+        // Nothing to stop early for, so search the rest of the modules in
+        // parallel.
+        std::vector<TypeList> module_types (modules.size());
+        ForEachModuleInParallel (modules, GetNumQueryThreads(), [&] (size_t idx, Module &module)
+        {
+            if (sc.module_sp.get() != &module)
+            {
+                SymbolContext world_sc;
+                module.FindTypes (world_sc, name, name_is_fully_qualified, max_matches, module_types[idx]);
+            }
+        });
+        for (size_t i = 0; i < module_types.size(); ++i)
+        {
+            const uint32_t num_types = module_types[i].GetSize();
+            for (uint32_t j = 0; j < num_types; ++j)
+                types.Insert (module_types[i].GetTypeAtIndex (j));
+            total_matches += num_types;
+        }
+    }
+    else if (total_matches < max_matches)
     {
+        // A lookup that wants a few matches usually finds them in the
+        // first modules, stop as soon as we have them.
         SymbolContext world_sc;
-        for (pos = m_modules.begin(); pos != end; ++pos)
+        for (pos = modules.begin(); pos != end; ++pos)
         {
             // Search the module if the module is not equal to the one in the symbol
             // context "sc". If "sc" contains a empty module shared pointer, then
@@ -682,6 +884,16 @@ ModuleList::FindFirstModule (const ModuleSpec &module_spec) const
 {
     ModuleSP module_sp;
     Mutex::Locker locker(m_modules_mutex);
+    const ModulePointers *candidates = GetCandidateModules (module_spec);
+    if (candidates)
+    {
+        for (ModulePointers::const_iterator pos = candidates->begin(); pos != candidates->end(); ++pos)
+        {
+            if ((*pos)->MatchesModuleSpec (module_spec))
+                return (*pos)->shared_from_this();
+        }
+        return module_sp;
+    }
     collection::const_iterator pos, end = m_modules.end();
     for (pos = m_modules.begin(); pos != end; ++pos)
     {
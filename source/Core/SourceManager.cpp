@@ -12,6 +12,8 @@
 #include "lldb/Core/SourceManager.h"
 
 // C Includes
+#include <string.h>
+
 // C++ Includes
 // Other libraries and framework includes
 // Project includes
@@ -71,21 +73,25 @@ SourceManager::GetFile (const FileSpec &file_spec)
     bool same_as_previous = m_last_file_sp && m_last_file_sp->FileSpecMatches (file_spec);
 
     DebuggerSP debugger_sp (m_debugger_wp.lock());
+    TargetSP target_sp (m_target_wp.lock());
     FileSP file_sp;
     if (same_as_previous)
         file_sp = m_last_file_sp;
     else if (debugger_sp)
-        file_sp = debugger_sp->GetSourceFileCache().FindSourceFile (file_spec);
-    
-    TargetSP target_sp (m_target_wp.lock());
+        file_sp = debugger_sp->GetSourceFileCache().FindSourceFile (file_spec, target_sp.get());
+
+    // The cache is shared by all the targets of the debugger, don't use a
+    // file another target remapped or found in its images.
+    if (file_sp && !file_sp->IsValidForTarget (target_sp.get()))
+        file_sp.reset();
 
     // It the target source path map has been updated, get this file again so we
     // can successfully remap the source file
-    if (target_sp && file_sp && file_sp->GetSourceMapModificationID() != target_sp->GetSourcePathMap().GetModificationID())
+    if (target_sp && file_sp && file_sp->GetTarget() && file_sp->GetSourceMapModificationID() != target_sp->GetSourcePathMap().GetModificationID())
         file_sp.reset();
 
     // If file_sp is no good or it points to a non-existent file, reset it.
-    if (!file_sp || !file_sp->GetFileSpec().Exists())
+    if (!file_sp || !file_sp->Exists())
     {
         file_sp.reset (new File (file_spec, target_sp.get()));
 
@@ -337,14 +343,19 @@ SourceManager::File::File(const FileSpec &file_spec, Target *target) :
     m_file_spec(file_spec),
     m_mod_time (file_spec.GetModificationTime()),
     m_source_map_mod_id (0),
+    m_target_wp (),
+    m_found_with_target (false),
     m_data_sp(),
-    m_offsets()
+    m_offsets(),
+    m_watch_sp()
 {
     if (!m_mod_time.IsValid())
     {
         if (target)
         {
             m_source_map_mod_id = target->GetSourcePathMap().GetModificationID();
+            m_target_wp = target->shared_from_this();
+            m_found_with_target = true;
 
             if (!file_spec.GetDirectory() && file_spec.GetFilename())
             {
@@ -406,9 +417,9 @@ SourceManager::File::File(const FileSpec &file_spec, Target *target) :
             }
         }
     }
-    
-    if (m_mod_time.IsValid())
-        m_data_sp = m_file_spec.ReadFileContents ();
+    // The contents are read the first time they are needed, so that
+    // looking up many files (and their remappings) doesn't also read
+    // them all on the calling thread.
 }
 
 SourceManager::File::~File()
@@ -446,17 +457,7 @@ SourceManager::File::LineIsValid (uint32_t line)
 size_t
 SourceManager::File::DisplaySourceLines (uint32_t line, uint32_t context_before, uint32_t context_after, Stream *s)
 {
-    // TODO: use host API to sign up for file modifications to anything in our
-    // source cache and only update when we determine a file has been updated.
-    // For now we check each time we want to display info for the file.
-    TimeValue curr_mod_time (m_file_spec.GetModificationTime());
-
-    if (curr_mod_time.IsValid() && m_mod_time != curr_mod_time)
-    {
-        m_mod_time = curr_mod_time;
-        m_data_sp = m_file_spec.ReadFileContents ();
-        m_offsets.clear();
-    }
+    UpdateIfNeeded ();
 
     // Sanity check m_data_sp before proceeding.
     if (!m_data_sp)
@@ -487,15 +488,37 @@ SourceManager::File::DisplaySourceLines (uint32_t line, uint32_t context_before,
 }
 
 void
-SourceManager::File::FindLinesMatchingRegex (RegularExpression& regex, uint32_t start_line, uint32_t end_line, std::vector<uint32_t> &match_lines)
+SourceManager::File::UpdateIfNeeded ()
 {
+    if (m_data_sp && m_watch_sp && !m_watch_sp->HasChanged())
+        return;
+
+    // Without a watch, compare modification times to find out if the file
+    // changed.  With one, it has changed (or the contents were never read).
+    if (m_data_sp && !m_watch_sp)
+    {
+        TimeValue curr_mod_time (m_file_spec.GetModificationTime());
+        if (!curr_mod_time.IsValid() || m_mod_time == curr_mod_time)
+            return;
+    }
+
+    // Watch the file before reading it, so a change made while reading
+    // isn't missed.
+    m_watch_sp = FileMonitor::WatchFile (m_file_spec);
+
     TimeValue curr_mod_time (m_file_spec.GetModificationTime());
-    if (m_mod_time != curr_mod_time)
+    if (curr_mod_time.IsValid())
     {
         m_mod_time = curr_mod_time;
         m_data_sp = m_file_spec.ReadFileContents ();
         m_offsets.clear();
     }
+}
+
+void
+SourceManager::File::FindLinesMatchingRegex (const RegularExpression& regex, uint32_t start_line, uint32_t end_line, std::vector<uint32_t> &match_lines)
+{
+    UpdateIfNeeded ();
     
     match_lines.clear();
     
@@ -503,12 +526,17 @@ SourceManager::File::FindLinesMatchingRegex (RegularExpression& regex, uint32_t
         return;
     if (start_line > end_line)
         return;
-        
-    for (uint32_t line_no = start_line; line_no < end_line; line_no++)
+    
+    // The line offsets are all computed now, walk them directly rather than
+    // going through GetLine for each line.
+    const char *data = (const char *)m_data_sp->GetBytes();
+    const uint32_t num_offsets = m_offsets.size();
+    std::string buffer;
+    for (uint32_t line_no = start_line; line_no < end_line && line_no < num_offsets; line_no++)
     {
-        std::string buffer;
-        if (!GetLine (line_no, buffer))
-            break;
+        const size_t start_offset = (line_no == 1) ? 0 : m_offsets[line_no - 1];
+        const size_t end_offset = (line_no + 1 < num_offsets) ? m_offsets[line_no] : m_data_sp->GetByteSize();
+        buffer.assign(data + start_offset, end_offset - start_offset);
         if (regex.Execute(buffer.c_str()))
         {
             match_lines.push_back(line_no);
@@ -516,12 +544,42 @@ SourceManager::File::FindLinesMatchingRegex (RegularExpression& regex, uint32_t
     }
 }
 
+size_t
+SourceManager::File::GetByteSize ()
+{
+    return m_data_sp ? m_data_sp->GetByteSize() : 0;
+}
+
+bool
+SourceManager::File::Exists ()
+{
+    // Deleting or moving the file would have flagged the watch.
+    if (m_watch_sp && !m_watch_sp->HasChanged())
+        return true;
+    return m_file_spec.Exists();
+}
+
 bool
 SourceManager::File::FileSpecMatches (const FileSpec &file_spec)
 {
     return FileSpec::Equal (m_file_spec, file_spec, false);
 }
 
+Target *
+SourceManager::File::GetTarget () const
+{
+    return m_found_with_target ? m_target_wp.lock().get() : NULL;
+}
+
+bool
+SourceManager::File::IsValidForTarget (Target *target) const
+{
+    // A target that went away leaves the file valid for none.
+    if (!m_found_with_target)
+        return true;
+    return target != NULL && m_target_wp.lock().get() == target;
+}
+
 bool
 lldb_private::operator== (const SourceManager::File &lhs, const SourceManager::File &rhs)
 {
@@ -555,6 +613,8 @@ SourceManager::File::CalculateLineOffsets (uint32_t line)
 
         if (m_offsets.empty())
         {
+            if (m_data_sp.get() == NULL)
+                UpdateIfNeeded ();
             if (m_data_sp.get() == NULL)
                 return false;
 
@@ -567,22 +627,32 @@ SourceManager::File::CalculateLineOffsets (uint32_t line)
 
                 // Push a 1 at index zero to indicate the file has been completely indexed.
                 m_offsets.push_back(UINT32_MAX);
-                const char *s;
-                for (s = start; s < end; ++s)
+                if (::memchr (start, '\r', end - start) == NULL)
                 {
-                    char curr_ch = *s;
-                    if (is_newline_char (curr_ch))
+                    // Only '\n' line endings, let memchr (which is vectorized
+                    // by the C library) do the scanning.
+                    for (const char *s = start; (s = (const char *)::memchr (s, '\n', end - s)) != NULL; ++s)
+                        m_offsets.push_back(s + 1 - start);
+                }
+                else
+                {
+                    const char *s;
+                    for (s = start; s < end; ++s)
                     {
-                        if (s + 1 < end)
+                        char curr_ch = *s;
+                        if (is_newline_char (curr_ch))
                         {
-                            char next_ch = s[1];
-                            if (is_newline_char (next_ch))
+                            if (s + 1 < end)
                             {
-                                if (curr_ch != next_ch)
-                                    ++s;
+                                char next_ch = s[1];
+                                if (is_newline_char (next_ch))
+                                {
+                                    if (curr_ch != next_ch)
+                                        ++s;
+                                }
                             }
+                            m_offsets.push_back(s + 1 - start);
                         }
-                        m_offsets.push_back(s + 1 - start);
                     }
                 }
                 if (!m_offsets.empty())
@@ -625,27 +695,48 @@ SourceManager::File::GetLine (uint32_t line_no, std::string &buffer)
     return true;
 }
 
+// Each cached file keeps its contents, line table and (on some hosts) a
+// file system watch alive.
+static const size_t g_max_cached_source_files = 256;
+
 void 
 SourceManager::SourceFileCache::AddSourceFile (const FileSP &file_sp)
 {
-    FileSpec file_spec;
-    FileCache::iterator pos = m_file_cache.find(file_spec);
-    if (pos == m_file_cache.end())
-        m_file_cache[file_spec] = file_sp;
-    else
+    const FileCacheKey key (file_sp->GetOriginalFileSpec(), file_sp->GetTarget());
+    FileCache::iterator pos = m_file_cache.find(key);
+    if (pos == m_file_cache.end() && m_file_cache.size() >= g_max_cached_source_files)
     {
-        if (file_sp != pos->second)
-            m_file_cache[file_spec] = file_sp;
+        // Evict the least recently used file.  Source managers that are
+        // still displaying it hold their own reference.
+        FileCache::iterator oldest = m_file_cache.begin();
+        for (FileCache::iterator it = m_file_cache.begin(), end = m_file_cache.end(); it != end; ++it)
+        {
+            if (it->second.m_last_use < oldest->second.m_last_use)
+                oldest = it;
+        }
+        m_file_cache.erase (oldest);
     }
+
+    Entry &entry = m_file_cache[key];
+    entry.m_file_sp = file_sp;
+    entry.m_last_use = ++m_use_counter;
 }
 
 SourceManager::FileSP 
-SourceManager::SourceFileCache::FindSourceFile (const FileSpec &file_spec) const
+SourceManager::SourceFileCache::FindSourceFile (const FileSpec &file_spec, Target *target) const
 {
     FileSP file_sp;
-    FileCache::const_iterator pos = m_file_cache.find(file_spec);
+    // Prefer the file as the target found it, then one found without a target.
+    FileCache::const_iterator pos = m_file_cache.end();
+    if (target)
+        pos = m_file_cache.find(FileCacheKey (file_spec, target));
+    if (pos == m_file_cache.end())
+        pos = m_file_cache.find(FileCacheKey (file_spec, NULL));
     if (pos != m_file_cache.end())
-        file_sp = pos->second;
+    {
+        file_sp = pos->second.m_file_sp;
+        pos->second.m_last_use = ++m_use_counter;
+    }
     return file_sp;
 }
 
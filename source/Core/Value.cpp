@@ -566,6 +566,19 @@ Value::GetValueAsData (ExecutionContext *exe_ctx,
     if (error.Fail())
         return error;
 
+    // Processes that keep their memory in a buffer, like memory mapped
+    // core files, can share it with "data" instead of copying the value
+    if (address_type == eAddressTypeLoad && !file_so_addr.IsValid() && data_offset == 0 && byte_size > 0 && exe_ctx)
+    {
+        Process *process = exe_ctx->GetProcessPtr();
+        DataExtractor memory_data;
+        if (process && process->GetMemoryData (address, byte_size, memory_data))
+        {
+            data.SetData (memory_data.GetSharedDataBuffer(), memory_data.GetSharedDataOffset(), byte_size);
+            return error;
+        }
+    }
+
     // Make sure we have enough room within "data", and if we don't make
     // something large enough that does
     if (!data.ValidOffsetForDataOfSize (data_offset, byte_size))
@@ -159,6 +159,12 @@ ValueObject::~ValueObject ()
 {
 }
 
+void *
+ValueObject::operator new (size_t size, ValueObject &parent)
+{
+    return parent.GetManager()->Allocate (size);
+}
+
 bool
 ValueObject::UpdateValueIfNeeded (bool update_format)
 {
@@ -374,6 +380,26 @@ ValueObject::GetDataExtractor ()
     return m_data;
 }
 
+// Aggregates bigger than this usually only have a few of their children
+// shown, so let those read their own data.
+static const uint64_t g_max_aggregate_read_size = 64 * 1024;
+
+void
+ValueObject::ReadAggregateData (ExecutionContext &exe_ctx, const Value &value)
+{
+    const uint64_t byte_size = GetByteSize();
+    if (byte_size > 0 && byte_size <= g_max_aggregate_read_size)
+    {
+        Value aggregate_value (value);
+        Error error (aggregate_value.GetValueAsData (&exe_ctx, m_data, 0, GetModule().get()));
+        if (error.Success() && m_data.GetByteSize() == byte_size)
+            return;
+    }
+    // This isn't an error for the aggregate itself, its children will
+    // read their own data.
+    m_data.SetData (DataBufferSP());
+}
+
 const Error &
 ValueObject::GetError()
 {
@@ -817,7 +843,7 @@ ValueObject::CreateChildAtIndex (size_t idx, bool synthetic_array_member, int32_
         if (!child_name_str.empty())
             child_name.SetCString (child_name_str.c_str());
 
-        valobj = new ValueObjectChild (*this,
+        valobj = new (*this) ValueObjectChild (*this,
                                        child_clang_type,
                                        child_name,
                                        child_byte_size,
@@ -1029,6 +1055,12 @@ ValueObject::GetPointeeData (DataExtractor& data,
                     Process *process = exe_ctx.GetProcessPtr();
                     if (process)
                     {
+                        DataExtractor memory_data;
+                        if (process->GetMemoryData(addr + offset, bytes, memory_data))
+                        {
+                            data.SetData(memory_data.GetSharedDataBuffer(), memory_data.GetSharedDataOffset(), bytes);
+                            return bytes;
+                        }
                         heap_buf_ptr->SetByteSize(bytes);
                         size_t bytes_read = process->ReadMemory(addr + offset, heap_buf_ptr->GetBytes(), bytes, error);
                         if (error.Success() || bytes_read > 0)
@@ -2147,7 +2179,7 @@ ValueObject::GetSyntheticBitFieldChild (uint32_t from, uint32_t to, bool can_cre
         {
             // We haven't made a synthetic array member for INDEX yet, so
             // lets make one and cache it for any future reference.
-            ValueObjectChild *synthetic_child = new ValueObjectChild (*this,
+            ValueObjectChild *synthetic_child = new (*this) ValueObjectChild (*this,
                                                                       GetClangType(),
                                                                       index_const_str,
                                                                       GetByteSize(),
@@ -2191,7 +2223,7 @@ ValueObject::GetSyntheticChildAtOffset(uint32_t offset, const ClangASTType& type
     if (!can_create)
         return ValueObjectSP();
     
-    ValueObjectChild *synthetic_child = new ValueObjectChild(*this,
+    ValueObjectChild *synthetic_child = new (*this) ValueObjectChild(*this,
                                                              type,
                                                              name_const_str,
                                                              type.GetByteSize(),
@@ -3508,7 +3540,7 @@ ValueObject::Dereference (Error &error)
             if (!child_name_str.empty())
                 child_name.SetCString (child_name_str.c_str());
 
-            m_deref_valobj = new ValueObjectChild (*this,
+            m_deref_valobj = new (*this) ValueObjectChild (*this,
                                                    child_clang_type,
                                                    child_name,
                                                    child_byte_size,
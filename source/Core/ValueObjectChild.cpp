@@ -9,6 +9,12 @@
 
 #include "lldb/Core/ValueObjectChild.h"
 
+// C Includes
+// C++ Includes
+#include <atomic>
+
+// Other libraries and framework includes
+// Project includes
 #include "lldb/Core/Module.h"
 #include "lldb/Core/ValueObjectList.h"
 
@@ -109,6 +115,51 @@ ValueObjectChild::GetQualifiedTypeName()
     return qualified_name;
 }
 
+// Number of times a child's bytes were sliced out of its parent's data
+// instead of being read from the process.
+static std::atomic<uint64_t> g_num_memory_reads_saved (0);
+
+uint64_t
+ValueObjectChild::GetNumMemoryReadsSaved ()
+{
+    return g_num_memory_reads_saved;
+}
+
+bool
+ValueObjectChild::GetDataFromParent (ValueObject *parent)
+{
+    // Only members and elements that live inside the parent's own bytes
+    // can be sliced out of them. The pointee of a pointer lives somewhere
+    // else, and bitfields are left to Value, which knows how to handle them.
+    if (m_is_deref_of_parent || m_bitfield_bit_size != 0 || m_byte_offset < 0 || m_byte_size == 0)
+        return false;
+
+    switch (m_value.GetValueType())
+    {
+    case Value::eValueTypeLoadAddress:
+    case Value::eValueTypeFileAddress:
+        break;
+    default:
+        return false;
+    }
+
+    if (parent->GetClangType().IsPointerOrReferenceType ())
+        return false;
+
+    // The parent was updated just before this, so its data is what is
+    // currently in memory at the parent's address.
+    const DataExtractor &parent_data = parent->GetDataExtractor();
+    const uint64_t byte_offset = m_byte_offset;
+    if (byte_offset + m_byte_size > parent_data.GetByteSize())
+        return false;
+
+    // This shares the parent's buffer rather than copying out of it.
+    if (m_data.SetData (parent_data, byte_offset, m_byte_size) != m_byte_size)
+        return false;
+    ++g_num_memory_reads_saved;
+    return true;
+}
+
 bool
 ValueObjectChild::UpdateValue ()
 {
@@ -206,8 +257,11 @@ ValueObjectChild::UpdateValue ()
 
             if (m_error.Success())
             {
-                ExecutionContext exe_ctx (GetExecutionContextRef().Lock());
-                m_error = m_value.GetValueAsData (&exe_ctx, m_data, 0, GetModule().get());
+                if (!GetDataFromParent (parent))
+                {
+                    ExecutionContext exe_ctx (GetExecutionContextRef().Lock());
+                    m_error = m_value.GetValueAsData (&exe_ctx, m_data, 0, GetModule().get());
+                }
             }
         }
         else
@@ -130,7 +130,7 @@ ValueObjectConstResultImpl::CreateChildAtIndex (size_t idx, bool synthetic_array
         if (!child_name_str.empty())
             child_name.SetCString (child_name_str.c_str());
         
-        valobj = new ValueObjectConstResultChild (*m_impl_backend,
+        valobj = new (*m_impl_backend) ValueObjectConstResultChild (*m_impl_backend,
                                                   child_clang_type,
                                                   child_name,
                                                   child_byte_size,
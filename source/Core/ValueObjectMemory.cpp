@@ -231,6 +231,14 @@ ValueObjectMemory::UpdateValue ()
                 // children have values, but this object does not. So we
                 // say we are changed if our location has changed.
                 SetValueDidChange (value_type != old_value.GetValueType() || m_value.GetScalar() != old_value.GetScalar());
+
+                // Read the whole aggregate at once for its children.
+                Value value(m_value);
+                if (m_type_sp)
+                    value.SetContext(Value::eContextTypeLLDBType, m_type_sp.get());
+                else
+                    value.SetClangType(m_clang_type);
+                ReadAggregateData (exe_ctx, value);
             }
             else
             {
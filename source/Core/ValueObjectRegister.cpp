@@ -217,7 +217,7 @@ ValueObjectRegisterSet::CreateChildAtIndex (size_t idx, bool synthetic_array_mem
     {
         const size_t num_children = GetNumChildren();
         if (idx < num_children)
-            valobj = new ValueObjectRegister(*this, m_reg_ctx_sp, m_reg_set->registers[idx]);
+            valobj = new (*this) ValueObjectRegister(*this, m_reg_ctx_sp, m_reg_set->registers[idx]);
     }
     return valobj;
 }
@@ -230,7 +230,7 @@ ValueObjectRegisterSet::GetChildMemberWithName (const ConstString &name, bool ca
     {
         const RegisterInfo *reg_info = m_reg_ctx_sp->GetRegisterInfoByName (name.AsCString());
         if (reg_info != NULL)
-            valobj = new ValueObjectRegister(*this, m_reg_ctx_sp, reg_info->kinds[eRegisterKindLLDB]);
+            valobj = new (*this) ValueObjectRegister(*this, m_reg_ctx_sp, reg_info->kinds[eRegisterKindLLDB]);
     }
     if (valobj)
         return valobj->GetSP();
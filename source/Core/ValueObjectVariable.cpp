@@ -231,6 +231,11 @@ ValueObjectVariable::UpdateValue ()
                     // children have values, but this object does not. So we
                     // say we are changed if our location has changed.
                     SetValueDidChange (value_type != old_value.GetValueType() || m_value.GetScalar() != old_value.GetScalar());
+
+                    // Read the whole aggregate at once for its children.
+                    Value value(m_value);
+                    value.SetContext(Value::eContextTypeVariable, variable);
+                    ReadAggregateData (exe_ctx, value);
                 }
                 else
                 {
@@ -14,6 +14,8 @@
 // Other libraries and framework includes
 // Project includes
 #include "lldb/Core/Debugger.h"
+#include "lldb/Core/Log.h"
+#include "lldb/Core/ValueObjectChild.h"
 #include "lldb/DataFormatters/DataVisualization.h"
 #include "lldb/Interpreter/CommandInterpreter.h"
 #include "lldb/Target/Target.h"
@@ -61,6 +63,7 @@ ValueObjectPrinter::Init (ValueObject* valobj,
     m_value.assign("");
     m_summary.assign("");
     m_error.assign("");
+    m_memory_reads_saved = 0;
 }
 
 bool
@@ -69,6 +72,8 @@ ValueObjectPrinter::PrintValueObject ()
     if (!GetDynamicValueIfNeeded () || m_valobj == nullptr)
         return false;
     
+    const uint64_t memory_reads_saved = ValueObjectChild::GetNumMemoryReadsSaved();
+    
     if (ShouldPrintValueObject())
     {
         PrintLocationIfNeeded();
@@ -89,6 +94,16 @@ ValueObjectPrinter::PrintValueObject ()
     else
         m_stream->EOL();
     
+    m_memory_reads_saved = ValueObjectChild::GetNumMemoryReadsSaved() - memory_reads_saved;
+    if (m_curr_depth == 0)
+    {
+        Log *log(lldb_private::GetLogIfAllCategoriesSet (LIBLLDB_LOG_TYPES));
+        if (log)
+            log->Printf("[ValueObjectPrinter::PrintValueObject] %s: %" PRIu64 " memory reads saved by using the parent's data",
+                        m_valobj->GetName().AsCString("<unnamed>"),
+                        m_memory_reads_saved);
+    }
+    
     return true;
 }
 
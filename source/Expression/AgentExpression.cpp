@@ -0,0 +1,1437 @@
+//===-- AgentExpression.cpp -------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Expression/AgentExpression.h"
+
+// C Includes
+#include <ctype.h>
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+
+// C++ Includes
+#include <algorithm>
+#include <memory>
+#include <string>
+
+// Other libraries and framework includes
+// Project includes
+#include "lldb/Core/ConstString.h"
+#include "lldb/Core/DataExtractor.h"
+#include "lldb/Core/dwarf.h"
+#include "lldb/Core/Error.h"
+#include "lldb/Core/Module.h"
+#include "lldb/Core/ModuleList.h"
+#include "lldb/Core/RegisterValue.h"
+#include "lldb/Core/Stream.h"
+#include "lldb/Expression/DWARFExpression.h"
+#include "lldb/Symbol/ClangASTType.h"
+#include "lldb/Symbol/FuncUnwinders.h"
+#include "lldb/Symbol/Function.h"
+#include "lldb/Symbol/ObjectFile.h"
+#include "lldb/Symbol/SymbolContext.h"
+#include "lldb/Symbol/Type.h"
+#include "lldb/Symbol/UnwindPlan.h"
+#include "lldb/Symbol/UnwindTable.h"
+#include "lldb/Symbol/Variable.h"
+#include "lldb/Symbol/VariableList.h"
+#include "lldb/Target/ExecutionContext.h"
+#include "lldb/Target/Process.h"
+#include "lldb/Target/RegisterContext.h"
+#include "lldb/Target/StackFrame.h"
+#include "lldb/Target/Target.h"
+#include "lldb/Target/Thread.h"
+
+using namespace lldb;
+using namespace lldb_private;
+
+namespace {
+
+// Limits that keep a runaway (or hostile, when it comes from a stub)
+// program from taking down the debugger.
+const size_t k_max_stack_depth = 64;
+const size_t k_max_program_size = 4096;
+const size_t k_max_steps = 65536;
+
+//----------------------------------------------------------------------
+// The integer type of a value on the bytecode stack, used to apply the
+// usual arithmetic conversions before comparing two values.
+//----------------------------------------------------------------------
+struct ValueType
+{
+    ValueType (uint32_t s = 4, bool sign = true) :
+        byte_size (s),
+        is_signed (sign)
+    {
+    }
+
+    uint32_t byte_size;
+    bool is_signed;
+};
+
+//----------------------------------------------------------------------
+// Where a variable (or a member of one) lives at the breakpoint's PC.
+//----------------------------------------------------------------------
+struct ValueLocation
+{
+    enum Kind
+    {
+        eKindInvalid,
+        eKindRegister,  // The value lives in register "reg_num"
+        eKindMemory     // "address" pushes a base address, add "offset" to it
+    };
+
+    ValueLocation () :
+        kind (eKindInvalid),
+        reg_num (LLDB_INVALID_REGNUM),
+        offset (0),
+        address ()
+    {
+    }
+
+    Kind kind;
+    uint32_t reg_num;
+    int64_t offset;
+    AgentExpression address;
+};
+
+//----------------------------------------------------------------------
+// Parse tree for a condition.  Leaves carry the bytecode that pushes
+// their value, interior nodes are emitted once both sides are typed.
+//----------------------------------------------------------------------
+struct ConditionNode
+{
+    enum Kind
+    {
+        eKindLeaf,
+        eKindLogicalNot,
+        eKindLogicalAnd,
+        eKindLogicalOr,
+        eKindBinary
+    };
+
+    ConditionNode (Kind k) :
+        kind (k),
+        op (),
+        type (),
+        code (),
+        lhs (),
+        rhs ()
+    {
+    }
+
+    Kind kind;
+    std::string op;
+    ValueType type;
+    AgentExpression code;
+    std::unique_ptr<ConditionNode> lhs;
+    std::unique_ptr<ConditionNode> rhs;
+};
+
+typedef std::unique_ptr<ConditionNode> ConditionNodeUP;
+
+class ConditionCompiler
+{
+public:
+    ConditionCompiler (const char *text, ExecutionContext &exe_ctx, Error &error) :
+        m_text (text),
+        m_pos (0),
+        m_depth (0),
+        m_exe_ctx (exe_ctx),
+        m_error (error),
+        m_pc (LLDB_INVALID_ADDRESS),
+        m_sc ()
+    {
+    }
+
+    bool
+    Compile (AgentExpression &expr)
+    {
+        StackFrame *frame = m_exe_ctx.GetFramePtr();
+        Target *target = m_exe_ctx.GetTargetPtr();
+        if (frame == NULL || target == NULL || m_exe_ctx.GetProcessPtr() == NULL)
+            return Fail ("no frame to compile the condition against");
+
+        m_pc = frame->GetFrameCodeAddress().GetLoadAddress (target);
+        m_sc = frame->GetSymbolContext (eSymbolContextModule | eSymbolContextFunction | eSymbolContextBlock);
+
+        ConditionNodeUP root (ParseBinary (0));
+        if (!root)
+            return false;
+        SkipSpaces();
+        if (m_pos != m_text.size())
+            return Fail ("unsupported syntax in condition");
+
+        if (!Emit (*root, expr))
+            return false;
+        expr.AppendOpcode (AgentExpression::eOpEnd);
+        if (expr.GetOpcodes().size() > k_max_program_size)
+            return Fail ("condition is too large");
+        return true;
+    }
+
+private:
+    bool
+    Fail (const char *reason)
+    {
+        if (m_error.Success())
+            m_error.SetErrorString (reason);
+        return false;
+    }
+
+    //------------------------------------------------------------------
+    // Lexing
+    //------------------------------------------------------------------
+    void
+    SkipSpaces ()
+    {
+        while (m_pos < m_text.size() && isspace (m_text[m_pos]))
+            ++m_pos;
+    }
+
+    bool
+    Accept (const char *token)
+    {
+        SkipSpaces();
+        const size_t len = strlen (token);
+        if (m_text.compare (m_pos, len, token) != 0)
+            return false;
+        m_pos += len;
+        return true;
+    }
+
+    bool
+    AcceptIdentifier (std::string &identifier)
+    {
+        SkipSpaces();
+        size_t end = m_pos;
+        if (end < m_text.size() && (isalpha (m_text[end]) || m_text[end] == '_'))
+        {
+            while (end < m_text.size() && (isalnum (m_text[end]) || m_text[end] == '_'))
+                ++end;
+            identifier = m_text.substr (m_pos, end - m_pos);
+            m_pos = end;
+            return true;
+        }
+        return false;
+    }
+
+    // Binary operators we support, from lowest to highest precedence.
+    // Anything else (division, shifts, assignment, ?:...) is left to the
+    // full expression parser.
+    static int
+    GetPrecedence (const std::string &op)
+    {
+        if (op == "||") return 1;
+        if (op == "&&") return 2;
+        if (op == "|")  return 3;
+        if (op == "^")  return 4;
+        if (op == "&")  return 5;
+        if (op == "==" || op == "!=") return 6;
+        if (op == "<" || op == ">" || op == "<=" || op == ">=") return 7;
+        if (op == "+" || op == "-") return 8;
+        if (op == "*") return 9;
+        return -1;
+    }
+
+    bool
+    PeekBinaryOperator (std::string &op)
+    {
+        SkipSpaces();
+        static const char *g_operators[] = { "||", "&&", "==", "!=", "<=", ">=", "|", "^", "&", "<", ">", "+", "-", "*" };
+        for (size_t i = 0; i < sizeof(g_operators)/sizeof(g_operators[0]); ++i)
+        {
+            const size_t len = strlen (g_operators[i]);
+            if (m_text.compare (m_pos, len, g_operators[i]) == 0)
+            {
+                // Don't mistake "->", "<<", ">>", "|=" and friends for one
+                // of our operators.
+                const char next = m_pos + len < m_text.size() ? m_text[m_pos + len] : '\0';
+                if (next == '=' || (len == 1 && (next == m_text[m_pos] || next == '>')))
+                    return false;
+                op = g_operators[i];
+                return true;
+            }
+        }
+        return false;
+    }
+
+    //------------------------------------------------------------------
+    // Parsing
+    //------------------------------------------------------------------
+    ConditionNodeUP
+    ParseBinary (int min_precedence)
+    {
+        if (++m_depth > 32)
+        {
+            Fail ("condition is nested too deeply");
+            return ConditionNodeUP();
+        }
+        ConditionNodeUP lhs (ParseUnary());
+        std::string op;
+        while (lhs && PeekBinaryOperator (op))
+        {
+            const int precedence = GetPrecedence (op);
+            if (precedence <= min_precedence)
+                break;
+            m_pos += op.size();
+            ConditionNodeUP rhs (ParseBinary (precedence));
+            if (!rhs)
+                return ConditionNodeUP();
+            ConditionNode::Kind kind = ConditionNode::eKindBinary;
+            if (op == "&&")
+                kind = ConditionNode::eKindLogicalAnd;
+            else if (op == "||")
+                kind = ConditionNode::eKindLogicalOr;
+            ConditionNodeUP node (new ConditionNode (kind));
+            node->op = op;
+            node->lhs.swap (lhs);
+            node->rhs.swap (rhs);
+            lhs.swap (node);
+        }
+        --m_depth;
+        return lhs;
+    }
+
+    ConditionNodeUP
+    ParseUnary ()
+    {
+        if (Accept ("!"))
+        {
+            ConditionNodeUP operand (ParseUnary());
+            if (!operand)
+                return operand;
+            ConditionNodeUP node (new ConditionNode (ConditionNode::eKindLogicalNot));
+            node->lhs.swap (operand);
+            return node;
+        }
+        if (Accept ("("))
+        {
+            ConditionNodeUP node (ParseBinary (0));
+            if (node && !Accept (")"))
+            {
+                Fail ("expected ')'");
+                return ConditionNodeUP();
+            }
+            return node;
+        }
+        SkipSpaces();
+        if (m_pos < m_text.size() && (isdigit (m_text[m_pos]) || m_text[m_pos] == '-' || m_text[m_pos] == '\''))
+            return ParseConstant();
+        return ParseVariablePath();
+    }
+
+    ConditionNodeUP
+    MakeConstant (uint64_t value, const ValueType &type)
+    {
+        ConditionNodeUP node (new ConditionNode (ConditionNode::eKindLeaf));
+        node->type = type;
+        node->code.AppendConstant (value);
+        return node;
+    }
+
+    ConditionNodeUP
+    ParseConstant ()
+    {
+        const bool negate = Accept ("-");
+        SkipSpaces();
+        if (m_pos < m_text.size() && m_text[m_pos] == '\'')
+        {
+            // Plain character literals only, escapes are rare in conditions.
+            if (m_pos + 2 < m_text.size() && m_text[m_pos + 1] != '\\' && m_text[m_pos + 2] == '\'')
+            {
+                int64_t value = (signed char)m_text[m_pos + 1];
+                m_pos += 3;
+                return MakeConstant (negate ? -value : value, ValueType (4, true));
+            }
+            Fail ("unsupported character literal");
+            return ConditionNodeUP();
+        }
+
+        if (m_pos >= m_text.size() || !isdigit (m_text[m_pos]))
+        {
+            Fail ("expected a number");
+            return ConditionNodeUP();
+        }
+        const char *start = m_text.c_str() + m_pos;
+        char *end = NULL;
+        uint64_t value = ::strtoull (start, &end, 0);
+        m_pos += end - start;
+
+        bool is_unsigned = false;
+        bool is_long = false;
+        while (m_pos < m_text.size())
+        {
+            const char c = m_text[m_pos];
+            if (c == 'u' || c == 'U')
+                is_unsigned = true;
+            else if (c == 'l' || c == 'L')
+                is_long = true;
+            else
+                break;
+            ++m_pos;
+        }
+        if (m_pos < m_text.size() && (isalnum (m_text[m_pos]) || m_text[m_pos] == '.' || m_text[m_pos] == '_'))
+        {
+            Fail ("unsupported numeric literal");
+            return ConditionNodeUP();
+        }
+
+        // The type of a literal is the first of these its value fits in,
+        // as in C (long is 64 bits):
+        //   decimal:      int, long
+        //   hex or octal: int, unsigned int, long, unsigned long
+        // with only the unsigned ones for a 'u' suffix and only the long
+        // ones for an 'l' suffix.
+        const bool is_decimal = !(start[0] == '0' && end - start > 1);
+        ValueType type;
+        if (!is_long && !is_unsigned && value <= INT32_MAX)
+            type = ValueType (4, true);
+        else if (!is_long && (is_unsigned || !is_decimal) && value <= UINT32_MAX)
+            type = ValueType (4, false);
+        else if (!is_unsigned && value <= INT64_MAX)
+            type = ValueType (8, true);
+        else
+            type = ValueType (8, false);
+
+        // Negate in the literal's type and keep it in that type's 64 bit
+        // representation, so "-1u" is 0xffffffff.
+        if (negate)
+            value = 0 - value;
+        if (type.byte_size == 4)
+            value = type.is_signed ? (uint64_t)(int64_t)(int32_t)value : (value & UINT32_MAX);
+        return MakeConstant (value, type);
+    }
+
+    ConditionNodeUP
+    ParseVariablePath ()
+    {
+        std::string name;
+        if (!AcceptIdentifier (name))
+        {
+            Fail ("unsupported syntax in condition");
+            return ConditionNodeUP();
+        }
+
+        if (name == "true" || name == "false")
+            return MakeConstant (name == "true", ValueType (4, true));
+        if (name == "NULL" || name == "nullptr" || name == "nil")
+            return MakeConstant (0, ValueType (m_exe_ctx.GetAddressByteSize(), false));
+
+        ValueLocation location;
+        ClangASTType clang_type;
+        if (!LocateVariable (name, location, clang_type))
+            return ConditionNodeUP();
+
+        // Walk any member accesses and constant array subscripts.
+        while (true)
+        {
+            if (!DereferenceIfReference (location, clang_type))
+                return ConditionNodeUP();
+
+            if (Accept ("->"))
+            {
+                ClangASTType pointee_type;
+                if (!clang_type.GetCanonicalType().IsPointerType (&pointee_type))
+                {
+                    Fail ("'->' applied to a non-pointer");
+                    return ConditionNodeUP();
+                }
+                if (!LoadPointer (location))
+                    return ConditionNodeUP();
+                clang_type = pointee_type;
+                if (!SelectMember (location, clang_type))
+                    return ConditionNodeUP();
+            }
+            else if (Accept ("."))
+            {
+                if (!SelectMember (location, clang_type))
+                    return ConditionNodeUP();
+            }
+            else if (Accept ("["))
+            {
+                if (!SelectElement (location, clang_type))
+                    return ConditionNodeUP();
+            }
+            else
+                break;
+        }
+
+        ConditionNodeUP node (new ConditionNode (ConditionNode::eKindLeaf));
+        if (!LoadValue (location, clang_type, node->code, node->type))
+            return ConditionNodeUP();
+        return node;
+    }
+
+    //------------------------------------------------------------------
+    // Variable location lowering
+    //------------------------------------------------------------------
+    bool
+    LocateVariable (const std::string &name, ValueLocation &location, ClangASTType &clang_type)
+    {
+        StackFrame *frame = m_exe_ctx.GetFramePtr();
+        Target *target = m_exe_ctx.GetTargetPtr();
+        ConstString const_name (name.c_str());
+
+        VariableSP var_sp;
+        VariableListSP var_list_sp (frame->GetInScopeVariableList (true));
+        if (var_list_sp)
+            var_sp = var_list_sp->FindVariable (const_name);
+        if (!var_sp)
+        {
+            // In a method the name could be a member of the implicit
+            // object, which only the expression parser knows how to look
+            // up; don't bind it to a global of the same name instead.
+            if (var_list_sp && (var_list_sp->FindVariable (ConstString ("this")) ||
+                                var_list_sp->FindVariable (ConstString ("self"))))
+                return Fail ("name may be a member of 'this'");
+
+            VariableList globals;
+            target->GetImages().FindGlobalVariables (const_name, true, 2, globals);
+            if (globals.GetSize() != 1)
+                return Fail ("condition refers to an unknown or ambiguous name");
+            var_sp = globals.GetVariableAtIndex (0);
+        }
+
+        if (!var_sp->LocationIsValidForFrame (frame))
+            return Fail ("variable is not available at this location");
+        if (var_sp->GetLocationIsConstantValueData())
+            return Fail ("variable has a constant value");
+
+        Type *var_type = var_sp->GetType();
+        if (var_type == NULL)
+            return Fail ("variable has no type");
+        clang_type = var_type->GetClangFullType();
+        if (!clang_type.IsValid())
+            return Fail ("variable has no type");
+
+        SymbolContext var_sc;
+        var_sp->CalculateSymbolContext (&var_sc);
+        if (!var_sc.module_sp)
+            var_sc.module_sp = m_sc.module_sp;
+        return LowerLocation (var_sp->LocationExpression(), var_sc, location);
+    }
+
+    bool
+    ConvertRegister (uint32_t kind, uint32_t reg, uint32_t &lldb_reg)
+    {
+        RegisterContextSP reg_ctx_sp (m_exe_ctx.GetFramePtr()->GetRegisterContext());
+        if (!reg_ctx_sp)
+            return Fail ("no register context");
+        lldb_reg = reg_ctx_sp->ConvertRegisterKindToRegisterNumber (kind, reg);
+        if (lldb_reg == LLDB_INVALID_REGNUM)
+            return Fail ("unknown register in location");
+        return true;
+    }
+
+    // Lower a single-operation DWARF location into "register" or
+    // "register/absolute address plus offset" form.
+    bool
+    LowerLocation (DWARFExpression &dwarf_expr, const SymbolContext &sc, ValueLocation &location)
+    {
+        Target *target = m_exe_ctx.GetTargetPtr();
+        addr_t loclist_base_load_addr = LLDB_INVALID_ADDRESS;
+        if (dwarf_expr.IsLocationList())
+        {
+            if (sc.function == NULL)
+                return Fail ("location list without a function");
+            loclist_base_load_addr = sc.function->GetAddressRange().GetBaseAddress().GetLoadAddress (target);
+        }
+
+        DataExtractor opcodes;
+        if (!dwarf_expr.GetExpressionDataAtAddress (loclist_base_load_addr, m_pc, opcodes))
+            return Fail ("variable has no location at this address");
+
+        const uint32_t reg_kind = dwarf_expr.GetRegisterKind();
+        lldb::offset_t offset = 0;
+        const uint8_t op = opcodes.GetU8 (&offset);
+        uint32_t reg = LLDB_INVALID_REGNUM;
+        int64_t reg_offset = 0;
+        bool is_memory = true;
+
+        switch (op)
+        {
+        case DW_OP_addr:
+            {
+                const addr_t file_addr = opcodes.GetAddress (&offset);
+                Address so_addr;
+                if (!sc.module_sp || !sc.module_sp->ResolveFileAddress (file_addr, so_addr))
+                    return Fail ("couldn't resolve a global's address");
+                const addr_t load_addr = so_addr.GetLoadAddress (target);
+                if (load_addr == LLDB_INVALID_ADDRESS)
+                    return Fail ("global isn't loaded");
+                location.kind = ValueLocation::eKindMemory;
+                location.address.AppendConstant (load_addr);
+                location.offset = 0;
+            }
+            break;
+
+        case DW_OP_fbreg:
+            {
+                reg_offset = opcodes.GetSLEB128 (&offset);
+                if (!LowerFrameBase (sc, location))
+                    return false;
+                location.offset += reg_offset;
+            }
+            break;
+
+        case DW_OP_bregx:
+            reg = opcodes.GetULEB128 (&offset);
+            reg_offset = opcodes.GetSLEB128 (&offset);
+            break;
+
+        case DW_OP_regx:
+            reg = opcodes.GetULEB128 (&offset);
+            is_memory = false;
+            break;
+
+        default:
+            if (op >= DW_OP_breg0 && op <= DW_OP_breg31)
+            {
+                reg = op - DW_OP_breg0;
+                reg_offset = opcodes.GetSLEB128 (&offset);
+            }
+            else if (op >= DW_OP_reg0 && op <= DW_OP_reg31)
+            {
+                reg = op - DW_OP_reg0;
+                is_memory = false;
+            }
+            else
+                return Fail ("unsupported DWARF location");
+            break;
+        }
+
+        // Anything after the first operation (pieces, TLS lookups, stack
+        // values...) is beyond what we lower.
+        if (opcodes.ValidOffset (offset))
+            return Fail ("unsupported DWARF location");
+
+        if (reg != LLDB_INVALID_REGNUM)
+        {
+            uint32_t lldb_reg;
+            if (!ConvertRegister (reg_kind, reg, lldb_reg))
+                return false;
+            if (is_memory)
+            {
+                location.kind = ValueLocation::eKindMemory;
+                location.address.AppendRegister (lldb_reg);
+                location.offset = reg_offset;
+            }
+            else
+            {
+                location.kind = ValueLocation::eKindRegister;
+                location.reg_num = lldb_reg;
+            }
+        }
+        return true;
+    }
+
+    bool
+    LowerFrameBase (const SymbolContext &sc, ValueLocation &location)
+    {
+        if (sc.function == NULL)
+            return Fail ("frame base without a function");
+        DWARFExpression &frame_base = sc.function->GetFrameBaseExpression();
+        if (!frame_base.IsValid())
+            return Fail ("function has no frame base");
+
+        Target *target = m_exe_ctx.GetTargetPtr();
+        addr_t loclist_base_load_addr = LLDB_INVALID_ADDRESS;
+        if (frame_base.IsLocationList())
+            loclist_base_load_addr = sc.function->GetAddressRange().GetBaseAddress().GetLoadAddress (target);
+
+        DataExtractor opcodes;
+        if (!frame_base.GetExpressionDataAtAddress (loclist_base_load_addr, m_pc, opcodes))
+            return Fail ("no frame base at this address");
+
+        lldb::offset_t offset = 0;
+        const uint8_t op = opcodes.GetU8 (&offset);
+        uint32_t reg = LLDB_INVALID_REGNUM;
+        uint32_t reg_kind = frame_base.GetRegisterKind();
+        int64_t reg_offset = 0;
+
+        if (op >= DW_OP_breg0 && op <= DW_OP_breg31)
+        {
+            reg = op - DW_OP_breg0;
+            reg_offset = opcodes.GetSLEB128 (&offset);
+        }
+        else if (op >= DW_OP_reg0 && op <= DW_OP_reg31)
+            reg = op - DW_OP_reg0;
+        else if (op == DW_OP_bregx)
+        {
+            reg = opcodes.GetULEB128 (&offset);
+            reg_offset = opcodes.GetSLEB128 (&offset);
+        }
+        else if (op == DW_OP_regx)
+            reg = opcodes.GetULEB128 (&offset);
+        else if (op == DW_OP_call_frame_cfa)
+        {
+            if (!GetCanonicalFrameAddressRule (reg_kind, reg, reg_offset))
+                return false;
+        }
+        else
+            return Fail ("unsupported frame base");
+
+        if (opcodes.ValidOffset (offset))
+            return Fail ("unsupported frame base");
+
+        uint32_t lldb_reg;
+        if (!ConvertRegister (reg_kind, reg, lldb_reg))
+            return false;
+        location.kind = ValueLocation::eKindMemory;
+        location.address.AppendRegister (lldb_reg);
+        location.offset = reg_offset;
+        return true;
+    }
+
+    // DW_OP_call_frame_cfa frame bases need the CFA rule for the
+    // breakpoint's PC, which is fixed for every hit of the location.
+    bool
+    GetCanonicalFrameAddressRule (uint32_t &reg_kind, uint32_t &reg, int64_t &reg_offset)
+    {
+        StackFrame *frame = m_exe_ctx.GetFramePtr();
+        Thread *thread = m_exe_ctx.GetThreadPtr();
+        if (!m_sc.module_sp || thread == NULL)
+            return Fail ("no unwind information for the frame base");
+        ObjectFile *objfile = m_sc.module_sp->GetObjectFile();
+        if (objfile == NULL)
+            return Fail ("no unwind information for the frame base");
+
+        Address pc_addr (frame->GetFrameCodeAddress());
+        SymbolContext unwind_sc;
+        FuncUnwindersSP func_unwinders_sp (objfile->GetUnwindTable().GetFuncUnwindersContainingAddress (pc_addr, unwind_sc));
+        if (!func_unwinders_sp || unwind_sc.function == NULL)
+            return Fail ("no unwind information for the frame base");
+
+        const int func_offset = pc_addr.GetFileAddress() - unwind_sc.function->GetAddressRange().GetBaseAddress().GetFileAddress();
+        UnwindPlanSP unwind_plan_sp (func_unwinders_sp->GetUnwindPlanAtNonCallSite (*thread));
+        if (!unwind_plan_sp)
+            unwind_plan_sp = func_unwinders_sp->GetUnwindPlanAtCallSite (func_offset);
+        if (!unwind_plan_sp)
+            return Fail ("no unwind information for the frame base");
+
+        UnwindPlan::RowSP row_sp (unwind_plan_sp->GetRowForFunctionOffset (func_offset));
+        if (!row_sp)
+            return Fail ("no unwind information for the frame base");
+        reg_kind = unwind_plan_sp->GetRegisterKind();
+        reg = row_sp->GetCFARegister();
+        reg_offset = row_sp->GetCFAOffset();
+        return true;
+    }
+
+    //------------------------------------------------------------------
+    // Member and element selection
+    //------------------------------------------------------------------
+    void
+    FlushOffset (ValueLocation &location)
+    {
+        if (location.offset > 0)
+        {
+            location.address.AppendConstant (location.offset);
+            location.address.AppendOpcode (AgentExpression::eOpAdd);
+        }
+        else if (location.offset < 0)
+        {
+            location.address.AppendConstant (-location.offset);
+            location.address.AppendOpcode (AgentExpression::eOpSub);
+        }
+        location.offset = 0;
+    }
+
+    bool
+    LoadPointer (ValueLocation &location)
+    {
+        AgentExpression pointer;
+        ValueType type;
+        if (location.kind == ValueLocation::eKindRegister)
+            pointer.AppendRegister (location.reg_num);
+        else
+        {
+            FlushOffset (location);
+            pointer.AppendBytecode (location.address);
+            if (!pointer.AppendMemoryRead (m_exe_ctx.GetAddressByteSize()))
+                return Fail ("unsupported pointer size");
+        }
+        location.kind = ValueLocation::eKindMemory;
+        location.address.Clear();
+        location.address.AppendBytecode (pointer);
+        location.offset = 0;
+        return true;
+    }
+
+    bool
+    DereferenceIfReference (ValueLocation &location, ClangASTType &clang_type)
+    {
+        ClangASTType referenced_type;
+        if (!clang_type.GetCanonicalType().IsReferenceType (&referenced_type))
+            return true;
+        if (!LoadPointer (location))
+            return false;
+        clang_type = referenced_type;
+        return true;
+    }
+
+    bool
+    SelectMember (ValueLocation &location, ClangASTType &clang_type)
+    {
+        std::string member_name;
+        if (!AcceptIdentifier (member_name))
+            return Fail ("expected a member name");
+        if (location.kind != ValueLocation::eKindMemory)
+            return Fail ("member of a register value");
+
+        ClangASTType record_type (clang_type.GetCanonicalType());
+        if ((record_type.GetTypeInfo() & ClangASTType::eTypeIsStructUnion) == 0)
+            return Fail ("member access on a non-aggregate");
+
+        ClangASTType member_type;
+        uint64_t bit_offset = 0;
+        uint32_t bitfield_bit_size = 0;
+        bool is_bitfield = false;
+        const uint32_t idx = record_type.GetIndexOfFieldWithName (member_name.c_str(),
+                                                                  &member_type,
+                                                                  &bit_offset,
+                                                                  &bitfield_bit_size,
+                                                                  &is_bitfield);
+        if (idx == UINT32_MAX)
+            return Fail ("member isn't a direct field");
+        if (is_bitfield || (bit_offset % 8) != 0)
+            return Fail ("bitfield members aren't supported");
+        location.offset += bit_offset / 8;
+        clang_type = member_type;
+        return true;
+    }
+
+    bool
+    SelectElement (ValueLocation &location, ClangASTType &clang_type)
+    {
+        SkipSpaces();
+        if (m_pos >= m_text.size() || !isdigit (m_text[m_pos]))
+            return Fail ("only constant subscripts are supported");
+        const char *start = m_text.c_str() + m_pos;
+        char *end = NULL;
+        const uint64_t index = ::strtoull (start, &end, 0);
+        m_pos += end - start;
+        if (!Accept ("]"))
+            return Fail ("expected ']'");
+
+        ClangASTType element_type;
+        ClangASTType canonical_type (clang_type.GetCanonicalType());
+        if (canonical_type.IsArrayType (&element_type, NULL, NULL))
+        {
+            if (location.kind != ValueLocation::eKindMemory)
+                return Fail ("array in a register");
+        }
+        else if (canonical_type.IsPointerType (&element_type))
+        {
+            if (!LoadPointer (location))
+                return false;
+        }
+        else
+            return Fail ("subscript of a non-array");
+
+        const uint64_t element_size = element_type.GetByteSize();
+        if (element_size == 0)
+            return Fail ("subscript of an incomplete type");
+        location.offset += index * element_size;
+        clang_type = element_type;
+        return true;
+    }
+
+    bool
+    LoadValue (ValueLocation &location, const ClangASTType &clang_type, AgentExpression &code, ValueType &type)
+    {
+        ClangASTType canonical_type (clang_type.GetCanonicalType());
+        const uint32_t type_info = canonical_type.GetTypeInfo();
+        if (type_info & ClangASTType::eTypeIsPointer)
+        {
+            type.byte_size = m_exe_ctx.GetAddressByteSize();
+            type.is_signed = false;
+        }
+        else
+        {
+            uint64_t count = 0;
+            switch (canonical_type.GetEncoding (count))
+            {
+            case eEncodingSint: type.is_signed = true; break;
+            case eEncodingUint: type.is_signed = false; break;
+            default:
+                return Fail ("only integer and pointer values are supported");
+            }
+            type.byte_size = canonical_type.GetByteSize();
+        }
+
+        switch (type.byte_size)
+        {
+        case 1: case 2: case 4: case 8: break;
+        default:
+            return Fail ("unsupported value size");
+        }
+
+        if (location.kind == ValueLocation::eKindRegister)
+            code.AppendRegister (location.reg_num);
+        else
+        {
+            FlushOffset (location);
+            code.AppendBytecode (location.address);
+            code.AppendMemoryRead (type.byte_size);
+        }
+
+        // Registers hold garbage above the value's size, and memory reads
+        // zero extend, so normalize to the value's 64 bit representation.
+        if (type.byte_size < 8)
+        {
+            if (type.is_signed)
+                code.AppendExtend (AgentExpression::eOpExt, type.byte_size * 8);
+            else if (location.kind == ValueLocation::eKindRegister)
+                code.AppendExtend (AgentExpression::eOpZeroExt, type.byte_size * 8);
+        }
+        return true;
+    }
+
+    //------------------------------------------------------------------
+    // Code generation
+    //------------------------------------------------------------------
+    static void
+    EmitConversion (const ValueType &from, const ValueType &to, AgentExpression &expr)
+    {
+        // Values are already extended to 64 bits according to their own
+        // type; the only conversion that changes bits is a signed value
+        // being compared or combined as a 32 bit unsigned one.
+        if (to.byte_size < 8 && !to.is_signed && from.is_signed)
+            expr.AppendExtend (AgentExpression::eOpZeroExt, to.byte_size * 8);
+    }
+
+    static bool
+    IsComparison (const std::string &op)
+    {
+        return op == "==" || op == "!=" || op == "<" || op == ">" || op == "<=" || op == ">=";
+    }
+
+    // The usual arithmetic conversions, restricted to integers.
+    static ValueType
+    GetCommonType (const ValueType &lhs_type, const ValueType &rhs_type)
+    {
+        ValueType common;
+        common.byte_size = std::max<uint32_t> (4, std::max (lhs_type.byte_size, rhs_type.byte_size));
+        common.is_signed = !((!lhs_type.is_signed && lhs_type.byte_size == common.byte_size) ||
+                             (!rhs_type.is_signed && rhs_type.byte_size == common.byte_size));
+        return common;
+    }
+
+    // Type the tree bottom up before emitting anything, so conversions can
+    // be emitted in place and jump targets stay absolute.
+    static void
+    AssignTypes (ConditionNode &node)
+    {
+        if (node.lhs)
+            AssignTypes (*node.lhs);
+        if (node.rhs)
+            AssignTypes (*node.rhs);
+        switch (node.kind)
+        {
+        case ConditionNode::eKindLeaf:
+            break;
+        case ConditionNode::eKindLogicalNot:
+        case ConditionNode::eKindLogicalAnd:
+        case ConditionNode::eKindLogicalOr:
+            node.type = ValueType (4, true);
+            break;
+        case ConditionNode::eKindBinary:
+            if (IsComparison (node.op))
+                node.type = ValueType (4, true);
+            else
+                node.type = GetCommonType (node.lhs->type, node.rhs->type);
+            break;
+        }
+    }
+
+    bool
+    Emit (ConditionNode &root, AgentExpression &expr)
+    {
+        AssignTypes (root);
+        return EmitNode (root, expr);
+    }
+
+    bool
+    EmitNode (ConditionNode &node, AgentExpression &expr)
+    {
+        switch (node.kind)
+        {
+        case ConditionNode::eKindLeaf:
+            expr.AppendBytecode (node.code);
+            return true;
+
+        case ConditionNode::eKindLogicalNot:
+            if (!EmitNode (*node.lhs, expr))
+                return false;
+            expr.AppendOpcode (AgentExpression::eOpLogNot);
+            return true;
+
+        case ConditionNode::eKindLogicalAnd:
+        case ConditionNode::eKindLogicalOr:
+            {
+                // Short circuit just like C does, so "p && p->x" never reads
+                // through a NULL pointer:
+                //   lhs; [log_not;] if_goto short; rhs; log_not; log_not; goto end;
+                //   short: const (0 for &&, 1 for ||); end:
+                const bool is_and = node.kind == ConditionNode::eKindLogicalAnd;
+                if (!EmitNode (*node.lhs, expr))
+                    return false;
+                if (is_and)
+                    expr.AppendOpcode (AgentExpression::eOpLogNot);
+                const size_t short_circuit = expr.AppendJump (AgentExpression::eOpIfGoto);
+                if (!EmitNode (*node.rhs, expr))
+                    return false;
+                expr.AppendOpcode (AgentExpression::eOpLogNot);
+                expr.AppendOpcode (AgentExpression::eOpLogNot);
+                const size_t end = expr.AppendJump (AgentExpression::eOpGoto);
+                expr.PatchJump (short_circuit);
+                expr.AppendConstant (is_and ? 0 : 1);
+                expr.PatchJump (end);
+                return true;
+            }
+
+        case ConditionNode::eKindBinary:
+            break;
+        }
+
+        const ValueType common (GetCommonType (node.lhs->type, node.rhs->type));
+        if (!EmitNode (*node.lhs, expr))
+            return false;
+        EmitConversion (node.lhs->type, common, expr);
+        if (!EmitNode (*node.rhs, expr))
+            return false;
+        EmitConversion (node.rhs->type, common, expr);
+
+        const uint8_t less = common.is_signed ? AgentExpression::eOpLessSigned : AgentExpression::eOpLessUnsigned;
+        const std::string &op = node.op;
+        if (op == "==")
+            expr.AppendOpcode (AgentExpression::eOpEqual);
+        else if (op == "!=")
+        {
+            expr.AppendOpcode (AgentExpression::eOpEqual);
+            expr.AppendOpcode (AgentExpression::eOpLogNot);
+        }
+        else if (op == "<")
+            expr.AppendOpcode (less);
+        else if (op == ">")
+        {
+            expr.AppendOpcode (AgentExpression::eOpSwap);
+            expr.AppendOpcode (less);
+        }
+        else if (op == "<=")
+        {
+            expr.AppendOpcode (AgentExpression::eOpSwap);
+            expr.AppendOpcode (less);
+            expr.AppendOpcode (AgentExpression::eOpLogNot);
+        }
+        else if (op == ">=")
+        {
+            expr.AppendOpcode (less);
+            expr.AppendOpcode (AgentExpression::eOpLogNot);
+        }
+        else
+        {
+            if (op == "&")
+                expr.AppendOpcode (AgentExpression::eOpBitAnd);
+            else if (op == "|")
+                expr.AppendOpcode (AgentExpression::eOpBitOr);
+            else if (op == "^")
+                expr.AppendOpcode (AgentExpression::eOpBitXor);
+            else if (op == "+")
+                expr.AppendOpcode (AgentExpression::eOpAdd);
+            else if (op == "-")
+                expr.AppendOpcode (AgentExpression::eOpSub);
+            else if (op == "*")
+                expr.AppendOpcode (AgentExpression::eOpMul);
+            else
+                return Fail ("unsupported operator");
+
+            // Keep the result in its type's 64 bit representation.
+            if (common.byte_size < 8)
+                expr.AppendExtend (common.is_signed ? AgentExpression::eOpExt : AgentExpression::eOpZeroExt,
+                                   common.byte_size * 8);
+        }
+        return true;
+    }
+
+    std::string m_text;
+    size_t m_pos;
+    uint32_t m_depth;
+    ExecutionContext &m_exe_ctx;
+    Error &m_error;
+    addr_t m_pc;
+    SymbolContext m_sc;
+};
+
+uint64_t
+ReadBigEndian (const std::vector<uint8_t> &opcodes, size_t &pc, size_t byte_size, bool &success)
+{
+    if (pc + byte_size > opcodes.size())
+    {
+        success = false;
+        return 0;
+    }
+    uint64_t value = 0;
+    for (size_t i = 0; i < byte_size; ++i)
+        value = (value << 8) | opcodes[pc++];
+    return value;
+}
+
+} // anonymous namespace
+
+AgentExpression::AgentExpression () :
+    m_opcodes (),
+    m_process_unique_id (0)
+{
+}
+
+AgentExpression::~AgentExpression ()
+{
+}
+
+void
+AgentExpression::Clear ()
+{
+    m_opcodes.clear();
+    m_process_unique_id = 0;
+}
+
+bool
+AgentExpression::Compile (const char *condition, ExecutionContext &exe_ctx, Error &error)
+{
+    Clear();
+    Process *process = exe_ctx.GetProcessPtr();
+    if (process)
+        m_process_unique_id = process->GetUniqueID();
+    if (condition == NULL || condition[0] == '\0')
+    {
+        error.SetErrorString ("empty condition");
+        return false;
+    }
+
+    ConditionCompiler compiler (condition, exe_ctx, error);
+    if (!compiler.Compile (*this))
+    {
+        m_opcodes.clear();
+        return false;
+    }
+    return true;
+}
+
+void
+AgentExpression::AppendOpcode (uint8_t opcode)
+{
+    m_opcodes.push_back (opcode);
+}
+
+void
+AgentExpression::AppendConstant (uint64_t value)
+{
+    size_t byte_size;
+    if (value <= UINT8_MAX)
+    {
+        m_opcodes.push_back (eOpConst8);
+        byte_size = 1;
+    }
+    else if (value <= UINT16_MAX)
+    {
+        m_opcodes.push_back (eOpConst16);
+        byte_size = 2;
+    }
+    else if (value <= UINT32_MAX)
+    {
+        m_opcodes.push_back (eOpConst32);
+        byte_size = 4;
+    }
+    else
+    {
+        m_opcodes.push_back (eOpConst64);
+        byte_size = 8;
+    }
+    for (size_t i = byte_size; i > 0; --i)
+        m_opcodes.push_back ((value >> ((i - 1) * 8)) & 0xff);
+}
+
+void
+AgentExpression::AppendRegister (uint32_t reg_num)
+{
+    m_opcodes.push_back (eOpReg);
+    m_opcodes.push_back ((reg_num >> 8) & 0xff);
+    m_opcodes.push_back (reg_num & 0xff);
+}
+
+void
+AgentExpression::AppendExtend (uint8_t opcode, uint32_t bit_size)
+{
+    m_opcodes.push_back (opcode);
+    m_opcodes.push_back (bit_size);
+}
+
+bool
+AgentExpression::AppendMemoryRead (uint32_t byte_size)
+{
+    switch (byte_size)
+    {
+    case 1: m_opcodes.push_back (eOpRef8); return true;
+    case 2: m_opcodes.push_back (eOpRef16); return true;
+    case 4: m_opcodes.push_back (eOpRef32); return true;
+    case 8: m_opcodes.push_back (eOpRef64); return true;
+    default: break;
+    }
+    return false;
+}
+
+void
+AgentExpression::AppendBytecode (const AgentExpression &rhs)
+{
+    m_opcodes.insert (m_opcodes.end(), rhs.m_opcodes.begin(), rhs.m_opcodes.end());
+}
+
+size_t
+AgentExpression::AppendJump (uint8_t opcode)
+{
+    m_opcodes.push_back (opcode);
+    const size_t operand_offset = m_opcodes.size();
+    m_opcodes.push_back (0);
+    m_opcodes.push_back (0);
+    return operand_offset;
+}
+
+void
+AgentExpression::PatchJump (size_t operand_offset)
+{
+    // Jump targets are absolute offsets from the start of the bytecode.
+    const size_t target = m_opcodes.size();
+    m_opcodes[operand_offset] = (target >> 8) & 0xff;
+    m_opcodes[operand_offset + 1] = target & 0xff;
+}
+
+bool
+AgentExpression::Evaluate (ExecutionContext &exe_ctx, uint64_t &result, Error &error) const
+{
+    StackFrame *frame = exe_ctx.GetFramePtr();
+    Process *process = exe_ctx.GetProcessPtr();
+    if (frame == NULL || process == NULL)
+    {
+        error.SetErrorString ("no frame to evaluate the condition in");
+        return false;
+    }
+    RegisterContextSP reg_ctx_sp (frame->GetRegisterContext());
+    if (!reg_ctx_sp)
+    {
+        error.SetErrorString ("no register context");
+        return false;
+    }
+
+    std::vector<uint64_t> stack;
+    stack.reserve (16);
+    size_t pc = 0;
+    bool success = true;
+
+    for (size_t steps = 0; steps < k_max_steps; ++steps)
+    {
+        if (pc >= m_opcodes.size())
+            break;
+        const uint8_t op = m_opcodes[pc++];
+
+        // Stack depth required by each operation.
+        size_t pops = 0;
+        switch (op)
+        {
+        case eOpAdd: case eOpSub: case eOpMul: case eOpBitAnd: case eOpBitOr:
+        case eOpBitXor: case eOpEqual: case eOpLessSigned: case eOpLessUnsigned:
+        case eOpSwap:
+            pops = 2;
+            break;
+        case eOpLogNot: case eOpBitNot: case eOpExt: case eOpZeroExt:
+        case eOpRef8: case eOpRef16: case eOpRef32: case eOpRef64:
+        case eOpIfGoto: case eOpEnd: case eOpDup: case eOpPop:
+            pops = 1;
+            break;
+        default:
+            break;
+        }
+        if (stack.size() < pops)
+        {
+            error.SetErrorString ("agent expression stack underflow");
+            return false;
+        }
+        if (stack.size() >= k_max_stack_depth)
+        {
+            error.SetErrorString ("agent expression stack overflow");
+            return false;
+        }
+
+        uint64_t a, b;
+        switch (op)
+        {
+        case eOpAdd: b = stack.back(); stack.pop_back(); stack.back() += b; break;
+        case eOpSub: b = stack.back(); stack.pop_back(); stack.back() -= b; break;
+        case eOpMul: b = stack.back(); stack.pop_back(); stack.back() *= b; break;
+        case eOpBitAnd: b = stack.back(); stack.pop_back(); stack.back() &= b; break;
+        case eOpBitOr: b = stack.back(); stack.pop_back(); stack.back() |= b; break;
+        case eOpBitXor: b = stack.back(); stack.pop_back(); stack.back() ^= b; break;
+        case eOpBitNot: stack.back() = ~stack.back(); break;
+        case eOpLogNot: stack.back() = stack.back() == 0; break;
+        case eOpEqual:
+            b = stack.back(); stack.pop_back();
+            stack.back() = stack.back() == b;
+            break;
+        case eOpLessSigned:
+            b = stack.back(); stack.pop_back();
+            stack.back() = (int64_t)stack.back() < (int64_t)b;
+            break;
+        case eOpLessUnsigned:
+            b = stack.back(); stack.pop_back();
+            stack.back() = stack.back() < b;
+            break;
+
+        case eOpExt:
+        case eOpZeroExt:
+            {
+                const uint64_t bits = ReadBigEndian (m_opcodes, pc, 1, success);
+                if (bits > 0 && bits < 64)
+                {
+                    const uint64_t mask = (1ull << bits) - 1;
+                    a = stack.back() & mask;
+                    if (op == eOpExt && (a & (1ull << (bits - 1))))
+                        a |= ~mask;
+                    stack.back() = a;
+                }
+            }
+            break;
+
+        case eOpRef8:
+        case eOpRef16:
+        case eOpRef32:
+        case eOpRef64:
+            {
+                const size_t byte_size = 1u << (op - eOpRef8);
+                Error read_error;
+                a = process->ReadUnsignedIntegerFromMemory (stack.back(), byte_size, 0, read_error);
+                if (read_error.Fail())
+                {
+                    error.SetErrorStringWithFormat ("couldn't read %" PRIu64 " bytes at 0x%" PRIx64,
+                                                    (uint64_t)byte_size,
+                                                    stack.back());
+                    return false;
+                }
+                stack.back() = a;
+            }
+            break;
+
+        case eOpIfGoto:
+        case eOpGoto:
+            {
+                const size_t target = ReadBigEndian (m_opcodes, pc, 2, success);
+                bool take = true;
+                if (op == eOpIfGoto)
+                {
+                    take = stack.back() != 0;
+                    stack.pop_back();
+                }
+                if (take)
+                    pc = target;
+            }
+            break;
+
+        case eOpConst8:  stack.push_back (ReadBigEndian (m_opcodes, pc, 1, success)); break;
+        case eOpConst16: stack.push_back (ReadBigEndian (m_opcodes, pc, 2, success)); break;
+        case eOpConst32: stack.push_back (ReadBigEndian (m_opcodes, pc, 4, success)); break;
+        case eOpConst64: stack.push_back (ReadBigEndian (m_opcodes, pc, 8, success)); break;
+
+        case eOpReg:
+            {
+                const uint32_t reg_num = ReadBigEndian (m_opcodes, pc, 2, success);
+                const RegisterInfo *reg_info = success ? reg_ctx_sp->GetRegisterInfoAtIndex (reg_num) : NULL;
+                RegisterValue reg_value;
+                if (reg_info == NULL || !reg_ctx_sp->ReadRegister (reg_info, reg_value))
+                {
+                    error.SetErrorStringWithFormat ("couldn't read register %u", reg_num);
+                    return false;
+                }
+                bool reg_success = false;
+                stack.push_back (reg_value.GetAsUInt64 (0, &reg_success));
+                if (!reg_success)
+                {
+                    error.SetErrorStringWithFormat ("register %u isn't an integer register", reg_num);
+                    return false;
+                }
+            }
+            break;
+
+        case eOpEnd:
+            result = stack.back();
+            return true;
+
+        case eOpDup: stack.push_back (stack.back()); break;
+        case eOpPop: stack.pop_back(); break;
+        case eOpSwap: std::swap (stack[stack.size() - 1], stack[stack.size() - 2]); break;
+
+        default:
+            error.SetErrorStringWithFormat ("unsupported agent expression opcode 0x%2.2x", op);
+            return false;
+        }
+
+        if (!success)
+        {
+            error.SetErrorString ("truncated agent expression");
+            return false;
+        }
+    }
+    error.SetErrorString ("agent expression didn't terminate");
+    return false;
+}
+
+void
+AgentExpression::Dump (Stream *s) const
+{
+    size_t pc = 0;
+    bool success = true;
+    while (pc < m_opcodes.size() && success)
+    {
+        const uint8_t op = m_opcodes[pc++];
+        if (pc > 1)
+            s->PutCString ("; ");
+        switch (op)
+        {
+        case eOpAdd:          s->PutCString ("add"); break;
+        case eOpSub:          s->PutCString ("sub"); break;
+        case eOpMul:          s->PutCString ("mul"); break;
+        case eOpLogNot:       s->PutCString ("log_not"); break;
+        case eOpBitAnd:       s->PutCString ("bit_and"); break;
+        case eOpBitOr:        s->PutCString ("bit_or"); break;
+        case eOpBitXor:       s->PutCString ("bit_xor"); break;
+        case eOpBitNot:       s->PutCString ("bit_not"); break;
+        case eOpEqual:        s->PutCString ("equal"); break;
+        case eOpLessSigned:   s->PutCString ("less_signed"); break;
+        case eOpLessUnsigned: s->PutCString ("less_unsigned"); break;
+        case eOpExt:          s->Printf ("ext %" PRIu64, ReadBigEndian (m_opcodes, pc, 1, success)); break;
+        case eOpZeroExt:      s->Printf ("zero_ext %" PRIu64, ReadBigEndian (m_opcodes, pc, 1, success)); break;
+        case eOpRef8:         s->PutCString ("ref8"); break;
+        case eOpRef16:        s->PutCString ("ref16"); break;
+        case eOpRef32:        s->PutCString ("ref32"); break;
+        case eOpRef64:        s->PutCString ("ref64"); break;
+        case eOpIfGoto:       s->Printf ("if_goto %" PRIu64, ReadBigEndian (m_opcodes, pc, 2, success)); break;
+        case eOpGoto:         s->Printf ("goto %" PRIu64, ReadBigEndian (m_opcodes, pc, 2, success)); break;
+        case eOpConst8:       s->Printf ("const8 0x%" PRIx64, ReadBigEndian (m_opcodes, pc, 1, success)); break;
+        case eOpConst16:      s->Printf ("const16 0x%" PRIx64, ReadBigEndian (m_opcodes, pc, 2, success)); break;
+        case eOpConst32:      s->Printf ("const32 0x%" PRIx64, ReadBigEndian (m_opcodes, pc, 4, success)); break;
+        case eOpConst64:      s->Printf ("const64 0x%" PRIx64, ReadBigEndian (m_opcodes, pc, 8, success)); break;
+        case eOpReg:          s->Printf ("reg %" PRIu64, ReadBigEndian (m_opcodes, pc, 2, success)); break;
+        case eOpEnd:          s->PutCString ("end"); break;
+        case eOpDup:          s->PutCString ("dup"); break;
+        case eOpPop:          s->PutCString ("pop"); break;
+        case eOpSwap:         s->PutCString ("swap"); break;
+        default:              s->Printf ("0x%2.2x", op); break;
+        }
+    }
+}
@@ -67,6 +67,8 @@
 #include "llvm/Support/Host.h"
 #include "llvm/Support/Signals.h"
 
+#include <atomic>
+
 using namespace clang;
 using namespace llvm;
 using namespace lldb_private;
@@ -455,6 +457,11 @@ static bool FindFunctionInModule (ConstString &mangled_name,
     return false;
 }
 
+// How many expressions were run by the IR interpreter, and how many had
+// to be JIT compiled into the inferior, for the expression log.
+static std::atomic<uint32_t> g_num_interpreted_expressions (0);
+static std::atomic<uint32_t> g_num_jitted_expressions (0);
+
 Error
 ClangExpressionParser::PrepareForExecution (lldb::addr_t &func_addr, 
                                             lldb::addr_t &func_end,
@@ -543,6 +550,19 @@ ClangExpressionParser::PrepareForExecution (lldb::addr_t &func_addr,
             return err;
         }
         
+        const bool will_interpret = can_interpret && execution_policy != eExecutionPolicyAlways;
+        const uint32_t num_interpreted = will_interpret ? ++g_num_interpreted_expressions : g_num_interpreted_expressions.load();
+        const uint32_t num_jitted = will_interpret ? g_num_jitted_expressions.load() : ++g_num_jitted_expressions;
+        
+        if (log)
+            log->Printf("%s expression %s (%u of %u expressions interpreted)%s%s",
+                        will_interpret ? "Interpreting" : "JIT compiling",
+                        function_name.AsCString(),
+                        num_interpreted,
+                        num_interpreted + num_jitted,
+                        can_interpret ? "" : ": ",
+                        can_interpret ? "" : interpret_error.AsCString());
+        
         if (execution_policy == eExecutionPolicyAlways || !can_interpret)
         {
             if (m_expr.NeedsValidation() && process)
@@ -28,6 +28,7 @@
 #include "lldb/Expression/ClangExpressionParser.h"
 #include "lldb/Expression/ClangFunction.h"
 #include "lldb/Expression/ClangUserExpression.h"
+#include "lldb/Expression/ClangUserExpressionCache.h"
 #include "lldb/Expression/ExpressionSourceCode.h"
 #include "lldb/Expression/IRExecutionUnit.h"
 #include "lldb/Expression/IRInterpreter.h"
@@ -56,6 +57,7 @@ ClangUserExpression::ClangUserExpression (const char *expr,
                                           lldb::LanguageType language,
                                           ResultType desired_type) :
     ClangExpression (),
+    m_block (NULL),
     m_stack_frame_bottom (LLDB_INVALID_ADDRESS),
     m_stack_frame_top (LLDB_INVALID_ADDRESS),
     m_expr_text (expr),
@@ -332,7 +334,10 @@ ClangUserExpression::InstallContext (ExecutionContext &exe_ctx)
     lldb::StackFrameSP frame_sp = exe_ctx.GetFrameSP();
     
     if (frame_sp)
+    {
         m_address = frame_sp->GetFrameCodeAddress();
+        m_block = frame_sp->GetSymbolContext(lldb::eSymbolContextBlock).block;
+    }
 }
 
 bool
@@ -355,8 +360,14 @@ ClangUserExpression::LockAndCheckContext (ExecutionContext &exe_ctx,
     {
         if (!frame_sp)
             return false;
-        else
-            return (0 == Address::CompareLoadAddress(m_address, frame_sp->GetFrameCodeAddress(), target_sp.get()));
+        if (0 == Address::CompareLoadAddress(m_address, frame_sp->GetFrameCodeAddress(), target_sp.get()))
+            return true;
+        // The Materializer looks variables up again in the current frame
+        // each time the expression runs, so the expression is good anywhere
+        // in the lexical block it was parsed in.
+        if (m_block != NULL)
+            return m_block == frame_sp->GetSymbolContext(lldb::eSymbolContextBlock).block;
+        return false;
     }
     
     return true;
@@ -951,16 +962,24 @@ ClangUserExpression::Evaluate (ExecutionContext &exe_ctx,
     if (process == NULL || !process->CanJIT())
         execution_policy = eExecutionPolicyNever;
     
-    ClangUserExpressionSP user_expression_sp (new ClangUserExpression (expr_cstr, expr_prefix, language, desired_type));
+    // If this expression was parsed before in the same context, all it
+    // needs is to have its variables materialized again.
+    Target *target = exe_ctx.GetTargetPtr();
+    ClangUserExpressionSP user_expression_sp;
+    if (target)
+        user_expression_sp = target->GetExpressionCache().Find (exe_ctx, expr_cstr, expr_prefix, language, desired_type, execution_policy);
+    const bool parsed = (bool)user_expression_sp;
+    if (!parsed)
+        user_expression_sp.reset (new ClangUserExpression (expr_cstr, expr_prefix, language, desired_type));
 
     StreamString error_stream;
         
     if (log)
-        log->Printf("== [ClangUserExpression::Evaluate] Parsing expression %s ==", expr_cstr);
+        log->Printf("== [ClangUserExpression::Evaluate] %s expression %s ==", parsed ? "Reusing parsed" : "Parsing", expr_cstr);
     
     const bool keep_expression_in_memory = true;
     
-    if (!user_expression_sp->Parse (error_stream, exe_ctx, execution_policy, keep_expression_in_memory))
+    if (!parsed && !user_expression_sp->Parse (error_stream, exe_ctx, execution_policy, keep_expression_in_memory))
     {
         if (error_stream.GetString().empty())
             error.SetErrorString ("expression failed to parse, unknown error");
@@ -969,6 +988,9 @@ ClangUserExpression::Evaluate (ExecutionContext &exe_ctx,
     }
     else
     {
+        if (!parsed && target)
+            target->GetExpressionCache().Insert (exe_ctx, expr_cstr, expr_prefix, language, desired_type, execution_policy, user_expression_sp);
+
         lldb::ClangExpressionVariableSP expr_result;
 
         if (execution_policy == eExecutionPolicyNever &&
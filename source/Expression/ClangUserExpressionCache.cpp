@@ -0,0 +1,183 @@
+//===-- ClangUserExpressionCache.cpp ----------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Expression/ClangUserExpressionCache.h"
+
+// C Includes
+#include <string.h>
+
+// C++ Includes
+// Other libraries and framework includes
+// Project includes
+#include "lldb/Core/Log.h"
+#include "lldb/Symbol/SymbolContext.h"
+#include "lldb/Target/ExecutionContext.h"
+#include "lldb/Target/Process.h"
+#include "lldb/Target/StackFrame.h"
+
+using namespace lldb;
+using namespace lldb_private;
+
+// Parsed expressions hold on to a Clang AST and JIT'ed code in the
+// inferior, so don't keep too many of them.
+static const size_t g_max_cached_expressions = 64;
+
+bool
+ClangUserExpressionCache::Key::operator < (const Key &rhs) const
+{
+    if (m_process_unique_id != rhs.m_process_unique_id)
+        return m_process_unique_id < rhs.m_process_unique_id;
+    if (m_block != rhs.m_block)
+        return m_block < rhs.m_block;
+    if (m_language != rhs.m_language)
+        return m_language < rhs.m_language;
+    if (m_desired_type != rhs.m_desired_type)
+        return m_desired_type < rhs.m_desired_type;
+    if (m_execution_policy != rhs.m_execution_policy)
+        return m_execution_policy < rhs.m_execution_policy;
+    const int text_cmp = m_text.compare (rhs.m_text);
+    if (text_cmp != 0)
+        return text_cmp < 0;
+    return m_prefix < rhs.m_prefix;
+}
+
+ClangUserExpressionCache::ClangUserExpressionCache () :
+    m_mutex (Mutex::eMutexTypeNormal),
+    m_entries (),
+    m_use_counter (0),
+    m_hit_count (0),
+    m_miss_count (0)
+{
+}
+
+ClangUserExpressionCache::~ClangUserExpressionCache ()
+{
+}
+
+bool
+ClangUserExpressionCache::CanCache (const char *expr_cstr)
+{
+    return expr_cstr != NULL && ::strchr (expr_cstr, '$') == NULL;
+}
+
+void
+ClangUserExpressionCache::MakeKey (ExecutionContext &exe_ctx,
+                                   const char *expr_cstr,
+                                   const char *expr_prefix,
+                                   lldb::LanguageType language,
+                                   ClangExpression::ResultType desired_type,
+                                   ExecutionPolicy execution_policy,
+                                   Key &key)
+{
+    key.m_text = expr_cstr;
+    key.m_prefix = expr_prefix ? expr_prefix : "";
+    key.m_language = language;
+    key.m_desired_type = desired_type;
+    key.m_execution_policy = execution_policy;
+    Process *process = exe_ctx.GetProcessPtr();
+    key.m_process_unique_id = process ? process->GetUniqueID() : 0;
+    StackFrame *frame = exe_ctx.GetFramePtr();
+    key.m_block = frame ? frame->GetSymbolContext(eSymbolContextBlock).block : NULL;
+}
+
+ClangUserExpression::ClangUserExpressionSP
+ClangUserExpressionCache::Find (ExecutionContext &exe_ctx,
+                                const char *expr_cstr,
+                                const char *expr_prefix,
+                                lldb::LanguageType language,
+                                ClangExpression::ResultType desired_type,
+                                ExecutionPolicy execution_policy)
+{
+    ClangUserExpression::ClangUserExpressionSP user_expression_sp;
+    if (!CanCache (expr_cstr))
+        return user_expression_sp;
+
+    Key key;
+    MakeKey (exe_ctx, expr_cstr, expr_prefix, language, desired_type, execution_policy, key);
+
+    Mutex::Locker locker (m_mutex);
+    collection::iterator pos = m_entries.find (key);
+    // The cache holds one reference; any other means the expression is
+    // still running (or was left on the stack of a thread after an
+    // error), and one expression can't be materialized twice at once.
+    if (pos != m_entries.end() &&
+        pos->second.m_expression_sp.use_count() == 1 &&
+        pos->second.m_expression_sp->MatchesContext (exe_ctx))
+    {
+        pos->second.m_last_use = ++m_use_counter;
+        user_expression_sp = pos->second.m_expression_sp;
+        ++m_hit_count;
+    }
+    else
+    {
+        ++m_miss_count;
+    }
+
+    Log *log (lldb_private::GetLogIfAllCategoriesSet (LIBLLDB_LOG_EXPRESSIONS));
+    if (log)
+        log->Printf ("ClangUserExpressionCache::Find (\"%s\") %s, %" PRIu64 " hits, %" PRIu64 " misses",
+                     expr_cstr,
+                     user_expression_sp ? "hit" : "miss",
+                     m_hit_count,
+                     m_miss_count);
+    return user_expression_sp;
+}
+
+void
+ClangUserExpressionCache::Insert (ExecutionContext &exe_ctx,
+                                  const char *expr_cstr,
+                                  const char *expr_prefix,
+                                  lldb::LanguageType language,
+                                  ClangExpression::ResultType desired_type,
+                                  ExecutionPolicy execution_policy,
+                                  const ClangUserExpression::ClangUserExpressionSP &user_expression_sp)
+{
+    if (!user_expression_sp || !CanCache (expr_cstr))
+        return;
+
+    Key key;
+    MakeKey (exe_ctx, expr_cstr, expr_prefix, language, desired_type, execution_policy, key);
+
+    Mutex::Locker locker (m_mutex);
+    collection::iterator pos = m_entries.find (key);
+    if (pos == m_entries.end() && m_entries.size() >= g_max_cached_expressions)
+    {
+        // Evict the least recently used expression.
+        collection::iterator oldest = m_entries.begin();
+        for (collection::iterator it = m_entries.begin(), end = m_entries.end(); it != end; ++it)
+        {
+            if (it->second.m_last_use < oldest->second.m_last_use)
+                oldest = it;
+        }
+        m_entries.erase (oldest);
+    }
+
+    Entry &entry = m_entries[key];
+    entry.m_expression_sp = user_expression_sp;
+    entry.m_last_use = ++m_use_counter;
+}
+
+void
+ClangUserExpressionCache::Clear ()
+{
+    // Destroying an expression frees its memory in the inferior, do that
+    // without holding the mutex.
+    collection entries;
+    {
+        Mutex::Locker locker (m_mutex);
+        entries.swap (m_entries);
+    }
+}
+
+size_t
+ClangUserExpressionCache::GetSize () const
+{
+    Mutex::Locker locker (m_mutex);
+    return m_entries.size();
+}
@@ -1184,6 +1184,21 @@ DWARFExpression::GetLocation (addr_t base_addr, addr_t pc, lldb::offset_t &offse
     return false;
 }
 
+bool
+DWARFExpression::GetExpressionDataAtAddress (addr_t loclist_base_load_addr, addr_t pc, DataExtractor &data)
+{
+    lldb::offset_t offset = 0;
+    lldb::offset_t length = 0;
+
+    if (GetLocation (loclist_base_load_addr, pc, offset, length) && length > 0)
+    {
+        data = DataExtractor (m_data, offset, length);
+        return true;
+    }
+    data.Clear();
+    return false;
+}
+
 bool
 DWARFExpression::DumpLocationForAddress (Stream *s,
                                          lldb::DescriptionLevel level,
@@ -20,10 +20,14 @@
 #include "llvm/IR/DataLayout.h"
 #include "llvm/IR/Function.h"
 #include "llvm/IR/Instructions.h"
+#include "llvm/IR/IntrinsicInst.h"
 #include "llvm/IR/Module.h"
+#include "llvm/Support/MathExtras.h"
 #include "llvm/Support/raw_ostream.h"
 
 #include <map>
+#include <vector>
+#include <string.h>
 
 using namespace llvm;
 
@@ -67,6 +71,7 @@ public:
     DataLayout                             &m_target_data;
     lldb_private::IRMemoryMap              &m_memory_map;
     const BasicBlock                       *m_bb;
+    const BasicBlock                       *m_prev_bb;
     BasicBlock::const_iterator              m_ii;
     BasicBlock::const_iterator              m_ie;
     
@@ -82,7 +87,9 @@ public:
                            lldb::addr_t stack_frame_bottom,
                            lldb::addr_t stack_frame_top) :
         m_target_data (target_data),
-        m_memory_map (memory_map)
+        m_memory_map (memory_map),
+        m_bb (NULL),
+        m_prev_bb (NULL)
     {
         m_byte_order = (target_data.isLittleEndian() ? lldb::eByteOrderLittle : lldb::eByteOrderBig);
         m_addr_byte_size = (target_data.getPointerSize(0));
@@ -98,6 +105,7 @@ public:
     
     void Jump (const BasicBlock *bb)
     {
+        m_prev_bb = m_bb;
         m_bb = bb;
         m_ii = m_bb->begin();
         m_ie = m_bb->end();
@@ -123,6 +131,25 @@ public:
     
     bool AssignToMatchType (lldb_private::Scalar &scalar, uint64_t u64value, Type *type)
     {
+        // Floating point values are passed around as their bit patterns,
+        // like everything else, so reinterpret them here.
+        if (type->isFloatTy())
+        {
+            uint32_t u32value = (uint32_t)u64value;
+            float float_value;
+            ::memcpy (&float_value, &u32value, sizeof(float_value));
+            scalar = float_value;
+            return true;
+        }
+        
+        if (type->isDoubleTy())
+        {
+            double double_value;
+            ::memcpy (&double_value, &u64value, sizeof(double_value));
+            scalar = double_value;
+            return true;
+        }
+        
         size_t type_size = m_target_data.getTypeStoreSize(type);
 
         switch (type_size)
@@ -428,6 +455,34 @@ static const char *memory_read_error                = "Interpreter couldn't read
 static const char *infinite_loop_error              = "Interpreter ran for too many cycles";
 //static const char *bad_result_error                 = "Result of expression is in bad memory";
 
+// Enough for expressions with small loops, while still catching runaway
+// ones quickly.
+static const uint32_t max_interpreted_instructions   = 65536;
+
+// memcpy, memmove and memset go through a buffer in lldb, so only
+// interpret the ones with a constant length that small; the others go to
+// the JIT.
+static const uint64_t max_interpreted_mem_intrinsic_length = 4096;
+
+// The interpreter moves values around as up to 64 bits of raw data, and
+// only knows the arithmetic for integers, pointers, float and double.
+static bool
+CanInterpretType (Type *type)
+{
+    switch (type->getTypeID())
+    {
+    default:
+        return true;
+    case Type::HalfTyID:
+    case Type::X86_FP80TyID:
+    case Type::FP128TyID:
+    case Type::PPC_FP128TyID:
+    case Type::X86_MMXTyID:
+    case Type::VectorTyID:
+        return false;
+    }
+}
+
 bool
 IRInterpreter::CanInterpret (llvm::Module &module,
                              llvm::Function &function,
@@ -473,6 +528,31 @@ IRInterpreter::CanInterpret (llvm::Module &module,
             case Instruction::Br:
             case Instruction::GetElementPtr:
                 break;
+            case Instruction::Call:
+                {
+                    // memcpy, memmove and memset are what Clang emits for
+                    // aggregate copies and initialization, and are easy to
+                    // do with the memory map.  Other calls need the JIT.
+                    if (!isa<MemIntrinsic>(ii))
+                    {
+                        if (log)
+                            log->Printf("Unsupported function call: %s", PrintValue(ii).c_str());
+                        error.SetErrorToGenericError();
+                        error.SetErrorString(unsupported_opcode_error);
+                        return false;
+                    }
+
+                    const ConstantInt *length = dyn_cast<ConstantInt>(cast<MemIntrinsic>(ii)->getLength());
+                    if (!length || length->getValue().ugt(max_interpreted_mem_intrinsic_length))
+                    {
+                        if (log)
+                            log->Printf("Unsupported memory intrinsic length: %s", PrintValue(ii).c_str());
+                        error.SetErrorToGenericError();
+                        error.SetErrorString(unsupported_operand_error);
+                        return false;
+                    }
+                }
+                break;
             case Instruction::ICmp:
                 {
                     ICmpInst *icmp_inst = dyn_cast<ICmpInst>(ii);
@@ -511,27 +591,48 @@ IRInterpreter::CanInterpret (llvm::Module &module,
                 break;
             case Instruction::And:
             case Instruction::AShr:
+            case Instruction::FAdd:
+            case Instruction::FCmp:
+            case Instruction::FDiv:
+            case Instruction::FMul:
+            case Instruction::FPExt:
+            case Instruction::FPToSI:
+            case Instruction::FPToUI:
+            case Instruction::FPTrunc:
+            case Instruction::FSub:
             case Instruction::IntToPtr:
             case Instruction::PtrToInt:
             case Instruction::Load:
             case Instruction::LShr:
             case Instruction::Mul:
             case Instruction::Or:
+            case Instruction::PHI:
             case Instruction::Ret:
             case Instruction::SDiv:
+            case Instruction::Select:
             case Instruction::SExt:
             case Instruction::Shl:
+            case Instruction::SIToFP:
             case Instruction::SRem:
             case Instruction::Store:
             case Instruction::Sub:
             case Instruction::Trunc:
             case Instruction::UDiv:
+            case Instruction::UIToFP:
             case Instruction::URem:
             case Instruction::Xor:
             case Instruction::ZExt:
                 break;
             }
             
+            if (!CanInterpretType(ii->getType()))
+            {
+                if (log)
+                    log->Printf("Unsupported result type: %s", PrintType(ii->getType()).c_str());
+                error.SetErrorString(unsupported_operand_error);
+                return false;
+            }
+            
             for (int oi = 0, oe = ii->getNumOperands();
                  oi != oe;
                  ++oi)
@@ -539,17 +640,12 @@ IRInterpreter::CanInterpret (llvm::Module &module,
                 Value *operand = ii->getOperand(oi);
                 Type *operand_type = operand->getType();
                 
-                switch (operand_type->getTypeID())
+                if (!CanInterpretType(operand_type))
                 {
-                default:
-                    break;
-                case Type::VectorTyID:
-                    {
-                        if (log)
-                            log->Printf("Unsupported operand type: %s", PrintType(operand_type).c_str());
-                        error.SetErrorString(unsupported_operand_error);
-                        return false;
-                    }
+                    if (log)
+                        log->Printf("Unsupported operand type: %s", PrintType(operand_type).c_str());
+                    error.SetErrorString(unsupported_operand_error);
+                    return false;
                 }
             }
         }
@@ -611,7 +707,7 @@ IRInterpreter::Interpret (llvm::Module &module,
     
     frame.Jump(function.begin());
     
-    while (frame.m_ii != frame.m_ie && (++num_insts < 4096))
+    while (frame.m_ii != frame.m_ie && (++num_insts < max_interpreted_instructions))
     {
         const Instruction *inst = frame.m_ii;
         
@@ -1098,6 +1194,482 @@ IRInterpreter::Interpret (llvm::Module &module,
                 }
             }
                 break;
+            case Instruction::FAdd:
+            case Instruction::FSub:
+            case Instruction::FMul:
+            case Instruction::FDiv:
+            {
+                Value *lhs = inst->getOperand(0);
+                Value *rhs = inst->getOperand(1);
+                
+                lldb_private::Scalar L;
+                lldb_private::Scalar R;
+                
+                if (!frame.EvaluateValue(L, lhs, module))
+                {
+                    if (log)
+                        log->Printf("Couldn't evaluate %s", PrintValue(lhs).c_str());
+                    error.SetErrorToGenericError();
+                    error.SetErrorString(bad_value_error);
+                    return false;
+                }
+                
+                if (!frame.EvaluateValue(R, rhs, module))
+                {
+                    if (log)
+                        log->Printf("Couldn't evaluate %s", PrintValue(rhs).c_str());
+                    error.SetErrorToGenericError();
+                    error.SetErrorString(bad_value_error);
+                    return false;
+                }
+                
+                // Do the arithmetic in the operands' own precision so the
+                // result matches what the target would have computed.
+                // (Scalar's operators don't do IEEE division by zero.)
+                lldb_private::Scalar result;
+                
+                if (inst->getType()->isFloatTy())
+                {
+                    float l = L.Float();
+                    float r = R.Float();
+                    
+                    switch (inst->getOpcode())
+                    {
+                        default:
+                        case Instruction::FAdd: result = l + r; break;
+                        case Instruction::FSub: result = l - r; break;
+                        case Instruction::FMul: result = l * r; break;
+                        case Instruction::FDiv: result = l / r; break;
+                    }
+                }
+                else
+                {
+                    double l = L.Double();
+                    double r = R.Double();
+                    
+                    switch (inst->getOpcode())
+                    {
+                        default:
+                        case Instruction::FAdd: result = l + r; break;
+                        case Instruction::FSub: result = l - r; break;
+                        case Instruction::FMul: result = l * r; break;
+                        case Instruction::FDiv: result = l / r; break;
+                    }
+                }
+                
+                frame.AssignValue(inst, result, module);
+                
+                if (log)
+                {
+                    log->Printf("Interpreted a %s", inst->getOpcodeName());
+                    log->Printf("  L : %s", frame.SummarizeValue(lhs).c_str());
+                    log->Printf("  R : %s", frame.SummarizeValue(rhs).c_str());
+                    log->Printf("  = : %s", frame.SummarizeValue(inst).c_str());
+                }
+            }
+                break;
+            case Instruction::FCmp:
+            {
+                const FCmpInst *fcmp_inst = dyn_cast<FCmpInst>(inst);
+                
+                if (!fcmp_inst)
+                {
+                    if (log)
+                        log->Printf("getOpcode() returns FCmp, but instruction is not an FCmpInst");
+                    error.SetErrorToGenericError();
+                    error.SetErrorString(interpreter_internal_error);
+                    return false;
+                }
+                
+                CmpInst::Predicate predicate = fcmp_inst->getPredicate();
+                
+                Value *lhs = inst->getOperand(0);
+                Value *rhs = inst->getOperand(1);
+                
+                lldb_private::Scalar L;
+                lldb_private::Scalar R;
+                
+                if (!frame.EvaluateValue(L, lhs, module))
+                {
+                    if (log)
+                        log->Printf("Couldn't evaluate %s", PrintValue(lhs).c_str());
+                    error.SetErrorToGenericError();
+                    error.SetErrorString(bad_value_error);
+                    return false;
+                }
+                
+                if (!frame.EvaluateValue(R, rhs, module))
+                {
+                    if (log)
+                        log->Printf("Couldn't evaluate %s", PrintValue(rhs).c_str());
+                    error.SetErrorToGenericError();
+                    error.SetErrorString(bad_value_error);
+                    return false;
+                }
+                
+                // Widening a float to a double is exact, so comparing the
+                // doubles gives the same answer for either type.
+                double l = L.Double();
+                double r = R.Double();
+                
+                // Unordered predicates are true, and ordered ones false,
+                // if either side is a NaN.
+                bool unordered = (l != l) || (r != r);
+                bool cmp_result = false;
+                
+                switch (predicate)
+                {
+                    default:
+                        return false;
+                    case CmpInst::FCMP_FALSE: cmp_result = false;                      break;
+                    case CmpInst::FCMP_OEQ:   cmp_result = !unordered && l == r;       break;
+                    case CmpInst::FCMP_OGT:   cmp_result = !unordered && l > r;        break;
+                    case CmpInst::FCMP_OGE:   cmp_result = !unordered && l >= r;       break;
+                    case CmpInst::FCMP_OLT:   cmp_result = !unordered && l < r;        break;
+                    case CmpInst::FCMP_OLE:   cmp_result = !unordered && l <= r;       break;
+                    case CmpInst::FCMP_ONE:   cmp_result = !unordered && l != r;       break;
+                    case CmpInst::FCMP_ORD:   cmp_result = !unordered;                 break;
+                    case CmpInst::FCMP_UNO:   cmp_result = unordered;                  break;
+                    case CmpInst::FCMP_UEQ:   cmp_result = unordered || l == r;        break;
+                    case CmpInst::FCMP_UGT:   cmp_result = unordered || l > r;         break;
+                    case CmpInst::FCMP_UGE:   cmp_result = unordered || l >= r;        break;
+                    case CmpInst::FCMP_ULT:   cmp_result = unordered || l < r;         break;
+                    case CmpInst::FCMP_ULE:   cmp_result = unordered || l <= r;        break;
+                    case CmpInst::FCMP_UNE:   cmp_result = unordered || l != r;        break;
+                    case CmpInst::FCMP_TRUE:  cmp_result = true;                       break;
+                }
+                
+                lldb_private::Scalar result(cmp_result);
+                
+                frame.AssignValue(inst, result, module);
+                
+                if (log)
+                {
+                    log->Printf("Interpreted an FCmpInst");
+                    log->Printf("  L : %s", frame.SummarizeValue(lhs).c_str());
+                    log->Printf("  R : %s", frame.SummarizeValue(rhs).c_str());
+                    log->Printf("  = : %s", frame.SummarizeValue(inst).c_str());
+                }
+            }
+                break;
+            case Instruction::FPExt:
+            case Instruction::FPTrunc:
+            case Instruction::FPToSI:
+            case Instruction::FPToUI:
+            case Instruction::SIToFP:
+            case Instruction::UIToFP:
+            {
+                const CastInst *cast_inst = dyn_cast<CastInst>(inst);
+                
+                if (!cast_inst)
+                {
+                    if (log)
+                        log->Printf("getOpcode() returns %s, but instruction is not a CastInst", inst->getOpcodeName());
+                    error.SetErrorToGenericError();
+                    error.SetErrorString(interpreter_internal_error);
+                    return false;
+                }
+                
+                Value *source = cast_inst->getOperand(0);
+                
+                lldb_private::Scalar S;
+                
+                if (!frame.EvaluateValue(S, source, module))
+                {
+                    if (log)
+                        log->Printf("Couldn't evaluate %s", PrintValue(source).c_str());
+                    error.SetErrorToGenericError();
+                    error.SetErrorString(bad_value_error);
+                    return false;
+                }
+                
+                Type *dest_type = cast_inst->getType();
+                lldb_private::Scalar result;
+                
+                switch (inst->getOpcode())
+                {
+                    default:
+                    case Instruction::FPExt:
+                    case Instruction::FPTrunc:
+                        if (dest_type->isFloatTy())
+                            result = S.Float();
+                        else
+                            result = S.Double();
+                        break;
+                    case Instruction::FPToSI:
+                        result = (long long)S.Double();
+                        break;
+                    case Instruction::FPToUI:
+                        result = (unsigned long long)S.Double();
+                        break;
+                    case Instruction::SIToFP:
+                        {
+                            // The scalar holds the source's bits zero extended.
+                            int64_t value = SignExtend64(S.GetRawBits64(0), source->getType()->getIntegerBitWidth());
+                            if (dest_type->isFloatTy())
+                                result = (float)value;
+                            else
+                                result = (double)value;
+                        }
+                        break;
+                    case Instruction::UIToFP:
+                        {
+                            uint64_t value = S.GetRawBits64(0);
+                            if (dest_type->isFloatTy())
+                                result = (float)value;
+                            else
+                                result = (double)value;
+                        }
+                        break;
+                }
+                
+                frame.AssignValue(inst, result, module);
+                
+                if (log)
+                {
+                    log->Printf("Interpreted a %s", inst->getOpcodeName());
+                    log->Printf("  Src : %s", frame.SummarizeValue(source).c_str());
+                    log->Printf("  =   : %s", frame.SummarizeValue(inst).c_str());
+                }
+            }
+                break;
+            case Instruction::Select:
+            {
+                const SelectInst *select_inst = dyn_cast<SelectInst>(inst);
+                
+                if (!select_inst)
+                {
+                    if (log)
+                        log->Printf("getOpcode() returns Select, but instruction is not a SelectInst");
+                    error.SetErrorToGenericError();
+                    error.SetErrorString(interpreter_internal_error);
+                    return false;
+                }
+                
+                const Value *condition = select_inst->getCondition();
+                
+                lldb_private::Scalar C;
+                
+                if (!frame.EvaluateValue(C, condition, module))
+                {
+                    if (log)
+                        log->Printf("Couldn't evaluate %s", PrintValue(condition).c_str());
+                    error.SetErrorToGenericError();
+                    error.SetErrorString(bad_value_error);
+                    return false;
+                }
+                
+                const Value *chosen = C.GetRawBits64(0) ? select_inst->getTrueValue() : select_inst->getFalseValue();
+                
+                lldb_private::Scalar V;
+                
+                if (!frame.EvaluateValue(V, chosen, module))
+                {
+                    if (log)
+                        log->Printf("Couldn't evaluate %s", PrintValue(chosen).c_str());
+                    error.SetErrorToGenericError();
+                    error.SetErrorString(bad_value_error);
+                    return false;
+                }
+                
+                frame.AssignValue(inst, V, module);
+                
+                if (log)
+                {
+                    log->Printf("Interpreted a SelectInst");
+                    log->Printf("  cond : %s", frame.SummarizeValue(condition).c_str());
+                    log->Printf("  =    : %s", frame.SummarizeValue(inst).c_str());
+                }
+            }
+                break;
+            case Instruction::PHI:
+            {
+                // The PHI nodes at the top of a block all take their values
+                // at once, as the edge from the previous block is taken, so
+                // read every incoming value before assigning any of them.
+                typedef std::vector <std::pair <const PHINode *, lldb_private::Scalar> > PHIValues;
+                
+                PHIValues phi_values;
+                BasicBlock::const_iterator pi;
+                
+                for (pi = frame.m_ii; pi != frame.m_ie; ++pi)
+                {
+                    const PHINode *phi_node = dyn_cast<PHINode>(pi);
+                    
+                    if (!phi_node)
+                        break;
+                    
+                    int incoming_index = frame.m_prev_bb ? phi_node->getBasicBlockIndex(frame.m_prev_bb) : -1;
+                    
+                    if (incoming_index < 0)
+                    {
+                        if (log)
+                            log->Printf("PHI node %s has no value for the previous block", PrintValue(phi_node).c_str());
+                        error.SetErrorToGenericError();
+                        error.SetErrorString(bad_value_error);
+                        return false;
+                    }
+                    
+                    const Value *incoming = phi_node->getIncomingValue(incoming_index);
+                    
+                    lldb_private::Scalar V;
+                    
+                    if (!frame.EvaluateValue(V, incoming, module))
+                    {
+                        if (log)
+                            log->Printf("Couldn't evaluate %s", PrintValue(incoming).c_str());
+                        error.SetErrorToGenericError();
+                        error.SetErrorString(bad_value_error);
+                        return false;
+                    }
+                    
+                    phi_values.push_back(std::make_pair(phi_node, V));
+                }
+                
+                for (PHIValues::iterator vi = phi_values.begin(), ve = phi_values.end();
+                     vi != ve;
+                     ++vi)
+                {
+                    frame.AssignValue(vi->first, vi->second, module);
+                    
+                    if (log)
+                    {
+                        log->Printf("Interpreted a PHINode");
+                        log->Printf("  = : %s", frame.SummarizeValue(vi->first).c_str());
+                    }
+                }
+                
+                frame.m_ii = pi;
+            }
+                continue;
+            case Instruction::Call:
+            {
+                const MemIntrinsic *mem_inst = dyn_cast<MemIntrinsic>(inst);
+                
+                if (!mem_inst)
+                {
+                    if (log)
+                        log->Printf("Can't interpret a call to anything but memcpy, memmove or memset");
+                    error.SetErrorToGenericError();
+                    error.SetErrorString(unsupported_opcode_error);
+                    return false;
+                }
+                
+                // The semantics of the memory intrinsics are:
+                //   Evaluate the destination pointer to get the region R
+                //   Evaluate the source pointer to get the region S, or the byte value V
+                //   Fill R with length bytes from S, or copies of V
+                
+                const Value *dest_operand = mem_inst->getRawDest();
+                const Value *length_operand = mem_inst->getLength();
+                
+                lldb_private::Scalar R;
+                lldb_private::Scalar L;
+                
+                if (!frame.EvaluateValue(R, dest_operand, module))
+                {
+                    if (log)
+                        log->Printf("Couldn't evaluate %s", PrintValue(dest_operand).c_str());
+                    error.SetErrorToGenericError();
+                    error.SetErrorString(bad_value_error);
+                    return false;
+                }
+                
+                if (!frame.EvaluateValue(L, length_operand, module))
+                {
+                    if (log)
+                        log->Printf("Couldn't evaluate %s", PrintValue(length_operand).c_str());
+                    error.SetErrorToGenericError();
+                    error.SetErrorString(bad_value_error);
+                    return false;
+                }
+                
+                lldb::addr_t dest = R.GetRawBits64(LLDB_INVALID_ADDRESS);
+                size_t length = L.GetRawBits64(0);
+                
+                if (length == 0)
+                {
+                    ++frame.m_ii;
+                    continue;
+                }
+                
+                // CanInterpret only lets through small constant lengths.
+                if (length > max_interpreted_mem_intrinsic_length)
+                {
+                    if (log)
+                        log->Printf("Memory intrinsic length %" PRIu64 " is too big", (uint64_t)length);
+                    error.SetErrorToGenericError();
+                    error.SetErrorString(unsupported_operand_error);
+                    return false;
+                }
+                
+                lldb_private::DataBufferHeap buffer(length, 0);
+                
+                if (const MemSetInst *memset_inst = dyn_cast<MemSetInst>(mem_inst))
+                {
+                    const Value *value_operand = memset_inst->getValue();
+                    
+                    lldb_private::Scalar V;
+                    
+                    if (!frame.EvaluateValue(V, value_operand, module))
+                    {
+                        if (log)
+                            log->Printf("Couldn't evaluate %s", PrintValue(value_operand).c_str());
+                        error.SetErrorToGenericError();
+                        error.SetErrorString(bad_value_error);
+                        return false;
+                    }
+                    
+                    ::memset(buffer.GetBytes(), (uint8_t)V.GetRawBits64(0), length);
+                }
+                else if (const MemTransferInst *transfer_inst = dyn_cast<MemTransferInst>(mem_inst))
+                {
+                    const Value *source_operand = transfer_inst->getRawSource();
+                    
+                    lldb_private::Scalar S;
+                    
+                    if (!frame.EvaluateValue(S, source_operand, module))
+                    {
+                        if (log)
+                            log->Printf("Couldn't evaluate %s", PrintValue(source_operand).c_str());
+                        error.SetErrorToGenericError();
+                        error.SetErrorString(bad_value_error);
+                        return false;
+                    }
+                    
+                    // Reading the whole source before writing makes memmove
+                    // work for overlapping regions too.
+                    lldb_private::Error read_error;
+                    memory_map.ReadMemory(buffer.GetBytes(), S.GetRawBits64(LLDB_INVALID_ADDRESS), length, read_error);
+                    if (!read_error.Success())
+                    {
+                        if (log)
+                            log->Printf("Couldn't read from a region on behalf of a %s", inst->getOpcodeName());
+                        error.SetErrorToGenericError();
+                        error.SetErrorString(memory_read_error);
+                        return false;
+                    }
+                }
+                
+                lldb_private::Error write_error;
+                memory_map.WriteMemory(dest, buffer.GetBytes(), buffer.GetByteSize(), write_error);
+                if (!write_error.Success())
+                {
+                    if (log)
+                        log->Printf("Couldn't write to a region on behalf of a %s", inst->getOpcodeName());
+                    error.SetErrorToGenericError();
+                    error.SetErrorString(memory_write_error);
+                    return false;
+                }
+                
+                if (log)
+                {
+                    log->Printf("Interpreted a %s", isa<MemSetInst>(mem_inst) ? "memset" : "memcpy/memmove");
+                    log->Printf("  R : 0x%" PRIx64, dest);
+                    log->Printf("  L : %" PRIu64, (uint64_t)length);
+                }
+            }
+                break;
             case Instruction::IntToPtr:
             {
                 const IntToPtrInst *int_to_ptr_inst = dyn_cast<IntToPtrInst>(inst);
@@ -1412,7 +1984,7 @@ IRInterpreter::Interpret (llvm::Module &module,
         ++frame.m_ii;
     }
     
-    if (num_insts >= 4096)
+    if (num_insts >= max_interpreted_instructions)
     {
         error.SetErrorToGenericError();
         error.SetErrorString(infinite_loop_error);
@@ -0,0 +1,216 @@
+//===-- FileMonitor.cpp -----------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Host/FileMonitor.h"
+
+// C Includes
+#if defined (__linux__)
+#include <errno.h>
+#include <limits.h>
+#include <string.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+// C++ Includes
+#include <algorithm>
+#include <map>
+#include <vector>
+
+// Other libraries and framework includes
+// Project includes
+#include "lldb/Core/Log.h"
+#include "lldb/Host/FileSpec.h"
+#include "lldb/Host/Host.h"
+#include "lldb/Host/Mutex.h"
+
+using namespace lldb;
+using namespace lldb_private;
+
+#if defined (__linux__)
+
+namespace {
+
+// All watches share one inotify descriptor and one thread that reads
+// its events.  inotify hands out the same watch descriptor for every
+// path that names the same file, so several Watch objects can share one.
+class InotifyMonitor
+{
+public:
+    static InotifyMonitor &
+    GetSharedInstance ()
+    {
+        // Never destroyed, the reader thread keeps using it until the
+        // process exits.
+        static InotifyMonitor *g_monitor = new InotifyMonitor();
+        return *g_monitor;
+    }
+
+    FileMonitor::WatchSP
+    AddWatch (const char *path)
+    {
+        FileMonitor::WatchSP watch_sp;
+        // Register the watch before any event for it can be read.
+        Mutex::Locker locker (m_mutex);
+        if (m_fd < 0)
+            return watch_sp;
+        if (!IS_VALID_LLDB_HOST_THREAD(m_thread))
+        {
+            m_thread = Host::ThreadCreate ("<lldb.host.file-monitor>", ReadEventsThread, this, NULL);
+            if (!IS_VALID_LLDB_HOST_THREAD(m_thread))
+                return watch_sp;
+        }
+        const int wd = ::inotify_add_watch (m_fd, path, IN_MODIFY | IN_ATTRIB | IN_CLOSE_WRITE | IN_MOVE_SELF | IN_DELETE_SELF);
+        if (wd < 0)
+            return watch_sp;
+        watch_sp.reset (new FileMonitor::Watch (wd));
+        m_watchers[wd].push_back (watch_sp.get());
+        return watch_sp;
+    }
+
+    void
+    RemoveWatch (FileMonitor::Watch *watch, int wd)
+    {
+        Mutex::Locker locker (m_mutex);
+        WatcherMap::iterator pos = m_watchers.find (wd);
+        if (pos == m_watchers.end())
+            return;
+        WatcherList &watchers = pos->second;
+        watchers.erase (std::remove (watchers.begin(), watchers.end(), watch), watchers.end());
+        if (watchers.empty())
+        {
+            m_watchers.erase (pos);
+            ::inotify_rm_watch (m_fd, wd);
+        }
+    }
+
+protected:
+    typedef std::vector<FileMonitor::Watch *> WatcherList;
+    typedef std::map<int, WatcherList> WatcherMap;
+
+    InotifyMonitor () :
+        m_fd (::inotify_init1 (IN_CLOEXEC)),
+        m_mutex (Mutex::eMutexTypeNormal),
+        m_watchers (),
+        m_thread (LLDB_INVALID_HOST_THREAD)
+    {
+    }
+
+    static lldb::thread_result_t
+    ReadEventsThread (lldb::thread_arg_t arg);
+
+    void
+    HandleEvents (const char *buffer, size_t length);
+
+    void
+    Shutdown ();
+
+    int m_fd;
+    Mutex m_mutex;
+    WatcherMap m_watchers;
+    lldb::thread_t m_thread;
+};
+
+} // anonymous namespace
+
+lldb::thread_result_t
+InotifyMonitor::ReadEventsThread (lldb::thread_arg_t arg)
+{
+    InotifyMonitor *monitor = (InotifyMonitor *)arg;
+    char buffer[4096] __attribute__ ((aligned(__alignof__(struct inotify_event))));
+    while (true)
+    {
+        const ssize_t bytes_read = ::read (monitor->m_fd, buffer, sizeof(buffer));
+        if (bytes_read < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            break;
+        }
+        if (bytes_read == 0)
+            break;
+        monitor->HandleEvents (buffer, bytes_read);
+    }
+    Log *log(lldb_private::GetLogIfAllCategoriesSet (LIBLLDB_LOG_HOST));
+    if (log)
+        log->Printf ("InotifyMonitor::ReadEventsThread exiting, file changes will be found by polling");
+    monitor->Shutdown ();
+    return NULL;
+}
+
+void
+InotifyMonitor::Shutdown ()
+{
+    // Nothing will be flagged from now on, so flag everything once more
+    // to make the owners check their files, and fail any new watches.
+    Mutex::Locker locker (m_mutex);
+    for (WatcherMap::iterator pos = m_watchers.begin(); pos != m_watchers.end(); ++pos)
+    {
+        for (WatcherList::iterator watch = pos->second.begin(); watch != pos->second.end(); ++watch)
+            (*watch)->SetChanged ();
+    }
+    m_watchers.clear();
+    ::close (m_fd);
+    m_fd = -1;
+}
+
+void
+InotifyMonitor::HandleEvents (const char *buffer, size_t length)
+{
+    Mutex::Locker locker (m_mutex);
+    size_t offset = 0;
+    while (offset + sizeof(struct inotify_event) <= length)
+    {
+        const struct inotify_event *event = (const struct inotify_event *)(buffer + offset);
+        WatcherMap::iterator pos = m_watchers.find (event->wd);
+        if (pos != m_watchers.end())
+        {
+            for (WatcherList::iterator watch = pos->second.begin(); watch != pos->second.end(); ++watch)
+                (*watch)->SetChanged ();
+        }
+        offset += sizeof(struct inotify_event) + event->len;
+    }
+}
+
+#endif // #if defined (__linux__)
+
+FileMonitor::Watch::Watch (int watch_descriptor) :
+    m_watch_descriptor (watch_descriptor),
+    m_changed (false)
+{
+}
+
+FileMonitor::Watch::~Watch ()
+{
+#if defined (__linux__)
+    InotifyMonitor::GetSharedInstance().RemoveWatch (this, m_watch_descriptor);
+#endif
+}
+
+FileMonitor::WatchSP
+FileMonitor::WatchFile (const FileSpec &file_spec)
+{
+    WatchSP watch_sp;
+#if defined (__linux__)
+    char path[PATH_MAX];
+    if (file_spec.GetPath (path, sizeof(path)) == 0)
+        return watch_sp;
+
+    watch_sp = InotifyMonitor::GetSharedInstance().AddWatch (path);
+    if (!watch_sp)
+    {
+        // Usually the file doesn't exist or we're out of watches
+        // (fs.inotify.max_user_watches).
+        Log *log(lldb_private::GetLogIfAllCategoriesSet (LIBLLDB_LOG_HOST));
+        if (log)
+            log->Printf ("FileMonitor::WatchFile (%s) failed: %s", path, ::strerror (errno));
+    }
+#endif
+    return watch_sp;
+}
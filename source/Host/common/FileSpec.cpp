@@ -666,6 +666,24 @@ FileSpec::GetModificationTime () const
     return mod_time;
 }
 
+TimeValue
+FileSpec::GetPreciseModificationTime () const
+{
+    TimeValue mod_time;
+    struct stat file_stats;
+    if (GetFileStats (this, &file_stats))
+    {
+#if defined (__APPLE__)
+        mod_time = TimeValue (file_stats.st_mtimespec);
+#elif defined (_WIN32)
+        mod_time.OffsetWithSeconds(file_stats.st_mtime);
+#else
+        mod_time = TimeValue (file_stats.st_mtim);
+#endif
+    }
+    return mod_time;
+}
+
 //------------------------------------------------------------------
 // Directory string get accessor.
 //------------------------------------------------------------------
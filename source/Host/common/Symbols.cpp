@@ -8,14 +8,30 @@
 //===----------------------------------------------------------------------===//
 
 #include "lldb/Host/Symbols.h"
+
+#include <stdio.h>
+#include <unistd.h>
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
 #include "lldb/Core/ArchSpec.h"
 #include "lldb/Core/DataBuffer.h"
 #include "lldb/Core/DataExtractor.h"
+#include "lldb/Core/Error.h"
+#include "lldb/Core/Log.h"
 #include "lldb/Core/Module.h"
 #include "lldb/Core/ModuleSpec.h"
 #include "lldb/Core/StreamString.h"
 #include "lldb/Core/Timer.h"
 #include "lldb/Core/UUID.h"
+#include "lldb/Host/Condition.h"
+#include "lldb/Host/File.h"
+#include "lldb/Host/Host.h"
+#include "lldb/Host/Mutex.h"
+#include "lldb/Host/TimeValue.h"
 #include "lldb/Symbol/ObjectFile.h"
 #include "lldb/Target/Target.h"
 
@@ -24,13 +40,600 @@ using namespace lldb_private;
 
 #if defined (__linux__) || defined (__FreeBSD__)
 
+// Returns true if file_spec is an object file with the given UUID.
+static bool
+FileMatchesUUID (const FileSpec &file_spec, const UUID &uuid)
+{
+    lldb_private::ModuleSpecList specs;
+    const size_t num_specs = ObjectFile::GetModuleSpecifications (file_spec, 0, 0, specs);
+    assert (num_specs <= 1 && "Symbol Vendor supports only a single architecture");
+    if (num_specs == 1)
+    {
+        ModuleSpec mspec;
+        if (specs.GetModuleSpecAtIndex (0, mspec))
+            return mspec.GetUUID() == uuid;
+    }
+    return false;
+}
+
 FileSpec
 Symbols::LocateExecutableObjectFile (const ModuleSpec &module_spec)
 {
-    // FIXME
+    // Only look for a file we can tell is the right one.
+    const UUID &module_uuid = module_spec.GetUUID();
+    if (!module_uuid.IsValid())
+        return FileSpec();
+
+    std::vector<std::string> candidates;
+
+    // A file with the same name in the executable search paths.
+    const char *filename = module_spec.GetFileSpec().GetFilename().AsCString();
+    if (filename && filename[0])
+    {
+        const FileSpecList exe_search_paths (Target::GetDefaultExecutableSearchPaths());
+        for (size_t idx = 0; idx < exe_search_paths.GetSize(); ++idx)
+            candidates.push_back (exe_search_paths.GetFileSpecAtIndex (idx).GetPath() + "/" + filename);
+    }
+
+    // The .build-id directories of the debug file search paths link the
+    // build ID of an executable to the executable itself, for example
+    //   /usr/lib/debug/.build-id/ff/e7fe727889ad82bb153de2ad065b2189693315
+    // The files with a .debug extension next to them are the debug files.
+    FileSpecList debug_file_search_paths (Target::GetDefaultDebugFileSearchPaths());
+    debug_file_search_paths.AppendIfUnique (FileSpec("/usr/lib/debug", true));
+    std::string build_id_path (module_uuid.GetAsString(""));
+    build_id_path.insert (2, 1, '/');
+    for (size_t idx = 0; idx < debug_file_search_paths.GetSize(); ++idx)
+        candidates.push_back (debug_file_search_paths.GetFileSpecAtIndex (idx).GetPath() + "/.build-id/" + build_id_path);
+
+    for (size_t idx = 0; idx < candidates.size(); ++idx)
+    {
+        FileSpec file_spec (candidates[idx].c_str(), true);
+        if (file_spec == module_spec.GetFileSpec())
+            continue;
+        if (file_spec.Exists() && FileMatchesUUID (file_spec, module_uuid))
+            return file_spec;
+    }
     return FileSpec();
 }
 
+namespace {
+
+//----------------------------------------------------------------------
+// An index of the files under the debug file search directories, so
+// looking for the debug file of every module doesn't stat and parse up
+// to four candidates in each directory, which is slow for big debug
+// trees on network file systems.
+//
+// A directory is scanned the first time it is searched. After that the
+// index is only checked against the file system when a lookup misses,
+// at most every few seconds per directory, and only the directories
+// whose modification time changed are read again. Scanning is done
+// without holding the index lock; lookups in the same directory wait
+// for it, lookups in other directories don't. The UUID of each candidate
+// is remembered too, so a file is parsed at most once while it doesn't
+// change.
+//
+// When target.cache-path is set the index is saved in its
+// debug-file-index file, so later sessions only need to stat the
+// directories they know about, and don't parse the candidates again.
+// The file is a list of records:
+//
+//     uint32_t magic, version, kind, size of the data
+//     uint8_t  data[size], padded to 4 bytes
+//
+// A directory record holds the search directory, then for each
+// directory under it its path, modification time, files and
+// subdirectories. It is written with all the other directory records
+// into a new file whenever a scan finds a change. A UUID record holds
+// the path, size and modification time of a candidate and its UUID, and
+// is appended to the file with one write when the candidate is parsed.
+// Later records replace earlier ones.
+//----------------------------------------------------------------------
+class DebugFileIndex
+{
+public:
+    static DebugFileIndex &
+    GetSharedInstance ()
+    {
+        // Never destroyed, it may be used while the process exits.
+        static DebugFileIndex *g_index = new DebugFileIndex();
+        return *g_index;
+    }
+
+    //------------------------------------------------------------------
+    // Returns true and fills in file_spec if root_dir contains one of
+    // relative_paths and that file has the given UUID.
+    //------------------------------------------------------------------
+    bool
+    FindFile (const std::string &root_dir,
+              const std::vector<std::string> &relative_paths,
+              const FileSpec &module_file_spec,
+              const UUID &uuid,
+              FileSpec &file_spec)
+    {
+        Mutex::Locker locker (m_mutex);
+        ReadCacheFile ();
+        Root &root = m_roots[root_dir];
+        while (root.updating)
+            m_condition.Wait (m_mutex);
+        if (!root.last_check.IsValid())
+            UpdateRoot (root, root_dir, locker);
+
+        const uint32_t generation = root.generation;
+        if (FindFileLocked (root, root_dir, relative_paths, module_file_spec, uuid, file_spec, locker))
+            return true;
+
+        // Maybe a file was added since we last looked.  Another lookup
+        // may have looked while the candidates were parsed.
+        while (root.updating)
+            m_condition.Wait (m_mutex);
+        if (root.generation != generation)
+            return FindFileLocked (root, root_dir, relative_paths, module_file_spec, uuid, file_spec, locker);
+        TimeValue now (TimeValue::Now());
+        if (now - root.last_check < g_recheck_interval_nsec)
+            return false;
+        if (!UpdateRoot (root, root_dir, locker))
+            return false;
+        return FindFileLocked (root, root_dir, relative_paths, module_file_spec, uuid, file_spec, locker);
+    }
+
+private:
+    static const uint64_t g_recheck_interval_nsec = 5ull * TimeValue::NanoSecPerSec;
+
+    enum
+    {
+        k_magic = 0x58494644,   // 'DFIX'
+        k_version = 2,
+        k_kind_root = 1,
+        k_kind_uuid = 2
+    };
+
+    struct Directory
+    {
+        uint64_t mod_time;
+        std::vector<std::string> files;     // Full paths
+        std::vector<std::string> subdirs;   // Full paths
+    };
+
+    typedef std::map<std::string, Directory> DirectoryMap;
+
+    struct Root
+    {
+        Root () :
+            last_check (),
+            updating (false),
+            generation (0),
+            directories (),
+            files ()
+        {
+        }
+
+        TimeValue last_check;   // Invalid until it is checked in this session
+        bool updating;          // Only the updating thread touches directories
+        uint32_t generation;    // Bumped when the files change
+        DirectoryMap directories;
+        std::set<std::string> files;
+    };
+
+    struct CachedUUID
+    {
+        uint64_t size;
+        uint64_t mod_time;
+        bool valid;
+        UUID uuid;
+    };
+
+    DebugFileIndex () :
+        m_mutex (Mutex::eMutexTypeNormal),
+        m_condition (),
+        m_write_mutex (Mutex::eMutexTypeNormal),
+        m_roots (),
+        m_uuids (),
+        m_cache_path ()
+    {
+    }
+
+    static uint64_t
+    GetModificationTime (const FileSpec &file_spec)
+    {
+        const TimeValue mod_time (file_spec.GetPreciseModificationTime());
+        return mod_time.IsValid() ? mod_time.GetAsNanoSecondsSinceJan1_1970() : 0;
+    }
+
+    static FileSpec::EnumerateDirectoryResult
+    AddDirectoryEntry (void *baton, FileSpec::FileType file_type, const FileSpec &spec)
+    {
+        Directory *directory = (Directory *)baton;
+        // Some file systems (NFS) don't return the type of the entries.
+        if (file_type == FileSpec::eFileTypeUnknown)
+            file_type = spec.GetFileType();
+        switch (file_type)
+        {
+            case FileSpec::eFileTypeDirectory:
+                directory->subdirs.push_back (spec.GetPath());
+                break;
+            case FileSpec::eFileTypeRegular:
+            case FileSpec::eFileTypeSymbolicLink:  // .build-id entries are links
+                directory->files.push_back (spec.GetPath());
+                break;
+            default:
+                break;
+        }
+        return FileSpec::eEnumerateDirectoryResultNext;
+    }
+
+    // Fill in directories with dir_path and everything below it.  The
+    // directories of old_directories whose modification time didn't
+    // change are copied instead of read again.  Returns true if any
+    // directory was read.
+    static bool
+    ScanDirectory (const DirectoryMap &old_directories, DirectoryMap &directories, const std::string &dir_path)
+    {
+        bool changed = false;
+        Directory &directory = directories[dir_path];
+        directory.mod_time = GetModificationTime (FileSpec (dir_path.c_str(), false));
+        DirectoryMap::const_iterator pos = old_directories.find (dir_path);
+        if (pos != old_directories.end() && pos->second.mod_time == directory.mod_time && directory.mod_time != 0)
+        {
+            directory.files = pos->second.files;
+            directory.subdirs = pos->second.subdirs;
+        }
+        else
+        {
+            FileSpec::EnumerateDirectory (dir_path.c_str(), true, true, true, AddDirectoryEntry, &directory);
+            changed = true;
+        }
+        // Copy, scanning the subdirectories may move this directory in the map.
+        const std::vector<std::string> subdirs (directory.subdirs);
+        for (size_t i = 0; i < subdirs.size(); ++i)
+            changed |= ScanDirectory (old_directories, directories, subdirs[i]);
+        return changed;
+    }
+
+    // Bring root up to date with the file system, without holding
+    // m_mutex while the directories are read.  Call with m_mutex locked
+    // and root not being updated.  Returns true if anything changed.
+    bool
+    UpdateRoot (Root &root, const std::string &root_dir, Mutex::Locker &locker)
+    {
+        root.updating = true;
+        root.last_check = TimeValue::Now();
+        locker.Unlock();
+
+        // Nothing else changes root.directories while root.updating is set.
+        DirectoryMap directories;
+        const bool changed = ScanDirectory (root.directories, directories, root_dir) ||
+                             directories.size() != root.directories.size();
+
+        locker.Lock (m_mutex);
+        if (changed)
+        {
+            root.directories.swap (directories);
+            root.files.clear();
+            for (DirectoryMap::const_iterator pos = root.directories.begin(); pos != root.directories.end(); ++pos)
+                root.files.insert (pos->second.files.begin(), pos->second.files.end());
+            ++root.generation;
+        }
+        root.updating = false;
+        m_condition.Broadcast();
+        if (changed)
+            WriteCacheFile (locker);
+        return changed;
+    }
+
+    bool
+    FindFileLocked (Root &root,
+                    const std::string &root_dir,
+                    const std::vector<std::string> &relative_paths,
+                    const FileSpec &module_file_spec,
+                    const UUID &uuid,
+                    FileSpec &file_spec,
+                    Mutex::Locker &locker)
+    {
+        for (size_t i = 0; i < relative_paths.size(); ++i)
+        {
+            const std::string path (root_dir + "/" + relative_paths[i]);
+            if (root.files.find (path) == root.files.end())
+                continue;
+
+            FileSpec candidate (path.c_str(), true);
+            if (candidate == module_file_spec)
+                continue;
+
+            // Stat and parse the file without the lock, it can take a
+            // while and shouldn't hold up other lookups.
+            locker.Unlock();
+            CachedUUID cached;
+            cached.size = candidate.GetByteSize();
+            cached.mod_time = GetModificationTime (candidate);
+            cached.valid = false;
+            locker.Lock (m_mutex);
+            std::map<std::string, CachedUUID>::const_iterator pos = m_uuids.find (path);
+            if (pos == m_uuids.end() || pos->second.size != cached.size || pos->second.mod_time != cached.mod_time)
+            {
+                locker.Unlock();
+                lldb_private::ModuleSpecList specs;
+                cached.valid = ObjectFile::GetModuleSpecifications (candidate, 0, 0, specs) == 1;
+                ModuleSpec mspec;
+                if (cached.valid && specs.GetModuleSpecAtIndex (0, mspec))
+                    cached.uuid = mspec.GetUUID();
+                AppendUUIDRecord (path, cached);
+                locker.Lock (m_mutex);
+                m_uuids[path] = cached;
+            }
+            else
+                cached = pos->second;
+            if (cached.valid && cached.uuid == uuid)
+            {
+                file_spec = candidate;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    //------------------------------------------------------------------
+    // The cache file
+    //------------------------------------------------------------------
+    static std::string
+    GetCacheFilePath ()
+    {
+        std::string cache_path;
+        FileSpec cache_dir (Target::GetDefaultCachePath());
+        if (cache_dir)
+        {
+            cache_path = cache_dir.GetPath();
+            cache_path += "/debug-file-index";
+        }
+        return cache_path;
+    }
+
+    static void
+    PutRecord (Stream &strm, uint32_t kind, const StreamString &data)
+    {
+        strm.PutHex32 (k_magic);
+        strm.PutHex32 (k_version);
+        strm.PutHex32 (kind);
+        strm.PutHex32 (data.GetSize());
+        strm.Write (data.GetData(), data.GetSize());
+        const uint32_t padding = 0;
+        strm.Write (&padding, ((data.GetSize() + 3) & ~3) - data.GetSize());
+    }
+
+    static void
+    PutRootRecord (Stream &strm, const std::string &root_dir, const Root &root)
+    {
+        StreamString data (Stream::eBinary, sizeof(lldb::addr_t), lldb::endian::InlHostByteOrder());
+        data.PutCString (root_dir.c_str());
+        data.PutHex32 (root.directories.size());
+        for (DirectoryMap::const_iterator pos = root.directories.begin(); pos != root.directories.end(); ++pos)
+        {
+            data.PutCString (pos->first.c_str());
+            data.PutHex64 (pos->second.mod_time);
+            data.PutHex32 (pos->second.files.size());
+            for (size_t i = 0; i < pos->second.files.size(); ++i)
+                data.PutCString (pos->second.files[i].c_str());
+            data.PutHex32 (pos->second.subdirs.size());
+            for (size_t i = 0; i < pos->second.subdirs.size(); ++i)
+                data.PutCString (pos->second.subdirs[i].c_str());
+        }
+        PutRecord (strm, k_kind_root, data);
+    }
+
+    static void
+    PutUUIDRecord (Stream &strm, const std::string &path, const CachedUUID &cached)
+    {
+        StreamString data (Stream::eBinary, sizeof(lldb::addr_t), lldb::endian::InlHostByteOrder());
+        UUID uuid (cached.uuid);
+        data.PutCString (path.c_str());
+        data.PutHex64 (cached.size);
+        data.PutHex64 (cached.mod_time);
+        data.PutHex32 (cached.valid);
+        data.PutHex32 (uuid.GetByteSize());
+        data.Write (uuid.GetBytes(), uuid.GetByteSize());
+        PutRecord (strm, k_kind_uuid, data);
+    }
+
+    static bool
+    GetStrings (const DataExtractor &data, lldb::offset_t *offset_ptr, std::vector<std::string> &strings)
+    {
+        const uint32_t count = data.GetU32 (offset_ptr);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const char *cstr = data.GetCStr (offset_ptr);
+            if (cstr == NULL)
+                return false;
+            strings.push_back (cstr);
+        }
+        return true;
+    }
+
+    static bool
+    GetRootRecord (const DataExtractor &data, std::string &root_dir, DirectoryMap &directories)
+    {
+        lldb::offset_t offset = 0;
+        const char *cstr = data.GetCStr (&offset);
+        if (cstr == NULL)
+            return false;
+        root_dir = cstr;
+        const uint32_t num_directories = data.GetU32 (&offset);
+        for (uint32_t i = 0; i < num_directories; ++i)
+        {
+            cstr = data.GetCStr (&offset);
+            if (cstr == NULL)
+                return false;
+            Directory &directory = directories[cstr];
+            directory.mod_time = data.GetU64 (&offset);
+            if (!GetStrings (data, &offset, directory.files) || !GetStrings (data, &offset, directory.subdirs))
+                return false;
+        }
+        return true;
+    }
+
+    static bool
+    GetUUIDRecord (const DataExtractor &data, std::string &path, CachedUUID &cached)
+    {
+        lldb::offset_t offset = 0;
+        const char *cstr = data.GetCStr (&offset);
+        if (cstr == NULL)
+            return false;
+        path = cstr;
+        cached.size = data.GetU64 (&offset);
+        cached.mod_time = data.GetU64 (&offset);
+        cached.valid = data.GetU32 (&offset) != 0;
+        const uint32_t uuid_size = data.GetU32 (&offset);
+        const void *uuid_bytes = data.GetData (&offset, uuid_size);
+        if (uuid_bytes == NULL)
+            return false;
+        if (uuid_size > 0)
+            cached.uuid.SetBytes (uuid_bytes, uuid_size);
+        return true;
+    }
+
+    // Call with m_mutex locked.  Reads the cache file the first time the
+    // index is used and whenever target.cache-path changes.  Directories
+    // that were already scanned in this session are kept.
+    void
+    ReadCacheFile ()
+    {
+        const std::string cache_path (GetCacheFilePath());
+        if (cache_path == m_cache_path)
+            return;
+        m_cache_path = cache_path;
+        if (m_cache_path.empty())
+            return;
+
+        FileSpec cache_file (m_cache_path.c_str(), false);
+        DataBufferSP data_sp;
+        if (cache_file.Exists())
+            data_sp = cache_file.ReadFileContents();
+        if (!data_sp)
+            return;
+
+        // Stop at the first record that doesn't look right, another
+        // process may be writing it.
+        DataExtractor file_data (data_sp, lldb::endian::InlHostByteOrder(), sizeof(lldb::addr_t));
+        lldb::offset_t offset = 0;
+        while (file_data.ValidOffsetForDataOfSize (offset, 4 * sizeof(uint32_t)))
+        {
+            const uint32_t magic = file_data.GetU32 (&offset);
+            const uint32_t version = file_data.GetU32 (&offset);
+            const uint32_t kind = file_data.GetU32 (&offset);
+            const uint32_t size = file_data.GetU32 (&offset);
+            if (magic != k_magic || version != k_version || !file_data.ValidOffsetForDataOfSize (offset, size))
+                break;
+            const DataExtractor data (file_data, offset, size);
+            offset += (size + 3) & ~3;
+            if (kind == k_kind_root)
+            {
+                std::string root_dir;
+                DirectoryMap directories;
+                if (!GetRootRecord (data, root_dir, directories))
+                    break;
+                Root &root = m_roots[root_dir];
+                if (root.last_check.IsValid() || root.updating)
+                    continue;
+                root.directories.swap (directories);
+                root.files.clear();
+                for (DirectoryMap::const_iterator pos = root.directories.begin(); pos != root.directories.end(); ++pos)
+                    root.files.insert (pos->second.files.begin(), pos->second.files.end());
+            }
+            else if (kind == k_kind_uuid)
+            {
+                std::string path;
+                CachedUUID cached;
+                if (!GetUUIDRecord (data, path, cached))
+                    break;
+                m_uuids[path] = cached;
+            }
+        }
+    }
+
+    // Call with m_mutex locked.  Saves the whole index into a new cache
+    // file, which leaves out the records that were replaced.  The file
+    // is written without the lock held.
+    void
+    WriteCacheFile (Mutex::Locker &locker)
+    {
+        if (m_cache_path.empty())
+            return;
+        const std::string cache_path (m_cache_path);
+        StreamString records (Stream::eBinary, sizeof(lldb::addr_t), lldb::endian::InlHostByteOrder());
+        for (std::map<std::string, Root>::const_iterator pos = m_roots.begin(); pos != m_roots.end(); ++pos)
+        {
+            if (!pos->second.directories.empty())
+                PutRootRecord (records, pos->first, pos->second);
+        }
+        for (std::map<std::string, CachedUUID>::const_iterator pos = m_uuids.begin(); pos != m_uuids.end(); ++pos)
+            PutUUIDRecord (records, pos->first, pos->second);
+        locker.Unlock();
+
+        // Write a new file and move it into place, so other processes
+        // never read a partial index.
+        Mutex::Locker write_locker (m_write_mutex);
+        StreamString temp_path;
+        temp_path.Printf ("%s.%" PRIu64, cache_path.c_str(), Host::GetCurrentProcessID());
+        Error error (WriteFile (temp_path.GetString(), records, File::eOpenOptionTruncate));
+        if (error.Success() && ::rename (temp_path.GetData(), cache_path.c_str()) != 0)
+            error.SetErrorToErrno();
+        if (error.Fail())
+        {
+            ::unlink (temp_path.GetData());
+            Log *log (GetLogIfAllCategoriesSet (LIBLLDB_LOG_SYMBOLS));
+            if (log)
+                log->Printf ("DebugFileIndex::%s couldn't write %s: %s", __FUNCTION__,
+                             cache_path.c_str(), error.AsCString());
+        }
+        write_locker.Unlock();
+        locker.Lock (m_mutex);
+    }
+
+    // Call with m_mutex unlocked.
+    void
+    AppendUUIDRecord (const std::string &path, const CachedUUID &cached)
+    {
+        const std::string cache_path (GetCacheFilePath());
+        if (cache_path.empty())
+            return;
+        StreamString record (Stream::eBinary, sizeof(lldb::addr_t), lldb::endian::InlHostByteOrder());
+        PutUUIDRecord (record, path, cached);
+        Mutex::Locker write_locker (m_write_mutex);
+        Error error (WriteFile (cache_path, record, File::eOpenOptionAppend));
+        Log *log (GetLogIfAllCategoriesSet (LIBLLDB_LOG_SYMBOLS));
+        if (error.Fail() && log)
+            log->Printf ("DebugFileIndex::%s couldn't write to %s: %s", __FUNCTION__,
+                         cache_path.c_str(), error.AsCString());
+    }
+
+    // Write all of data to path with one write.
+    static Error
+    WriteFile (const std::string &path, const StreamString &data, uint32_t options)
+    {
+        File file;
+        Error error (file.Open (path.c_str(),
+                                File::eOpenOptionWrite | File::eOpenOptionCanCreate | options,
+                                lldb::eFilePermissionsFileDefault));
+        if (error.Success())
+        {
+            size_t bytes_written = data.GetSize();
+            error = file.Write (data.GetData(), bytes_written);
+            if (error.Success() && bytes_written != data.GetSize())
+                error.SetErrorString ("short write");
+        }
+        return error;
+    }
+
+    Mutex m_mutex;
+    Condition m_condition;      // Broadcast when a root is updated
+    Mutex m_write_mutex;        // Serializes writes to the cache file
+    std::map<std::string, Root> m_roots;
+    std::map<std::string, CachedUUID> m_uuids;
+    std::string m_cache_path;   // The cache file that was read
+};
+
+} // anonymous namespace
+
 FileSpec
 Symbols::LocateExecutableSymbolFile (const ModuleSpec &module_spec)
 {
@@ -40,6 +643,11 @@ Symbols::LocateExecutableSymbolFile (const ModuleSpec &module_spec)
 
     FileSpecList debug_file_search_paths (Target::GetDefaultDebugFileSearchPaths());
 
+    // The directories that only hold debug files are indexed, the others
+    // are probed for each file.
+    FileSpecList indexed_directories (debug_file_search_paths);
+    indexed_directories.AppendIfUnique (FileSpec("/usr/lib/debug", true));
+
     // Add module directory.
     const ConstString &file_dir = module_spec.GetFileSpec().GetDirectory();
     debug_file_search_paths.AppendIfUnique (FileSpec(file_dir.AsCString("."), true));
@@ -65,6 +673,14 @@ Symbols::LocateExecutableSymbolFile (const ModuleSpec &module_spec)
     //   /usr/lib/debug/usr/lib/library.so.debug
     std::string module_directory = module_spec.GetFileSpec().GetDirectory().AsCString();
 
+    std::vector<std::string> relative_paths;
+    relative_paths.push_back (symbol_filename);
+    relative_paths.push_back (std::string(".debug/") + symbol_filename);
+    relative_paths.push_back (".build-id/" + uuid_str);
+    const size_t module_directory_start = module_directory.find_first_not_of ('/');
+    if (module_directory_start != std::string::npos)
+        relative_paths.push_back (module_directory.substr (module_directory_start) + "/" + symbol_filename);
+
     size_t num_directories = debug_file_search_paths.GetSize();
     for (size_t idx = 0; idx < num_directories; ++idx)
     {
@@ -73,38 +689,27 @@ Symbols::LocateExecutableSymbolFile (const ModuleSpec &module_spec)
         if (!dirspec.Exists() || !dirspec.IsDirectory())
             continue;
 
-        std::vector<std::string> files;
         std::string dirname = dirspec.GetPath();
 
-        files.push_back (dirname + "/" + symbol_filename);
-        files.push_back (dirname + "/.debug/" + symbol_filename);
-        files.push_back (dirname + "/.build-id/" + uuid_str);
-        files.push_back (dirname + module_directory + "/" + symbol_filename);
+        if (indexed_directories.FindFileIndex (0, debug_file_search_paths.GetFileSpecAtIndex (idx), true) != UINT32_MAX)
+        {
+            FileSpec file_spec;
+            if (DebugFileIndex::GetSharedInstance().FindFile (dirname, relative_paths, module_spec.GetFileSpec(), module_uuid, file_spec))
+                return file_spec;
+            continue;
+        }
 
-        const uint32_t num_files = files.size();
+        const uint32_t num_files = relative_paths.size();
         for (size_t idx_file = 0; idx_file < num_files; ++idx_file)
         {
-            const std::string &filename = files[idx_file];
+            const std::string filename = dirname + "/" + relative_paths[idx_file];
             FileSpec file_spec (filename.c_str(), true);
 
             if (file_spec == module_spec.GetFileSpec())
                 continue;
 
-            if (file_spec.Exists())
-            {
-                lldb_private::ModuleSpecList specs;
-                const size_t num_specs = ObjectFile::GetModuleSpecifications (file_spec, 0, 0, specs);
-                assert (num_specs <= 1 && "Symbol Vendor supports only a single architecture");
-                if (num_specs == 1)
-                {
-                    ModuleSpec mspec;
-                    if (specs.GetModuleSpecAtIndex (0, mspec))
-                    {
-                        if (mspec.GetUUID() == module_uuid)
-                            return file_spec;
-                    }
-                }
-            }
+            if (file_spec.Exists() && FileMatchesUUID (file_spec, module_uuid))
+                return file_spec;
         }
     }
 
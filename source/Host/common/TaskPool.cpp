@@ -0,0 +1,166 @@
+//===-- TaskPool.cpp --------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Host/TaskPool.h"
+
+// C Includes
+// C++ Includes
+#include <algorithm>
+#include <atomic>
+#include <deque>
+
+// Other libraries and framework includes
+// Project includes
+#include "lldb/Host/Condition.h"
+#include "lldb/Host/Host.h"
+#include "lldb/Host/Mutex.h"
+
+using namespace lldb;
+using namespace lldb_private;
+
+namespace {
+
+// One call to TaskPool::ForEachIndex.  Every thread working on it takes
+// the next index until there are none left.
+struct Job
+{
+    Job (size_t count, const std::function<void(size_t)> &callback, uint32_t num_helpers) :
+        m_count (count),
+        m_callback (callback),
+        m_next_index (0),
+        m_helpers_wanted (num_helpers),
+        m_active_helpers (0)
+    {
+    }
+
+    void
+    Run ()
+    {
+        size_t index;
+        while ((index = m_next_index++) < m_count)
+            m_callback (index);
+    }
+
+    const size_t m_count;
+    const std::function<void(size_t)> &m_callback;
+    std::atomic<size_t> m_next_index;
+    uint32_t m_helpers_wanted;  // Pool threads that may still join, protected by the pool mutex
+    uint32_t m_active_helpers;  // Pool threads working on the job, protected by the pool mutex
+};
+
+class ThreadPool
+{
+public:
+    static ThreadPool &
+    GetSharedInstance ()
+    {
+        // Never destroyed, the pool threads keep waiting on it until the
+        // process exits.
+        static ThreadPool *g_pool = new ThreadPool();
+        return *g_pool;
+    }
+
+    void
+    Run (Job &job)
+    {
+        {
+            Mutex::Locker locker (m_mutex);
+            while (m_num_threads < job.m_helpers_wanted)
+            {
+                lldb::thread_t thread = Host::ThreadCreate ("<lldb.host.task-pool>", WorkerThread, this, NULL);
+                if (!IS_VALID_LLDB_HOST_THREAD(thread))
+                    break;
+                ++m_num_threads;
+            }
+            job.m_helpers_wanted = std::min (job.m_helpers_wanted, m_num_threads);
+            if (job.m_helpers_wanted > 0)
+            {
+                m_jobs.push_back (&job);
+                m_work_condition.Broadcast ();
+            }
+        }
+
+        job.Run ();
+
+        // No more helpers may join once our share is done, then wait for
+        // the ones that did to finish theirs.
+        Mutex::Locker locker (m_mutex);
+        std::deque<Job *>::iterator pos = std::find (m_jobs.begin(), m_jobs.end(), &job);
+        if (pos != m_jobs.end())
+            m_jobs.erase (pos);
+        while (job.m_active_helpers > 0)
+            m_done_condition.Wait (m_mutex);
+    }
+
+protected:
+    ThreadPool () :
+        m_mutex (Mutex::eMutexTypeNormal),
+        m_work_condition (),
+        m_done_condition (),
+        m_jobs (),
+        m_num_threads (0)
+    {
+    }
+
+    static lldb::thread_result_t
+    WorkerThread (lldb::thread_arg_t arg);
+
+    Mutex m_mutex;
+    Condition m_work_condition;
+    Condition m_done_condition;
+    std::deque<Job *> m_jobs;
+    uint32_t m_num_threads;
+};
+
+} // anonymous namespace
+
+lldb::thread_result_t
+ThreadPool::WorkerThread (lldb::thread_arg_t arg)
+{
+    ThreadPool *pool = (ThreadPool *)arg;
+    Mutex::Locker locker (pool->m_mutex);
+    while (true)
+    {
+        while (pool->m_jobs.empty())
+            pool->m_work_condition.Wait (pool->m_mutex);
+
+        Job *job = pool->m_jobs.front();
+        ++job->m_active_helpers;
+        if (--job->m_helpers_wanted == 0)
+            pool->m_jobs.pop_front();
+
+        locker.Unlock ();
+        job->Run ();
+        locker.Lock (pool->m_mutex);
+
+        if (--job->m_active_helpers == 0)
+            pool->m_done_condition.Broadcast ();
+    }
+    return NULL;
+}
+
+void
+TaskPool::ForEachIndex (size_t count,
+                        uint32_t max_threads,
+                        const std::function<void(size_t)> &callback)
+{
+    if (max_threads == 0)
+        max_threads = Host::GetNumberCPUS ();
+
+    if (count <= 1 || max_threads <= 1)
+    {
+        for (size_t i = 0; i < count; ++i)
+            callback (i);
+        return;
+    }
+
+    // The calling thread is one of the threads doing the work.
+    Job job (count, callback, std::min<size_t> (max_threads, count) - 1);
+    ThreadPool::GetSharedInstance().Run (job);
+}
@@ -15,7 +15,9 @@
 #include "lldb/Core/Module.h"
 #include "lldb/Core/ModuleSpec.h"
 #include "lldb/Core/Section.h"
+#include "lldb/Host/TaskPool.h"
 #include "lldb/Symbol/ObjectFile.h"
+#include "lldb/Symbol/SymbolVendor.h"
 #include "lldb/Target/Process.h"
 #include "lldb/Target/Target.h"
 #include "lldb/Target/Thread.h"
@@ -464,7 +466,23 @@ DynamicLoaderPOSIXDYLD::LoadAllCurrentModules()
         }
     }
 
-    m_process->GetTarget().ModulesDidLoad(module_list);
+    // Processes with hundreds of shared libraries, like big core files,
+    // spend most of the time above finding their symbol files and parsing
+    // their symbol tables the first time anything looks up a symbol or
+    // unwinds, one module after another. Each module only locks itself
+    // while it does that, so do it for all of them at once.
+    Target &target = m_process->GetTarget();
+    TaskPool::ForEachIndex (module_list.GetSize(),
+                            target.GetModuleQueryThreads(),
+                            [&module_list] (size_t idx)
+                            {
+                                ModuleSP module_sp (module_list.GetModuleAtIndex (idx));
+                                SymbolVendor *sym_vendor = module_sp ? module_sp->GetSymbolVendor() : NULL;
+                                if (sym_vendor)
+                                    sym_vendor->GetSymtab();
+                            });
+
+    target.ModulesDidLoad(module_list);
 }
 
 ModuleSP
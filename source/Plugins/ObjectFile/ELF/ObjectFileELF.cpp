@@ -11,9 +11,13 @@
 
 #include <cassert>
 #include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
 
 #include "lldb/Core/ArchSpec.h"
 #include "lldb/Core/DataBuffer.h"
+#include "lldb/Core/DataExtractor.h"
 #include "lldb/Core/Error.h"
 #include "lldb/Core/FileSpecList.h"
 #include "lldb/Core/Log.h"
@@ -25,7 +29,11 @@
 #include "lldb/Symbol/DWARFCallFrameInfo.h"
 #include "lldb/Symbol/SymbolContext.h"
 #include "lldb/Target/Target.h"
+#include "lldb/Host/File.h"
 #include "lldb/Host/Host.h"
+#include "lldb/Host/Mutex.h"
+#include "lldb/Host/TaskPool.h"
+#include "lldb/Host/TimeValue.h"
 
 #include "llvm/ADT/PointerUnion.h"
 
@@ -277,69 +285,369 @@ ObjectFileELF::MagicBytesMatch (DataBufferSP& data_sp,
 }
 
 /*
- * crc function from http://svnweb.freebsd.org/base/head/sys/libkern/crc32.c
+ * crc table from http://svnweb.freebsd.org/base/head/sys/libkern/crc32.c
  *
  *   COPYRIGHT (C) 1986 Gary S. Brown. You may use this program, or
  *   code or tables extracted from it, as desired without restriction.
  */
+static const uint32_t g_crc32_tab[] =
+{
+    0x00000000, 0x77073096, 0xee0e612c, 0x990951ba, 0x076dc419, 0x706af48f,
+    0xe963a535, 0x9e6495a3, 0x0edb8832, 0x79dcb8a4, 0xe0d5e91e, 0x97d2d988,
+    0x09b64c2b, 0x7eb17cbd, 0xe7b82d07, 0x90bf1d91, 0x1db71064, 0x6ab020f2,
+    0xf3b97148, 0x84be41de, 0x1adad47d, 0x6ddde4eb, 0xf4d4b551, 0x83d385c7,
+    0x136c9856, 0x646ba8c0, 0xfd62f97a, 0x8a65c9ec, 0x14015c4f, 0x63066cd9,
+    0xfa0f3d63, 0x8d080df5, 0x3b6e20c8, 0x4c69105e, 0xd56041e4, 0xa2677172,
+    0x3c03e4d1, 0x4b04d447, 0xd20d85fd, 0xa50ab56b, 0x35b5a8fa, 0x42b2986c,
+    0xdbbbc9d6, 0xacbcf940, 0x32d86ce3, 0x45df5c75, 0xdcd60dcf, 0xabd13d59,
+    0x26d930ac, 0x51de003a, 0xc8d75180, 0xbfd06116, 0x21b4f4b5, 0x56b3c423,
+    0xcfba9599, 0xb8bda50f, 0x2802b89e, 0x5f058808, 0xc60cd9b2, 0xb10be924,
+    0x2f6f7c87, 0x58684c11, 0xc1611dab, 0xb6662d3d, 0x76dc4190, 0x01db7106,
+    0x98d220bc, 0xefd5102a, 0x71b18589, 0x06b6b51f, 0x9fbfe4a5, 0xe8b8d433,
+    0x7807c9a2, 0x0f00f934, 0x9609a88e, 0xe10e9818, 0x7f6a0dbb, 0x086d3d2d,
+    0x91646c97, 0xe6635c01, 0x6b6b51f4, 0x1c6c6162, 0x856530d8, 0xf262004e,
+    0x6c0695ed, 0x1b01a57b, 0x8208f4c1, 0xf50fc457, 0x65b0d9c6, 0x12b7e950,
+    0x8bbeb8ea, 0xfcb9887c, 0x62dd1ddf, 0x15da2d49, 0x8cd37cf3, 0xfbd44c65,
+    0x4db26158, 0x3ab551ce, 0xa3bc0074, 0xd4bb30e2, 0x4adfa541, 0x3dd895d7,
+    0xa4d1c46d, 0xd3d6f4fb, 0x4369e96a, 0x346ed9fc, 0xad678846, 0xda60b8d0,
+    0x44042d73, 0x33031de5, 0xaa0a4c5f, 0xdd0d7cc9, 0x5005713c, 0x270241aa,
+    0xbe0b1010, 0xc90c2086, 0x5768b525, 0x206f85b3, 0xb966d409, 0xce61e49f,
+    0x5edef90e, 0x29d9c998, 0xb0d09822, 0xc7d7a8b4, 0x59b33d17, 0x2eb40d81,
+    0xb7bd5c3b, 0xc0ba6cad, 0xedb88320, 0x9abfb3b6, 0x03b6e20c, 0x74b1d29a,
+    0xead54739, 0x9dd277af, 0x04db2615, 0x73dc1683, 0xe3630b12, 0x94643b84,
+    0x0d6d6a3e, 0x7a6a5aa8, 0xe40ecf0b, 0x9309ff9d, 0x0a00ae27, 0x7d079eb1,
+    0xf00f9344, 0x8708a3d2, 0x1e01f268, 0x6906c2fe, 0xf762575d, 0x806567cb,
+    0x196c3671, 0x6e6b06e7, 0xfed41b76, 0x89d32be0, 0x10da7a5a, 0x67dd4acc,
+    0xf9b9df6f, 0x8ebeeff9, 0x17b7be43, 0x60b08ed5, 0xd6d6a3e8, 0xa1d1937e,
+    0x38d8c2c4, 0x4fdff252, 0xd1bb67f1, 0xa6bc5767, 0x3fb506dd, 0x48b2364b,
+    0xd80d2bda, 0xaf0a1b4c, 0x36034af6, 0x41047a60, 0xdf60efc3, 0xa867df55,
+    0x316e8eef, 0x4669be79, 0xcb61b38c, 0xbc66831a, 0x256fd2a0, 0x5268e236,
+    0xcc0c7795, 0xbb0b4703, 0x220216b9, 0x5505262f, 0xc5ba3bbe, 0xb2bd0b28,
+    0x2bb45a92, 0x5cb36a04, 0xc2d7ffa7, 0xb5d0cf31, 0x2cd99e8b, 0x5bdeae1d,
+    0x9b64c2b0, 0xec63f226, 0x756aa39c, 0x026d930a, 0x9c0906a9, 0xeb0e363f,
+    0x72076785, 0x05005713, 0x95bf4a82, 0xe2b87a14, 0x7bb12bae, 0x0cb61b38,
+    0x92d28e9b, 0xe5d5be0d, 0x7cdcefb7, 0x0bdbdf21, 0x86d3d2d4, 0xf1d4e242,
+    0x68ddb3f8, 0x1fda836e, 0x81be16cd, 0xf6b9265b, 0x6fb077e1, 0x18b74777,
+    0x88085ae6, 0xff0f6a70, 0x66063bca, 0x11010b5c, 0x8f659eff, 0xf862ae69,
+    0x616bffd3, 0x166ccf45, 0xa00ae278, 0xd70dd2ee, 0x4e048354, 0x3903b3c2,
+    0xa7672661, 0xd06016f7, 0x4969474d, 0x3e6e77db, 0xaed16a4a, 0xd9d65adc,
+    0x40df0b66, 0x37d83bf0, 0xa9bcae53, 0xdebb9ec5, 0x47b2cf7f, 0x30b5ffe9,
+    0xbdbdf21c, 0xcabac28a, 0x53b39330, 0x24b4a3a6, 0xbad03605, 0xcdd70693,
+    0x54de5729, 0x23d967bf, 0xb3667a2e, 0xc4614ab8, 0x5d681b02, 0x2a6f2b94,
+    0xb40bbe37, 0xc30c8ea1, 0x5a05df1b, 0x2d02ef8d
+};
+
+namespace {
+
+// The tables for slicing-by-8: g_crc32_tab, followed by the CRC of each
+// byte value shifted through one to seven more zero bytes, which lets the
+// loop below consume eight bytes with eight independent lookups.
+struct CRC32SliceTables
+{
+    CRC32SliceTables ()
+    {
+        for (uint32_t i = 0; i < 256; ++i)
+            tab[0][i] = g_crc32_tab[i];
+        for (uint32_t slice = 1; slice < 8; ++slice)
+        {
+            for (uint32_t i = 0; i < 256; ++i)
+                tab[slice][i] = (tab[slice - 1][i] >> 8) ^ tab[0][tab[slice - 1][i] & 0xFF];
+        }
+    }
+
+    uint32_t tab[8][256];
+};
+
+} // anonymous namespace
+
 static uint32_t
-calc_gnu_debuglink_crc32(const void *buf, size_t size)
+crc32_update(uint32_t crc, const uint8_t *p, size_t size)
+{
+    static const CRC32SliceTables g_slice_tables;
+    const uint32_t (&tab)[8][256] = g_slice_tables.tab;
+
+    while (size >= 8)
+    {
+        const uint32_t lo = crc ^ ((uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24);
+        const uint32_t hi = (uint32_t)p[4] | (uint32_t)p[5] << 8 | (uint32_t)p[6] << 16 | (uint32_t)p[7] << 24;
+        crc = tab[7][lo & 0xFF] ^ tab[6][(lo >> 8) & 0xFF] ^ tab[5][(lo >> 16) & 0xFF] ^ tab[4][lo >> 24] ^
+              tab[3][hi & 0xFF] ^ tab[2][(hi >> 8) & 0xFF] ^ tab[1][(hi >> 16) & 0xFF] ^ tab[0][hi >> 24];
+        p += 8;
+        size -= 8;
+    }
+    while (size--)
+        crc = tab[0][(crc ^ *p++) & 0xFF] ^ (crc >> 8);
+    return crc;
+}
+
+static uint32_t
+gf2_matrix_times(const uint32_t *mat, uint32_t vec)
 {
-    static const uint32_t g_crc32_tab[] =
+    uint32_t sum = 0;
+    while (vec)
     {
-        0x00000000, 0x77073096, 0xee0e612c, 0x990951ba, 0x076dc419, 0x706af48f,
-        0xe963a535, 0x9e6495a3, 0x0edb8832, 0x79dcb8a4, 0xe0d5e91e, 0x97d2d988,
-        0x09b64c2b, 0x7eb17cbd, 0xe7b82d07, 0x90bf1d91, 0x1db71064, 0x6ab020f2,
-        0xf3b97148, 0x84be41de, 0x1adad47d, 0x6ddde4eb, 0xf4d4b551, 0x83d385c7,
-        0x136c9856, 0x646ba8c0, 0xfd62f97a, 0x8a65c9ec, 0x14015c4f, 0x63066cd9,
-        0xfa0f3d63, 0x8d080df5, 0x3b6e20c8, 0x4c69105e, 0xd56041e4, 0xa2677172,
-        0x3c03e4d1, 0x4b04d447, 0xd20d85fd, 0xa50ab56b, 0x35b5a8fa, 0x42b2986c,
-        0xdbbbc9d6, 0xacbcf940, 0x32d86ce3, 0x45df5c75, 0xdcd60dcf, 0xabd13d59,
-        0x26d930ac, 0x51de003a, 0xc8d75180, 0xbfd06116, 0x21b4f4b5, 0x56b3c423,
-        0xcfba9599, 0xb8bda50f, 0x2802b89e, 0x5f058808, 0xc60cd9b2, 0xb10be924,
-        0x2f6f7c87, 0x58684c11, 0xc1611dab, 0xb6662d3d, 0x76dc4190, 0x01db7106,
-        0x98d220bc, 0xefd5102a, 0x71b18589, 0x06b6b51f, 0x9fbfe4a5, 0xe8b8d433,
-        0x7807c9a2, 0x0f00f934, 0x9609a88e, 0xe10e9818, 0x7f6a0dbb, 0x086d3d2d,
-        0x91646c97, 0xe6635c01, 0x6b6b51f4, 0x1c6c6162, 0x856530d8, 0xf262004e,
-        0x6c0695ed, 0x1b01a57b, 0x8208f4c1, 0xf50fc457, 0x65b0d9c6, 0x12b7e950,
-        0x8bbeb8ea, 0xfcb9887c, 0x62dd1ddf, 0x15da2d49, 0x8cd37cf3, 0xfbd44c65,
-        0x4db26158, 0x3ab551ce, 0xa3bc0074, 0xd4bb30e2, 0x4adfa541, 0x3dd895d7,
-        0xa4d1c46d, 0xd3d6f4fb, 0x4369e96a, 0x346ed9fc, 0xad678846, 0xda60b8d0,
-        0x44042d73, 0x33031de5, 0xaa0a4c5f, 0xdd0d7cc9, 0x5005713c, 0x270241aa,
-        0xbe0b1010, 0xc90c2086, 0x5768b525, 0x206f85b3, 0xb966d409, 0xce61e49f,
-        0x5edef90e, 0x29d9c998, 0xb0d09822, 0xc7d7a8b4, 0x59b33d17, 0x2eb40d81,
-        0xb7bd5c3b, 0xc0ba6cad, 0xedb88320, 0x9abfb3b6, 0x03b6e20c, 0x74b1d29a,
-        0xead54739, 0x9dd277af, 0x04db2615, 0x73dc1683, 0xe3630b12, 0x94643b84,
-        0x0d6d6a3e, 0x7a6a5aa8, 0xe40ecf0b, 0x9309ff9d, 0x0a00ae27, 0x7d079eb1,
-        0xf00f9344, 0x8708a3d2, 0x1e01f268, 0x6906c2fe, 0xf762575d, 0x806567cb,
-        0x196c3671, 0x6e6b06e7, 0xfed41b76, 0x89d32be0, 0x10da7a5a, 0x67dd4acc,
-        0xf9b9df6f, 0x8ebeeff9, 0x17b7be43, 0x60b08ed5, 0xd6d6a3e8, 0xa1d1937e,
-        0x38d8c2c4, 0x4fdff252, 0xd1bb67f1, 0xa6bc5767, 0x3fb506dd, 0x48b2364b,
-        0xd80d2bda, 0xaf0a1b4c, 0x36034af6, 0x41047a60, 0xdf60efc3, 0xa867df55,
-        0x316e8eef, 0x4669be79, 0xcb61b38c, 0xbc66831a, 0x256fd2a0, 0x5268e236,
-        0xcc0c7795, 0xbb0b4703, 0x220216b9, 0x5505262f, 0xc5ba3bbe, 0xb2bd0b28,
-        0x2bb45a92, 0x5cb36a04, 0xc2d7ffa7, 0xb5d0cf31, 0x2cd99e8b, 0x5bdeae1d,
-        0x9b64c2b0, 0xec63f226, 0x756aa39c, 0x026d930a, 0x9c0906a9, 0xeb0e363f,
-        0x72076785, 0x05005713, 0x95bf4a82, 0xe2b87a14, 0x7bb12bae, 0x0cb61b38,
-        0x92d28e9b, 0xe5d5be0d, 0x7cdcefb7, 0x0bdbdf21, 0x86d3d2d4, 0xf1d4e242,
-        0x68ddb3f8, 0x1fda836e, 0x81be16cd, 0xf6b9265b, 0x6fb077e1, 0x18b74777,
-        0x88085ae6, 0xff0f6a70, 0x66063bca, 0x11010b5c, 0x8f659eff, 0xf862ae69,
-        0x616bffd3, 0x166ccf45, 0xa00ae278, 0xd70dd2ee, 0x4e048354, 0x3903b3c2,
-        0xa7672661, 0xd06016f7, 0x4969474d, 0x3e6e77db, 0xaed16a4a, 0xd9d65adc,
-        0x40df0b66, 0x37d83bf0, 0xa9bcae53, 0xdebb9ec5, 0x47b2cf7f, 0x30b5ffe9,
-        0xbdbdf21c, 0xcabac28a, 0x53b39330, 0x24b4a3a6, 0xbad03605, 0xcdd70693,
-        0x54de5729, 0x23d967bf, 0xb3667a2e, 0xc4614ab8, 0x5d681b02, 0x2a6f2b94,
-        0xb40bbe37, 0xc30c8ea1, 0x5a05df1b, 0x2d02ef8d
-    };    
+        if (vec & 1)
+            sum ^= *mat;
+        vec >>= 1;
+        mat++;
+    }
+    return sum;
+}
+
+static void
+gf2_matrix_square(uint32_t *square, const uint32_t *mat)
+{
+    for (int n = 0; n < 32; n++)
+        square[n] = gf2_matrix_times(mat, mat[n]);
+}
+
+// Returns the CRC of two blocks given the CRC of each and the length of
+// the second, by applying len2 zero bytes to crc1 (as zlib's crc32_combine).
+static uint32_t
+crc32_combine(uint32_t crc1, uint32_t crc2, uint64_t len2)
+{
+    if (len2 == 0)
+        return crc1;
+
+    uint32_t even[32];  // even-power-of-two zeros operator
+    uint32_t odd[32];   // odd-power-of-two zeros operator
+
+    // Put the operator for one zero bit in odd.
+    odd[0] = 0xedb88320;
+    uint32_t row = 1;
+    for (int n = 1; n < 32; n++)
+    {
+        odd[n] = row;
+        row <<= 1;
+    }
+    // Put the operator for two zero bits in even, then four in odd.
+    gf2_matrix_square(even, odd);
+    gf2_matrix_square(odd, even);
+
+    // Apply len2 zeros to crc1, the first square puts the operator for
+    // one zero byte (eight zero bits) in even.
+    do
+    {
+        gf2_matrix_square(even, odd);
+        if (len2 & 1)
+            crc1 = gf2_matrix_times(even, crc1);
+        len2 >>= 1;
+        if (len2 == 0)
+            break;
+
+        gf2_matrix_square(odd, even);
+        if (len2 & 1)
+            crc1 = gf2_matrix_times(odd, crc1);
+        len2 >>= 1;
+    } while (len2 != 0);
+
+    return crc1 ^ crc2;
+}
+
+static uint32_t
+calc_gnu_debuglink_crc32(const void *buf, size_t size)
+{
+    // Big files are split into chunks whose CRCs are computed on the task
+    // pool and then combined, which also spreads the page faults of a
+    // file that was just mapped over several threads.
+    static const size_t g_chunk_size = 16 * 1024 * 1024;
+
     const uint8_t *p = (const uint8_t *)buf;
-    uint32_t crc;
+    if (size < 2 * g_chunk_size)
+        return crc32_update(~0U, p, size) ^ ~0U;
 
-    crc = ~0U;
-    while (size--)
-        crc = g_crc32_tab[(crc ^ *p++) & 0xFF] ^ (crc >> 8);
-    return crc ^ ~0U;
+    const size_t num_chunks = (size + g_chunk_size - 1) / g_chunk_size;
+    std::vector<uint32_t> chunk_crcs(num_chunks);
+    TaskPool::ForEachIndex(num_chunks, 0, [p, size, &chunk_crcs] (size_t idx)
+    {
+        const size_t offset = idx * g_chunk_size;
+        const size_t chunk_size = std::min(g_chunk_size, size - offset);
+        chunk_crcs[idx] = crc32_update(~0U, p + offset, chunk_size) ^ ~0U;
+    });
+
+    uint32_t crc = chunk_crcs[0];
+    for (size_t idx = 1; idx < num_chunks; ++idx)
+        crc = crc32_combine(crc, chunk_crcs[idx], std::min(g_chunk_size, size - idx * g_chunk_size));
+    return crc;
 }
 
+namespace {
+
+// The CRC of a file without a build ID is its UUID, and a module can be
+// looked for many times while locating symbols.  Remember the CRCs so each
+// file is only read once for as long as it doesn't change.  When
+// target.cache-path is set they are also saved in its gnu-debuglink-crcs
+// file, so later sessions don't read the files again either.  The file is a
+// list of records, appended with one write each:
+//
+//     uint32_t magic, version, crc, length of the path
+//     uint64_t file size, modification time in ns, offset in the file
+//     char     path[length], padded to 4 bytes
+//
+// Later records replace earlier ones for the same path and offset.
+class FileCRCCache
+{
+public:
+    static FileCRCCache &
+    GetSharedInstance ()
+    {
+        static FileCRCCache *g_cache = new FileCRCCache();
+        return *g_cache;
+    }
+
+    bool
+    Lookup (const FileSpec &file, lldb::offset_t file_offset, uint32_t &crc)
+    {
+        Key key;
+        Entry current;
+        if (!GetKeyAndEntry (file, file_offset, key, current))
+            return false;
+        Mutex::Locker locker (m_mutex);
+        ReadCacheFile ();
+        Map::const_iterator pos = m_map.find (key);
+        if (pos == m_map.end() ||
+            pos->second.size != current.size ||
+            pos->second.mod_time != current.mod_time)
+            return false;
+        crc = pos->second.crc;
+        return true;
+    }
+
+    void
+    Insert (const FileSpec &file, lldb::offset_t file_offset, uint32_t crc)
+    {
+        Key key;
+        Entry entry;
+        if (!GetKeyAndEntry (file, file_offset, key, entry))
+            return;
+        entry.crc = crc;
+
+        const uint32_t header[4] = { k_magic, k_version, crc, (uint32_t)key.first.size() };
+        const uint64_t values[3] = { entry.size, entry.mod_time, key.second };
+        std::vector<uint8_t> record (sizeof(header) + sizeof(values) + ((key.first.size() + 3) & ~3), 0);
+        memcpy (&record[0], header, sizeof(header));
+        memcpy (&record[sizeof(header)], values, sizeof(values));
+        memcpy (&record[sizeof(header) + sizeof(values)], key.first.data(), key.first.size());
+
+        Mutex::Locker locker (m_mutex);
+        const std::string &cache_path = ReadCacheFile ();
+        m_map[key] = entry;
+        if (cache_path.empty())
+            return;
+
+        Log *log (GetLogIfAllCategoriesSet (LIBLLDB_LOG_SYMBOLS));
+        File cache_file;
+        Error error (cache_file.Open (cache_path.c_str(),
+                                      File::eOpenOptionWrite | File::eOpenOptionAppend | File::eOpenOptionCanCreate,
+                                      lldb::eFilePermissionsFileDefault));
+        if (error.Success())
+        {
+            size_t bytes_written = record.size();
+            error = cache_file.Write (&record[0], bytes_written);
+            if (error.Success() && bytes_written != record.size())
+                error.SetErrorString ("short write");
+        }
+        if (error.Fail() && log)
+            log->Printf ("FileCRCCache::%s couldn't write to %s: %s", __FUNCTION__,
+                         cache_path.c_str(), error.AsCString());
+    }
+
+private:
+    enum
+    {
+        k_magic = 0x43524347,   // 'GCRC'
+        k_version = 2
+    };
+
+    typedef std::pair<std::string, lldb::offset_t> Key;
+
+    struct Entry
+    {
+        uint64_t size;
+        uint64_t mod_time;
+        uint32_t crc;
+    };
+
+    typedef std::map<Key, Entry> Map;
+
+    FileCRCCache () :
+        m_mutex (Mutex::eMutexTypeNormal),
+        m_map (),
+        m_cache_path ()
+    {
+    }
+
+    static bool
+    GetKeyAndEntry (const FileSpec &file, lldb::offset_t file_offset, Key &key, Entry &entry)
+    {
+        const TimeValue mod_time (file.GetPreciseModificationTime());
+        if (!mod_time.IsValid())
+            return false;
+        entry.mod_time = mod_time.GetAsNanoSecondsSinceJan1_1970();
+        entry.size = file.GetByteSize();
+        entry.crc = 0;
+        key.first = file.GetPath();
+        key.second = file_offset;
+        return true;
+    }
+
+    // Call with m_mutex locked.  Reads the cache file the first time it is
+    // used and whenever target.cache-path changes, and returns its path,
+    // which is empty when the CRCs aren't saved.
+    const std::string &
+    ReadCacheFile ()
+    {
+        std::string cache_path;
+        FileSpec cache_dir (Target::GetDefaultCachePath());
+        if (cache_dir)
+        {
+            cache_path = cache_dir.GetPath();
+            cache_path += "/gnu-debuglink-crcs";
+        }
+        if (cache_path == m_cache_path)
+            return m_cache_path;
+        m_cache_path = cache_path;
+        if (m_cache_path.empty())
+            return m_cache_path;
+
+        FileSpec cache_file (m_cache_path.c_str(), false);
+        DataBufferSP data_sp;
+        if (cache_file.Exists())
+            data_sp = cache_file.ReadFileContents();
+        if (!data_sp)
+            return m_cache_path;
+
+        // Stop at the first record that doesn't look right, another
+        // process may be writing it.
+        DataExtractor data (data_sp, lldb::endian::InlHostByteOrder(), sizeof(lldb::addr_t));
+        lldb::offset_t offset = 0;
+        while (data.ValidOffsetForDataOfSize (offset, 4 * sizeof(uint32_t) + 3 * sizeof(uint64_t)))
+        {
+            const uint32_t magic = data.GetU32 (&offset);
+            const uint32_t version = data.GetU32 (&offset);
+            Entry entry;
+            entry.crc = data.GetU32 (&offset);
+            const uint32_t path_length = data.GetU32 (&offset);
+            entry.size = data.GetU64 (&offset);
+            entry.mod_time = data.GetU64 (&offset);
+            Key key;
+            key.second = data.GetU64 (&offset);
+            if (magic != k_magic || version != k_version || !data.ValidOffsetForDataOfSize (offset, path_length))
+                break;
+            key.first.assign ((const char *)data.GetDataStart() + offset, path_length);
+            offset += (path_length + 3) & ~3;
+            m_map[key] = entry;
+        }
+        return m_cache_path;
+    }
+
+    Mutex m_mutex;
+    Map m_map;
+    std::string m_cache_path;
+};
+
+} // anonymous namespace
+
 size_t
 ObjectFileELF::GetModuleSpecifications (const lldb_private::FileSpec& file,
                                         lldb::DataBufferSP& data_sp,
@@ -391,12 +699,14 @@ ObjectFileELF::GetModuleSpecifications (const lldb_private::FileSpec& file,
 
                     if (!uuid.IsValid())
                     {
-                        if (!gnu_debuglink_crc)
+                        if (!gnu_debuglink_crc &&
+                            !FileCRCCache::GetSharedInstance().Lookup (file, file_offset, gnu_debuglink_crc))
                         {
                             // Need to map entire file into memory to calculate the crc.
                             data_sp = file.MemoryMapFileContents (file_offset, SIZE_MAX);
                             data.SetData(data_sp);
                             gnu_debuglink_crc = calc_gnu_debuglink_crc32 (data.GetDataStart(), data.GetByteSize());
+                            FileCRCCache::GetSharedInstance().Insert (file, file_offset, gnu_debuglink_crc);
                         }
                         if (gnu_debuglink_crc)
                         {
@@ -512,8 +822,12 @@ ObjectFileELF::GetUUID(lldb_private::UUID* uuid)
     }
     else 
     {
-        if (!m_gnu_debuglink_crc)
+        if (!m_gnu_debuglink_crc &&
+            !FileCRCCache::GetSharedInstance().Lookup (m_file, m_file_offset, m_gnu_debuglink_crc))
+        {
             m_gnu_debuglink_crc = calc_gnu_debuglink_crc32 (m_data.GetDataStart(), m_data.GetByteSize());
+            FileCRCCache::GetSharedInstance().Insert (m_file, m_file_offset, m_gnu_debuglink_crc);
+        }
         if (m_gnu_debuglink_crc)
         {
             // Use 4 bytes of crc from the .gnu_debuglink section.
@@ -0,0 +1,616 @@
+//===-- LinuxCoreWriter.cpp -------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+// C Includes
+#include <elf.h>
+#include <errno.h>
+#include <link.h>
+#include <signal.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/procfs.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <sys/user.h>
+#include <unistd.h>
+
+// C++ Includes
+#include <algorithm>
+
+// Other libraries and framework includes
+#include "lldb/Core/Log.h"
+#include "lldb/Core/Module.h"
+#include "lldb/Core/ModuleList.h"
+#include "lldb/Core/Section.h"
+#include "lldb/Host/File.h"
+#include "lldb/Host/Host.h"
+#include "lldb/Target/Target.h"
+#include "lldb/Target/Thread.h"
+
+#include "LinuxCoreWriter.h"
+#include "ProcessLinux.h"
+#include "ProcessMonitor.h"
+#include "ProcessPOSIXLog.h"
+
+using namespace lldb;
+using namespace lldb_private;
+
+#ifndef NT_FILE
+#define NT_FILE 0x46494c45
+#endif
+
+// The type of the "LLDB" note that lists the loaded modules, ProcessElfCore
+// reads it.
+#define NT_LLDB_MODULES 1
+
+// Stacks only cores keep this much below the stack pointer, the x86_64
+// ABI lets leaf functions use it without moving the stack pointer.
+static const lldb::addr_t k_red_zone_size = 128;
+
+// Memory is read and written this much at a time.
+static const size_t k_chunk_size = 1024 * 1024;
+
+// Reads all of /proc/<pid>/<name>, whose size stat doesn't know.
+static bool
+ReadProcFile(lldb::pid_t pid, const char *name, std::string &contents)
+{
+    char path[PATH_MAX];
+    snprintf(path, sizeof(path), "/proc/%" PRIu64 "/%s", pid, name);
+    FILE *file = fopen(path, "r");
+    if (file == NULL)
+        return false;
+    contents.clear();
+    char buf[4096];
+    size_t bytes_read;
+    while ((bytes_read = fread(buf, 1, sizeof(buf), file)) > 0)
+        contents.append(buf, bytes_read);
+    fclose(file);
+    return true;
+}
+
+static bool
+WriteAll(File &file, const void *buf, size_t size, Error &error)
+{
+    const uint8_t *bytes = (const uint8_t *)buf;
+    while (size > 0)
+    {
+        size_t bytes_written = size;
+        error = file.Write(bytes, bytes_written);
+        if (error.Fail())
+            return false;
+        if (bytes_written == 0)
+        {
+            error.SetErrorString("no bytes were written to the core file");
+            return false;
+        }
+        bytes += bytes_written;
+        size -= bytes_written;
+    }
+    return true;
+}
+
+LinuxCoreWriter::LinuxCoreWriter(ProcessLinux &process, ProcessMonitor &monitor)
+    : m_process(process),
+      m_monitor(monitor),
+      m_pid(process.GetID()),
+      m_ppid(0),
+      m_pgrp(0),
+      m_sid(0),
+      m_state('t'),
+      m_mappings(),
+      m_segments(),
+      m_stack_pointers(),
+      m_notes(),
+      m_use_process_vm_readv(true)
+{
+}
+
+Error
+LinuxCoreWriter::Write(const FileSpec &outfile, const SaveCoreOptions &options)
+{
+    Error error;
+    Log *log (ProcessPOSIXLog::GetLogIfAllCategoriesSet (POSIX_LOG_PROCESS));
+
+#if defined(__x86_64__)
+    const uint16_t machine = EM_X86_64;
+#elif defined(__i386__)
+    const uint16_t machine = EM_386;
+#else
+    error.SetErrorString("saving core files is not supported on this architecture");
+    return error;
+#endif
+
+    if (!ReadMappings(options, error))
+        return error;
+    ReadProcessStatus();
+
+    // Like the kernel, put the thread whose ID is the process ID first,
+    // and the process notes after its NT_PRSTATUS.
+    ThreadList &thread_list = m_process.GetThreadList();
+    std::vector<lldb::tid_t> tids;
+    const uint32_t num_threads = thread_list.GetSize(false);
+    for (uint32_t i = 0; i < num_threads; ++i)
+    {
+        lldb::tid_t tid = thread_list.GetThreadAtIndex(i, false)->GetID();
+        if (tid == m_pid)
+            tids.insert(tids.begin(), tid);
+        else
+            tids.push_back(tid);
+    }
+
+    bool added_process_notes = false;
+    for (size_t i = 0; i < tids.size(); ++i)
+    {
+        if (AddThreadNotes(tids[i], !added_process_notes))
+            added_process_notes = true;
+        else if (log)
+            log->Printf("LinuxCoreWriter::%s couldn't read the registers of thread %" PRIu64 ", leaving it out",
+                        __FUNCTION__, tids[i]);
+    }
+    if (!added_process_notes)
+    {
+        error.SetErrorString("couldn't read the registers of any thread");
+        return error;
+    }
+    AddModulesNote();
+    MakeSegments(options.GetStacksOnly());
+
+    // Lay out the file: the ELF header, the program headers, the notes,
+    // then the memory of each PT_LOAD segment starting on a page.
+    const size_t page_size = Host::GetPageSize();
+    const size_t num_loads = m_segments.size();
+    if (num_loads + 1 >= PN_XNUM)
+    {
+        error.SetErrorStringWithFormat("too many memory mappings (%" PRIu64 ")", (uint64_t)num_loads);
+        return error;
+    }
+
+    const uint64_t notes_offset = sizeof(ElfW(Ehdr)) + (num_loads + 1) * sizeof(ElfW(Phdr));
+    uint64_t data_offset = notes_offset + m_notes.size();
+    data_offset = (data_offset + page_size - 1) / page_size * page_size;
+
+    std::vector<uint8_t> headers(notes_offset);
+
+    ElfW(Ehdr) *ehdr = (ElfW(Ehdr) *)&headers[0];
+    memcpy(ehdr->e_ident, ELFMAG, SELFMAG);
+    ehdr->e_ident[EI_CLASS] = __ELF_NATIVE_CLASS == 64 ? ELFCLASS64 : ELFCLASS32;
+    ehdr->e_ident[EI_DATA] = ELFDATA2LSB;
+    ehdr->e_ident[EI_VERSION] = EV_CURRENT;
+    ehdr->e_ident[EI_OSABI] = ELFOSABI_NONE;
+    ehdr->e_type = ET_CORE;
+    ehdr->e_machine = machine;
+    ehdr->e_version = EV_CURRENT;
+    ehdr->e_phoff = sizeof(ElfW(Ehdr));
+    ehdr->e_ehsize = sizeof(ElfW(Ehdr));
+    ehdr->e_phentsize = sizeof(ElfW(Phdr));
+    ehdr->e_phnum = num_loads + 1;
+
+    ElfW(Phdr) *phdr = (ElfW(Phdr) *)&headers[sizeof(ElfW(Ehdr))];
+    phdr->p_type = PT_NOTE;
+    phdr->p_offset = notes_offset;
+    phdr->p_filesz = m_notes.size();
+    phdr->p_align = 4;
+    ++phdr;
+
+    uint64_t segment_offset = data_offset;
+    for (size_t i = 0; i < m_segments.size(); ++i)
+    {
+        const Segment &segment = m_segments[i];
+        phdr->p_type = PT_LOAD;
+        phdr->p_flags = segment.flags;
+        phdr->p_offset = segment_offset;
+        phdr->p_vaddr = segment.start;
+        phdr->p_filesz = segment.end - segment.start;
+        phdr->p_memsz = segment.end - segment.start;
+        phdr->p_align = page_size;
+        segment_offset += phdr->p_filesz;
+        ++phdr;
+    }
+
+    File file;
+    error = file.Open(outfile.GetPath().c_str(),
+                      File::eOpenOptionWrite | File::eOpenOptionCanCreate | File::eOpenOptionTruncate,
+                      lldb::eFilePermissionsFileDefault);
+    if (error.Fail())
+        return error;
+
+    if (!WriteAll(file, &headers[0], headers.size(), error) ||
+        !WriteAll(file, &m_notes[0], m_notes.size(), error))
+        return error;
+
+    std::vector<uint8_t> buffer(std::max<size_t>(k_chunk_size, data_offset - notes_offset - m_notes.size()), 0);
+    if (!WriteAll(file, &buffer[0], data_offset - notes_offset - m_notes.size(), error))
+        return error;
+
+    // Stream the memory out a chunk at a time, zero filling the pages
+    // that can't be read.
+    uint64_t unreadable_bytes = 0;
+    for (size_t i = 0; i < m_segments.size(); ++i)
+    {
+        const Segment &segment = m_segments[i];
+        for (lldb::addr_t addr = segment.start; addr < segment.end; addr += k_chunk_size)
+        {
+            const size_t size = std::min<lldb::addr_t>(k_chunk_size, segment.end - addr);
+            size_t bytes_done = 0;
+            while (bytes_done < size)
+            {
+                bytes_done += ReadMemory(addr + bytes_done, &buffer[bytes_done], size - bytes_done);
+                if (bytes_done < size)
+                {
+                    const size_t skip_size = std::min<size_t>(page_size - (addr + bytes_done) % page_size, size - bytes_done);
+                    memset(&buffer[bytes_done], 0, skip_size);
+                    bytes_done += skip_size;
+                    unreadable_bytes += skip_size;
+                }
+            }
+            // The core should have the original bytes where our software
+            // breakpoints are.
+            m_process.RemoveBreakpointOpcodesFromBuffer(addr, size, &buffer[0]);
+            if (!WriteAll(file, &buffer[0], size, error))
+                return error;
+        }
+    }
+
+    if (log)
+        log->Printf("LinuxCoreWriter::%s wrote %" PRIu64 " threads and %" PRIu64 " segments (%" PRIu64 " bytes, %" PRIu64 " unreadable) to %s",
+                    __FUNCTION__, (uint64_t)tids.size(), (uint64_t)num_loads,
+                    segment_offset - data_offset, unreadable_bytes, outfile.GetPath().c_str());
+    return error;
+}
+
+bool
+LinuxCoreWriter::ReadMappings(const SaveCoreOptions &options, Error &error)
+{
+    std::string maps;
+    if (!ReadProcFile(m_pid, "maps", maps))
+    {
+        error.SetErrorStringWithFormat("couldn't read /proc/%" PRIu64 "/maps", m_pid);
+        return false;
+    }
+
+    size_t line_start = 0;
+    while (line_start < maps.size())
+    {
+        size_t line_end = maps.find('\n', line_start);
+        if (line_end == std::string::npos)
+            line_end = maps.size();
+        const std::string line(maps, line_start, line_end - line_start);
+        line_start = line_end + 1;
+
+        // start-end perms offset dev inode [path]
+        unsigned long long start, end, offset, inode;
+        char perms[8];
+        int path_pos = 0;
+        if (sscanf(line.c_str(), "%llx-%llx %7s %llx %*s %llu %n", &start, &end, perms, &offset, &inode, &path_pos) < 5)
+            continue;
+
+        Mapping mapping;
+        mapping.start = start;
+        mapping.end = end;
+        mapping.file_offset = offset;
+        mapping.flags = 0;
+        if (perms[0] == 'r')
+            mapping.flags |= PF_R;
+        if (perms[1] == 'w')
+            mapping.flags |= PF_W;
+        if (perms[2] == 'x')
+            mapping.flags |= PF_X;
+        if (path_pos > 0)
+            mapping.path = line.substr(path_pos);
+        mapping.is_file = inode != 0 && !mapping.path.empty() && mapping.path[0] == '/';
+
+        // The vsyscall page isn't in the process' address space as far as
+        // process_vm_readv is concerned, and reading vvar can fault.
+        mapping.include = (mapping.flags & PF_R) &&
+                          mapping.path != "[vsyscall]" &&
+                          mapping.path != "[vvar]";
+        if (options.GetSkipReadOnlyFiles() && mapping.is_file && !(mapping.flags & PF_W))
+            mapping.include = false;
+        if (mapping.include && options.GetStacksOnly())
+        {
+            // The stacks are added once the stack pointers are known.  The
+            // vDSO is tiny and has the signal trampolines' unwind info.
+            mapping.include = mapping.path == "[vdso]";
+            const std::vector<lldb::addr_t> &addresses = options.GetIncludeAddresses();
+            for (size_t i = 0; i < addresses.size(); ++i)
+            {
+                if (mapping.start <= addresses[i] && addresses[i] < mapping.end)
+                    mapping.include = true;
+            }
+        }
+
+        m_mappings.push_back(mapping);
+    }
+    return true;
+}
+
+void
+LinuxCoreWriter::MakeSegments(bool stacks_only)
+{
+    for (size_t i = 0; i < m_mappings.size(); ++i)
+    {
+        const Mapping &mapping = m_mappings[i];
+        if (mapping.include)
+        {
+            Segment segment = { mapping.start, mapping.end, mapping.flags };
+            m_segments.push_back(segment);
+        }
+    }
+    if (!stacks_only)
+        return;
+
+    // Stacks grow down, so the used part of a thread's stack goes from
+    // just below its stack pointer to the end of the mapping.
+    Log *log (ProcessPOSIXLog::GetLogIfAllCategoriesSet (POSIX_LOG_PROCESS));
+    const size_t page_size = Host::GetPageSize();
+    for (size_t i = 0; i < m_stack_pointers.size(); ++i)
+    {
+        const lldb::addr_t sp = m_stack_pointers[i];
+        std::vector<Mapping>::const_iterator pos;
+        for (pos = m_mappings.begin(); pos != m_mappings.end(); ++pos)
+        {
+            if (pos->start <= sp && sp < pos->end && (pos->flags & PF_R))
+                break;
+        }
+        if (pos == m_mappings.end())
+        {
+            if (log)
+                log->Printf("LinuxCoreWriter::%s stack pointer 0x%" PRIx64 " isn't in a readable mapping, leaving its stack out",
+                            __FUNCTION__, sp);
+            continue;
+        }
+        lldb::addr_t start = sp > k_red_zone_size ? sp - k_red_zone_size : 0;
+        start = std::max(pos->start, start / page_size * page_size);
+        Segment segment = { start, pos->end, pos->flags };
+        m_segments.push_back(segment);
+    }
+
+    // Threads can share a stack, say in a signal handler on an alternate
+    // stack, so merge the segments that overlap.
+    std::sort(m_segments.begin(), m_segments.end());
+    std::vector<Segment> merged;
+    for (size_t i = 0; i < m_segments.size(); ++i)
+    {
+        if (!merged.empty() && m_segments[i].start < merged.back().end)
+        {
+            merged.back().end = std::max(merged.back().end, m_segments[i].end);
+            merged.back().flags |= m_segments[i].flags;
+        }
+        else
+            merged.push_back(m_segments[i]);
+    }
+    m_segments.swap(merged);
+}
+
+void
+LinuxCoreWriter::ReadProcessStatus()
+{
+    // pid (comm) state ppid pgrp session ...  The command can contain
+    // spaces and parentheses, so start after the last ')'.
+    std::string stat;
+    if (!ReadProcFile(m_pid, "stat", stat))
+        return;
+    const size_t comm_end = stat.rfind(')');
+    if (comm_end == std::string::npos)
+        return;
+    sscanf(stat.c_str() + comm_end + 1, " %c %d %d %d", &m_state, &m_ppid, &m_pgrp, &m_sid);
+}
+
+void
+LinuxCoreWriter::AddNote(const char *name, uint32_t type, const void *desc, size_t desc_size)
+{
+    ElfW(Nhdr) nhdr;
+    nhdr.n_namesz = strlen(name) + 1;
+    nhdr.n_descsz = desc_size;
+    nhdr.n_type = type;
+
+    const size_t name_size = (nhdr.n_namesz + 3) & ~3;
+    const size_t padded_desc_size = (desc_size + 3) & ~3;
+    const size_t note_offset = m_notes.size();
+    m_notes.resize(note_offset + sizeof(nhdr) + name_size + padded_desc_size, 0);
+
+    uint8_t *note = &m_notes[note_offset];
+    memcpy(note, &nhdr, sizeof(nhdr));
+    memcpy(note + sizeof(nhdr), name, nhdr.n_namesz);
+    if (desc_size > 0)
+        memcpy(note + sizeof(nhdr) + name_size, desc, desc_size);
+}
+
+void
+LinuxCoreWriter::AddProcessNotes()
+{
+    elf_prpsinfo prpsinfo;
+    memset(&prpsinfo, 0, sizeof(prpsinfo));
+    const char *states = "RSDTZW";
+    const char *state = strchr(states, m_state);
+    prpsinfo.pr_state = state ? state - states : 0;
+    prpsinfo.pr_sname = m_state;
+    prpsinfo.pr_zomb = m_state == 'Z';
+    prpsinfo.pr_pid = m_pid;
+    prpsinfo.pr_ppid = m_ppid;
+    prpsinfo.pr_pgrp = m_pgrp;
+    prpsinfo.pr_sid = m_sid;
+
+    char proc_path[PATH_MAX];
+    snprintf(proc_path, sizeof(proc_path), "/proc/%" PRIu64, m_pid);
+    struct stat proc_stat;
+    if (::stat(proc_path, &proc_stat) == 0)
+    {
+        prpsinfo.pr_uid = proc_stat.st_uid;
+        prpsinfo.pr_gid = proc_stat.st_gid;
+    }
+
+    std::string contents;
+    if (ReadProcFile(m_pid, "comm", contents))
+    {
+        contents.erase(contents.find_last_not_of('\n') + 1);
+        strncpy(prpsinfo.pr_fname, contents.c_str(), sizeof(prpsinfo.pr_fname));
+    }
+    if (ReadProcFile(m_pid, "cmdline", contents))
+    {
+        // The arguments are separated by NULs.
+        size_t size = std::min(contents.size(), sizeof(prpsinfo.pr_psargs) - 1);
+        for (size_t i = 0; i < size; ++i)
+            prpsinfo.pr_psargs[i] = contents[i] ? contents[i] : ' ';
+        while (size > 0 && prpsinfo.pr_psargs[size - 1] == ' ')
+            prpsinfo.pr_psargs[--size] = '\0';
+    }
+    AddNote("CORE", NT_PRPSINFO, &prpsinfo, sizeof(prpsinfo));
+
+    if (ReadProcFile(m_pid, "auxv", contents) && !contents.empty())
+        AddNote("CORE", NT_AUXV, contents.data(), contents.size());
+
+    // The files that are mapped: a count and the page size, a start, end
+    // and page offset for each mapping, then their paths.
+    const size_t page_size = Host::GetPageSize();
+    std::vector<unsigned long> file_ranges;
+    std::string file_names;
+    file_ranges.push_back(0);
+    file_ranges.push_back(page_size);
+    for (size_t i = 0; i < m_mappings.size(); ++i)
+    {
+        const Mapping &mapping = m_mappings[i];
+        if (!mapping.is_file)
+            continue;
+        ++file_ranges[0];
+        file_ranges.push_back(mapping.start);
+        file_ranges.push_back(mapping.end);
+        file_ranges.push_back(mapping.file_offset / page_size);
+        file_names.append(mapping.path.c_str(), mapping.path.size() + 1);
+    }
+    if (file_ranges[0] > 0)
+    {
+        std::vector<uint8_t> desc(file_ranges.size() * sizeof(unsigned long) + file_names.size());
+        memcpy(&desc[0], &file_ranges[0], file_ranges.size() * sizeof(unsigned long));
+        memcpy(&desc[file_ranges.size() * sizeof(unsigned long)], file_names.data(), file_names.size());
+        AddNote("CORE", NT_FILE, &desc[0], desc.size());
+    }
+}
+
+void
+LinuxCoreWriter::AddModulesNote()
+{
+    // A record for each loaded module: the slide of its file addresses,
+    // the size of its UUID and of its path, then the UUID and the path,
+    // padded to 8 bytes.
+    Target &target = m_process.GetTarget();
+    const ModuleList &images = target.GetImages();
+    Mutex::Locker locker(images.GetMutex());
+    std::vector<uint8_t> desc;
+    for (size_t i = 0; i < images.GetSize(); ++i)
+    {
+        ModuleSP module_sp(images.GetModuleAtIndexUnlocked(i));
+        SectionList *section_list = module_sp ? module_sp->GetSectionList() : NULL;
+        if (section_list == NULL)
+            continue;
+
+        lldb::addr_t slide = LLDB_INVALID_ADDRESS;
+        for (size_t j = 0; j < section_list->GetSize() && slide == LLDB_INVALID_ADDRESS; ++j)
+        {
+            SectionSP section_sp(section_list->GetSectionAtIndex(j));
+            const lldb::addr_t load_addr = section_sp ? section_sp->GetLoadBaseAddress(&target) : LLDB_INVALID_ADDRESS;
+            if (load_addr != LLDB_INVALID_ADDRESS)
+                slide = load_addr - section_sp->GetFileAddress();
+        }
+        if (slide == LLDB_INVALID_ADDRESS)
+            continue;
+
+        UUID uuid(module_sp->GetUUID());
+        const uint32_t uuid_size = uuid.IsValid() ? uuid.GetByteSize() : 0;
+        const std::string path(module_sp->GetFileSpec().GetPath());
+        const uint32_t path_size = path.size();
+
+        const size_t record_offset = desc.size();
+        const size_t record_size = sizeof(uint64_t) + 2 * sizeof(uint32_t) + uuid_size + path_size;
+        desc.resize(record_offset + ((record_size + 7) & ~7), 0);
+        uint8_t *record = &desc[record_offset];
+        const uint64_t slide64 = slide;
+        memcpy(record, &slide64, sizeof(slide64));
+        record += sizeof(slide64);
+        memcpy(record, &uuid_size, sizeof(uuid_size));
+        record += sizeof(uuid_size);
+        memcpy(record, &path_size, sizeof(path_size));
+        record += sizeof(path_size);
+        if (uuid_size > 0)
+            memcpy(record, uuid.GetBytes(), uuid_size);
+        memcpy(record + uuid_size, path.data(), path_size);
+    }
+    if (!desc.empty())
+        AddNote("LLDB", NT_LLDB_MODULES, &desc[0], desc.size());
+}
+
+bool
+LinuxCoreWriter::AddThreadNotes(lldb::tid_t tid, bool add_process_notes)
+{
+    elf_prstatus prstatus;
+    memset(&prstatus, 0, sizeof(prstatus));
+    if (!m_monitor.ReadGPR(tid, &prstatus.pr_reg, sizeof(prstatus.pr_reg)))
+        return false;
+
+    siginfo_t info;
+    int ptrace_err;
+    if (m_monitor.GetSignalInfo(tid, &info, ptrace_err))
+    {
+        prstatus.pr_info.si_signo = info.si_signo;
+        prstatus.pr_info.si_code = info.si_code;
+        prstatus.pr_info.si_errno = info.si_errno;
+        prstatus.pr_cursig = info.si_signo;
+    }
+    prstatus.pr_pid = tid;
+    prstatus.pr_ppid = m_ppid;
+    prstatus.pr_pgrp = m_pgrp;
+    prstatus.pr_sid = m_sid;
+    AddNote("CORE", NT_PRSTATUS, &prstatus, sizeof(prstatus));
+
+    const struct user_regs_struct *regs = (const struct user_regs_struct *)&prstatus.pr_reg;
+#if defined(__x86_64__)
+    m_stack_pointers.push_back(regs->rsp);
+#elif defined(__i386__)
+    m_stack_pointers.push_back(regs->esp);
+#endif
+
+    if (add_process_notes)
+        AddProcessNotes();
+
+    elf_fpregset_t fpregset;
+    if (m_monitor.ReadFPR(tid, &fpregset, sizeof(fpregset)))
+        AddNote("CORE", NT_FPREGSET, &fpregset, sizeof(fpregset));
+    return true;
+}
+
+size_t
+LinuxCoreWriter::ReadMemory(lldb::addr_t addr, void *buf, size_t size)
+{
+    size_t bytes_read = 0;
+#if defined(__NR_process_vm_readv)
+    // One system call copies a whole chunk, ptrace would take one per word.
+    while (m_use_process_vm_readv && bytes_read < size)
+    {
+        struct iovec local_iov = { (uint8_t *)buf + bytes_read, size - bytes_read };
+        struct iovec remote_iov = { (void *)(uintptr_t)(addr + bytes_read), size - bytes_read };
+        const ssize_t result = syscall(__NR_process_vm_readv, m_pid, &local_iov, 1, &remote_iov, 1, 0);
+        if (result > 0)
+            bytes_read += result;
+        else if (result < 0 && (errno == ENOSYS || errno == EPERM))
+            m_use_process_vm_readv = false;
+        else
+            return bytes_read;  // Stopped at a page that can't be read
+    }
+#else
+    m_use_process_vm_readv = false;
+#endif
+
+    if (bytes_read < size && !m_use_process_vm_readv)
+    {
+        Error error;
+        bytes_read += m_monitor.ReadMemory(addr + bytes_read, (uint8_t *)buf + bytes_read, size - bytes_read, error);
+    }
+    return bytes_read;
+}
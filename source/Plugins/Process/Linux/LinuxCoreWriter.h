@@ -0,0 +1,114 @@
+//===-- LinuxCoreWriter.h ---------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef liblldb_LinuxCoreWriter_H_
+#define liblldb_LinuxCoreWriter_H_
+
+// C Includes
+// C++ Includes
+#include <string>
+#include <vector>
+
+// Other libraries and framework includes
+// Project includes
+#include "lldb/lldb-forward.h"
+#include "lldb/lldb-types.h"
+#include "lldb/Core/Error.h"
+#include "lldb/Host/FileSpec.h"
+
+class ProcessLinux;
+class ProcessMonitor;
+
+/// @class LinuxCoreWriter
+/// @brief Writes an ELF core file of a stopped Linux process.
+///
+/// The core has the same layout as the ones the kernel writes: a PT_NOTE
+/// segment with the process (NT_PRPSINFO, NT_AUXV, NT_FILE) and thread
+/// (NT_PRSTATUS, NT_FPREGSET) notes, and a PT_LOAD segment for each
+/// mapping in /proc/<pid>/maps.  Memory is read with process_vm_readv in
+/// large chunks and written out as it is read.
+///
+/// An "LLDB" note lists the loaded modules with their build IDs and load
+/// slides, so cores that leave out the dynamic loader's data, like the
+/// stacks only ones, can still be symbolicated.  See ProcessElfCore.
+class LinuxCoreWriter
+{
+public:
+    LinuxCoreWriter(ProcessLinux &process, ProcessMonitor &monitor);
+
+    /// Writes the core to @p outfile, with the memory @p options selects.
+    /// Mappings that are left out are still listed in the NT_FILE note.
+    lldb_private::Error
+    Write(const lldb_private::FileSpec &outfile, const lldb_private::SaveCoreOptions &options);
+
+private:
+    struct Mapping
+    {
+        lldb::addr_t start;
+        lldb::addr_t end;
+        uint64_t file_offset;
+        uint32_t flags;         // PF_R, PF_W and PF_X
+        bool is_file;
+        bool include;           // Whether the whole mapping goes in the core
+        std::string path;
+    };
+
+    // A PT_LOAD segment.
+    struct Segment
+    {
+        lldb::addr_t start;
+        lldb::addr_t end;
+        uint32_t flags;
+
+        bool
+        operator<(const Segment &rhs) const
+        {
+            return start < rhs.start;
+        }
+    };
+
+    bool
+    ReadMappings(const lldb_private::SaveCoreOptions &options, lldb_private::Error &error);
+
+    void
+    MakeSegments(bool stacks_only);
+
+    void
+    AddNote(const char *name, uint32_t type, const void *desc, size_t desc_size);
+
+    void
+    AddProcessNotes();
+
+    void
+    AddModulesNote();
+
+    bool
+    AddThreadNotes(lldb::tid_t tid, bool add_process_notes);
+
+    void
+    ReadProcessStatus();
+
+    size_t
+    ReadMemory(lldb::addr_t addr, void *buf, size_t size);
+
+    ProcessLinux &m_process;
+    ProcessMonitor &m_monitor;
+    lldb::pid_t m_pid;
+    int m_ppid;
+    int m_pgrp;
+    int m_sid;
+    char m_state;
+    std::vector<Mapping> m_mappings;
+    std::vector<Segment> m_segments;
+    std::vector<lldb::addr_t> m_stack_pointers;
+    std::vector<uint8_t> m_notes;
+    bool m_use_process_vm_readv;
+};
+
+#endif // #ifndef liblldb_LinuxCoreWriter_H_
@@ -11,6 +11,9 @@
 #include <errno.h>
 
 // C++ Includes
+#include <memory>
+#include <vector>
+
 // Other libraries and framework includes
 #include "lldb/Core/PluginManager.h"
 #include "lldb/Core/State.h"
@@ -23,6 +26,7 @@
 #include "ProcessPOSIXLog.h"
 #include "Plugins/Process/Utility/InferiorCallPOSIX.h"
 #include "ProcessMonitor.h"
+#include "LinuxCoreWriter.h"
 #include "LinuxThread.h"
 
 using namespace lldb;
@@ -164,6 +168,41 @@ ProcessLinux::DoDetach(bool keep_stopped)
     return error;
 }
 
+Error
+ProcessLinux::SaveCore(const FileSpec &outfile, const SaveCoreOptions &options)
+{
+    Error error;
+    if (!m_monitor || !StateIsStoppedState(GetPrivateState(), false))
+    {
+        error.SetErrorString("the process must be stopped to save a core file");
+        return error;
+    }
+
+    Mutex::Locker lock(m_thread_list.GetMutex());
+
+    // In non-stop mode the process can be stopped while some threads still
+    // run.  Their registers can't be read and they would change the memory
+    // while it is saved, so the core would be incomplete.
+    if (IsNonStopMode())
+    {
+        const uint32_t thread_count = m_thread_list.GetSize(false);
+        for (uint32_t i = 0; i < thread_count; ++i)
+        {
+            POSIXThread *thread = static_cast<POSIXThread*>(
+                m_thread_list.GetThreadAtIndex(i, false).get());
+            if (thread && thread->IsRunningInNonStopMode())
+            {
+                error.SetErrorStringWithFormat("thread %" PRIu64 " is still running, stop all threads to save a core file",
+                                               thread->GetID());
+                return error;
+            }
+        }
+    }
+
+    LinuxCoreWriter writer(*this, *m_monitor);
+    return writer.Write(outfile, options);
+}
+
 
 // ProcessPOSIX override
 void
@@ -197,10 +236,78 @@ ProcessLinux::StopAllThreads(lldb::tid_t stop_tid)
 
     m_stopping_threads = false;
 
+    // Every thread is stopped, so memory can go through the main thread.
+    m_monitor->SetMemoryTID(LLDB_INVALID_THREAD_ID);
+
     if (log)
         log->Printf ("ProcessLinux::%s() finished", __FUNCTION__);
 }
 
+// ProcessPOSIX override
+void
+ProcessLinux::StopOnlyThread(lldb::tid_t stop_tid)
+{
+    Log *log (ProcessPOSIXLog::GetLogIfAllCategoriesSet (POSIX_LOG_PROCESS));
+    if (log)
+        log->Printf ("ProcessLinux::%s() non-stop mode, only thread %" PRIu64 " is stopped", __FUNCTION__, stop_tid);
+
+    // The main thread may be running, and ptrace can only reach memory
+    // through a stopped thread.
+    m_monitor->SetMemoryTID(stop_tid);
+}
+
+void
+ProcessLinux::RefreshStateAfterStop()
+{
+    ProcessPOSIX::RefreshStateAfterStop();
+    ReadAllThreadsGPRs();
+}
+
+void
+ProcessLinux::ReadAllThreadsGPRs()
+{
+    // Nearly every stop reads at least the PC of every thread.  Reading the
+    // registers of all threads in one batch saves a trip to the monitor's
+    // operation thread per thread, which matters with thousands of threads.
+    if (!m_monitor)
+        return;
+
+    Mutex::Locker thread_list_lock(m_thread_list.GetMutex());
+
+    std::vector<lldb::tid_t> tids;
+    std::vector<POSIXBreakpointProtocol *> reg_ctxs;
+    size_t gpr_size = 0;
+    const uint32_t thread_count = m_thread_list.GetSize(false);
+    for (uint32_t i = 0; i < thread_count; ++i)
+    {
+        POSIXThread *thread = static_cast<POSIXThread*>(
+            m_thread_list.GetThreadAtIndex(i, false).get());
+        if (!thread)
+            continue;
+        POSIXBreakpointProtocol *reg_ctx = thread->GetPOSIXBreakpointProtocol();
+        if (!reg_ctx)
+            continue;
+        const size_t size = reg_ctx->GetGPRBufferSize();
+        if (size == 0 || (gpr_size && size != gpr_size))
+            continue;
+        gpr_size = size;
+        tids.push_back(thread->GetID());
+        reg_ctxs.push_back(reg_ctx);
+    }
+
+    if (tids.empty())
+        return;
+
+    std::vector<uint8_t> gprs(tids.size() * gpr_size);
+    std::unique_ptr<bool[]> results(new bool[tids.size()]);
+    m_monitor->ReadGPRs(&tids[0], tids.size(), &gprs[0], gpr_size, results.get());
+    for (size_t i = 0; i < tids.size(); ++i)
+    {
+        if (results[i])
+            reg_ctxs[i]->SupplyGPR(&gprs[i * gpr_size]);
+    }
+}
+
 // ProcessPOSIX override
 POSIXThread *
 ProcessLinux::CreateNewPOSIXThread(lldb_private::Process &process, lldb::tid_t tid)
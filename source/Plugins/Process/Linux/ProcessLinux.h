@@ -26,6 +26,8 @@ class ProcessMonitor;
 class ProcessLinux :
     public ProcessPOSIX
 {
+    friend class LinuxCoreWriter;
+
 public:
     //------------------------------------------------------------------
     // Static functions.
@@ -92,17 +94,35 @@ public:
     virtual bool
     CanDebug(lldb_private::Target &target, bool plugin_specified_by_name);
 
+    virtual lldb_private::Error
+    SaveCore(const lldb_private::FileSpec &outfile, const lldb_private::SaveCoreOptions &options);
+
+    virtual void
+    RefreshStateAfterStop();
+
     //------------------------------------------------------------------
     // ProcessPOSIX overrides
     //------------------------------------------------------------------
     virtual void
     StopAllThreads(lldb::tid_t stop_tid);
 
+    virtual bool
+    SupportsNonStopMode() { return true; }
+
+    virtual void
+    StopOnlyThread(lldb::tid_t stop_tid);
+
     virtual POSIXThread *
     CreateNewPOSIXThread(lldb_private::Process &process, lldb::tid_t tid);
 
 private:
 
+    /// Reads the general purpose registers of all stopped threads with a
+    /// single ProcessMonitor operation, and hands them to their register
+    /// contexts.
+    void
+    ReadAllThreadsGPRs();
+
     /// Linux-specific signal set.
     LinuxSignals m_linux_signals;
 
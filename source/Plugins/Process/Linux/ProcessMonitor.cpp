@@ -23,6 +23,8 @@
 #include <sys/wait.h>
 
 // C++ Includes
+#include <vector>
+
 // Other libraries and framework includes
 #include "lldb/Core/Debugger.h"
 #include "lldb/Core/Error.h"
@@ -426,9 +428,9 @@ private:
 void
 ReadOperation::Execute(ProcessMonitor *monitor)
 {
-    lldb::pid_t pid = monitor->GetPID();
+    lldb::tid_t tid = monitor->GetMemoryTID();
 
-    m_result = DoReadMemory(pid, m_addr, m_buff, m_size, m_error);
+    m_result = DoReadMemory(tid, m_addr, m_buff, m_size, m_error);
 }
 
 //------------------------------------------------------------------------------
@@ -456,9 +458,9 @@ private:
 void
 WriteOperation::Execute(ProcessMonitor *monitor)
 {
-    lldb::pid_t pid = monitor->GetPID();
+    lldb::tid_t tid = monitor->GetMemoryTID();
 
-    m_result = DoWriteMemory(pid, m_addr, m_buff, m_size, m_error);
+    m_result = DoWriteMemory(tid, m_addr, m_buff, m_size, m_error);
 }
 
 
@@ -1017,8 +1019,10 @@ ProcessMonitor::ProcessMonitor(ProcessPOSIX *process,
       m_operation_thread(LLDB_INVALID_HOST_THREAD),
       m_monitor_thread(LLDB_INVALID_HOST_THREAD),
       m_pid(LLDB_INVALID_PROCESS_ID),
+      m_memory_tid(LLDB_INVALID_THREAD_ID),
       m_terminal_fd(-1),
-      m_operation(0)
+      m_operations(NULL),
+      m_num_operations(0)
 {
     std::unique_ptr<LaunchArgs> args(new LaunchArgs(this, module, argv, envp,
                                      stdin_path, stdout_path, stderr_path,
@@ -1070,8 +1074,10 @@ ProcessMonitor::ProcessMonitor(ProcessPOSIX *process,
       m_operation_thread(LLDB_INVALID_HOST_THREAD),
       m_monitor_thread(LLDB_INVALID_HOST_THREAD),
       m_pid(LLDB_INVALID_PROCESS_ID),
+      m_memory_tid(LLDB_INVALID_THREAD_ID),
       m_terminal_fd(-1),
-      m_operation(0)
+      m_operations(NULL),
+      m_num_operations(0)
 {
     sem_init(&m_operation_pending, 0, 0);
     sem_init(&m_operation_done, 0, 0);
@@ -2064,25 +2070,36 @@ ProcessMonitor::ServeOperation(OperationArgs *args)
         // wait for next pending operation
         sem_wait(&monitor->m_operation_pending);
 
-        monitor->m_operation->Execute(monitor);
+        for (size_t i = 0; i < monitor->m_num_operations; ++i)
+            monitor->m_operations[i]->Execute(monitor);
 
-        // notify calling thread that operation is complete
+        // notify calling thread that the operations are complete
         sem_post(&monitor->m_operation_done);
     }
 }
 
 void
 ProcessMonitor::DoOperation(Operation *op)
+{
+    DoOperations(&op, 1);
+}
+
+void
+ProcessMonitor::DoOperations(Operation **ops, size_t num_ops)
 {
     Mutex::Locker lock(m_operation_mutex);
 
-    m_operation = op;
+    m_operations = ops;
+    m_num_operations = num_ops;
 
-    // notify operation thread that an operation is ready to be processed
+    // notify operation thread that operations are ready to be processed
     sem_post(&m_operation_pending);
 
-    // wait for operation to complete
+    // wait for the operations to complete
     sem_wait(&m_operation_done);
+
+    m_operations = NULL;
+    m_num_operations = 0;
 }
 
 size_t
@@ -2134,6 +2151,37 @@ ProcessMonitor::ReadGPR(lldb::tid_t tid, void *buf, size_t buf_size)
     return result;
 }
 
+size_t
+ProcessMonitor::ReadGPRs(const lldb::tid_t *tids, size_t num_tids, void *buf, size_t buf_size, bool *results)
+{
+    if (num_tids == 0)
+        return 0;
+
+    std::vector<ReadGPROperation> ops;
+    std::vector<Operation *> op_ptrs;
+    ops.reserve(num_tids);
+    op_ptrs.reserve(num_tids);
+    for (size_t i = 0; i < num_tids; ++i)
+    {
+        ops.push_back(ReadGPROperation(tids[i], (uint8_t *)buf + i * buf_size, buf_size, results[i]));
+        op_ptrs.push_back(&ops.back());
+    }
+    DoOperations(&op_ptrs[0], op_ptrs.size());
+
+    size_t num_read = 0;
+    for (size_t i = 0; i < num_tids; ++i)
+    {
+        if (results[i])
+            ++num_read;
+    }
+
+    Log *log (ProcessPOSIXLog::GetLogIfAllCategoriesSet (POSIX_LOG_REGISTERS));
+    if (log)
+        log->Printf ("ProcessMonitor::%s() read the registers of %" PRIu64 " of %" PRIu64 " threads",
+                     __FUNCTION__, (uint64_t)num_read, (uint64_t)num_tids);
+    return num_read;
+}
+
 bool
 ProcessMonitor::ReadFPR(lldb::tid_t tid, void *buf, size_t buf_size)
 {
@@ -72,6 +72,20 @@ public:
     lldb::pid_t
     GetPID() const { return m_pid; }
 
+    /// Sets the thread whose ptrace requests read and write memory.  Memory
+    /// can only be accessed through a stopped thread, which in non-stop mode
+    /// may not be the main one.  LLDB_INVALID_THREAD_ID selects the main
+    /// thread.
+    void
+    SetMemoryTID(lldb::tid_t tid) { m_memory_tid = tid; }
+
+    /// Returns the thread used to access memory.
+    lldb::tid_t
+    GetMemoryTID() const
+    {
+        return m_memory_tid == LLDB_INVALID_THREAD_ID ? m_pid : m_memory_tid;
+    }
+
     /// Returns the process associated with this ProcessMonitor.
     ProcessLinux &
     GetProcess() { return *m_process; }
@@ -125,6 +139,16 @@ public:
     bool
     ReadGPR(lldb::tid_t tid, void *buf, size_t buf_size);
 
+    /// Reads the general purpose registers of several threads with a
+    /// single trip to the operation thread.  The registers of @p tids[i]
+    /// are read into @p buf + i * @p buf_size, and @p results[i] is set
+    /// to whether that succeeded.
+    ///
+    /// @return
+    ///     The number of threads whose registers were read.
+    size_t
+    ReadGPRs(const lldb::tid_t *tids, size_t num_tids, void *buf, size_t buf_size, bool *results);
+
     /// Reads generic floating point registers into the specified buffer.
     bool
     ReadFPR(lldb::tid_t tid, void *buf, size_t buf_size);
@@ -199,10 +223,12 @@ private:
     lldb::thread_t m_operation_thread;
     lldb::thread_t m_monitor_thread;
     lldb::pid_t m_pid;
+    lldb::tid_t m_memory_tid;
     int m_terminal_fd;
 
-    // current operation which must be executed on the priviliged thread
-    Operation *m_operation;
+    // current operations which must be executed on the priviliged thread
+    Operation **m_operations;
+    size_t m_num_operations;
     lldb_private::Mutex m_operation_mutex;
 
     // semaphores notified when Operation is ready to be processed and when
@@ -312,6 +338,11 @@ private:
     void
     DoOperation(Operation *op);
 
+    /// Executes all of @p ops on the operation thread, in order, with a
+    /// single hand-off.
+    void
+    DoOperations(Operation **ops, size_t num_ops);
+
     /// Stops the child monitor thread.
     void
     StopMonitoringChildProcess();
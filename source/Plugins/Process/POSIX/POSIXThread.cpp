@@ -96,6 +96,7 @@ POSIXThread::RefreshStateAfterStop()
     // register supply functions where they check the process stop ID and do
     // the right thing.
     //if (StateIsStoppedState(GetState())
+    if (!IsRunningInNonStopMode())
     {
         const bool force = false;
         GetRegisterContext()->InvalidateIfNeeded (force);
@@ -245,10 +246,26 @@ POSIXThread::GetThreadPointer ()
 bool
 POSIXThread::CalculateStopInfo()
 {
+    // A thread that is still running didn't stop for any reason, whatever
+    // it stopped for last time.
+    if (IsRunningInNonStopMode())
+        m_stop_info_sp.reset();
     SetStopInfo (m_stop_info_sp);
     return true;
 }
 
+bool
+POSIXThread::IsRunningInNonStopMode()
+{
+    if (GetState() != lldb::eStateRunning)
+        return false;
+    ProcessSP base = GetProcess();
+    if (!base)
+        return false;
+    ProcessPOSIX &process = static_cast<ProcessPOSIX&>(*base);
+    return process.IsNonStopMode();
+}
+
 Unwind *
 POSIXThread::GetUnwinder()
 {
@@ -288,6 +305,11 @@ POSIXThread::Resume()
         log->Printf ("POSIXThread::%s (), resume_state = %s", __FUNCTION__,
                          StateAsCString(resume_state));
 
+    // Registers cached since the last stop won't be valid once we run.
+    if (m_reg_context_sp &&
+        (resume_state == lldb::eStateRunning || resume_state == lldb::eStateStepping))
+        m_reg_context_sp->InvalidateAllRegisters();
+
     switch (resume_state)
     {
     default:
@@ -296,6 +318,12 @@ POSIXThread::Resume()
         break;
 
     case lldb::eStateRunning:
+        // In non-stop mode the threads that didn't stop are still running.
+        if (GetState() == lldb::eStateRunning)
+        {
+            status = true;
+            break;
+        }
         SetState(resume_state);
         status = monitor.Resume(GetID(), GetResumeSignal());
         break;
@@ -83,6 +83,11 @@ public:
 
     void Notify(const ProcessMessage &message);
 
+    // True if this thread is still running in non-stop mode while the
+    // process is stopped for another thread.  It has no registers, frames
+    // or stop info until it stops.
+    bool IsRunningInNonStopMode();
+
     //--------------------------------------------------------------------------
     // These methods provide an interface to watchpoints
     //
@@ -94,7 +99,6 @@ public:
 
     uint32_t FindVacantWatchpointIndex();
 
-protected:
     POSIXBreakpointProtocol *
     GetPOSIXBreakpointProtocol ()
     {
@@ -102,7 +106,8 @@ protected:
             m_reg_context_sp = GetRegisterContext();
         return m_posix_thread;
     }
-    
+
+protected:
     std::unique_ptr<lldb_private::StackFrame> m_frame_ap;
 
     lldb::BreakpointSiteSP m_breakpoint;
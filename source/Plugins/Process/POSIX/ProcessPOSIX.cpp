@@ -284,6 +284,26 @@ ProcessPOSIX::DoResume()
     return Error();
 }
 
+bool
+ProcessPOSIX::HasPendingStop()
+{
+    if (!IsNonStopMode())
+        return false;
+
+    // A thread that stopped while we were stopped hasn't been reported yet
+    // (its PC still points past the breakpoint), so it must be reported
+    // before anything runs.
+    Mutex::Locker message_lock(m_message_mutex);
+    if (m_message_queue.empty())
+        return false;
+
+    Log *log (ProcessPOSIXLog::GetLogIfAllCategoriesSet (POSIX_LOG_PROCESS));
+    if (log)
+        log->Printf ("ProcessPOSIX::%s() %d pending stop(s)",
+                     __FUNCTION__, (int)m_message_queue.size());
+    return true;
+}
+
 addr_t
 ProcessPOSIX::GetImageInfoAddress()
 {
@@ -439,13 +459,25 @@ ProcessPOSIX::SendMessage(const ProcessMessage &message)
             return;
         // Intentional fall-through
 
+    case ProcessMessage::eCrashMessage:
+        assert(thread);
+        thread->SetState(eStateStopped);
+        StopAllThreads(message.GetTID());
+        SetPrivateState(eStateStopped);
+        break;
+
     case ProcessMessage::eBreakpointMessage:
     case ProcessMessage::eTraceMessage:
     case ProcessMessage::eWatchpointMessage:
-    case ProcessMessage::eCrashMessage:
         assert(thread);
         thread->SetState(eStateStopped);
-        StopAllThreads(message.GetTID());
+        // In non-stop mode the other threads keep running while this one is
+        // stopped.  If we are already stopped the message waits in the queue
+        // until the next resume reports it.
+        if (IsNonStopMode())
+            StopOnlyThread(message.GetTID());
+        else
+            StopAllThreads(message.GetTID());
         SetPrivateState(eStateStopped);
         break;
 
@@ -483,6 +515,18 @@ ProcessPOSIX::StopAllThreads(lldb::tid_t stop_tid)
     // FIXME: Will this work the same way on FreeBSD and Linux?
 }
 
+bool
+ProcessPOSIX::IsNonStopMode()
+{
+    return SupportsNonStopMode() && GetNonStopMode();
+}
+
+void
+ProcessPOSIX::StopOnlyThread(lldb::tid_t stop_tid)
+{
+    // Only plug-ins that support non-stop mode get here.
+}
+
 bool
 ProcessPOSIX::AddThreadForInitialStopIfNeeded(lldb::tid_t stop_tid)
 {
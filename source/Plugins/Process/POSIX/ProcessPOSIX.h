@@ -66,6 +66,9 @@ public:
     virtual lldb_private::Error
     DoResume();
 
+    virtual bool
+    HasPendingStop();
+
     virtual lldb_private::Error
     DoHalt(bool &caused_stop);
 
@@ -166,6 +169,21 @@ public:
     virtual void
     StopAllThreads(lldb::tid_t stop_tid);
 
+    /// Returns true if the plug-in can stop one thread while leaving the
+    /// others running.
+    virtual bool
+    SupportsNonStopMode() { return false; }
+
+    /// Returns true if breakpoints, watchpoints and single steps should only
+    /// stop the thread they happened in (the process "non-stop-mode" setting).
+    bool
+    IsNonStopMode();
+
+    /// Called instead of StopAllThreads in non-stop mode.
+    /// The \p stop_tid parameter indicates the only thread which is stopped.
+    virtual void
+    StopOnlyThread(lldb::tid_t stop_tid);
+
     /// Adds the thread to the list of threads for which we have received the initial stopping signal.
     /// The \p stop_tid paramter indicates the thread which the stop happened for.
     bool
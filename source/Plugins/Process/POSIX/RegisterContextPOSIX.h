@@ -66,6 +66,23 @@ public:
     virtual uint32_t
     NumSupportedHardwareWatchpoints () = 0;
 
+    /// Returns the size of the buffer the general purpose registers are
+    /// read into, or zero if they can't be supplied with SupplyGPR.
+    virtual size_t
+    GetGPRBufferSize ()
+    {
+        return 0;
+    }
+
+    /// Takes general purpose registers that were read for this thread
+    /// along with those of other threads, so they don't have to be read
+    /// one at a time.  The registers stay cached until the register
+    /// context is invalidated.
+    virtual void
+    SupplyGPR (const void *buf)
+    {
+    }
+
 protected:
     bool m_watchpoints_initialized;
 };
@@ -10,6 +10,7 @@
 #include "lldb/Target/Thread.h"
 #include "lldb/Core/RegisterValue.h"
 
+#include "POSIXThread.h"
 #include "ProcessPOSIX.h"
 #include "RegisterContextPOSIXProcessMonitor_x86.h"
 #include "ProcessMonitor.h"
@@ -54,7 +55,8 @@ size_and_rw_bits(size_t size, bool read, bool write)
 RegisterContextPOSIXProcessMonitor_x86_64::RegisterContextPOSIXProcessMonitor_x86_64(Thread &thread,
                                                                                      uint32_t concrete_frame_idx,
                                                                                      RegisterInfoInterface *register_info)
-    : RegisterContextPOSIX_x86(thread, concrete_frame_idx, register_info)
+    : RegisterContextPOSIX_x86(thread, concrete_frame_idx, register_info),
+      m_gpr_valid(false)
 {
 }
 
@@ -66,16 +68,30 @@ RegisterContextPOSIXProcessMonitor_x86_64::GetMonitor()
     return process->GetMonitor();
 }
 
+// In non-stop mode a thread can still be running while the process is
+// stopped for another one.  ptrace can't read its registers, so don't
+// ask it to (this is what keeps a running thread from being unwound).
+bool
+RegisterContextPOSIXProcessMonitor_x86_64::IsThreadRunning()
+{
+    return static_cast<POSIXThread &>(m_thread).IsRunningInNonStopMode();
+}
+
 bool
 RegisterContextPOSIXProcessMonitor_x86_64::ReadGPR()
 {
+     if (IsThreadRunning())
+         return false;
      ProcessMonitor &monitor = GetMonitor();
-     return monitor.ReadGPR(m_thread.GetID(), &m_gpr_x86_64, GetGPRSize());
+     m_gpr_valid = monitor.ReadGPR(m_thread.GetID(), &m_gpr_x86_64, GetGPRSize());
+     return m_gpr_valid;
 }
 
 bool
 RegisterContextPOSIXProcessMonitor_x86_64::ReadFPR()
 {
+    if (IsThreadRunning())
+        return false;
     ProcessMonitor &monitor = GetMonitor();
     if (GetFPRType() == eFXSAVE)
         return monitor.ReadFPR(m_thread.GetID(), &m_fpr.xstate.fxsave, sizeof(m_fpr.xstate.fxsave));
@@ -89,7 +105,8 @@ bool
 RegisterContextPOSIXProcessMonitor_x86_64::WriteGPR()
 {
     ProcessMonitor &monitor = GetMonitor();
-    return monitor.WriteGPR(m_thread.GetID(), &m_gpr_x86_64, GetGPRSize());
+    m_gpr_valid = monitor.WriteGPR(m_thread.GetID(), &m_gpr_x86_64, GetGPRSize());
+    return m_gpr_valid;
 }
 
 bool
@@ -108,6 +125,19 @@ bool
 RegisterContextPOSIXProcessMonitor_x86_64::ReadRegister(const unsigned reg,
                                                         RegisterValue &value)
 {
+    // Take general purpose registers from the cache the way PTRACE_PEEKUSER
+    // would return them, a word at the register's offset.
+    const unsigned offset = GetRegisterOffset(reg);
+    if (m_gpr_valid && offset + sizeof(long) <= GetGPRSize())
+    {
+        long data;
+        ::memcpy (&data, (const uint8_t *)&m_gpr_x86_64 + offset, sizeof(data));
+        value = (lldb::addr_t)data;
+        return true;
+    }
+
+    if (IsThreadRunning())
+        return false;
     ProcessMonitor &monitor = GetMonitor();
     return monitor.ReadRegisterValue(m_thread.GetID(),
                                      GetRegisterOffset(reg),
@@ -163,6 +193,7 @@ RegisterContextPOSIXProcessMonitor_x86_64::WriteRegister(const unsigned reg,
         }
     }
 
+    m_gpr_valid = false;
     ProcessMonitor &monitor = GetMonitor();
     return monitor.WriteRegisterValue(m_thread.GetID(),
                                       GetRegisterOffset(reg_to_write),
@@ -630,3 +661,23 @@ RegisterContextPOSIXProcessMonitor_x86_64::NumSupportedHardwareWatchpoints()
     return 4;
 }
 
+size_t
+RegisterContextPOSIXProcessMonitor_x86_64::GetGPRBufferSize()
+{
+    const size_t gpr_size = GetGPRSize();
+    return gpr_size <= sizeof(m_gpr_x86_64) ? gpr_size : 0;
+}
+
+void
+RegisterContextPOSIXProcessMonitor_x86_64::SupplyGPR(const void *buf)
+{
+    ::memcpy (&m_gpr_x86_64, buf, GetGPRBufferSize());
+    m_gpr_valid = true;
+}
+
+void
+RegisterContextPOSIXProcessMonitor_x86_64::InvalidateAllRegisters()
+{
+    m_gpr_valid = false;
+    RegisterContextPOSIX_x86::InvalidateAllRegisters();
+}
@@ -87,9 +87,24 @@ protected:
     uint32_t
     NumSupportedHardwareWatchpoints();
 
+    size_t
+    GetGPRBufferSize();
+
+    void
+    SupplyGPR(const void *buf);
+
+    // lldb_private::RegisterContext
+    void
+    InvalidateAllRegisters();
+
 private:
     ProcessMonitor &
     GetMonitor();
+
+    bool
+    IsThreadRunning();
+
+    bool m_gpr_valid; // True if m_gpr_x86_64 holds the thread's registers
 };
 
 #endif
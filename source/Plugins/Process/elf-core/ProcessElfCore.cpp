@@ -89,6 +89,8 @@ ProcessElfCore::ProcessElfCore(Target& target, Listener &listener,
     m_dyld_plugin_name (),
     m_thread_data_valid(false),
     m_thread_data(),
+    m_auxv (),
+    m_modules (),
     m_core_aranges ()
 {
 }
@@ -210,12 +212,67 @@ ProcessElfCore::DoLoadCore ()
     if (arch.IsValid())
         m_target.SetArchitecture(arch);            
 
+    if (m_modules.GetByteSize() > 0)
+        LoadModulesFromNote();
+
     return error;
 }
 
+void
+ProcessElfCore::LoadModulesFromNote ()
+{
+    Log *log (ProcessPOSIXLog::GetLogIfAllCategoriesSet (POSIX_LOG_PROCESS));
+    Target &target = GetTarget();
+    ModuleList loaded_modules;
+
+    // Each record is the slide of the module's file addresses, the sizes
+    // of its UUID and of its path, then the UUID and the path, padded to
+    // 8 bytes.
+    lldb::offset_t offset = 0;
+    while (m_modules.ValidOffsetForDataOfSize(offset, 16))
+    {
+        const lldb::offset_t record_offset = offset;
+        const lldb::addr_t slide = m_modules.GetU64(&offset);
+        const uint32_t uuid_size = m_modules.GetU32(&offset);
+        const uint32_t path_size = m_modules.GetU32(&offset);
+        const void *uuid_bytes = uuid_size > 0 ? m_modules.GetData(&offset, uuid_size) : NULL;
+        const char *path = (const char *)m_modules.GetData(&offset, path_size);
+        if ((uuid_size > 0 && uuid_bytes == NULL) || path == NULL)
+            break;
+        offset = record_offset + llvm::RoundUpToAlignment(offset - record_offset, 8);
+
+        ModuleSpec module_spec (FileSpec (std::string (path, path_size).c_str(), false), target.GetArchitecture());
+        if (uuid_bytes)
+            module_spec.GetUUID().SetBytes (uuid_bytes, uuid_size);
+
+        Error module_error;
+        lldb::ModuleSP module_sp (target.GetSharedModule (module_spec, &module_error));
+        if (!module_sp)
+        {
+            if (log)
+                log->Printf ("ProcessElfCore::%s couldn't find module %s: %s", __FUNCTION__,
+                             module_spec.GetFileSpec().GetPath().c_str(), module_error.AsCString("not found"));
+            continue;
+        }
+
+        bool changed = false;
+        module_sp->SetLoadAddress (target, slide, changed);
+        if (changed)
+            loaded_modules.AppendIfNeeded (module_sp);
+    }
+
+    if (loaded_modules.GetSize() > 0)
+        target.ModulesDidLoad (loaded_modules);
+}
+
 lldb_private::DynamicLoader *
 ProcessElfCore::GetDynamicLoader ()
 {
+    // The modules of cores that list them are already loaded, and the
+    // dynamic loader's data may not even be in the core.
+    if (m_modules.GetByteSize() > 0)
+        return NULL;
+
     if (m_dyld_ap.get() == NULL)
         m_dyld_ap.reset (DynamicLoader::FindPlugin(this, DynamicLoaderPOSIXDYLD::GetPluginNameStatic().GetCString()));
     return m_dyld_ap.get();
@@ -228,6 +285,15 @@ ProcessElfCore::UpdateThreadList (ThreadList &old_thread_list, ThreadList &new_t
     if (!m_thread_data_valid)
         return false;
 
+    // The threads of a core never change, so keep the ones we already
+    // made rather than making thousands of them again.
+    if (old_thread_list.GetSize(false) == num_threads)
+    {
+        for (uint32_t idx = 0; idx < num_threads; ++idx)
+            new_thread_list.AddThread (old_thread_list.GetThreadAtIndex (idx, false));
+        return num_threads > 0;
+    }
+
     for (lldb::tid_t tid = 0; tid < num_threads; ++tid)
     {
         const ThreadData &td = m_thread_data[tid];
@@ -315,6 +381,29 @@ ProcessElfCore::DoReadMemory (lldb::addr_t addr, void *buf, size_t size, Error &
     return bytes_copied + zero_fill_size;
 }
 
+bool
+ProcessElfCore::GetMemoryData (lldb::addr_t addr, size_t size, DataExtractor &data)
+{
+    ObjectFile *core_objfile = m_core_module_sp->GetObjectFile();
+
+    if (core_objfile == NULL || size == 0)
+        return false;
+
+    const VMRangeToFileOffset::Entry *address_range = m_core_aranges.FindEntryThatContains (addr);
+    if (address_range == NULL)
+        return false;
+
+    // The whole core file is memory mapped, so memory that is all in one
+    // segment can be handed out as is. Memory that isn't in the file
+    // needs zero filling, let DoReadMemory do that.
+    const lldb::addr_t offset = addr - address_range->GetRangeBase();
+    const lldb::addr_t file_size = address_range->data.GetByteSize();
+    if (offset >= file_size || size > file_size - offset)
+        return false;
+
+    return core_objfile->GetData (address_range->data.GetRangeBase() + offset, size, data) == size;
+}
+
 void
 ProcessElfCore::Clear()
 {
@@ -355,6 +444,11 @@ enum {
     NT_AUXV
 };
 
+// The "LLDB" note written by LinuxCoreWriter
+enum {
+    NT_LLDB_MODULES = 1
+};
+
 enum {
     NT_FREEBSD_PRSTATUS      = 1,
     NT_FREEBSD_FPREGSET,
@@ -424,7 +518,7 @@ ProcessElfCore::ParseThreadContextsFromNoteSegment(const elf::ELFProgramHeader *
     assert(segment_header && segment_header->p_type == llvm::ELF::PT_NOTE);
 
     lldb::offset_t offset = 0;
-    ThreadData *thread_data = new ThreadData();
+    ThreadData thread_data = ThreadData();
     bool have_prstatus = false;
     bool have_prpsinfo = false;
 
@@ -444,10 +538,10 @@ ProcessElfCore::ParseThreadContextsFromNoteSegment(const elf::ELFProgramHeader *
         if ((note.n_type == NT_PRSTATUS && have_prstatus) ||
             (note.n_type == NT_PRPSINFO && have_prpsinfo))
         {
-            assert(thread_data->gpregset.GetByteSize() > 0);
+            assert(thread_data.gpregset.GetByteSize() > 0);
             // Add the new thread to thread list
-            m_thread_data.push_back(*thread_data);
-            thread_data = new ThreadData();
+            m_thread_data.push_back(thread_data);
+            thread_data = ThreadData();
             have_prstatus = false;
             have_prpsinfo = false;
         }
@@ -464,16 +558,16 @@ ProcessElfCore::ParseThreadContextsFromNoteSegment(const elf::ELFProgramHeader *
             {
                 case NT_FREEBSD_PRSTATUS:
                     have_prstatus = true;
-                    ParseFreeBSDPrStatus(thread_data, note_data, arch);
+                    ParseFreeBSDPrStatus(&thread_data, note_data, arch);
                     break;
                 case NT_FREEBSD_FPREGSET:
-                    thread_data->fpregset = note_data;
+                    thread_data.fpregset = note_data;
                     break;
                 case NT_FREEBSD_PRPSINFO:
                     have_prpsinfo = true;
                     break;
                 case NT_FREEBSD_THRMISC:
-                    ParseFreeBSDThrMisc(thread_data, note_data);
+                    ParseFreeBSDThrMisc(&thread_data, note_data);
                     break;
                 case NT_FREEBSD_PROCSTAT_AUXV:
                     // FIXME: FreeBSD sticks an int at the beginning of the note
@@ -483,6 +577,11 @@ ProcessElfCore::ParseThreadContextsFromNoteSegment(const elf::ELFProgramHeader *
                     break;
             }
         }
+        else if (note.n_name == "LLDB")
+        {
+            if (note.n_type == NT_LLDB_MODULES)
+                m_modules = note_data;
+        }
         else
         {
             switch (note.n_type)
@@ -490,18 +589,18 @@ ProcessElfCore::ParseThreadContextsFromNoteSegment(const elf::ELFProgramHeader *
                 case NT_PRSTATUS:
                     have_prstatus = true;
                     prstatus.Parse(note_data, arch);
-                    thread_data->signo = prstatus.pr_cursig;
+                    thread_data.signo = prstatus.pr_cursig;
                     header_size = ELFLinuxPrStatus::GetSize(arch);
                     len = note_data.GetByteSize() - header_size;
-                    thread_data->gpregset = DataExtractor(note_data, header_size, len);
+                    thread_data.gpregset = DataExtractor(note_data, header_size, len);
                     break;
                 case NT_FPREGSET:
-                    thread_data->fpregset = note_data;
+                    thread_data.fpregset = note_data;
                     break;
                 case NT_PRPSINFO:
                     have_prpsinfo = true;
                     prpsinfo.Parse(note_data, arch);
-                    thread_data->name = prpsinfo.pr_fname;
+                    thread_data.name = prpsinfo.pr_fname;
                     break;
                 case NT_AUXV:
                     m_auxv = DataExtractor(note_data);
@@ -514,9 +613,9 @@ ProcessElfCore::ParseThreadContextsFromNoteSegment(const elf::ELFProgramHeader *
         offset += note_size;
     }
     // Add last entry in the note section
-    if (thread_data && thread_data->gpregset.GetByteSize() > 0)
+    if (thread_data.gpregset.GetByteSize() > 0)
     {
-        m_thread_data.push_back(*thread_data);
+        m_thread_data.push_back(thread_data);
     }
 }
 
@@ -111,6 +111,9 @@ public:
     
     virtual size_t
     DoReadMemory (lldb::addr_t addr, void *buf, size_t size, lldb_private::Error &error);
+
+    virtual bool
+    GetMemoryData (lldb::addr_t addr, size_t size, lldb_private::DataExtractor &data);
     
     virtual lldb::addr_t
     GetImageInfoAddress ();
@@ -151,6 +154,10 @@ private:
     // AUXV structure found from the NOTE segment
     lldb_private::DataExtractor m_auxv;
 
+    // Loaded modules found in the "LLDB" NOTE entry of cores that lldb
+    // saved, see LinuxCoreWriter
+    lldb_private::DataExtractor m_modules;
+
     // Address ranges found in the core
     VMRangeToFileOffset m_core_aranges;
 
@@ -166,6 +173,11 @@ private:
     // Parse a contiguous address range of the process from LOAD segment
     lldb::addr_t
     AddAddressRangeFromLoadSegment(const elf::ELFProgramHeader *header);
+
+    // Add the modules listed in m_modules to the target at their load
+    // addresses
+    void
+    LoadModulesFromNote();
 };
 
 #endif  // liblldb_ProcessElffCore_h_
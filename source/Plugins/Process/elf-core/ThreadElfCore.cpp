@@ -47,7 +47,11 @@ ThreadElfCore::~ThreadElfCore ()
 void
 ThreadElfCore::RefreshStateAfterStop()
 {
-    GetRegisterContext()->InvalidateIfNeeded (false);
+    // The registers in a core never change. Don't make a register context
+    // for every thread when the core is loaded, only for the ones that are
+    // looked at.
+    if (m_reg_context_sp)
+        m_reg_context_sp->InvalidateIfNeeded (false);
 }
 
 void
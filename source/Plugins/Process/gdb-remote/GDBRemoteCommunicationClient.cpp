@@ -24,6 +24,7 @@
 #include "lldb/Core/State.h"
 #include "lldb/Core/StreamGDBRemote.h"
 #include "lldb/Core/StreamString.h"
+#include "lldb/Expression/AgentExpression.h"
 #include "lldb/Host/Endian.h"
 #include "lldb/Host/Host.h"
 #include "lldb/Host/TimeValue.h"
@@ -69,6 +70,7 @@ GDBRemoteCommunicationClient::GDBRemoteCommunicationClient(bool is_platform) :
     m_supports_p (eLazyBoolCalculate),
     m_avoid_g_packets (eLazyBoolCalculate),
     m_supports_QSaveRegisterState (eLazyBoolCalculate),
+    m_supports_conditional_breakpoints (eLazyBoolCalculate),
     m_supports_qProcessInfoPID (true),
     m_supports_qfProcessInfo (true),
     m_supports_qUserName (true),
@@ -231,6 +233,35 @@ GDBRemoteCommunicationClient::GetSyncThreadStateSupported ()
         return false;
 }
 
+bool
+GDBRemoteCommunicationClient::GetConditionalBreakpointsSupported ()
+{
+    if (m_supports_conditional_breakpoints == eLazyBoolCalculate)
+    {
+        m_supports_conditional_breakpoints = eLazyBoolNo;
+
+        StringExtractorGDBRemote response;
+        if (SendPacketAndWaitForResponse("qSupported", response, false) == PacketResult::Success)
+        {
+            // The reply is a ';' separated list of "name+", "name-",
+            // "name?" and "name=value" features.
+            std::string features (response.GetStringRef());
+            size_t pos = 0;
+            while (pos != std::string::npos)
+            {
+                const size_t end = features.find(';', pos);
+                if (features.compare(pos, end == std::string::npos ? std::string::npos : end - pos, "ConditionalBreakpoints+") == 0)
+                {
+                    m_supports_conditional_breakpoints = eLazyBoolYes;
+                    break;
+                }
+                pos = (end == std::string::npos) ? end : end + 1;
+            }
+        }
+    }
+    return m_supports_conditional_breakpoints == eLazyBoolYes;
+}
+
 
 void
 GDBRemoteCommunicationClient::ResetDiscoverableSettings()
@@ -244,6 +275,7 @@ GDBRemoteCommunicationClient::ResetDiscoverableSettings()
     m_supports_vCont_S = eLazyBoolCalculate;
     m_supports_p = eLazyBoolCalculate;
     m_supports_QSaveRegisterState = eLazyBoolCalculate;
+    m_supports_conditional_breakpoints = eLazyBoolCalculate;
     m_qHostInfo_is_valid = eLazyBoolCalculate;
     m_qProcessInfo_is_valid = eLazyBoolCalculate;
     m_qGDBServerVersion_is_valid = eLazyBoolCalculate;
@@ -2568,7 +2600,11 @@ GDBRemoteCommunicationClient::GetThreadStopInfo (lldb::tid_t tid, StringExtracto
 
 
 uint8_t
-GDBRemoteCommunicationClient::SendGDBStoppointTypePacket (GDBStoppointType type, bool insert,  addr_t addr, uint32_t length)
+GDBRemoteCommunicationClient::SendGDBStoppointTypePacket (GDBStoppointType type,
+                                                          bool insert,
+                                                          addr_t addr,
+                                                          uint32_t length,
+                                                          const std::vector<const AgentExpression *> *conditions)
 {
     switch (type)
     {
@@ -2579,18 +2615,21 @@ GDBRemoteCommunicationClient::SendGDBStoppointTypePacket (GDBStoppointType type,
     case eWatchpointReadWrite:  if (!m_supports_z4) return UINT8_MAX; break;
     }
 
-    char packet[64];
-    const int packet_len = ::snprintf (packet, 
-                                       sizeof(packet), 
-                                       "%c%i,%" PRIx64 ",%x",
-                                       insert ? 'Z' : 'z', 
-                                       type, 
-                                       addr, 
-                                       length);
+    StreamString packet;
+    packet.Printf ("%c%i,%" PRIx64 ",%x", insert ? 'Z' : 'z', type, addr, length);
+    if (insert && conditions && !conditions->empty())
+    {
+        // Append each condition as ";X<len>,<bytecode as hex>"
+        for (size_t i=0; i<conditions->size(); ++i)
+        {
+            const std::vector<uint8_t> &opcodes = (*conditions)[i]->GetOpcodes();
+            packet.Printf (";X%" PRIx64 ",", (uint64_t)opcodes.size());
+            packet.PutBytesAsRawHex8 (&opcodes[0], opcodes.size());
+        }
+    }
 
-    assert (packet_len + 1 < (int)sizeof(packet));
     StringExtractorGDBRemote response;
-    if (SendPacketAndWaitForResponse(packet, packet_len, response, true) == PacketResult::Success)
+    if (SendPacketAndWaitForResponse(packet.GetData(), packet.GetSize(), response, true) == PacketResult::Success)
     {
         if (response.IsOKResponse())
             return 0;
@@ -263,6 +263,13 @@ public:
     
     bool
     GetSyncThreadStateSupported();
+
+    //------------------------------------------------------------------
+    /// Ask the remote stub, with "qSupported", whether it can evaluate
+    /// agent expression conditions sent along with "Z0" packets.
+    //------------------------------------------------------------------
+    bool
+    GetConditionalBreakpointsSupported ();
     
     void
     ResetDiscoverableSettings();
@@ -343,7 +350,8 @@ public:
     SendGDBStoppointTypePacket (GDBStoppointType type,   // Type of breakpoint or watchpoint
                                 bool insert,              // Insert or remove?
                                 lldb::addr_t addr,        // Address of breakpoint or watchpoint
-                                uint32_t length);         // Byte Size of breakpoint or watchpoint
+                                uint32_t length,          // Byte Size of breakpoint or watchpoint
+                                const std::vector<const lldb_private::AgentExpression *> *conditions = NULL); // Conditions for the stub to evaluate, see GetConditionalBreakpointsSupported()
 
     void
     TestPacketSpeed (const uint32_t num_packets);
@@ -507,6 +515,7 @@ protected:
     lldb_private::LazyBool m_supports_p;
     lldb_private::LazyBool m_avoid_g_packets;
     lldb_private::LazyBool m_supports_QSaveRegisterState;
+    lldb_private::LazyBool m_supports_conditional_breakpoints;
     
     bool
         m_supports_qProcessInfoPID:1,
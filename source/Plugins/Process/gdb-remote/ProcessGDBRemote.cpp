@@ -28,6 +28,7 @@
 
 // Other libraries and framework includes
 
+#include "lldb/Breakpoint/BreakpointLocation.h"
 #include "lldb/Breakpoint/Watchpoint.h"
 #include "lldb/Interpreter/Args.h"
 #include "lldb/Core/ArchSpec.h"
@@ -282,7 +283,8 @@ ProcessGDBRemote::ProcessGDBRemote(Target& target, Listener &listener) :
     m_waiting_for_attach (false),
     m_destroy_tried_resuming (false),
     m_command_sp (),
-    m_breakpoint_pc_offset (0)
+    m_breakpoint_pc_offset (0),
+    m_conditional_bp_site_ids ()
 {
     m_async_broadcaster.SetEventName (eBroadcastBitAsyncThreadShouldExit,   "async thread should exit");
     m_async_broadcaster.SetEventName (eBroadcastBitAsyncContinue,           "async thread continue");
@@ -2341,8 +2343,22 @@ ProcessGDBRemote::EnableBreakpointSite (BreakpointSite *bp_site)
         }
         else if (m_gdb_comm.SupportsGDBStoppointPacket (eBreakpointSoftware))
         {
-            if (m_gdb_comm.SendGDBStoppointTypePacket(eBreakpointSoftware, true, addr, bp_op_size) == 0)
+            // If the remote stub can evaluate the conditions of all of the
+            // site's owners, send them along so it only stops when one of
+            // them is true.
+            std::vector<const AgentExpression *> conditions;
+            const bool has_conditions = GetBreakpointSiteConditions (bp_site, conditions);
+            if (m_gdb_comm.SendGDBStoppointTypePacket(eBreakpointSoftware, true, addr, bp_op_size, &conditions) == 0)
             {
+                if (has_conditions)
+                    m_conditional_bp_site_ids.insert (site_id);
+                else
+                    m_conditional_bp_site_ids.erase (site_id);
+                if (log && has_conditions)
+                    log->Printf ("ProcessGDBRemote::EnableBreakpointSite (size_id = %" PRIu64 ") address = 0x%" PRIx64 " -- sent %" PRIu64 " conditions",
+                                 site_id,
+                                 (uint64_t)addr,
+                                 (uint64_t)conditions.size());
                 bp_site->SetEnabled(true);
                 bp_site->SetType (BreakpointSite::eExternal);
                 return error;
@@ -2412,6 +2428,51 @@ ProcessGDBRemote::DisableBreakpointSite (BreakpointSite *bp_site)
     return error;
 }
 
+void
+ProcessGDBRemote::UpdateBreakpointSiteConditions (BreakpointSite *bp_site)
+{
+    // Only breakpoints the remote stub inserted for us with "Z0" can have
+    // conditions.
+    if (bp_site == NULL || !bp_site->IsEnabled() || bp_site->GetType() != BreakpointSite::eExternal)
+        return;
+
+    std::vector<const AgentExpression *> conditions;
+    if (!GetBreakpointSiteConditions (bp_site, conditions) &&
+        m_conditional_bp_site_ids.find (bp_site->GetID()) == m_conditional_bp_site_ids.end())
+        return;
+
+    // Stubs reference count "Z0" packets for the same address, so remove
+    // the breakpoint and insert it again with the new conditions.
+    DisableBreakpointSite (bp_site);
+    if (!bp_site->IsEnabled())
+        EnableBreakpointSite (bp_site);
+}
+
+bool
+ProcessGDBRemote::GetBreakpointSiteConditions (BreakpointSite *bp_site,
+                                               std::vector<const AgentExpression *> &conditions)
+{
+    conditions.clear();
+    if (!m_gdb_comm.GetConditionalBreakpointsSupported())
+        return false;
+
+    // The stub can only skip a hit if none of the site's owners would
+    // have stopped, so every owner needs a condition it can evaluate.
+    const size_t num_owners = bp_site->GetNumberOfOwners();
+    for (size_t i = 0; i < num_owners; ++i)
+    {
+        BreakpointLocationSP location_sp (bp_site->GetOwnerAtIndex (i));
+        const AgentExpression *condition = location_sp ? location_sp->GetConditionBytecode() : NULL;
+        if (condition == NULL)
+        {
+            conditions.clear();
+            return false;
+        }
+        conditions.push_back (condition);
+    }
+    return !conditions.empty();
+}
+
 // Pre-requisite: wp != NULL.
 static GDBStoppointType
 GetGDBStoppointType (Watchpoint *wp)
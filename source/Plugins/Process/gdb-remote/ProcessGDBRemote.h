@@ -14,6 +14,7 @@
 
 // C++ Includes
 #include <list>
+#include <set>
 #include <vector>
 
 // Other libraries and framework includes
@@ -195,6 +196,9 @@ public:
     virtual lldb_private::Error
     DisableBreakpointSite (lldb_private::BreakpointSite *bp_site);
 
+    virtual void
+    UpdateBreakpointSiteConditions (lldb_private::BreakpointSite *bp_site);
+
     //----------------------------------------------------------------------
     // Process Watchpoints
     //----------------------------------------------------------------------
@@ -344,6 +348,7 @@ protected:
     bool m_destroy_tried_resuming;
     lldb::CommandObjectSP m_command_sp;
     int64_t m_breakpoint_pc_offset;
+    std::set<lldb::user_id_t> m_conditional_bp_site_ids; // Breakpoint sites whose conditions were sent with their "Z0" packet
     
     bool
     StartAsyncThread ();
@@ -390,6 +395,10 @@ protected:
     lldb_private::DynamicLoader *
     GetDynamicLoader ();
 
+    bool
+    GetBreakpointSiteConditions (lldb_private::BreakpointSite *bp_site,
+                                 std::vector<const lldb_private::AgentExpression *> &conditions);
+
 private:
     //------------------------------------------------------------------
     // For ProcessGDBRemote only
@@ -25,6 +25,7 @@
 #include "clang/Sema/DeclSpec.h"
 
 #include "llvm/Support/Casting.h"
+#include "llvm/Support/MD5.h"
 
 #include "lldb/Core/Module.h"
 #include "lldb/Core/PluginManager.h"
@@ -34,9 +35,12 @@
 #include "lldb/Core/StreamFile.h"
 #include "lldb/Core/StreamString.h"
 #include "lldb/Core/Timer.h"
+#include "lldb/Core/UUID.h"
 #include "lldb/Core/Value.h"
 
+#include "lldb/Host/File.h"
 #include "lldb/Host/Host.h"
+#include "lldb/Host/Mutex.h"
 
 #include "lldb/Symbol/Block.h"
 #include "lldb/Symbol/ClangExternalASTSourceCallbacks.h"
@@ -48,6 +52,7 @@
 
 #include "lldb/Target/ObjCLanguageRuntime.h"
 #include "lldb/Target/CPPLanguageRuntime.h"
+#include "lldb/Target/Target.h"
 
 #include "DWARFCompileUnit.h"
 #include "DWARFDebugAbbrev.h"
@@ -65,6 +70,7 @@
 #include "SymbolFileDWARFDebugMap.h"
 
 #include <map>
+#include <set>
 
 //#define ENABLE_DEBUG_PRINTF // COMMENT OUT THIS LINE PRIOR TO CHECKIN
 
@@ -1182,6 +1188,196 @@ SymbolFileDWARF::ParseCompileUnitSupportFiles (const SymbolContext& sc, FileSpec
     return false;
 }
 
+//----------------------------------------------------------------------
+// LineTableCache
+//
+// Saves the compact line tables of modules with a UUID in a file named
+// after the UUID and the size of the module's file in the
+// target.cache-path directory, so later sessions don't have to run the
+// .debug_line programs again.  The size is part of the name because the
+// UUID of an ELF file without a build ID is only the 32 bit CRC of the
+// file.  A file is a list of records that each hold the line table of a
+// compile unit:
+//
+//     uint32_t magic, version, .debug_line offset, number of entries
+//     uint32_t size of the entries, checksum of the entries
+//     uint8_t  entries[size], padded to 4 bytes
+//
+// Records are appended with one write as line tables are parsed, so a
+// cache file can be shared by several lldb processes.  Only the memory
+// mapped contents of the cache files are kept; the line tables written
+// in this session are read back from the file if they are needed again.
+//----------------------------------------------------------------------
+namespace {
+
+class LineTableCache
+{
+public:
+    static LineTableCache &
+    GetSharedInstance ()
+    {
+        // Never destroyed, it is used from any thread while modules parse.
+        static LineTableCache *g_cache = new LineTableCache();
+        return *g_cache;
+    }
+
+    static FileSpec
+    GetCacheFile (ObjectFile *objfile)
+    {
+        FileSpec cache_dir (Target::GetDefaultCachePath());
+        UUID uuid;
+        if (!cache_dir || objfile == NULL || !objfile->GetUUID (&uuid) || !uuid.IsValid())
+            return FileSpec();
+        const uint64_t file_size = objfile->GetFileSpec().GetByteSize();
+        if (file_size == 0)
+            return FileSpec();
+        StreamString path;
+        path.Printf ("%s/%s-%" PRIu64 ".lines", cache_dir.GetPath().c_str(), uuid.GetAsString().c_str(), file_size);
+        return FileSpec (path.GetData(), false);
+    }
+
+    bool
+    Lookup (const FileSpec &cache_file, dw_offset_t stmt_list, DataExtractor &data, uint32_t &num_entries)
+    {
+        Mutex::Locker locker (m_mutex);
+        CacheFile &file = ReadCacheFile (cache_file, false);
+        TableMap::const_iterator pos = file.tables.find (stmt_list);
+        if (pos == file.tables.end())
+        {
+            // It was written after the file was read, read it again.
+            if (file.written.find (stmt_list) == file.written.end())
+                return false;
+            ReadCacheFile (cache_file, true);
+            pos = file.tables.find (stmt_list);
+            if (pos == file.tables.end())
+                return false;
+        }
+        data = pos->second.data;
+        num_entries = pos->second.num_entries;
+        return true;
+    }
+
+    void
+    Insert (const FileSpec &cache_file, dw_offset_t stmt_list, const DataExtractor &data, uint32_t num_entries)
+    {
+        const uint32_t header[6] = { k_magic, k_version, stmt_list, num_entries, (uint32_t)data.GetByteSize(), GetChecksum (data) };
+        std::vector<uint8_t> record (sizeof(header) + ((data.GetByteSize() + 3) & ~3), 0);
+        memcpy (&record[0], header, sizeof(header));
+        memcpy (&record[sizeof(header)], data.GetDataStart(), data.GetByteSize());
+
+        Mutex::Locker locker (m_mutex);
+        CacheFile &file = ReadCacheFile (cache_file, false);
+        if (file.tables.find (stmt_list) != file.tables.end() || !file.written.insert (stmt_list).second)
+            return;
+
+        Log *log (LogChannelDWARF::GetLogIfAll (DWARF_LOG_DEBUG_LINE));
+        File output;
+        Error error (output.Open (cache_file.GetPath().c_str(),
+                                  File::eOpenOptionWrite | File::eOpenOptionAppend | File::eOpenOptionCanCreate,
+                                  lldb::eFilePermissionsFileDefault));
+        if (error.Success())
+        {
+            size_t bytes_written = record.size();
+            error = output.Write (&record[0], bytes_written);
+            if (error.Success() && bytes_written != record.size())
+                error.SetErrorString ("short write");
+        }
+        if (error.Fail() && log)
+            log->Printf ("LineTableCache::%s couldn't write to %s: %s", __FUNCTION__,
+                         cache_file.GetPath().c_str(), error.AsCString());
+    }
+
+private:
+    enum
+    {
+        k_magic = 0x4c54424c,   // 'LTBL'
+        k_version = 2
+    };
+
+    struct Table
+    {
+        DataExtractor data;     // Points into the mapped cache file
+        uint32_t num_entries;
+    };
+    typedef std::map<dw_offset_t, Table> TableMap;
+
+    struct CacheFile
+    {
+        TableMap tables;                // The tables in the file when it was read
+        std::set<dw_offset_t> written;  // The tables this process appended since
+    };
+    typedef std::map<std::string, CacheFile> FileMap;
+
+    LineTableCache () :
+        m_mutex (Mutex::eMutexTypeNormal),
+        m_files ()
+    {
+    }
+
+    static uint32_t
+    GetChecksum (const DataExtractor &data)
+    {
+        llvm::MD5 md5;
+        md5.update (llvm::ArrayRef<uint8_t> (data.GetDataStart(), data.GetByteSize()));
+        llvm::MD5::MD5Result result;
+        md5.final (result);
+        uint32_t checksum;
+        memcpy (&checksum, result, sizeof(checksum));
+        return checksum;
+    }
+
+    // Call with m_mutex locked.  Reads the cache file the first time, and
+    // again if reread is true.
+    CacheFile &
+    ReadCacheFile (const FileSpec &cache_file, bool reread)
+    {
+        const std::string path (cache_file.GetPath());
+        FileMap::iterator pos = m_files.find (path);
+        if (pos != m_files.end() && !reread)
+            return pos->second;
+
+        CacheFile &file = m_files[path];
+        file.tables.clear();
+        DataBufferSP data_sp;
+        if (cache_file.Exists())
+            data_sp = cache_file.MemoryMapFileContents();
+        if (!data_sp)
+            return file;
+
+        // Stop at the first record that doesn't look right, another
+        // process may be writing it.
+        DataExtractor file_data (data_sp, lldb::endian::InlHostByteOrder(), sizeof(lldb::addr_t));
+        lldb::offset_t offset = 0;
+        while (file_data.ValidOffsetForDataOfSize (offset, 6 * sizeof(uint32_t)))
+        {
+            const uint32_t magic = file_data.GetU32 (&offset);
+            const uint32_t version = file_data.GetU32 (&offset);
+            const dw_offset_t stmt_list = file_data.GetU32 (&offset);
+            const uint32_t num_entries = file_data.GetU32 (&offset);
+            const uint32_t size = file_data.GetU32 (&offset);
+            const uint32_t checksum = file_data.GetU32 (&offset);
+            if (magic != k_magic || version != k_version || !file_data.ValidOffsetForDataOfSize (offset, size))
+                break;
+            Table table = { DataExtractor (file_data, offset, size), num_entries };
+            if (GetChecksum (table.data) != checksum)
+                break;
+            file.tables.insert (std::make_pair (stmt_list, table));
+            offset += (size + 3) & ~3;
+        }
+
+        Log *log (LogChannelDWARF::GetLogIfAll (DWARF_LOG_DEBUG_LINE));
+        if (log)
+            log->Printf ("LineTableCache::%s read %" PRIu64 " line tables from %s", __FUNCTION__,
+                         (uint64_t)file.tables.size(), path.c_str());
+        return file;
+    }
+
+    Mutex m_mutex;
+    FileMap m_files;
+};
+
+} // anonymous namespace
+
 struct ParseDWARFLineTableCallbackInfo
 {
     LineTable* line_table;
@@ -1253,6 +1449,20 @@ SymbolFileDWARF::ParseCompileUnitLineTable (const SymbolContext &sc)
                 std::unique_ptr<LineTable> line_table_ap(new LineTable(sc.comp_unit));
                 if (line_table_ap.get())
                 {
+                    // Linked line tables from a debug map aren't cached.
+                    FileSpec cache_file;
+                    if (m_debug_map_symfile == NULL)
+                        cache_file = LineTableCache::GetCacheFile (m_obj_file);
+                    DataExtractor compact_data;
+                    uint32_t num_entries = 0;
+                    if (cache_file &&
+                        LineTableCache::GetSharedInstance().Lookup (cache_file, cu_line_offset, compact_data, num_entries) &&
+                        line_table_ap->SetCompactData (compact_data, num_entries))
+                    {
+                        sc.comp_unit->SetLineTable(line_table_ap.release());
+                        return true;
+                    }
+
                     ParseDWARFLineTableCallbackInfo info;
                     info.line_table = line_table_ap.get();
                     lldb::offset_t offset = cu_line_offset;
@@ -1267,6 +1477,12 @@ SymbolFileDWARF::ParseCompileUnitLineTable (const SymbolContext &sc)
                     }
                     else
                     {
+                        if (cache_file)
+                        {
+                            line_table_ap->Compact();
+                            if (line_table_ap->GetCompactData (compact_data, num_entries))
+                                LineTableCache::GetSharedInstance().Insert (cache_file, cu_line_offset, compact_data, num_entries);
+                        }
                         sc.comp_unit->SetLineTable(line_table_ap.release());
                         return true;
                     }
@@ -260,7 +260,11 @@ CompileUnit::SetLineTable(LineTable* line_table)
     if (line_table == NULL)
         m_flags.Clear(flagsParsedLineTable);
     else
+    {
         m_flags.Set(flagsParsedLineTable);
+        // Line tables are only searched once they are set.
+        line_table->Compact();
+    }
     m_line_table_ap.reset(line_table);
 }
 
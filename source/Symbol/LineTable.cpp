@@ -8,9 +8,11 @@
 //===----------------------------------------------------------------------===//
 
 #include "lldb/Core/Address.h"
+#include "lldb/Core/DataBufferHeap.h"
 #include "lldb/Core/Module.h"
 #include "lldb/Core/Section.h"
 #include "lldb/Core/Stream.h"
+#include "lldb/Core/StreamString.h"
 #include "lldb/Symbol/CompileUnit.h"
 #include "lldb/Symbol/LineTable.h"
 #include <algorithm>
@@ -18,12 +20,30 @@
 using namespace lldb;
 using namespace lldb_private;
 
+// A compact line table keeps a full copy of every this many entries.
+static const uint32_t k_checkpoint_interval = 16;
+
+// The flags byte of each entry in a compact line table.
+enum
+{
+    eEntryFlagStartOfStatement  = (1u << 0),
+    eEntryFlagStartOfBasicBlock = (1u << 1),
+    eEntryFlagPrologueEnd       = (1u << 2),
+    eEntryFlagEpilogueBegin     = (1u << 3),
+    eEntryFlagTerminal          = (1u << 4),
+    eEntryFlagColumnChanged     = (1u << 5),
+    eEntryFlagFileChanged       = (1u << 6)
+};
+
 //----------------------------------------------------------------------
 // LineTable constructor
 //----------------------------------------------------------------------
 LineTable::LineTable(CompileUnit* comp_unit) :
     m_comp_unit(comp_unit),
-    m_entries()
+    m_entries(),
+    m_compact_data(),
+    m_checkpoints(),
+    m_num_compact_entries(0)
 {
 }
 
@@ -50,6 +70,9 @@ LineTable::InsertLineEntry
 {
     Entry entry(file_addr, line, column, file_idx, is_start_of_statement, is_start_of_basic_block, is_prologue_end, is_epilogue_begin, is_terminal_entry);
 
+    if (IsCompact())
+        Expand();
+
     entry_collection::iterator begin_pos = m_entries.begin();
     entry_collection::iterator end_pos = m_entries.end();
     LineTable::Entry::LessThanBinaryPredicate less_than_bp(this);
@@ -107,6 +130,9 @@ LineTable::InsertSequence (LineSequence* sequence)
     if (seq->m_entries.empty())
         return;
     Entry& entry = seq->m_entries.front();
+
+    if (IsCompact())
+        Expand();
     
     // If the first entry address in this sequence is greater than or equal to
     // the address of the last item in our entry collection, just append.
@@ -165,13 +191,243 @@ LineTable::Entry::LessThanBinaryPredicate::operator() (const LineTable::Entry& a
 uint32_t
 LineTable::GetSize() const
 {
+    if (IsCompact())
+        return m_num_compact_entries;
     return m_entries.size();
 }
 
+//----------------------------------------------------------------------
+// Compact line tables
+//----------------------------------------------------------------------
+void
+LineTable::EncodeEntry (Stream &strm, const Entry &prev_entry, const Entry &entry)
+{
+    uint8_t flags = 0;
+    if (entry.is_start_of_statement)
+        flags |= eEntryFlagStartOfStatement;
+    if (entry.is_start_of_basic_block)
+        flags |= eEntryFlagStartOfBasicBlock;
+    if (entry.is_prologue_end)
+        flags |= eEntryFlagPrologueEnd;
+    if (entry.is_epilogue_begin)
+        flags |= eEntryFlagEpilogueBegin;
+    if (entry.is_terminal_entry)
+        flags |= eEntryFlagTerminal;
+    if (entry.column != prev_entry.column)
+        flags |= eEntryFlagColumnChanged;
+    if (entry.file_idx != prev_entry.file_idx)
+        flags |= eEntryFlagFileChanged;
+
+    strm.Write (&flags, 1);
+    // The entries are sorted by address, but the lines go up and down.
+    strm.PutSLEB128 ((int64_t)(entry.file_addr - prev_entry.file_addr));
+    strm.PutSLEB128 ((int64_t)entry.line - (int64_t)prev_entry.line);
+    if (flags & eEntryFlagColumnChanged)
+        strm.PutULEB128 (entry.column);
+    if (flags & eEntryFlagFileChanged)
+        strm.PutULEB128 (entry.file_idx);
+}
+
+bool
+LineTable::DecodeEntry (const DataExtractor &data, lldb::offset_t *offset_ptr, Entry &entry)
+{
+    if (!data.ValidOffset (*offset_ptr))
+        return false;
+
+    const uint8_t flags = data.GetU8 (offset_ptr);
+    entry.file_addr += data.GetSLEB128 (offset_ptr);
+    entry.line += data.GetSLEB128 (offset_ptr);
+    if (flags & eEntryFlagColumnChanged)
+        entry.column = data.GetULEB128 (offset_ptr);
+    if (flags & eEntryFlagFileChanged)
+        entry.file_idx = data.GetULEB128 (offset_ptr);
+    entry.is_start_of_statement = (flags & eEntryFlagStartOfStatement) != 0;
+    entry.is_start_of_basic_block = (flags & eEntryFlagStartOfBasicBlock) != 0;
+    entry.is_prologue_end = (flags & eEntryFlagPrologueEnd) != 0;
+    entry.is_epilogue_begin = (flags & eEntryFlagEpilogueBegin) != 0;
+    entry.is_terminal_entry = (flags & eEntryFlagTerminal) != 0;
+    return *offset_ptr <= data.GetByteSize();
+}
+
+void
+LineTable::Compact ()
+{
+    if (IsCompact() || m_entries.empty())
+        return;
+
+    StreamString strm (Stream::eBinary, sizeof(lldb::addr_t), lldb::endian::InlHostByteOrder());
+    checkpoint_collection checkpoints;
+    checkpoints.reserve ((m_entries.size() + k_checkpoint_interval - 1) / k_checkpoint_interval);
+    Entry prev_entry (0, 0, 0, 0, false, false, false, false, false);
+    const size_t count = m_entries.size();
+    for (size_t idx = 0; idx < count; ++idx)
+    {
+        const Entry &entry = m_entries[idx];
+        EncodeEntry (strm, prev_entry, entry);
+        if (idx % k_checkpoint_interval == 0)
+        {
+            Checkpoint checkpoint = { entry, strm.GetSize() };
+            checkpoints.push_back (checkpoint);
+        }
+        prev_entry = entry;
+    }
+
+    DataBufferSP data_sp (new DataBufferHeap (strm.GetData(), strm.GetSize()));
+    m_compact_data.SetData (data_sp);
+    m_compact_data.SetByteOrder (lldb::endian::InlHostByteOrder());
+    m_checkpoints.swap (checkpoints);
+    m_num_compact_entries = count;
+    entry_collection().swap (m_entries);
+}
+
+bool
+LineTable::GetCompactData (DataExtractor &data, uint32_t &num_entries) const
+{
+    if (!IsCompact())
+        return false;
+    data = m_compact_data;
+    num_entries = m_num_compact_entries;
+    return true;
+}
+
+bool
+LineTable::SetCompactData (const DataExtractor &data, uint32_t num_entries)
+{
+    if (num_entries == 0)
+        return false;
+
+    // Decode everything once to check the data and find the checkpoints.
+    checkpoint_collection checkpoints;
+    checkpoints.reserve ((num_entries + k_checkpoint_interval - 1) / k_checkpoint_interval);
+    Entry entry (0, 0, 0, 0, false, false, false, false, false);
+    lldb::offset_t offset = 0;
+    for (uint32_t idx = 0; idx < num_entries; ++idx)
+    {
+        if (!DecodeEntry (data, &offset, entry))
+            return false;
+        if (idx % k_checkpoint_interval == 0)
+        {
+            Checkpoint checkpoint = { entry, offset };
+            checkpoints.push_back (checkpoint);
+        }
+    }
+    if (offset != data.GetByteSize())
+        return false;
+
+    entry_collection().swap (m_entries);
+    m_compact_data = data;
+    m_checkpoints.swap (checkpoints);
+    m_num_compact_entries = num_entries;
+    return true;
+}
+
+void
+LineTable::Expand ()
+{
+    entry_collection entries;
+    entries.reserve (m_num_compact_entries);
+    EntryReader reader (*this);
+    for (bool valid = reader.SeekToIndex (0); valid; valid = reader.Next())
+        entries.push_back (reader.GetEntry());
+
+    m_entries.swap (entries);
+    m_compact_data.Clear();
+    checkpoint_collection().swap (m_checkpoints);
+    m_num_compact_entries = 0;
+}
+
+LineTable::EntryReader::EntryReader (const LineTable &line_table) :
+    m_line_table (line_table),
+    m_idx (UINT32_MAX),
+    m_offset (0),
+    m_entry ()
+{
+}
+
+bool
+LineTable::EntryReader::SeekToIndex (uint32_t idx)
+{
+    const uint32_t count = m_line_table.GetSize();
+    if (idx >= count)
+    {
+        m_idx = count;
+        return false;
+    }
+
+    m_idx = idx;
+    if (!m_line_table.IsCompact())
+    {
+        m_entry = m_line_table.m_entries[idx];
+        return true;
+    }
+
+    const Checkpoint &checkpoint = m_line_table.m_checkpoints[idx / k_checkpoint_interval];
+    m_entry = checkpoint.entry;
+    m_offset = checkpoint.next_offset;
+    for (uint32_t i = idx % k_checkpoint_interval; i > 0; --i)
+        DecodeEntry (m_line_table.m_compact_data, &m_offset, m_entry);
+    return true;
+}
+
+bool
+LineTable::EntryReader::Next ()
+{
+    const uint32_t count = m_line_table.GetSize();
+    if (m_idx >= count || m_idx + 1 == count)
+    {
+        m_idx = count;
+        return false;
+    }
+
+    ++m_idx;
+    if (m_line_table.IsCompact())
+        DecodeEntry (m_line_table.m_compact_data, &m_offset, m_entry);
+    else
+        m_entry = m_line_table.m_entries[m_idx];
+    return true;
+}
+
+bool
+LineTable::GetEntryAtIndex (uint32_t idx, Entry &entry) const
+{
+    EntryReader reader (*this);
+    if (!reader.SeekToIndex (idx))
+        return false;
+    entry = reader.GetEntry();
+    return true;
+}
+
+uint32_t
+LineTable::FindFirstEntryIndexAtOrAfter (lldb::addr_t file_addr) const
+{
+    if (!IsCompact())
+    {
+        Entry search_entry;
+        search_entry.file_addr = file_addr;
+        entry_collection::const_iterator pos = std::lower_bound (m_entries.begin(), m_entries.end(), search_entry, Entry::EntryAddressLessThan);
+        return std::distance (m_entries.begin(), pos);
+    }
+
+    // Start decoding at the last checkpoint that is before the address.
+    checkpoint_collection::const_iterator pos = std::lower_bound (m_checkpoints.begin(), m_checkpoints.end(), file_addr, Checkpoint::CheckpointAddressLessThan);
+    if (pos == m_checkpoints.begin())
+        return 0;
+    --pos;
+
+    EntryReader reader (*this);
+    reader.SeekToIndex (std::distance (m_checkpoints.begin(), pos) * k_checkpoint_interval);
+    while (reader.Next())
+    {
+        if (reader.GetEntry().file_addr >= file_addr)
+            break;
+    }
+    return reader.GetIndex();
+}
+
 bool
 LineTable::GetLineEntryAtIndex(uint32_t idx, LineEntry& line_entry)
 {
-    if (idx < m_entries.size())
+    if (idx < GetSize())
     {
         ConvertEntryAtIndexToLineEntry (idx, line_entry);
         return true;
@@ -190,62 +446,54 @@ LineTable::FindLineEntryByAddress (const Address &so_addr, LineEntry& line_entry
 
     if (so_addr.GetModule().get() == m_comp_unit->GetModule().get())
     {
-        Entry search_entry;
-        search_entry.file_addr = so_addr.GetFileAddress();
-        if (search_entry.file_addr != LLDB_INVALID_ADDRESS)
+        const lldb::addr_t file_addr = so_addr.GetFileAddress();
+        if (file_addr != LLDB_INVALID_ADDRESS)
         {
-            entry_collection::const_iterator begin_pos = m_entries.begin();
-            entry_collection::const_iterator end_pos = m_entries.end();
-            entry_collection::const_iterator pos = lower_bound(begin_pos, end_pos, search_entry, Entry::EntryAddressLessThan);
-            if (pos != end_pos)
+            const uint32_t count = GetSize();
+            uint32_t match_idx = FindFirstEntryIndexAtOrAfter (file_addr);
+            Entry entry;
+            if (GetEntryAtIndex (match_idx, entry))
             {
-                if (pos != begin_pos)
+                if (match_idx != 0)
                 {
-                    if (pos->file_addr != search_entry.file_addr)
-                        --pos;
-                    else if (pos->file_addr == search_entry.file_addr)
+                    if (entry.file_addr != file_addr)
+                        --match_idx;
+                    else
                     {
                         // If this is a termination entry, it should't match since
-                        // entries with the "is_terminal_entry" member set to true 
-                        // are termination entries that define the range for the 
+                        // entries with the "is_terminal_entry" member set to true
+                        // are termination entries that define the range for the
                         // previous entry.
-                        if (pos->is_terminal_entry)
+                        if (entry.is_terminal_entry)
                         {
                             // The matching entry is a terminal entry, so we skip
                             // ahead to the next entry to see if there is another
                             // entry following this one whose section/offset matches.
-                            ++pos;
-                            if (pos != end_pos)
-                            {
-                                if (pos->file_addr != search_entry.file_addr)
-                                    pos = end_pos;
-                            }
+                            ++match_idx;
+                            if (GetEntryAtIndex (match_idx, entry) && entry.file_addr != file_addr)
+                                match_idx = count;
                         }
-                        
-                        if (pos != end_pos)
+
+                        if (match_idx < count)
                         {
                             // While in the same section/offset backup to find the first
-                            // line entry that matches the address in case there are 
+                            // line entry that matches the address in case there are
                             // multiple
-                            while (pos != begin_pos)
-                            {
-                                entry_collection::const_iterator prev_pos = pos - 1;
-                                if (prev_pos->file_addr == search_entry.file_addr &&
-                                    prev_pos->is_terminal_entry == false)
-                                    --pos;
-                                else
-                                    break;
-                            }
+                            Entry prev_entry;
+                            while (match_idx != 0 &&
+                                   GetEntryAtIndex (match_idx - 1, prev_entry) &&
+                                   prev_entry.file_addr == file_addr &&
+                                   prev_entry.is_terminal_entry == false)
+                                --match_idx;
                         }
                     }
 
                 }
-                
+
                 // Make sure we have a valid match and that the match isn't a terminating
                 // entry for a previous line...
-                if (pos != end_pos && pos->is_terminal_entry == false)
+                if (GetEntryAtIndex (match_idx, entry) && entry.is_terminal_entry == false)
                 {
-                    uint32_t match_idx = std::distance (begin_pos, pos);
                     success = ConvertEntryAtIndexToLineEntry(match_idx, line_entry);
                     if (index_ptr != NULL && success)
                         *index_ptr = match_idx;
@@ -260,54 +508,64 @@ LineTable::FindLineEntryByAddress (const Address &so_addr, LineEntry& line_entry
 bool
 LineTable::ConvertEntryAtIndexToLineEntry (uint32_t idx, LineEntry &line_entry)
 {
-    if (idx < m_entries.size())
+    EntryReader reader (*this);
+    if (reader.SeekToIndex (idx))
+        return ConvertEntryToLineEntry (reader, line_entry);
+    return false;
+}
+
+bool
+LineTable::ConvertEntryToLineEntry (const EntryReader &reader, LineEntry &line_entry)
+{
+    const Entry& entry = reader.GetEntry();
+    ModuleSP module_sp (m_comp_unit->GetModule());
+    if (module_sp && module_sp->ResolveFileAddress(entry.file_addr, line_entry.range.GetBaseAddress()))
     {
-        const Entry& entry = m_entries[idx];
-        ModuleSP module_sp (m_comp_unit->GetModule());
-        if (module_sp && module_sp->ResolveFileAddress(entry.file_addr, line_entry.range.GetBaseAddress()))
-        {
-            if (!entry.is_terminal_entry && idx + 1 < m_entries.size())
-                line_entry.range.SetByteSize(m_entries[idx+1].file_addr - entry.file_addr);
-            else
-                line_entry.range.SetByteSize(0);
-
-            line_entry.file = m_comp_unit->GetSupportFiles().GetFileSpecAtIndex (entry.file_idx);
-            line_entry.line = entry.line;
-            line_entry.column = entry.column;
-            line_entry.is_start_of_statement = entry.is_start_of_statement;
-            line_entry.is_start_of_basic_block = entry.is_start_of_basic_block;
-            line_entry.is_prologue_end = entry.is_prologue_end;
-            line_entry.is_epilogue_begin = entry.is_epilogue_begin;
-            line_entry.is_terminal_entry = entry.is_terminal_entry;
-            return true;
-        }
+        EntryReader next_reader (reader);
+        if (!entry.is_terminal_entry && next_reader.Next())
+            line_entry.range.SetByteSize(next_reader.GetEntry().file_addr - entry.file_addr);
+        else
+            line_entry.range.SetByteSize(0);
+
+        line_entry.file = m_comp_unit->GetSupportFiles().GetFileSpecAtIndex (entry.file_idx);
+        line_entry.line = entry.line;
+        line_entry.column = entry.column;
+        line_entry.is_start_of_statement = entry.is_start_of_statement;
+        line_entry.is_start_of_basic_block = entry.is_start_of_basic_block;
+        line_entry.is_prologue_end = entry.is_prologue_end;
+        line_entry.is_epilogue_begin = entry.is_epilogue_begin;
+        line_entry.is_terminal_entry = entry.is_terminal_entry;
+        return true;
     }
     return false;
 }
 
 uint32_t
-LineTable::FindLineEntryIndexByFileIndex 
+LineTable::FindLineEntryIndexByFileIndex
 (
-    uint32_t start_idx, 
-    const std::vector<uint32_t> &file_indexes, 
-    uint32_t line, 
-    bool exact, 
+    uint32_t start_idx,
+    const std::vector<uint32_t> &file_indexes,
+    uint32_t line,
+    bool exact,
     LineEntry* line_entry_ptr
 )
 {
 
-    const size_t count = m_entries.size();
     std::vector<uint32_t>::const_iterator begin_pos = file_indexes.begin();
     std::vector<uint32_t>::const_iterator end_pos = file_indexes.end();
     size_t best_match = UINT32_MAX;
+    uint32_t best_line = 0;
 
-    for (size_t idx = start_idx; idx < count; ++idx)
+    EntryReader reader (*this);
+    for (bool valid = reader.SeekToIndex (start_idx); valid; valid = reader.Next())
     {
+        const Entry &entry = reader.GetEntry();
+
         // Skip line table rows that terminate the previous row (is_terminal_entry is non-zero)
-        if (m_entries[idx].is_terminal_entry)
+        if (entry.is_terminal_entry)
             continue;
 
-        if (find (begin_pos, end_pos, m_entries[idx].file_idx) == end_pos)
+        if (find (begin_pos, end_pos, entry.file_idx) == end_pos)
             continue;
 
         // Exact match always wins.  Otherwise try to find the closest line > the desired
@@ -315,22 +573,23 @@ LineTable::FindLineEntryIndexByFileIndex
         // FIXME: Maybe want to find the line closest before and the line closest after and
         // if they're not in the same function, don't return a match.
 
-        if (m_entries[idx].line < line)
+        if (entry.line < line)
         {
             continue;
         }
-        else if (m_entries[idx].line == line)
+        else if (entry.line == line)
         {
             if (line_entry_ptr)
-                ConvertEntryAtIndexToLineEntry (idx, *line_entry_ptr);
-            return idx;
+                ConvertEntryToLineEntry (reader, *line_entry_ptr);
+            return reader.GetIndex();
         }
         else if (!exact)
         {
-            if (best_match == UINT32_MAX)
-                best_match = idx;
-            else if (m_entries[idx].line < m_entries[best_match].line)
-                best_match = idx;
+            if (best_match == UINT32_MAX || entry.line < best_line)
+            {
+                best_match = reader.GetIndex();
+                best_line = entry.line;
+            }
         }
     }
 
@@ -346,16 +605,19 @@ LineTable::FindLineEntryIndexByFileIndex
 uint32_t
 LineTable::FindLineEntryIndexByFileIndex (uint32_t start_idx, uint32_t file_idx, uint32_t line, bool exact, LineEntry* line_entry_ptr)
 {
-    const size_t count = m_entries.size();
     size_t best_match = UINT32_MAX;
+    uint32_t best_line = 0;
 
-    for (size_t idx = start_idx; idx < count; ++idx)
+    EntryReader reader (*this);
+    for (bool valid = reader.SeekToIndex (start_idx); valid; valid = reader.Next())
     {
+        const Entry &entry = reader.GetEntry();
+
         // Skip line table rows that terminate the previous row (is_terminal_entry is non-zero)
-        if (m_entries[idx].is_terminal_entry)
+        if (entry.is_terminal_entry)
             continue;
 
-        if (m_entries[idx].file_idx != file_idx)
+        if (entry.file_idx != file_idx)
             continue;
 
         // Exact match always wins.  Otherwise try to find the closest line > the desired
@@ -363,22 +625,23 @@ LineTable::FindLineEntryIndexByFileIndex (uint32_t start_idx, uint32_t file_idx,
         // FIXME: Maybe want to find the line closest before and the line closest after and
         // if they're not in the same function, don't return a match.
 
-        if (m_entries[idx].line < line)
+        if (entry.line < line)
         {
             continue;
         }
-        else if (m_entries[idx].line == line)
+        else if (entry.line == line)
         {
             if (line_entry_ptr)
-                ConvertEntryAtIndexToLineEntry (idx, *line_entry_ptr);
-            return idx;
+                ConvertEntryToLineEntry (reader, *line_entry_ptr);
+            return reader.GetIndex();
         }
         else if (!exact)
         {
-            if (best_match == UINT32_MAX)
-                best_match = idx;
-            else if (m_entries[idx].line < m_entries[best_match].line)
-                best_match = idx;
+            if (best_match == UINT32_MAX || entry.line < best_line)
+            {
+                best_match = reader.GetIndex();
+                best_line = entry.line;
+            }
         }
     }
 
@@ -392,29 +655,31 @@ LineTable::FindLineEntryIndexByFileIndex (uint32_t start_idx, uint32_t file_idx,
 }
 
 size_t
-LineTable::FineLineEntriesForFileIndex (uint32_t file_idx, 
+LineTable::FineLineEntriesForFileIndex (uint32_t file_idx,
                                         bool append,
                                         SymbolContextList &sc_list)
 {
-    
+
     if (!append)
         sc_list.Clear();
 
     size_t num_added = 0;
-    const size_t count = m_entries.size();
-    if (count > 0)
+    if (GetSize() > 0)
     {
         SymbolContext sc (m_comp_unit);
 
-        for (size_t idx = 0; idx < count; ++idx)
+        EntryReader reader (*this);
+        for (bool valid = reader.SeekToIndex (0); valid; valid = reader.Next())
         {
+            const Entry &entry = reader.GetEntry();
+
             // Skip line table rows that terminate the previous row (is_terminal_entry is non-zero)
-            if (m_entries[idx].is_terminal_entry)
+            if (entry.is_terminal_entry)
                 continue;
-            
-            if (m_entries[idx].file_idx == file_idx)
+
+            if (entry.file_idx == file_idx)
             {
-                if (ConvertEntryAtIndexToLineEntry (idx, sc.line_entry))
+                if (ConvertEntryToLineEntry (reader, sc.line_entry))
                 {
                     ++num_added;
                     sc_list.Append(sc);
@@ -429,12 +694,12 @@ LineTable::FineLineEntriesForFileIndex (uint32_t file_idx,
 void
 LineTable::Dump (Stream *s, Target *target, Address::DumpStyle style, Address::DumpStyle fallback_style, bool show_line_ranges)
 {
-    const size_t count = m_entries.size();
     LineEntry line_entry;
     FileSpec prev_file;
-    for (size_t idx = 0; idx < count; ++idx)
+    EntryReader reader (*this);
+    for (bool valid = reader.SeekToIndex (0); valid; valid = reader.Next())
     {
-        ConvertEntryAtIndexToLineEntry (idx, line_entry);
+        ConvertEntryToLineEntry (reader, line_entry);
         line_entry.Dump (s, target, prev_file != line_entry.file, style, fallback_style, show_line_ranges);
         s->EOL();
         prev_file = line_entry.file;
@@ -445,11 +710,11 @@ LineTable::Dump (Stream *s, Target *target, Address::DumpStyle style, Address::D
 void
 LineTable::GetDescription (Stream *s, Target *target, DescriptionLevel level)
 {
-    const size_t count = m_entries.size();
     LineEntry line_entry;
-    for (size_t idx = 0; idx < count; ++idx)
+    EntryReader reader (*this);
+    for (bool valid = reader.SeekToIndex (0); valid; valid = reader.Next())
     {
-        ConvertEntryAtIndexToLineEntry (idx, line_entry);
+        ConvertEntryToLineEntry (reader, line_entry);
         line_entry.GetDescription (s, level, m_comp_unit, target, true);
         s->EOL();
     }
@@ -461,13 +726,12 @@ LineTable::GetContiguousFileAddressRanges (FileAddressRanges &file_ranges, bool
     if (!append)
         file_ranges.Clear();
     const size_t initial_count = file_ranges.GetSize();
-    
-    const size_t count = m_entries.size();
-    LineEntry line_entry;
+
     FileAddressRanges::Entry range (LLDB_INVALID_ADDRESS, 0);
-    for (size_t idx = 0; idx < count; ++idx)
+    EntryReader reader (*this);
+    for (bool valid = reader.SeekToIndex (0); valid; valid = reader.Next())
     {
-        const Entry& entry = m_entries[idx];
+        const Entry& entry = reader.GetEntry();
 
         if (entry.is_terminal_entry)
         {
@@ -491,17 +755,17 @@ LineTable::LinkLineTable (const FileRangeMap &file_range_map)
 {
     std::unique_ptr<LineTable> line_table_ap (new LineTable (m_comp_unit));
     LineSequenceImpl sequence;
-    const size_t count = m_entries.size();
     LineEntry line_entry;
     const FileRangeMap::Entry *file_range_entry = NULL;
     const FileRangeMap::Entry *prev_file_range_entry = NULL;
     lldb::addr_t prev_file_addr = LLDB_INVALID_ADDRESS;
     bool prev_entry_was_linked = false;
     bool range_changed = false;
-    for (size_t idx = 0; idx < count; ++idx)
+    EntryReader reader (*this);
+    for (bool valid = reader.SeekToIndex (0); valid; valid = reader.Next())
     {
-        const Entry& entry = m_entries[idx];
-        
+        const Entry& entry = reader.GetEntry();
+
         const bool end_sequence = entry.is_terminal_entry;
         const lldb::addr_t lookup_file_addr = entry.file_addr - (end_sequence ? 1 : 0);
         if (file_range_entry == NULL || !file_range_entry->Contains(lookup_file_addr))
@@ -524,7 +788,7 @@ LineTable::LinkLineTable (const FileRangeMap &file_range_map)
             {
                 prev_end_entry_linked_file_addr = std::min<lldb::addr_t>(entry.file_addr, prev_file_range_entry->GetRangeEnd()) - prev_file_range_entry->GetRangeBase() + prev_file_range_entry->data;
                 if (prev_end_entry_linked_file_addr != entry_linked_file_addr)
-                    terminate_previous_entry = prev_entry_was_linked;                
+                    terminate_previous_entry = prev_entry_was_linked;
             }
         }
         else if (prev_entry_was_linked)
@@ -539,7 +803,7 @@ LineTable::LinkLineTable (const FileRangeMap &file_range_map)
                 terminate_previous_entry = true;
             }
         }
-        
+
         if (terminate_previous_entry && !sequence.m_entries.empty())
         {
             assert (prev_file_addr != LLDB_INVALID_ADDRESS);
@@ -554,7 +818,7 @@ LineTable::LinkLineTable (const FileRangeMap &file_range_map)
             sequence.Clear();
             prev_entry_was_linked = false;
         }
-        
+
         // Now link the current entry
         if (file_range_entry)
         {
@@ -578,7 +842,7 @@ LineTable::LinkLineTable (const FileRangeMap &file_range_map)
         prev_file_addr = entry.file_addr;
         range_changed = false;
     }
-    if (line_table_ap->m_entries.empty())
+    if (line_table_ap->GetSize() == 0)
         return NULL;
     return line_table_ap.release();
 }
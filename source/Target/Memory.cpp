@@ -10,6 +10,7 @@
 #include "lldb/Target/Memory.h"
 // C Includes
 // C++ Includes
+#include <algorithm>
 // Other libraries and framework includes
 // Project includes
 #include "lldb/Core/DataBufferHeap.h"
@@ -379,6 +380,14 @@ AllocatedMemoryCache::Clear()
 }
 
 
+// Every expression allocates a handful of small structs, result
+// variables and code sections, and on some platforms each call to
+// DoAllocateMemory runs a function (mmap) in the inferior.  Allocating
+// regions this large up front means a typical debug session only needs
+// one region per set of permissions, which is then reused by every
+// expression after the first.
+static const size_t g_min_region_byte_size = 64 * 1024;
+
 AllocatedMemoryCache::AllocatedBlockSP
 AllocatedMemoryCache::AllocatePage (uint32_t byte_size, 
                                     uint32_t permissions, 
@@ -388,7 +397,7 @@ AllocatedMemoryCache::AllocatePage (uint32_t byte_size,
     AllocatedBlockSP block_sp;
     const size_t page_size = 4096;
     const size_t num_pages = (byte_size + page_size - 1) / page_size;
-    const size_t page_byte_size = num_pages * page_size;
+    const size_t page_byte_size = std::max<size_t> (num_pages * page_size, g_min_region_byte_size);
 
     addr_t addr = m_process.DoAllocateMemory(page_byte_size, permissions, error);
 
@@ -422,6 +431,8 @@ AllocatedMemoryCache::AllocateMemory (size_t byte_size,
     for (PermissionsToBlockMap::iterator pos = range.first; pos != range.second; ++pos)
     {
         addr = (*pos).second->ReserveBlock (byte_size);
+        if (addr != LLDB_INVALID_ADDRESS)
+            break;
     }
     
     if (addr == LLDB_INVALID_ADDRESS)
@@ -107,6 +107,8 @@ g_properties[] =
     { "python-os-plugin-path", OptionValue::eTypeFileSpec, false, true, NULL, NULL, "A path to a python OS plug-in module file that contains a OperatingSystemPlugIn class." },
     { "stop-on-sharedlibrary-events" , OptionValue::eTypeBoolean, true, false, NULL, NULL, "If true, stop when a shared library is loaded or unloaded." },
     { "detach-keeps-stopped" , OptionValue::eTypeBoolean, true, false, NULL, NULL, "If true, detach will attempt to keep the process stopped." },
+    { "non-stop-mode" , OptionValue::eTypeBoolean, true, false, NULL, NULL, "If true, only the thread that hit a breakpoint, watchpoint or finished a step is stopped, and the other threads keep running.  "
+                                                                             "Signals and crashes still stop all threads.  Only supported when debugging Linux processes locally." },
     {  NULL                  , OptionValue::eTypeInvalid, false, 0, NULL, NULL, NULL  }
 };
 
@@ -117,7 +119,8 @@ enum {
     ePropertyUnwindOnErrorInExpressions,
     ePropertyPythonOSPluginPath,
     ePropertyStopOnSharedLibraryEvents,
-    ePropertyDetachKeepsStopped
+    ePropertyDetachKeepsStopped,
+    ePropertyNonStopMode
 };
 
 ProcessProperties::ProcessProperties (bool is_global) :
@@ -234,6 +237,20 @@ ProcessProperties::SetDetachKeepsStopped (bool stop)
     m_collection_sp->SetPropertyAtIndexAsBoolean(NULL, idx, stop);
 }
 
+bool
+ProcessProperties::GetNonStopMode () const
+{
+    const uint32_t idx = ePropertyNonStopMode;
+    return m_collection_sp->GetPropertyAtIndexAsBoolean(NULL, idx, g_properties[idx].default_uint_value != 0);
+}
+
+void
+ProcessProperties::SetNonStopMode (bool non_stop)
+{
+    const uint32_t idx = ePropertyNonStopMode;
+    m_collection_sp->SetPropertyAtIndexAsBoolean(NULL, idx, non_stop);
+}
+
 void
 ProcessInstanceInfo::Dump (Stream &s, Platform *platform) const
 {
@@ -2157,6 +2174,9 @@ Process::CreateBreakpointSite (const BreakpointLocationSP &owner, bool use_hardw
         {
             bp_site_sp->AddOwner (owner);
             owner->SetBreakpointSite (bp_site_sp);
+            // The new owner may not want its condition (if any) evaluated
+            // for it, so the site's conditions need updating.
+            UpdateBreakpointSiteConditions (bp_site_sp.get());
             return bp_site_sp->GetID();
         }
         else
@@ -3435,6 +3455,17 @@ Process::PrivateResume ()
                     StateAsCString(m_public_state.GetValue()),
                     StateAsCString(m_private_state.GetValue()));
 
+    if (HasPendingStop())
+    {
+        // Report the stop without running anything.
+        if (log)
+            log->Printf ("Process::PrivateResume() reporting a pending stop instead of resuming.");
+
+        SetPrivateState(eStateRunning);
+        SetPrivateState(eStateStopped);
+        return Error();
+    }
+
     Error error (WillResume());
     // Tell the process it is about to resume before the thread list
     if (error.Success())
@@ -28,11 +28,16 @@ using namespace lldb_private;
 SectionLoadList::SectionLoadList (const SectionLoadList& rhs) :
     m_addr_to_sect(),
     m_sect_to_addr(),
-    m_mutex (Mutex::eMutexTypeRecursive)
+    m_mutex (Mutex::eMutexTypeRecursive),
+    m_addr_index_mutex (Mutex::eMutexTypeNormal),
+    m_addr_index_sp()
 {
     Mutex::Locker locker(rhs.m_mutex);
     m_addr_to_sect = rhs.m_addr_to_sect;
     m_sect_to_addr = rhs.m_sect_to_addr;
+    // The index can't change, so the copies share it.
+    Mutex::Locker index_locker(rhs.m_addr_index_mutex);
+    m_addr_index_sp = rhs.m_addr_index_sp;
 }
 
 void
@@ -42,6 +47,12 @@ SectionLoadList::operator=(const SectionLoadList &rhs)
     Mutex::Locker rhs_locker (rhs.m_mutex);
     m_addr_to_sect = rhs.m_addr_to_sect;
     m_sect_to_addr = rhs.m_sect_to_addr;
+    addr_index_sp index_sp;
+    {
+        Mutex::Locker index_locker (rhs.m_addr_index_mutex);
+        index_sp = rhs.m_addr_index_sp;
+    }
+    SetAddressIndex (index_sp);
 }
 
 bool
@@ -57,6 +68,55 @@ SectionLoadList::Clear ()
     Mutex::Locker locker(m_mutex);
     m_addr_to_sect.clear();
     m_sect_to_addr.clear();
+    InvalidateAddressIndex ();
+}
+
+void
+SectionLoadList::InvalidateAddressIndex ()
+{
+    SetAddressIndex (addr_index_sp());
+}
+
+void
+SectionLoadList::SetAddressIndex (const addr_index_sp &index_sp) const
+{
+    // Let go of the old index after unlocking, destroying it can take a
+    // while.
+    addr_index_sp old_index_sp (index_sp);
+    Mutex::Locker index_locker (m_addr_index_mutex);
+    m_addr_index_sp.swap (old_index_sp);
+}
+
+SectionLoadList::addr_index_sp
+SectionLoadList::GetAddressIndex () const
+{
+    addr_index_sp index_sp;
+    {
+        Mutex::Locker index_locker (m_addr_index_mutex);
+        index_sp = m_addr_index_sp;
+    }
+    if (index_sp)
+        return index_sp;
+
+    Mutex::Locker locker(m_mutex);
+    // Another thread might have made it while we waited for the lock.
+    {
+        Mutex::Locker index_locker (m_addr_index_mutex);
+        index_sp = m_addr_index_sp;
+    }
+    if (!index_sp)
+    {
+        // m_addr_to_sect is sorted by address, so the index is too.  Its
+        // sections are kept alive by the index as long as anyone is
+        // still using it.
+        addr_index *index = new addr_index();
+        addr_to_sect_collection::const_iterator pos, end = m_addr_to_sect.end();
+        for (pos = m_addr_to_sect.begin(); pos != end; ++pos)
+            index->Append (addr_index::Entry (pos->first, pos->second->GetByteSize(), pos->second));
+        index_sp.reset (index);
+        SetAddressIndex (index_sp);
+    }
+    return index_sp;
 }
 
 addr_t
@@ -147,6 +207,7 @@ SectionLoadList::SetSectionLoadAddress (const lldb::SectionSP &section, addr_t l
         }
         else
             m_addr_to_sect[load_addr] = section;
+        InvalidateAddressIndex ();
         return true;    // Changed
 
     }
@@ -194,7 +255,10 @@ SectionLoadList::SetSectionUnloaded (const lldb::SectionSP &section_sp)
 
             addr_to_sect_collection::iterator ats_pos = m_addr_to_sect.find(load_addr);
             if (ats_pos != m_addr_to_sect.end())
+            {
                 m_addr_to_sect.erase (ats_pos);
+                InvalidateAddressIndex ();
+            }
         }
     }
     return unload_count;
@@ -229,6 +293,7 @@ SectionLoadList::SetSectionUnloaded (const lldb::SectionSP &section_sp, addr_t l
     {
         erased = true;
         m_addr_to_sect.erase (ats_pos);
+        InvalidateAddressIndex ();
     }
 
     return erased;
@@ -238,43 +303,16 @@ SectionLoadList::SetSectionUnloaded (const lldb::SectionSP &section_sp, addr_t l
 bool
 SectionLoadList::ResolveLoadAddress (addr_t load_addr, Address &so_addr) const
 {
-    // First find the top level section that this load address exists in    
-    Mutex::Locker locker(m_mutex);
-    if (!m_addr_to_sect.empty())
+    // First find the top level section that this load address exists in.
+    // This is done for every frame and every symbolicated address, so it
+    // searches the index without taking m_mutex.
+    addr_index_sp index_sp (GetAddressIndex ());
+    const addr_index::Entry *entry = index_sp->FindEntryThatContains (load_addr);
+    if (entry)
     {
-        addr_to_sect_collection::const_iterator pos = m_addr_to_sect.lower_bound (load_addr);
-        if (pos != m_addr_to_sect.end())
-        {
-            if (load_addr != pos->first && pos != m_addr_to_sect.begin())
-                --pos;
-            const addr_t pos_load_addr = pos->first;
-            if (load_addr >= pos_load_addr)
-            {
-                addr_t offset = load_addr - pos_load_addr;
-                if (offset < pos->second->GetByteSize())
-                {
-                    // We have found the top level section, now we need to find the
-                    // deepest child section.
-                    return pos->second->ResolveContainedAddress (offset, so_addr);
-                }
-            }
-        }
-        else
-        {
-            // There are no entries that have an address that is >= load_addr,
-            // so we need to check the last entry on our collection.
-            addr_to_sect_collection::const_reverse_iterator rpos = m_addr_to_sect.rbegin();
-            if (load_addr >= rpos->first)
-            {
-                addr_t offset = load_addr - rpos->first;
-                if (offset < rpos->second->GetByteSize())
-                {
-                    // We have found the top level section, now we need to find the
-                    // deepest child section.
-                    return rpos->second->ResolveContainedAddress (offset, so_addr);
-                }
-            }
-        }
+        // We have found the top level section, now we need to find the
+        // deepest child section.
+        return entry->data->ResolveContainedAddress (load_addr - entry->GetRangeBase(), so_addr);
     }
     so_addr.Clear();
     return false;
@@ -34,6 +34,7 @@
 #include "lldb/Core/ValueObject.h"
 #include "lldb/Expression/ClangASTSource.h"
 #include "lldb/Expression/ClangUserExpression.h"
+#include "lldb/Expression/ClangUserExpressionCache.h"
 #include "lldb/Host/Host.h"
 #include "lldb/Interpreter/CommandInterpreter.h"
 #include "lldb/Interpreter/CommandReturnObject.h"
@@ -82,6 +83,7 @@ Target::Target(Debugger &debugger, const ArchSpec &target_arch, const lldb::Plat
     m_scratch_ast_source_ap (),
     m_ast_importer_ap (),
     m_persistent_variables (),
+    m_expression_cache_ap (),
     m_source_manager_ap(),
     m_stop_hooks (),
     m_stop_hook_next_id (0),
@@ -168,6 +170,9 @@ Target::DeleteCurrentProcess ()
 
         CleanupProcess ();
 
+        if (m_expression_cache_ap.get())
+            m_expression_cache_ap->Clear();
+
         m_process_sp.reset();
     }
 }
@@ -204,6 +209,8 @@ Target::Destroy()
     m_search_filter_sp.reset();
     m_image_search_paths.Clear(notify);
     m_persistent_variables.Clear();
+    if (m_expression_cache_ap.get())
+        m_expression_cache_ap->Clear();
     m_stop_hooks.clear();
     m_stop_hook_next_id = 0;
     m_suppress_stop_hooks = false;
@@ -1137,6 +1144,12 @@ Target::WillClearList (const ModuleList& module_list)
 {
 }
 
+uint32_t
+Target::GetNumModuleQueryThreads () const
+{
+    return GetModuleQueryThreads();
+}
+
 void
 Target::ModuleAdded (const ModuleList& module_list, const ModuleSP &module_sp)
 {
@@ -1168,6 +1181,9 @@ Target::ModulesDidLoad (ModuleList &module_list)
 {
     if (module_list.GetSize())
     {
+        // Names used by cached expressions may resolve differently now.
+        if (m_expression_cache_ap.get())
+            m_expression_cache_ap->Clear();
         m_breakpoint_list.UpdateBreakpoints (module_list, true, false);
         if (m_process_sp)
         {
@@ -1197,6 +1213,8 @@ Target::SymbolsDidLoad (ModuleList &module_list)
             }
         }
         
+        if (m_expression_cache_ap.get())
+            m_expression_cache_ap->Clear();
         m_breakpoint_list.UpdateBreakpoints (module_list, true, false);
         BroadcastEvent(eBroadcastBitSymbolsLoaded, NULL);
     }
@@ -1207,6 +1225,9 @@ Target::ModulesDidUnload (ModuleList &module_list, bool delete_locations)
 {
     if (module_list.GetSize())
     {
+        // Cached expressions may refer to blocks and functions in these modules.
+        if (m_expression_cache_ap.get())
+            m_expression_cache_ap->Clear();
         m_breakpoint_list.UpdateBreakpoints (module_list, false, delete_locations);
         // TODO: make event data that packages up the module_list
         BroadcastEvent (eBroadcastBitModulesUnloaded, NULL);
@@ -1814,6 +1835,15 @@ Target::GetDefaultDebugFileSearchPaths ()
     return FileSpecList();
 }
 
+FileSpec
+Target::GetDefaultCachePath ()
+{
+    TargetPropertiesSP properties_sp(Target::GetGlobalProperties());
+    if (properties_sp)
+        return properties_sp->GetCachePath();
+    return FileSpec();
+}
+
 ArchSpec
 Target::GetDefaultArchitecture ()
 {
@@ -1849,6 +1879,14 @@ Target::GetTargetFromContexts (const ExecutionContext *exe_ctx_ptr, const Symbol
     return target;
 }
 
+ClangUserExpressionCache &
+Target::GetExpressionCache()
+{
+    if (m_expression_cache_ap.get() == NULL)
+        m_expression_cache_ap.reset (new ClangUserExpressionCache ());
+    return *m_expression_cache_ap;
+}
+
 ExecutionResults
 Target::EvaluateExpression
 (
@@ -2622,6 +2660,7 @@ g_properties[] =
     { "use-hex-immediates"                 , OptionValue::eTypeBoolean   , false, true,                       NULL, NULL, "Show immediates in disassembly as hexadecimal." },
     { "hex-immediate-style"                , OptionValue::eTypeEnum   ,    false, Disassembler::eHexStyleC,   NULL, g_hex_immediate_style_values, "Which style to use for printing hexadecimal disassembly values." },
     { "use-fast-stepping"                  , OptionValue::eTypeBoolean   , false, true,                       NULL, NULL, "Use a fast stepping algorithm based on running from branch to branch rather than instruction single-stepping." },
+    { "use-fast-breakpoint-conditions"     , OptionValue::eTypeBoolean   , false, true,                       NULL, NULL, "Compile simple breakpoint conditions to bytecode that is evaluated directly against registers and memory, rather than running them through the expression parser on every hit." },
     { "load-script-from-symbol-file"       , OptionValue::eTypeEnum   ,    false, eLoadScriptFromSymFileWarn, NULL, g_load_script_from_sym_file_values, "Allow LLDB to load scripting resources embedded in symbol files when available." },
     { "memory-module-load-level"           , OptionValue::eTypeEnum   ,    false, eMemoryModuleLoadLevelComplete, NULL, g_memory_module_load_level_values,
         "Loading modules from memory can be slow as reading the symbol tables and other data can take a long time depending on your connection to the debug target. "
@@ -2630,6 +2669,12 @@ g_properties[] =
         "'partial' will load sections and attempt to find function bounds without downloading the symbol table (faster, still accurate, missing symbol names). "
         "'minimal' is the fastest setting and will load section data with no symbols, but should rarely be used as stack frames in these memory regions will be inaccurate and not provide any context (fastest). " },
     { "display-expression-in-crashlogs"    , OptionValue::eTypeBoolean   , false, false,                      NULL, NULL, "Expressions that crash will show up in crash logs if the host system supports executable specific crash log strings and this setting is set to true." },
+    { "module-query-threads"               , OptionValue::eTypeUInt64    , false, 0,                          NULL, NULL, "The number of threads used to search the modules of a target for functions, global variables, types and symbols.  "
+        "Searching a module for the first time indexes its symbols and debug info, so more threads make the first lookups faster in programs with many shared libraries.  "
+        "0 uses one thread per CPU, 1 searches the modules one after the other on the calling thread." },
+    { "cache-path"                         , OptionValue::eTypeFileSpec  , false, 0,                          NULL, NULL, "A directory where LLDB saves what it works out about the files it reads, so later sessions don't need to work it out again: "
+        "the decoded line tables of modules with a build ID, the CRCs of files found through .gnu_debuglink sections and the index of the debug file search paths.  "
+        "Nothing is saved if this is empty." },
     { NULL                                 , OptionValue::eTypeInvalid   , false, 0                         , NULL, NULL, NULL }
 };
 enum
@@ -2660,9 +2705,12 @@ enum
     ePropertyUseHexImmediates,
     ePropertyHexImmediateStyle,
     ePropertyUseFastStepping,
+    ePropertyUseFastBreakpointConditions,
     ePropertyLoadScriptFromSymbolFile,
     ePropertyMemoryModuleLoadLevel,
-    ePropertyDisplayExpressionsInCrashlogs
+    ePropertyDisplayExpressionsInCrashlogs,
+    ePropertyModuleQueryThreads,
+    ePropertyCachePath
 };
 
 
@@ -3041,6 +3089,13 @@ TargetProperties::GetUseFastStepping () const
     return m_collection_sp->GetPropertyAtIndexAsBoolean (NULL, idx, g_properties[idx].default_uint_value != 0);
 }
 
+bool
+TargetProperties::GetUseFastBreakpointConditions () const
+{
+    const uint32_t idx = ePropertyUseFastBreakpointConditions;
+    return m_collection_sp->GetPropertyAtIndexAsBoolean (NULL, idx, g_properties[idx].default_uint_value != 0);
+}
+
 bool
 TargetProperties::GetDisplayExpressionsInCrashlogs () const
 {
@@ -3048,6 +3103,20 @@ TargetProperties::GetDisplayExpressionsInCrashlogs () const
     return m_collection_sp->GetPropertyAtIndexAsBoolean (NULL, idx, g_properties[idx].default_uint_value != 0);
 }
 
+uint32_t
+TargetProperties::GetModuleQueryThreads () const
+{
+    const uint32_t idx = ePropertyModuleQueryThreads;
+    return m_collection_sp->GetPropertyAtIndexAsUInt64 (NULL, idx, g_properties[idx].default_uint_value);
+}
+
+FileSpec
+TargetProperties::GetCachePath () const
+{
+    const uint32_t idx = ePropertyCachePath;
+    return m_collection_sp->GetPropertyAtIndexAsFileSpec (NULL, idx);
+}
+
 LoadScriptFromSymFile
 TargetProperties::GetLoadScriptFromSymbolFile () const
 {
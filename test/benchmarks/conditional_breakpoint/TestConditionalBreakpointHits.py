@@ -0,0 +1,66 @@
+"""Measure how many conditional breakpoint hits per second lldb can process."""
+
+import os, sys
+import unittest2
+import lldb
+from lldbbench import *
+
+class ConditionalBreakpointHitsBench(BenchBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    def setUp(self):
+        BenchBase.setUp(self)
+        self.source = 'main.cpp'
+        self.line_to_break = line_number(self.source, '// Set breakpoint here.')
+        self.count = lldb.bmIterationCount
+        if self.count <= 0:
+            self.count = 1000
+
+    @benchmarks_test
+    def test_conditional_breakpoint_hits(self):
+        """Compare conditional breakpoint hits per second with and without condition bytecode."""
+        self.buildDefault()
+        self.exe_name = 'a.out'
+
+        print
+        for condition in ['j == %d' % (self.count - 1),
+                          'ptr->point.y < %d && g_iterations > 0' % -(self.count - 2)]:
+            for fast in [True, False]:
+                hits_per_second = self.run_conditional_breakpoint(self.exe_name, condition, fast, self.count)
+                print "lldb conditional breakpoint benchmark (%s, use-fast-breakpoint-conditions=%s): %.1f hits/sec" % (condition, fast, hits_per_second)
+
+    def run_conditional_breakpoint(self, exe_name, condition, fast, count):
+        exe = os.path.join(os.getcwd(), exe_name)
+
+        self.runCmd("settings set target.use-fast-breakpoint-conditions %s" % ('true' if fast else 'false'))
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target, VALID_TARGET)
+
+        breakpoint = target.BreakpointCreateByLocation(self.source, self.line_to_break)
+        self.assertTrue(breakpoint, VALID_BREAKPOINT)
+        breakpoint.SetCondition(condition)
+
+        self.stopwatch.reset()
+        with self.stopwatch:
+            process = target.LaunchSimple([str(count)], None, self.get_process_working_directory())
+            self.assertTrue(process, PROCESS_IS_VALID)
+            self.assertTrue(process.GetState() == lldb.eStateStopped, "Process should stop at the conditional breakpoint")
+
+        # Both conditions are only true on the last iteration, so the
+        # condition was checked once per iteration.
+        self.assertTrue(process.GetSelectedThread().GetSelectedFrame().FindVariable('j').GetValueAsSigned() == count - 1,
+                        "Process should stop on the last iteration")
+        hits_per_second = count / self.stopwatch.avg()
+
+        process.Kill()
+        self.dbg.DeleteTarget(target)
+        self.runCmd("settings clear target.use-fast-breakpoint-conditions")
+        return hits_per_second
+
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
@@ -0,0 +1,42 @@
+//===-- main.cpp ------------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <stdio.h>
+#include <stdlib.h>
+
+struct Point {
+    int x;
+    int y;
+};
+
+struct Data {
+    long id;
+    Point point;
+};
+
+int g_iterations = 0;
+
+int main(int argc, char const *argv[]) {
+    int count = argc > 1 ? atoi(argv[1]) : 1000;
+    Data *data = new Data[count];
+    for (int i = 0; i < count; ++i) {
+        data[i].id = i;
+        data[i].point.x = i;
+        data[i].point.y = -i;
+    }
+
+    long sum = 0;
+    for (int j = 0; j < count; ++j) {
+        Data *ptr = &data[j];
+        sum += ptr->point.x; // Set breakpoint here.
+        ++g_iterations;
+    }
+    printf("sum = %ld\n", sum);
+    delete [] data;
+    return 0;
+}
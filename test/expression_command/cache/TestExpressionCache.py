@@ -0,0 +1,68 @@
+"""
+Test that expressions evaluated again at a later stop see the new values
+of the variables they use, whether or not they were reused from the cache.
+"""
+
+import os, time
+import unittest2
+import lldb
+from lldbtest import *
+
+class ExpressionCacheTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    def test_expression_cache(self):
+        """Test that reevaluated expressions are rematerialized at each stop."""
+        self.buildDefault()
+
+        self.runCmd("file a.out", CURRENT_EXECUTABLE_SET)
+
+        log_file = os.path.join(os.getcwd(), "expression-cache.log")
+        if os.path.exists(log_file):
+            os.remove(log_file)
+        self.addTearDownHook(lambda: os.path.exists(log_file) and os.remove(log_file))
+        self.runCmd("log enable -f %s lldb expr" % log_file)
+        self.addTearDownHook(lambda: self.runCmd("log disable lldb expr", check=False))
+
+        self.runCmd("breakpoint set --source-pattern-regexp 'Set breakpoint here'")
+
+        self.runCmd("run", RUN_SUCCEEDED)
+
+        self.expect("expression i * 10 + g_total",
+            substrs = ["(int)", "= 0"])
+
+        self.runCmd("continue")
+
+        self.expect("expression i * 10 + g_total",
+            substrs = ["(int)", "= 10"])
+
+        self.runCmd("continue")
+
+        self.expect("expression i * 10 + g_total",
+            substrs = ["(int)", "= 21"])
+
+        # Persistent variables are never cached, and still work alongside
+        # cached expressions.
+        self.runCmd("expression int $j = i")
+
+        self.expect("expression $j + i",
+            substrs = ["(int)", "= 4"])
+
+        # The first evaluation parsed the expression, the two after it
+        # were found in the cache.
+        self.runCmd("log disable lldb expr")
+        with open(log_file, "r") as f:
+            log = f.read()
+        self.assertTrue(log.count('ClangUserExpressionCache::Find ("i * 10 + g_total") miss') == 1,
+                        "The first evaluation missed the cache")
+        self.assertTrue(log.count('ClangUserExpressionCache::Find ("i * 10 + g_total") hit') == 2,
+                        "The later evaluations hit the cache")
+        self.assertTrue('ClangUserExpressionCache::Find ("$j + i") hit' not in log,
+                        "Expressions with persistent variables are not cached")
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
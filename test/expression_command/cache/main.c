@@ -0,0 +1,20 @@
+//===-- main.c --------------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+int g_total = 0;
+
+int main (int argc, char const *argv[])
+{
+    int i;
+    for (i = 0; i < 3; ++i)
+    {
+        g_total += i; // Set breakpoint here
+    }
+    return 0;
+}
@@ -0,0 +1,87 @@
+"""
+Test expressions that the IR interpreter can run without JIT compiling
+anything: floating point arithmetic and comparisons, conversions,
+conditionals and aggregate copies.
+"""
+
+import os, time
+import unittest2
+import lldb
+from lldbtest import *
+
+class ExprInterpreterTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    def test_expr_interpreter(self):
+        """Test floating point, conditional and aggregate expressions."""
+        self.buildDefault()
+
+        self.runCmd("file a.out", CURRENT_EXECUTABLE_SET)
+
+        self.runCmd("breakpoint set --source-pattern-regexp 'Set breakpoint here'")
+
+        self.runCmd("run", RUN_SUCCEEDED)
+
+        log_file = os.path.join(os.getcwd(), "expr-interpreter.log")
+        if os.path.exists(log_file):
+            os.remove(log_file)
+        self.addTearDownHook(lambda: os.path.exists(log_file) and os.remove(log_file))
+        self.runCmd("log enable -f %s lldb expr" % log_file)
+        self.addTearDownHook(lambda: self.runCmd("log disable lldb expr", check=False))
+
+        self.expect("expression (int)(f * 4.0f)",
+            substrs = ["(int)", "= 6"])
+
+        self.expect("expression (int)(d / f * 100)",
+            substrs = ["(int)", "= 150"])
+
+        self.expect("expression f < d",
+            substrs = ["(bool)", "= true"])
+
+        self.expect("expression (long)(i * d)",
+            substrs = ["(long)", "= -6"])
+
+        self.expect("expression i < 0 ? f : d",
+            substrs = ["(double)", "= 1.5"])
+
+        self.expect("expression i < 0 && f > 1",
+            substrs = ["(bool)", "= true"])
+
+        self.runCmd("expression p2 = p1")
+
+        self.expect("expression p2.y",
+            substrs = ["(int)", "= 2"])
+
+        self.expect("expression (int)(p2.weight * 10)",
+            substrs = ["(int)", "= 5"])
+
+        # Every one of the expressions above ran in the IR interpreter.
+        self.runCmd("log disable lldb expr")
+        with open(log_file, "r") as f:
+            log = f.read()
+        self.assertTrue("JIT compiling expression $__lldb_expr" not in log,
+                        "No expression was JIT compiled")
+        self.assertTrue(log.count("Interpreting expression $__lldb_expr") == 9,
+                        "All of the expressions were interpreted")
+
+        # Copies bigger than the interpreter handles are JIT compiled.
+        os.remove(log_file)
+        self.runCmd("log enable -f %s lldb expr" % log_file)
+        self.runCmd("expression b2 = b1")
+        self.runCmd("log disable lldb expr")
+        with open(log_file, "r") as f:
+            log = f.read()
+        self.assertTrue("Unsupported memory intrinsic length" in log,
+                        "The interpreter turned down the big copy")
+        self.assertTrue("Interpreting expression $__lldb_expr" not in log,
+                        "The big copy wasn't interpreted")
+
+        self.expect("expression (int)b2.bytes[8000]",
+            substrs = ["(int)", "= 7"])
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
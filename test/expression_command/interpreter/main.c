@@ -0,0 +1,34 @@
+//===-- main.c --------------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+struct point
+{
+    int x;
+    int y;
+    double weight;
+};
+
+// Too big to copy in the interpreter.
+struct big
+{
+    char bytes[8192];
+};
+
+int main (int argc, char const *argv[])
+{
+    float f = 1.5f;
+    double d = 2.25;
+    int i = -3;
+    struct point p1 = { 1, 2, 0.5 };
+    struct point p2 = { 0, 0, 0.0 };
+    struct big b1 = { { 0 } };
+    struct big b2 = { { 0 } };
+    b1.bytes[8000] = 7;
+    return 0; // Set breakpoint here
+}
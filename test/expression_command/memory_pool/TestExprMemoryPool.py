@@ -0,0 +1,57 @@
+"""
+Test that JIT compiled expressions carve their memory out of the regions
+the process already allocated instead of allocating new ones each time.
+"""
+
+import os, time
+import unittest2
+import lldb
+from lldbtest import *
+
+class ExprMemoryPoolTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    def test_expr_memory_pool(self):
+        """Test that several expressions share one pooled memory region."""
+        self.buildDefault()
+
+        self.runCmd("file a.out", CURRENT_EXECUTABLE_SET)
+
+        self.runCmd("breakpoint set --source-pattern-regexp 'Set breakpoint here'")
+
+        self.runCmd("run", RUN_SUCCEEDED)
+
+        # The first expression sets up the pooled region.
+        self.expect("expression (int)add(1, 2)",
+            substrs = ["(int)", "= 3"])
+
+        log_file = os.path.join(os.getcwd(), "expr-memory-pool.log")
+        if os.path.exists(log_file):
+            os.remove(log_file)
+        self.addTearDownHook(lambda: os.path.exists(log_file) and os.remove(log_file))
+        self.runCmd("log enable -f %s lldb expr process" % log_file)
+        self.addTearDownHook(lambda: self.runCmd("log disable lldb expr process", check=False))
+
+        for i in range(5):
+            self.expect("expression (int)add(%d, total)" % i,
+                substrs = ["(int)", "= %d" % (i + 2)])
+
+        self.runCmd("log disable lldb expr process")
+        with open(log_file, "r") as f:
+            log = f.read()
+
+        # Each expression still allocated memory for itself...
+        self.assertTrue(log.count("IRMemoryMap::Malloc") >= 5,
+                        "The expressions allocated memory")
+        self.assertTrue(log.count("AllocatedMemoryCache::AllocateMemory") >= 5,
+                        "The allocations went through the memory cache")
+        # ...but all of it came out of the region the first one set up.
+        self.assertTrue("Process::DoAllocateMemory" not in log,
+                        "No new region was allocated in the inferior")
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
@@ -0,0 +1,20 @@
+//===-- main.c --------------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+int
+add (int a, int b)
+{
+    return a + b;
+}
+
+int main (int argc, char const *argv[])
+{
+    int total = add (argc, 1);
+    return total; // Set breakpoint here
+}
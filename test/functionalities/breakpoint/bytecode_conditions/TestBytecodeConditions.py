@@ -0,0 +1,115 @@
+"""
+Test that breakpoint conditions compiled to bytecode follow the C rules
+for literal types, signed/unsigned comparisons and short-circuiting, and
+that they stop at the same places as the expression parser.
+"""
+
+import os
+import unittest2
+import lldb
+from lldbtest import *
+import lldbutil
+
+class BytecodeConditionsTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    # Each condition and the values of 'i' the process should stop at.
+    loop_conditions = [
+        # 0x80000000 is an unsigned int, so x is converted to unsigned.
+        ('x == 0x80000000', [0]),
+        # 2147483648 is a long, so x keeps its sign.
+        ('x == 2147483648', []),
+        ('x == -2147483648', [0]),
+        ('x == 020000000000', [0]),
+        ('u > 0', [-4, -3, -2, -1, 1, 2, 3]),
+        ('i < 2', [-4, -3, -2, -1, 0, 1]),
+        ('i < 2l', [-4, -3, -2, -1, 0, 1]),
+        # Negative values of i are huge once converted to unsigned.
+        ('i < 2u', [0, 1]),
+        ('i >= -1u', [-1]),
+        ('-1 < 0u', []),
+        ('i * 2 + 1 == -5', [-3]),
+        # The right hand side would read through a NULL pointer.
+        ('null_ptr && null_ptr[0] == 1', []),
+        ('!null_ptr || null_ptr[0] == 1', [-4, -3, -2, -1, 0, 1, 2, 3]),
+        ('(i == 1 || i == 3) && !(u == 3)', [1]),
+    ]
+
+    @dwarf_test
+    def test_with_dwarf(self):
+        """Test that bytecode conditions follow the C rules."""
+        self.buildDwarf()
+        self.bytecode_conditions_test()
+
+    def setUp(self):
+        # Call super's setUp().
+        TestBase.setUp(self)
+        self.loop_line = line_number('main.cpp', '// Set loop breakpoint here.')
+        self.member_line = line_number('main.cpp', '// Set member breakpoint here.')
+        self.log_file = os.path.join(os.getcwd(), "bytecode-conditions.log")
+
+    def stops_for_condition(self, line, condition, fast):
+        """Run to exit, returning the value of 'i' at each stop and the breakpoint log."""
+        if os.path.exists(self.log_file):
+            os.remove(self.log_file)
+        self.runCmd("log enable -f %s lldb break" % self.log_file)
+        self.runCmd("settings set target.use-fast-breakpoint-conditions %s" % ('true' if fast else 'false'))
+
+        exe = os.path.join(os.getcwd(), "a.out")
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target, VALID_TARGET)
+        breakpoint = target.BreakpointCreateByLocation("main.cpp", line)
+        self.assertTrue(breakpoint and breakpoint.GetNumLocations() == 1, VALID_BREAKPOINT)
+        breakpoint.SetCondition(condition)
+
+        stops = []
+        process = target.LaunchSimple(None, None, self.get_process_working_directory())
+        self.assertTrue(process, PROCESS_IS_VALID)
+        while process.GetState() == lldb.eStateStopped:
+            thread = lldbutil.get_stopped_thread(process, lldb.eStopReasonBreakpoint)
+            self.assertTrue(thread, "Stopped at the breakpoint for '%s'" % condition)
+            stops.append(thread.GetFrameAtIndex(0).FindVariable("i").GetValueAsSigned())
+            process.Continue()
+        self.assertTrue(process.GetState() == lldb.eStateExited, "The process exited")
+
+        self.runCmd("log disable lldb break")
+        self.runCmd("settings clear target.use-fast-breakpoint-conditions")
+        self.dbg.DeleteTarget(target)
+        with open(self.log_file, "r") as f:
+            log = f.read()
+        os.remove(self.log_file)
+        return (stops, log)
+
+    def bytecode_conditions_test(self):
+        """Test that bytecode conditions follow the C rules."""
+        for (condition, expected) in self.loop_conditions:
+            (stops, log) = self.stops_for_condition(self.loop_line, condition, True)
+            self.assertTrue(stops == expected,
+                            "'%s' stopped at %s, expected %s" % (condition, stops, expected))
+            self.assertTrue("Compiled condition \"%s\"" % condition in log,
+                            "'%s' was compiled to bytecode" % condition)
+            self.assertTrue("Bytecode evaluation failed" not in log,
+                            "'%s' was evaluated without falling back" % condition)
+
+            (stops, log) = self.stops_for_condition(self.loop_line, condition, False)
+            self.assertTrue(stops == expected,
+                            "'%s' without bytecode stopped at %s, expected %s" % (condition, stops, expected))
+
+        # 'value' in a method is the member, not the global of that name,
+        # so the condition has to go through the expression parser.
+        (stops, log) = self.stops_for_condition(self.member_line, "value == 100", True)
+        self.assertTrue(stops == [-4, -3, -2, -1, 0, 1, 2, 3],
+                        "'value == 100' in Counter::Check stopped at %s" % stops)
+        self.assertTrue("needs the expression parser" in log,
+                        "'value == 100' in Counter::Check used the expression parser")
+
+        (stops, log) = self.stops_for_condition(self.member_line, "this->value == 100 && i > 2", True)
+        self.assertTrue(stops == [3], "'this->value == 100 && i > 2' stopped at %s" % stops)
+        self.assertTrue("Compiled condition" in log, "'this->value' was compiled to bytecode")
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
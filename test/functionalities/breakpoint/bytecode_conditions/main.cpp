@@ -0,0 +1,40 @@
+//===-- main.cpp ------------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <limits.h>
+#include <stdio.h>
+
+// A global with the same name as a member of Counter.
+int value = 5;
+
+struct Counter
+{
+    int value;
+
+    int
+    Check (int i)
+    {
+        return value + i; // Set member breakpoint here.
+    }
+};
+
+int
+main (int argc, char const *argv[])
+{
+    Counter counter = { 100 };
+    int *null_ptr = NULL;
+    int sum = 0;
+    for (int i = -4; i < 4; ++i)
+    {
+        int x = i == 0 ? INT_MIN : i;
+        unsigned int u = (unsigned int)i;
+        sum += counter.Check (i) + x + u; // Set loop breakpoint here.
+    }
+    printf ("sum = %d\n", sum + (null_ptr != NULL) + value);
+    return 0;
+}
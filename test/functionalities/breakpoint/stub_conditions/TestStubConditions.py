@@ -0,0 +1,75 @@
+"""
+Test that debugserver evaluates breakpoint conditions sent with "Z0".
+"""
+
+import os
+import unittest2
+import lldb
+from lldbtest import *
+import lldbutil
+
+class StubConditionsTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    @unittest2.skipUnless(sys.platform.startswith("darwin"), "requires debugserver")
+    @dsym_test
+    def test_with_dsym(self):
+        """Test that the stub only reports hits where the condition is true."""
+        self.buildDsym()
+        self.stub_conditions_test()
+
+    @unittest2.skipUnless(sys.platform.startswith("darwin"), "requires debugserver")
+    @dwarf_test
+    def test_with_dwarf(self):
+        """Test that the stub only reports hits where the condition is true."""
+        self.buildDwarf()
+        self.stub_conditions_test()
+
+    def setUp(self):
+        # Call super's setUp().
+        TestBase.setUp(self)
+        self.line = line_number('main.c', '// Set breakpoint here.')
+        self.log_file = os.path.join(os.getcwd(), "stub-conditions.log")
+        if os.path.exists(self.log_file):
+            os.remove(self.log_file)
+        self.addTearDownHook(lambda: os.path.exists(self.log_file) and os.remove(self.log_file))
+
+    def stub_conditions_test(self):
+        """Test that the stub only reports hits where the condition is true."""
+        self.runCmd("log enable -f %s gdb-remote packets" % self.log_file)
+        self.addTearDownHook(lambda: self.runCmd("log disable gdb-remote packets", check=False))
+
+        exe = os.path.join(os.getcwd(), "a.out")
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target, VALID_TARGET)
+        breakpoint = target.BreakpointCreateByLocation("main.c", self.line)
+        self.assertTrue(breakpoint and breakpoint.GetNumLocations() == 1, VALID_BREAKPOINT)
+        breakpoint.SetCondition("i == 7 || i == 9")
+
+        stops = []
+        process = target.LaunchSimple(None, None, self.get_process_working_directory())
+        self.assertTrue(process, PROCESS_IS_VALID)
+        while process.GetState() == lldb.eStateStopped:
+            thread = lldbutil.get_stopped_thread(process, lldb.eStopReasonBreakpoint)
+            self.assertTrue(thread, "Stopped at the breakpoint")
+            stops.append(thread.GetFrameAtIndex(0).FindVariable("i").GetValueAsSigned())
+            process.Continue()
+        self.assertTrue(process.GetState() == lldb.eStateExited, "The process exited")
+        self.assertTrue(stops == [7, 9], "Stopped where the condition is true, not at %s" % stops)
+
+        # The first hit compiles the condition, after that the stub only
+        # reports the two hits where it is true.
+        self.assertTrue(breakpoint.GetHitCount() == 3,
+                        "The stub filtered out the false hits, hit count is %d" % breakpoint.GetHitCount())
+
+        self.runCmd("log disable gdb-remote packets")
+        with open(self.log_file, "r") as f:
+            sent_conditions = [line for line in f if "$Z0," in line and ";X" in line]
+        self.assertTrue(len(sent_conditions) > 0, "The condition was sent with the Z0 packet")
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
@@ -0,0 +1,22 @@
+//===-- main.c --------------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <stdio.h>
+
+int g_sum = 0;
+
+int
+main (int argc, char const *argv[])
+{
+    for (int i = 0; i < 20; ++i)
+    {
+        g_sum += i; // Set breakpoint here.
+    }
+    printf ("sum = %d\n", g_sum);
+    return 0;
+}
@@ -0,0 +1,88 @@
+"""
+Test that debug files are found through the index of the debug file search
+paths, including files added after the index was made, and that the index
+is saved in the target.cache-path directory.
+"""
+
+import os
+import shutil
+import time
+import unittest2
+import lldb
+from lldbtest import *
+import lldbutil
+
+class DebugFileIndexTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    @unittest2.skipUnless(sys.platform.startswith("linux"), "requires Linux")
+    @dwarf_test
+    def test_with_dwarf(self):
+        """Test that a debug file added to a search path is found once the index is checked again."""
+        self.buildDwarf()
+        self.debug_file_index_test()
+
+    def make_directory(self, name):
+        path = os.path.join(os.getcwd(), name)
+        if os.path.exists(path):
+            shutil.rmtree(path)
+        os.mkdir(path)
+        self.addTearDownHook(lambda: shutil.rmtree(path))
+        return path
+
+    def create_target(self, exe):
+        """Create a target for exe with fresh modules, and return it and its executable module."""
+        lldb.SBDebugger.MemoryPressureDetected()
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target, VALID_TARGET)
+        return target, target.GetModuleAtIndex(0)
+
+    def debug_file_index_test(self):
+        """Test that a debug file added to a search path is found once the index is checked again."""
+        exe = os.path.join(os.getcwd(), "a.out.stripped")
+
+        # Keep the debug file out of the directory of the executable, which
+        # is searched without the index.
+        staging_dir = self.make_directory("staging")
+        shutil.move(os.path.join(os.getcwd(), "a.out.debug"), staging_dir)
+        debug_dir = self.make_directory("debug-files")
+        cache_dir = self.make_directory("cache")
+
+        self.runCmd("settings set target.debug-file-search-paths " + debug_dir)
+        self.addTearDownHook(lambda: self.runCmd("settings clear target.debug-file-search-paths"))
+        self.runCmd("settings set target.cache-path " + cache_dir)
+        self.addTearDownHook(lambda: self.runCmd("settings clear target.cache-path"))
+
+        # The search path is empty, so this indexes it and finds nothing.
+        target, module = self.create_target(exe)
+        self.assertTrue(module.GetNumCompileUnits() == 0, "No debug file yet")
+        self.dbg.DeleteTarget(target)
+
+        # Misses only check the file system again every few seconds.
+        shutil.copy(os.path.join(staging_dir, "a.out.debug"), debug_dir)
+        time.sleep(6)
+
+        target, module = self.create_target(exe)
+        self.assertTrue(module.GetSymbolFileSpec().GetFilename() == "a.out.debug",
+                        "The debug file added to the search path is found")
+        self.assertTrue(module.GetNumCompileUnits() > 0, "The debug file has the debug info")
+        breakpoint = target.BreakpointCreateByLocation("main.c", line_number("main.c", "// Set breakpoint here"))
+        self.assertTrue(breakpoint.GetNumLocations() == 1, "The breakpoint resolves with the debug file")
+        self.dbg.DeleteTarget(target)
+
+        # The index, with the search path and the UUID of the debug file,
+        # is saved for the next session.
+        cache_file = os.path.join(cache_dir, "debug-file-index")
+        self.assertTrue(os.path.exists(cache_file), "The index was saved")
+        with open(cache_file, "rb") as f:
+            contents = f.read()
+        self.assertTrue(debug_dir in contents, "The search path is in the saved index")
+        self.assertTrue(os.path.join(debug_dir, "a.out.debug") in contents,
+                        "The debug file is in the saved index")
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
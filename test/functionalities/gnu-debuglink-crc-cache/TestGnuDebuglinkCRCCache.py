@@ -0,0 +1,87 @@
+"""
+Test that the gnu_debuglink CRCs of files without a build ID are saved in
+the target.cache-path directory.
+"""
+
+import os
+import shutil
+import struct
+import unittest2
+import lldb
+from lldbtest import *
+import lldbutil
+
+class GnuDebuglinkCRCCacheTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    @unittest2.skipUnless(sys.platform.startswith("linux"), "requires Linux")
+    @dwarf_test
+    def test_with_dwarf(self):
+        """Test that the CRC used as the UUID of a file without a build ID is saved and reused."""
+        self.buildDwarf()
+        self.crc_cache_test()
+
+    def read_records(self, cache_file):
+        """Return the (path, crc) of each record in the CRC cache file."""
+        records = []
+        with open(cache_file, "rb") as f:
+            data = f.read()
+        offset = 0
+        while offset + 40 <= len(data):
+            magic, version, crc, path_length = struct.unpack_from("=IIII", data, offset)
+            if magic != 0x43524347 or version != 2:
+                break
+            offset += 40
+            records.append((data[offset:offset + path_length], crc))
+            offset += (path_length + 3) & ~3
+        return records
+
+    def crc_cache_test(self):
+        """Test that the CRC used as the UUID of a file without a build ID is saved and reused."""
+        exe = os.path.join(os.getcwd(), "a.out")
+        cache_dir = os.path.join(os.getcwd(), "crc-cache")
+        if os.path.exists(cache_dir):
+            shutil.rmtree(cache_dir)
+        os.mkdir(cache_dir)
+        self.addTearDownHook(lambda: shutil.rmtree(cache_dir))
+
+        self.runCmd("settings set target.cache-path " + cache_dir)
+        self.addTearDownHook(lambda: self.runCmd("settings clear target.cache-path"))
+
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target, VALID_TARGET)
+        uuid = target.GetModuleAtIndex(0).GetUUIDString()
+        self.assertTrue(uuid, "The CRC is used as the UUID")
+
+        cache_file = os.path.join(cache_dir, "gnu-debuglink-crcs")
+        self.assertTrue(os.path.exists(cache_file), "The CRC cache file was written")
+        crcs = [crc for (path, crc) in self.read_records(cache_file) if path == exe]
+        self.assertTrue(len(crcs) >= 1, "The CRC of a.out was saved")
+        self.assertTrue(crcs[-1] != 0, "The saved CRC is not empty")
+
+        # A new module for the same file gets the same UUID.
+        self.dbg.DeleteTarget(target)
+        lldb.SBDebugger.MemoryPressureDetected()
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target, VALID_TARGET)
+        self.assertTrue(target.GetModuleAtIndex(0).GetUUIDString() == uuid,
+                        "The UUID is the same with the saved CRC")
+
+        # Changing the file invalidates the saved CRC.
+        self.dbg.DeleteTarget(target)
+        lldb.SBDebugger.MemoryPressureDetected()
+        with open(exe, "ab") as f:
+            f.write(b"\0" * 16)
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target, VALID_TARGET)
+        self.assertTrue(target.GetModuleAtIndex(0).GetUUIDString() != uuid,
+                        "The CRC of the changed file is computed again")
+        crcs = [crc for (path, crc) in self.read_records(cache_file) if path == exe]
+        self.assertTrue(len(crcs) >= 2, "The new CRC of a.out was saved")
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
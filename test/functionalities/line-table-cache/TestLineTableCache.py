@@ -0,0 +1,152 @@
+"""
+Test that line tables are saved to and read back from the line table cache.
+"""
+
+import os
+import re
+import shutil
+import unittest2
+import lldb
+import pexpect
+from lldbtest import *
+import lldbutil
+
+class LineTableCacheTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    @unittest2.skipUnless(sys.platform.startswith("linux"), "requires Linux")
+    @dwarf_test
+    def test_with_dwarf(self):
+        """Test that breakpoints and line tables are the same with and without a cached line table."""
+        self.buildDwarf()
+        self.line_table_cache_test()
+
+    def setUp(self):
+        # Call super's setUp().
+        TestBase.setUp(self)
+        # Find the line numbers for our breakpoints.
+        self.main_line = line_number('main.c', '// Set breakpoint in main')
+        self.add_line = line_number('main.c', '// Set breakpoint in add')
+
+    def set_breakpoints(self, target):
+        addresses = []
+        for line in [self.main_line, self.add_line]:
+            breakpoint = target.BreakpointCreateByLocation("main.c", line)
+            self.assertTrue(breakpoint.GetNumLocations() == 1, "The breakpoint has one location")
+            address = breakpoint.GetLocationAtIndex(0).GetAddress()
+            self.assertTrue(address.GetLineEntry().GetLine() == line, "The location is on the breakpoint line")
+            addresses.append(address.GetFileAddress())
+        return addresses
+
+    def get_rows(self, output):
+        """Return the rows of an 'image dump line-table' output.  The empty
+        rows follow the terminal entries that end each sequence but the last."""
+        lines = [line.strip() for line in output.splitlines()]
+        rows = [i for i in range(len(lines)) if lines[i].startswith("0x")]
+        if not rows:
+            return []
+        return lines[rows[0]:rows[-1] + 1]
+
+    def dump_line_table(self):
+        self.runCmd("image dump line-table main.c")
+        return self.get_rows(self.res.GetOutput())
+
+    def create_target(self, exe):
+        """Create a target with fresh modules, so the line table is read again."""
+        lldb.SBDebugger.MemoryPressureDetected()
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target, VALID_TARGET)
+        return target
+
+    def get_tables_read(self, log_file):
+        """Return how many line tables the log says were read from cache files."""
+        with open(log_file, "r") as f:
+            counts = re.findall(r"read (\d+) line tables from .*\.lines", f.read())
+        return max([int(count) for count in counts] + [0])
+
+    def line_table_cache_test(self):
+        """Test that breakpoints and line tables are the same with and without a cached line table."""
+        exe = os.path.join(os.getcwd(), "a.out")
+        cache_dir = os.path.join(os.getcwd(), "line-table-cache")
+        if os.path.exists(cache_dir):
+            shutil.rmtree(cache_dir)
+        os.mkdir(cache_dir)
+        self.addTearDownHook(lambda: shutil.rmtree(cache_dir))
+
+        # The line table as decoded from .debug_line.
+        target = self.create_target(exe)
+        addresses = self.set_breakpoints(target)
+        rows = self.dump_line_table()
+        self.dbg.DeleteTarget(target)
+
+        # Make sure the table covers the harder parts of the compact
+        # encoding: more rows than between two checkpoints, lines that go
+        # backwards and several sequences.
+        self.assertTrue(len([row for row in rows if row]) > 16, "The line table has more than 16 rows")
+        lines = [int(line) for line in re.findall(r"main\.c:(\d+)", "\n".join(rows))]
+        self.assertTrue([a for (a, b) in zip(lines, lines[1:]) if b < a], "The line table goes back to earlier lines")
+        self.assertTrue("" in rows, "The line table has several sequences")
+
+        self.runCmd("settings set target.cache-path " + cache_dir)
+        self.addTearDownHook(lambda: self.runCmd("settings clear target.cache-path"))
+
+        target = self.create_target(exe)
+        self.assertTrue(self.set_breakpoints(target) == addresses, "Breakpoints resolve the same while the cache is written")
+        self.assertTrue(self.dump_line_table() == rows, "The line table is the same while the cache is written")
+        self.dbg.DeleteTarget(target)
+
+        # Other files in the cache directory are for the other caches.
+        cache_files = [name for name in os.listdir(cache_dir) if name.endswith(".lines")]
+        self.assertTrue(len(cache_files) == 1, "The line table was written to the cache")
+
+        # This process wrote the line table, so it reads the cache file
+        # again to get it.
+        log_file = os.path.join(os.getcwd(), "line-table-cache.log")
+        self.runCmd("log enable -f %s dwarf line" % log_file)
+        self.addTearDownHook(lambda: self.runCmd("log disable dwarf line", check=False))
+        target = self.create_target(exe)
+        self.assertTrue(self.set_breakpoints(target) == addresses,
+                        "The cached line table resolves the same addresses")
+        self.assertTrue(self.dump_line_table() == rows, "The cached line table has the same rows")
+        self.runCmd("log disable dwarf line")
+        self.assertTrue(self.get_tables_read(log_file) >= 1, "The line table was read from the cache file")
+
+        process = target.LaunchSimple(None, None, os.getcwd())
+        self.assertTrue(process, PROCESS_IS_VALID)
+        thread = lldbutil.get_stopped_thread(process, lldb.eStopReasonBreakpoint)
+        self.assertTrue(thread, "Stopped at the breakpoint in main")
+        self.assertTrue(thread.GetFrameAtIndex(0).GetLineEntry().GetLine() == self.main_line,
+                        "Stopped on the line in main")
+        process.Kill()
+        self.dbg.DeleteTarget(target)
+
+        # A new lldb reads the cache file it didn't write.
+        fresh_log_file = os.path.join(os.getcwd(), "line-table-cache-fresh.log")
+        if os.path.exists(fresh_log_file):
+            os.remove(fresh_log_file)
+        prompt = "(lldb) "
+        child = pexpect.spawn('%s %s' % (self.lldbHere, self.lldbOption))
+        # So that the spawned lldb session gets shutdown during teardown.
+        self.child = child
+        if self.TraceOn():
+            child.logfile_read = sys.stdout
+        child.expect_exact(prompt)
+        for command in ["settings set target.cache-path " + cache_dir,
+                        "log enable -f %s dwarf line" % fresh_log_file,
+                        "target create " + exe]:
+            child.sendline(command)
+            child.expect_exact(prompt)
+        child.sendline("image dump line-table main.c")
+        child.expect_exact(prompt)
+        fresh_rows = self.get_rows(child.before)
+        child.sendline("log disable dwarf line")
+        child.expect_exact(prompt)
+        self.assertTrue(self.get_tables_read(fresh_log_file) >= 1, "A new lldb read the line table from the cache file")
+        self.assertTrue(fresh_rows == rows, "A new lldb gets the same rows from the cache file")
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
@@ -0,0 +1,45 @@
+#include <stdio.h>
+
+int g_value = 0;
+
+int
+add (int a, int b)
+{
+    return a + b; // Set breakpoint in add
+}
+
+// In its own section, so the rows of this function are a sequence of
+// their own that ends with a terminal entry in the middle of the table.
+__attribute__((section(".text.line_table_cache")))
+int
+mix (int n)
+{
+    int total = 0;
+    int i;
+    // The increment and the test of the loop come after the body in the
+    // code, so their rows go back to an earlier line.
+    for (i = 0; i < n; ++i)
+    {
+        int square = i * i;
+        if (square % 3 == 0)
+            total += square;
+        else if (square % 3 == 1)
+            total -= square;
+        else
+            total ^= square;
+        if (total > 1000)
+            total = total / 2;
+    }
+    while (total < 0)
+        total += n;
+    return total;
+}
+
+int
+main (int argc, char const *argv[])
+{
+    g_value = add (argc, 1); // Set breakpoint in main
+    g_value += mix (g_value + 10);
+    printf ("%d\n", g_value);
+    return 0;
+}
@@ -0,0 +1,110 @@
+"""
+Test that searching a target's modules in parallel (target.module-query-threads)
+finds the same things, in the same order, as searching them one at a time.
+"""
+
+import os, time
+import unittest2
+import lldb
+from lldbtest import *
+import lldbutil
+
+class ModuleQueryThreadsTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    @python_api_test
+    @dwarf_test
+    def test_with_dwarf(self):
+        """Test that lookups return the same results in the same order with 1 thread and with one per CPU."""
+        self.buildDwarf()
+        self.module_query_threads()
+
+    def setUp(self):
+        # Call super's setUp().
+        TestBase.setUp(self)
+        # Find the line number to break inside main().
+        self.line = line_number('main.c', '// Set break point at this line.')
+        if sys.platform.startswith("freebsd") or sys.platform.startswith("linux"):
+            if "LD_LIBRARY_PATH" in os.environ:
+                self.runCmd("settings set target.env-vars " + self.dylibPath + "=" + os.environ["LD_LIBRARY_PATH"] + ":" + os.getcwd())
+            else:
+                self.runCmd("settings set target.env-vars " + self.dylibPath + "=" + os.getcwd())
+            self.addTearDownHook(lambda: self.runCmd("settings remove target.env-vars " + self.dylibPath))
+
+    def describe_contexts(self, sc_list):
+        """Return the module and name of each symbol context in the list, in order."""
+        result = []
+        for sc in sc_list:
+            name = sc.GetFunction().GetName() if sc.GetFunction().IsValid() else sc.GetSymbol().GetName()
+            result.append((sc.GetModule().GetFileSpec().GetFilename(), name))
+        return result
+
+    def run_queries(self, target):
+        """Run each kind of parallel lookup and return what they found."""
+        results = {}
+        results['functions'] = self.describe_contexts(target.FindFunctions("helper"))
+        results['symbols'] = self.describe_contexts(target.FindSymbols("malloc"))
+        variables = target.FindGlobalVariables("g_shared", 10)
+        results['variables'] = [(value.GetName(), value.GetChildMemberWithName("x").GetValueAsSigned()) for value in variables]
+        types = target.FindTypes("point_t")
+        results['types'] = [types.GetTypeAtIndex(i).GetName() for i in range(types.GetSize())]
+        return results
+
+    def module_query_threads(self):
+        """Test that lookups return the same results in the same order with 1 thread and with one per CPU."""
+        exe = os.path.join(os.getcwd(), "a.out")
+        self.runCmd("file " + exe, CURRENT_EXECUTABLE_SET)
+
+        # Run to main so the library and the system libraries are loaded.
+        lldbutil.run_break_set_by_file_and_line (self, "main.c", self.line, num_expected_locations=1, loc_exact=True)
+        self.runCmd("run", RUN_SUCCEEDED)
+
+        target = self.dbg.GetSelectedTarget()
+        self.assertTrue(target.GetNumModules() > 2, "The library and the system libraries are loaded")
+
+        # The setting belongs to the target, so this is what the target's
+        # image list searches with.
+        self.addTearDownHook(lambda: self.runCmd("settings clear target.module-query-threads"))
+        self.runCmd("settings set target.module-query-threads 1")
+        serial = self.run_queries(target)
+
+        self.runCmd("settings set target.module-query-threads 0")
+        parallel = self.run_queries(target)
+
+        if self.TraceOn():
+            print "serial:", serial
+            print "parallel:", parallel
+
+        # Both the executable and the library have each of these.
+        self.assertTrue(len(serial['functions']) == 2, "helper found in both modules")
+        self.assertTrue(len(serial['variables']) == 2, "g_shared found in both modules")
+        self.assertTrue(len(serial['types']) >= 1, "point_t found")
+        self.assertTrue(len(serial['symbols']) >= 1, "malloc found")
+
+        for kind in ['functions', 'symbols', 'variables', 'types']:
+            self.assertTrue(serial[kind] == parallel[kind],
+                            "%s are the same with 1 thread and with one per CPU" % kind)
+
+        # Search again with fresh modules, so the parallel search indexes
+        # them this time.
+        self.runCmd("kill")
+        self.dbg.DeleteTarget(target)
+        lldb.SBDebugger.MemoryPressureDetected()
+
+        self.runCmd("file " + exe, CURRENT_EXECUTABLE_SET)
+        lldbutil.run_break_set_by_file_and_line (self, "main.c", self.line, num_expected_locations=1, loc_exact=True)
+        self.runCmd("run", RUN_SUCCEEDED)
+        target = self.dbg.GetSelectedTarget()
+        self.runCmd("settings set target.module-query-threads 0")
+        indexed_in_parallel = self.run_queries(target)
+        for kind in ['functions', 'symbols', 'variables', 'types']:
+            self.assertTrue(serial[kind] == indexed_in_parallel[kind],
+                            "%s are the same when the modules are indexed in parallel" % kind)
+
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
@@ -0,0 +1,22 @@
+// The library has its own static helper, global and type with the same
+// names as those in main.c, so lookups find them in two modules.
+
+typedef struct point
+{
+    int x;
+    int y;
+} point_t;
+
+static point_t g_shared = { 3, 4 };
+
+static int
+helper (int value)
+{
+    return value + g_shared.x;
+}
+
+int
+foo (int value)
+{
+    return helper (value) * g_shared.y;
+}
@@ -0,0 +1,24 @@
+#include <stdio.h>
+
+typedef struct point
+{
+    int x;
+    int y;
+} point_t;
+
+static point_t g_shared = { 1, 2 };
+
+extern int foo (int value);
+
+static int
+helper (int value)
+{
+    return value + g_shared.y;
+}
+
+int
+main (int argc, char const *argv[])
+{
+    printf ("%d\n", helper (foo (argc))); // Set break point at this line.
+    return 0;
+}
@@ -0,0 +1,174 @@
+"""
+Test that 'process save-core' writes a core file that can be loaded back.
+"""
+
+import os
+import shutil
+import unittest2
+import lldb
+from lldbtest import *
+import lldbutil
+
+class SaveCoreTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    @unittest2.skipUnless(sys.platform.startswith("linux"), "requires Linux")
+    @dwarf_test
+    def test_with_dwarf(self):
+        """Test that a saved core has the threads and memory of the process."""
+        self.buildDwarf()
+        self.save_core_test()
+
+    @unittest2.skipUnless(sys.platform.startswith("linux"), "requires Linux")
+    @dwarf_test
+    def test_stacks_only_with_dwarf(self):
+        """Test that a stacks only core can be backtraced and symbolicated."""
+        self.buildDwarf()
+        self.save_stacks_only_core_test()
+
+    @unittest2.skipUnless(sys.platform.startswith("linux"), "requires Linux")
+    @dwarf_test
+    def test_stacks_only_moved_executable_with_dwarf(self):
+        """Test that the executable of a stacks only core is found by build ID after it moved."""
+        self.buildDwarf()
+        self.save_stacks_only_core_moved_executable_test()
+
+    def setUp(self):
+        # Call super's setUp().
+        TestBase.setUp(self)
+        # Find the line number for our breakpoint.
+        self.breakpoint = line_number('main.c', '// Set breakpoint here')
+
+    def save_core(self, core, options):
+        if os.path.exists(core):
+            os.remove(core)
+        self.addTearDownHook(lambda: os.path.exists(core) and os.remove(core))
+        self.runCmd("process save-core %s %s" % (options, core))
+        self.assertTrue(os.path.exists(core), "The core file was written")
+        return os.path.getsize(core)
+
+    def run_to_breakpoint(self):
+        exe = os.path.join(os.getcwd(), "a.out")
+        self.runCmd("file " + exe, CURRENT_EXECUTABLE_SET)
+
+        lldbutil.run_break_set_by_file_and_line (self, "main.c", self.breakpoint, num_expected_locations=1)
+
+        self.runCmd("run", RUN_SUCCEEDED)
+        return exe
+
+    def load_core(self, exe, core_file):
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target, VALID_TARGET)
+        process = target.LoadCore(core_file)
+        self.assertTrue(process, PROCESS_IS_VALID)
+        self.assertTrue(process.GetNumThreads() == 1, "The core has the one thread")
+
+        frame = process.GetThreadAtIndex(0).GetFrameAtIndex(0)
+        self.assertTrue(frame.GetFunctionName() == "main", "The thread is stopped in main")
+        self.assertTrue(frame.GetLineEntry().GetLine() == self.breakpoint, "The thread is stopped at the breakpoint")
+        self.assertTrue(frame.FindVariable("stack_value").GetValueAsUnsigned() == 0x12345679, "The stack is in the core")
+        return (target, frame)
+
+    def save_core_test(self):
+        """Test that a saved core has the threads and memory of the process."""
+        exe = self.run_to_breakpoint()
+
+        core = os.path.join(os.getcwd(), "save-core.core")
+        small_core = os.path.join(os.getcwd(), "save-core-small.core")
+        size = self.save_core(core, "")
+        small_size = self.save_core(small_core, "--skip-read-only-files")
+        self.assertTrue(small_size < size, "Leaving out read only files makes the core smaller")
+
+        self.runCmd("process kill")
+
+        for core_file in [core, small_core]:
+            (target, frame) = self.load_core(exe, core_file)
+
+            value = target.FindFirstGlobalVariable("g_value")
+            self.assertTrue(value.GetValueAsUnsigned() == 0x12345678, "Globals are in the core")
+            string = target.FindFirstGlobalVariable("g_heap_string")
+            self.assertTrue(string.GetSummary() == '"saved in the core"', "The heap is in the core")
+
+            self.dbg.DeleteTarget(target)
+
+    def save_stacks_only_core_test(self):
+        """Test that a stacks only core can be backtraced and symbolicated."""
+        exe = self.run_to_breakpoint()
+
+        core = os.path.join(os.getcwd(), "save-core-full.core")
+        stacks_core = os.path.join(os.getcwd(), "save-core-stacks.core")
+        size = self.save_core(core, "")
+        # Only stacks only cores leave memory out, so there is nothing to include otherwise.
+        if os.path.exists(stacks_core):
+            os.remove(stacks_core)
+        self.expect("process save-core --include-memory heap_string " + stacks_core, error=True,
+            substrs = ["invalid combination of options"])
+        self.assertFalse(os.path.exists(stacks_core), "No core file was written")
+
+        stacks_size = self.save_core(stacks_core, "--stacks-only --include-memory heap_string")
+        self.assertTrue(stacks_size < size, "A stacks only core is smaller")
+
+        self.runCmd("process kill")
+
+        (target, frame) = self.load_core(exe, stacks_core)
+
+        # The modules come from the core's module list, not the dynamic
+        # loader, whose data isn't in the core.
+        self.assertTrue(target.GetNumModules() > 1, "The shared libraries are loaded")
+        self.assertTrue(frame.GetModule().GetFileSpec().GetFilename() == "a.out", "The frame is symbolicated")
+
+        # Globals aren't in a stacks only core, the heap was asked for.
+        string = frame.FindVariable("heap_string")
+        self.assertTrue(string.GetSummary() == '"saved in the core"', "The included heap mapping is in the core")
+
+        self.dbg.DeleteTarget(target)
+
+    def save_stacks_only_core_moved_executable_test(self):
+        """Test that the executable of a stacks only core is found by build ID after it moved."""
+        exe = self.run_to_breakpoint()
+        uuid = self.dbg.GetSelectedTarget().GetModuleAtIndex(0).GetUUIDString()
+        self.assertTrue(uuid, "The executable has a build ID")
+
+        stacks_core = os.path.join(os.getcwd(), "save-core-moved.core")
+        self.save_core(stacks_core, "--stacks-only")
+        self.runCmd("process kill")
+        self.dbg.DeleteTarget(self.dbg.GetSelectedTarget())
+        lldb.SBDebugger.MemoryPressureDetected()
+
+        # Move the executable away from the path in the core, and link its
+        # build ID to it the way /usr/lib/debug/.build-id does.
+        moved_dir = os.path.join(os.getcwd(), "moved")
+        debug_dir = os.path.join(os.getcwd(), "debug-files")
+        for path in [moved_dir, debug_dir]:
+            if os.path.exists(path):
+                shutil.rmtree(path)
+        self.addTearDownHook(lambda: shutil.rmtree(moved_dir))
+        self.addTearDownHook(lambda: shutil.rmtree(debug_dir))
+        self.addTearDownHook(lambda: os.path.exists(os.path.join(moved_dir, "a.out")) and shutil.move(os.path.join(moved_dir, "a.out"), exe))
+        os.mkdir(moved_dir)
+        shutil.move(exe, moved_dir)
+        build_id = uuid.replace("-", "").lower()
+        os.makedirs(os.path.join(debug_dir, ".build-id", build_id[:2]))
+        os.symlink(os.path.join(moved_dir, "a.out"), os.path.join(debug_dir, ".build-id", build_id[:2], build_id[2:]))
+
+        self.runCmd("settings set target.debug-file-search-paths " + debug_dir)
+        self.addTearDownHook(lambda: self.runCmd("settings clear target.debug-file-search-paths"))
+
+        # Without an executable, the only way to the modules is the core.
+        self.runCmd("target create --core " + stacks_core)
+        target = self.dbg.GetSelectedTarget()
+        process = target.GetProcess()
+        self.assertTrue(process, PROCESS_IS_VALID)
+        frame = process.GetThreadAtIndex(0).GetFrameAtIndex(0)
+        self.assertTrue(frame.GetModule().GetUUIDString() == uuid, "The executable was found by its build ID")
+        self.assertTrue(frame.GetFunctionName() == "main", "The frame is symbolicated")
+        self.assertTrue(frame.GetLineEntry().GetLine() == self.breakpoint, "The frame has its line")
+
+        self.dbg.DeleteTarget(target)
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
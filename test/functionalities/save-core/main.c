@@ -0,0 +1,17 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+unsigned g_value = 0x12345678;
+char *g_heap_string = NULL;
+
+int main (int argc, char const *argv[])
+{
+    unsigned stack_value = g_value + 1;
+    char *heap_string = (char *) malloc (64);
+    strcpy (heap_string, "saved in the core");
+    g_heap_string = heap_string;
+    printf ("%s %u\n", heap_string, stack_value); // Set breakpoint here
+    free (heap_string);
+    return 0;
+}
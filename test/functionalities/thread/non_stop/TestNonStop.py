@@ -0,0 +1,142 @@
+"""
+Test that in non-stop mode only the thread that hit a breakpoint stops.
+"""
+
+import os, time
+import unittest2
+import lldb
+from lldbtest import *
+import lldbutil
+
+class NonStopTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    @unittest2.skipUnless(sys.platform.startswith("linux"), "requires Linux")
+    @dwarf_test
+    def test_with_dwarf(self):
+        """Test that other threads keep running while a thread is stopped at a breakpoint."""
+        self.buildDwarf()
+        self.non_stop_test()
+
+    @unittest2.skipUnless(sys.platform.startswith("linux"), "requires Linux")
+    @dwarf_test
+    def test_pending_stop_with_dwarf(self):
+        """Test that a thread stopping while the process is stopped is reported by the next continue."""
+        self.buildDwarf()
+        self.pending_stop_test()
+
+    def setUp(self):
+        # Call super's setUp().
+        TestBase.setUp(self)
+        # Find the line numbers for our breakpoints.
+        self.breakpoint = line_number('main.cpp', '// Set breakpoint here')
+        self.worker_breakpoint = line_number('main.cpp', '// Worker breakpoint')
+
+    def stop_main_thread(self):
+        """Run in non-stop mode to the main thread's breakpoint, and return the process and that thread."""
+        exe = os.path.join(os.getcwd(), "a.out")
+        self.runCmd("file " + exe, CURRENT_EXECUTABLE_SET)
+
+        self.runCmd("settings set target.process.non-stop-mode true")
+        # Read memory every time, we want to see the counter change.
+        self.runCmd("settings set target.process.disable-memory-cache true")
+        self.addTearDownHook(lambda: self.runCmd("settings clear target.process.non-stop-mode"))
+        self.addTearDownHook(lambda: self.runCmd("settings clear target.process.disable-memory-cache"))
+
+        lldbutil.run_break_set_by_file_and_line (self, "main.cpp", self.breakpoint, num_expected_locations=1)
+
+        self.runCmd("run", RUN_SUCCEEDED)
+
+        target = self.dbg.GetSelectedTarget()
+        process = target.GetProcess()
+        self.assertTrue(process.GetState() == lldb.eStateStopped, PROCESS_STOPPED)
+
+        stopped_thread = lldbutil.get_stopped_thread(process, lldb.eStopReasonBreakpoint)
+        self.assertTrue(stopped_thread and stopped_thread.IsValid(), STOPPED_DUE_TO_BREAKPOINT)
+        self.assertTrue(stopped_thread.IsStopped(), "The thread that hit the breakpoint is stopped")
+        return (target, process, stopped_thread)
+
+    def non_stop_test(self):
+        """Test that other threads keep running while a thread is stopped at a breakpoint."""
+        (target, process, stopped_thread) = self.stop_main_thread()
+
+        # The counting thread is still running.  It has no stop reason, and
+        # its registers aren't read, so it has no frames.
+        self.assertTrue(process.GetNumThreads() == 2, 'Number of expected threads and actual threads do not match.')
+        for thread in process:
+            if thread.GetThreadID() != stopped_thread.GetThreadID():
+                self.assertFalse(thread.IsStopped(), "The counting thread kept running")
+                self.assertTrue(thread.GetStopReason() == lldb.eStopReasonNone, "The counting thread has no stop reason")
+                self.assertTrue(thread.GetNumFrames() == 0, "The counting thread isn't unwound")
+
+        # A core can't be saved while a thread runs.
+        core = os.path.join(os.getcwd(), "non-stop.core")
+        self.addTearDownHook(lambda: os.path.exists(core) and os.remove(core))
+        self.expect("process save-core " + core, error=True,
+            substrs = ["is still running, stop all threads to save a core file"])
+        self.assertFalse(os.path.exists(core), "No core file was written")
+
+        counter = target.FindFirstGlobalVariable("g_counter")
+        self.assertTrue(counter.IsValid(), "g_counter found")
+        counter_addr = counter.GetLoadAddress()
+
+        error = lldb.SBError()
+        first = process.ReadUnsignedFromMemory(counter_addr, 4, error)
+        self.assertTrue(error.Success(), "Read g_counter while the other thread runs")
+        time.sleep(0.5)
+        second = process.ReadUnsignedFromMemory(counter_addr, 4, error)
+        self.assertTrue(error.Success(), "Read g_counter again")
+        self.assertTrue(first != second, "g_counter changed while the main thread was stopped")
+
+        # Run to completion.
+        self.runCmd("continue")
+        self.assertTrue(process.GetState() == lldb.eStateExited, PROCESS_EXITED)
+
+    def pending_stop_test(self):
+        """Test that a thread stopping while the process is stopped is reported by the next continue."""
+        (target, process, stopped_thread) = self.stop_main_thread()
+        main_tid = stopped_thread.GetThreadID()
+
+        # The counting thread hits this while the main thread is stopped, and
+        # its stop waits for the next continue.
+        worker_bkpt = target.BreakpointCreateByLocation("main.cpp", self.worker_breakpoint)
+        self.assertTrue(worker_bkpt.GetNumLocations() == 1, VALID_BREAKPOINT)
+        time.sleep(0.5)
+
+        logfile = os.path.join(os.getcwd(), "non-stop-log.txt")
+        if os.path.exists(logfile):
+            os.unlink(logfile)
+        self.runCmd("log enable -f %s lldb process step" % logfile)
+        self.addTearDownHook(lambda: self.runCmd("log disable lldb process step", check=False))
+
+        # The continue reports the pending stop without running anything.
+        self.runCmd("continue")
+        self.runCmd("log disable lldb process step")
+        self.assertTrue(process.GetState() == lldb.eStateStopped, PROCESS_STOPPED)
+
+        threads = lldbutil.get_threads_stopped_at_breakpoint(process, worker_bkpt)
+        self.assertTrue(len(threads) == 1 and threads[0].GetThreadID() != main_tid, "The counting thread stopped at its breakpoint")
+
+        main_thread = process.GetThreadByID(main_tid)
+        self.assertTrue(main_thread.IsStopped(), "The main thread is still stopped")
+        self.assertTrue(main_thread.GetFrameAtIndex(0).GetLineEntry().GetLine() == self.breakpoint,
+                        "The main thread is still at its breakpoint")
+
+        # The main thread must not have started stepping over its breakpoint
+        # (which lifts the breakpoint) for a resume that didn't happen.
+        with open(logfile, 'r') as f:
+            log = f.read()
+        self.assertTrue("reporting a pending stop instead of resuming" in log, "The pending stop was reported")
+        self.assertTrue("Single stepping past breakpoint site" not in log, "No step over breakpoint plan was pushed")
+
+        # Now both threads run to completion.
+        target.BreakpointDelete(worker_bkpt.GetID())
+        self.runCmd("continue")
+        self.assertTrue(process.GetState() == lldb.eStateExited, PROCESS_EXITED)
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
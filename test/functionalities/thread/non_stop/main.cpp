@@ -0,0 +1,44 @@
+//===-- main.cpp ------------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+// The main thread stops at a breakpoint while a worker thread keeps counting.
+// In non-stop mode the counter keeps going up while the main thread is
+// stopped.
+
+#include <pthread.h>
+#include <atomic>
+
+volatile unsigned int g_counter = 0;
+std::atomic<bool> g_done (false);
+
+void *
+counting_thread (void *input)
+{
+    while (!g_done)
+    {
+        ++g_counter; // Worker breakpoint
+    }
+    return NULL;
+}
+
+int
+main ()
+{
+    pthread_t thread;
+    pthread_create (&thread, NULL, counting_thread, NULL);
+
+    // Make sure the worker is running before we stop.
+    while (g_counter == 0)
+        ;
+
+    g_done = true; // Set breakpoint here
+
+    pthread_join (thread, NULL);
+    return 0;
+}
@@ -92,6 +92,59 @@ class LogTestCase(TestBase):
         if not success:
             self.fail (err_msg)
 
+    def test_flight_recorder (self):
+        """Test that flight recorder logs are only written out by 'log dump'."""
+        log_file = os.path.join (os.getcwd(), "lldb-flight-recorder-log.txt")
+        if (os.path.exists (log_file)):
+            os.remove (log_file)
+
+        self.runCmd ("log enable -r -f '%s' lldb commands" % (log_file))
+        self.addTearDownHook(lambda: self.runCmd("log disable lldb"))
+
+        self.runCmd ("settings show prompt")
+
+        log_lines = []
+        if (os.path.exists (log_file)):
+            f = open (log_file)
+            log_lines = f.readlines()
+            f.close ()
+        self.assertTrue (len (log_lines) == 0, "Nothing is written before 'log dump'")
+
+        self.runCmd ("log dump")
+
+        f = open (log_file)
+        log_text = f.read()
+        f.close ()
+        os.remove (log_file)
+        self.assertTrue ("Processing command: settings show prompt" in log_text)
+
+    def test_async (self):
+        """Test that async logs are written in order, and all of them by 'log disable'."""
+        log_file = os.path.join (os.getcwd(), "lldb-async-log.txt")
+        if (os.path.exists (log_file)):
+            os.remove (log_file)
+
+        self.runCmd ("log enable -a -f '%s' lldb commands" % (log_file))
+        self.addTearDownHook(lambda: self.runCmd("log disable lldb", check=False))
+
+        commands = ["settings show prompt", "help help", "version"]
+        for command in commands:
+            self.runCmd (command)
+
+        # Disabling the log writes out everything queued, so the file is
+        # complete as soon as it returns.
+        self.runCmd ("log disable lldb")
+
+        f = open (log_file)
+        log_lines = f.readlines()
+        f.close ()
+        os.remove (log_file)
+
+        processed = [line for line in log_lines if line.startswith ("Processing command: ")]
+        expected = ["Processing command: %s\n" % command for command in commands + ["log disable lldb"]]
+        self.assertTrue (processed == expected,
+                         "Expected %s, found %s" % (expected, processed))
+
 
 if __name__ == '__main__':
     import atexit
@@ -0,0 +1,64 @@
+"""
+Test that the children of a value with many children are created on
+demand in any order, are only created once, and stay alive as long as
+any value of their cluster is referenced.
+"""
+
+import os, time
+import unittest2
+import lldb, lldbutil
+from lldbtest import *
+
+class ValueManyChildrenTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    @python_api_test
+    def test_many_children(self):
+        """Check the children of an array of 1000 structures."""
+        self.buildDefault()
+
+        exe = os.path.join(os.getcwd(), "a.out")
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target, VALID_TARGET)
+
+        line = line_number('main.c', '// Stop here and check values')
+        self.assertTrue(target.BreakpointCreateByLocation('main.c', line), VALID_BREAKPOINT)
+
+        process = target.LaunchSimple (None, None, self.get_process_working_directory())
+        self.assertTrue(process, PROCESS_IS_VALID)
+
+        thread = lldbutil.get_stopped_thread(process, lldb.eStopReasonBreakpoint)
+        self.assertTrue(thread.IsValid(), "There should be a thread stopped due to breakpoint")
+        frame = thread.GetFrameAtIndex(0)
+
+        lines = frame.FindVariable("g_lines")
+        self.assertTrue(lines.IsValid() and lines.GetNumChildren() == 1000)
+
+        # Create the children from the back, then from the front, and
+        # check that asking again returns the same child.
+        for i in range(999, -1, -7) + range(0, 1000, 5):
+            line = lines.GetChildAtIndex(i)
+            self.assertTrue(line.GetName() == "[%d]" % i)
+            self.assertTrue(line.GetChildMemberWithName("start").GetChildMemberWithName("x").GetValueAsSigned() == i)
+            self.assertTrue(line.GetChildMemberWithName("start").GetChildMemberWithName("y").GetValueAsSigned() == -i)
+            self.assertTrue(line.GetChildMemberWithName("end").GetChildMemberWithName("x").GetValueAsSigned() == i * 2)
+            self.assertTrue(line.GetChildMemberWithName("end").GetChildMemberWithName("y").GetValueAsSigned() == i * 3)
+            self.assertTrue(lines.GetChildAtIndex(i).GetID() == line.GetID(),
+                            "Child %d was created only once" % i)
+
+        # There is no child past the end, no matter how often we ask.
+        for i in range(3):
+            self.assertFalse(lines.GetChildAtIndex(1000).IsValid())
+
+        # A grandchild keeps the whole cluster alive.
+        end_y = lines.GetChildAtIndex(500).GetChildMemberWithName("end").GetChildMemberWithName("y")
+        lines = None
+        frame = None
+        self.assertTrue(end_y.IsValid() and end_y.GetValueAsSigned() == 1500)
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
@@ -0,0 +1,38 @@
+//===-- main.c --------------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <stdio.h>
+
+struct point
+{
+    int x;
+    int y;
+};
+
+struct line
+{
+    struct point start;
+    struct point end;
+};
+
+struct line g_lines[1000];
+
+int
+main (int argc, char const *argv[])
+{
+    int i;
+    for (i = 0; i < 1000; i++)
+    {
+        g_lines[i].start.x = i;
+        g_lines[i].start.y = -i;
+        g_lines[i].end.x = i * 2;
+        g_lines[i].end.y = i * 3;
+    }
+    printf ("%d\n", g_lines[3].end.x); // Stop here and check values
+    return 0;
+}
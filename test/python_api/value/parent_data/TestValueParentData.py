@@ -0,0 +1,78 @@
+"""
+Test that the members of an array of structures, whose bytes are taken
+from the data their parent read, have the right values, and are updated
+when the memory changes.
+"""
+
+import os, time
+import unittest2
+import lldb, lldbutil
+from lldbtest import *
+
+class ValueParentDataTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    @python_api_test
+    def test_children_of_memory_value(self):
+        """Check children sliced out of their parent's data."""
+        self.buildDefault()
+
+        exe = os.path.join(os.getcwd(), "a.out")
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target, VALID_TARGET)
+
+        first_line = line_number('main.c', '// Stop here and check values')
+        second_line = line_number('main.c', '// Stop here and check new values')
+        self.assertTrue(target.BreakpointCreateByLocation('main.c', first_line), VALID_BREAKPOINT)
+        self.assertTrue(target.BreakpointCreateByLocation('main.c', second_line), VALID_BREAKPOINT)
+
+        process = target.LaunchSimple (None, None, self.get_process_working_directory())
+        self.assertTrue(process, PROCESS_IS_VALID)
+
+        thread = lldbutil.get_stopped_thread(process, lldb.eStopReasonBreakpoint)
+        self.assertTrue(thread.IsValid(), "There should be a thread stopped due to breakpoint")
+        frame = thread.GetFrameAtIndex(0)
+
+        # g_points is read with one memory read.  Its 16 elements, and
+        # their x, y and label members, are sliced out of it; the
+        # bitfields read their own data.
+        log_file = os.path.join(os.getcwd(), "parent-data.log")
+        if os.path.exists(log_file):
+            os.remove(log_file)
+        self.addTearDownHook(lambda: os.path.exists(log_file) and os.remove(log_file))
+        self.runCmd("log enable -f %s lldb types" % log_file)
+        self.addTearDownHook(lambda: self.runCmd("log disable lldb types", check=False))
+        self.runCmd("frame variable g_points")
+        self.runCmd("log disable lldb types")
+        with open(log_file, "r") as f:
+            log = f.read()
+        self.assertTrue("g_points: 64 memory reads saved" in log,
+                        "The children of g_points used their parent's data")
+
+        points = frame.FindVariable("g_points")
+        self.assertTrue(points.IsValid() and points.GetNumChildren() == 16)
+        for i in range(16):
+            point = points.GetChildAtIndex(i)
+            self.assertTrue(point.GetChildMemberWithName("x").GetValueAsSigned() == i)
+            self.assertTrue(point.GetChildMemberWithName("y").GetValueAsSigned() == i * 2)
+            self.assertTrue(point.GetChildMemberWithName("flags").GetValueAsUnsigned() == i & 7)
+            self.assertTrue(point.GetChildMemberWithName("mode").GetValueAsUnsigned() == i)
+            self.assertTrue(point.GetChildMemberWithName("label").GetSummary() == '"point"')
+
+        process.Continue()
+        thread = lldbutil.get_stopped_thread(process, lldb.eStopReasonBreakpoint)
+        self.assertTrue(thread.IsValid(), "There should be a thread stopped due to breakpoint")
+        frame = thread.GetFrameAtIndex(0)
+
+        points = frame.FindVariable("g_points")
+        for i in range(16):
+            point = points.GetChildAtIndex(i)
+            self.assertTrue(point.GetChildMemberWithName("x").GetValueAsSigned() == i)
+            self.assertTrue(point.GetChildMemberWithName("y").GetValueAsSigned() == -i)
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
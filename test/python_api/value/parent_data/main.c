@@ -0,0 +1,40 @@
+//===-- main.c --------------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <stdio.h>
+
+struct point
+{
+    int x;
+    int y;
+    unsigned flags : 3;
+    unsigned mode : 5;
+    const char *label;
+};
+
+struct point g_points[16];
+
+int
+main (int argc, char const *argv[])
+{
+    int i;
+    for (i = 0; i < 16; i++)
+    {
+        g_points[i].x = i;
+        g_points[i].y = i * 2;
+        g_points[i].flags = i & 7;
+        g_points[i].mode = i;
+        g_points[i].label = "point";
+    }
+    printf ("%d\n", g_points[3].x); // Stop here and check values
+
+    for (i = 0; i < 16; i++)
+        g_points[i].y = -i;
+    printf ("%d\n", g_points[3].y); // Stop here and check new values
+    return 0;
+}
@@ -7,6 +7,8 @@ o test_display_source_python:
   Test display of source using the SBSourceManager API.
 o test_modify_source_file_while_debugging:
   Test the caching mechanism of the source manager.
+o test_source_map_per_target:
+  Test that targets with different source maps don't share cached files.
 """
 
 import unittest2
@@ -41,6 +43,11 @@ class SourceManagerTestCase(TestBase):
         self.buildDefault()
         self.modify_source_file_while_debugging()
 
+    def test_source_map_per_target(self):
+        """Test that two targets with different target.source-map settings each see their own main.c."""
+        self.buildDefault()
+        self.source_map_per_target()
+
     def display_source_python(self):
         """Display source using the SBSourceManager API."""
         exe = os.path.join(os.getcwd(), "a.out")
@@ -108,6 +115,51 @@ class SourceManagerTestCase(TestBase):
         self.expect("source list -n main", SOURCE_DISPLAYED_CORRECTLY,
             substrs = ['Hello world'])
 
+    def source_map_per_target(self):
+        """Test that two targets with different target.source-map settings each see their own main.c."""
+        exe = os.path.join(os.getcwd(), "a.out")
+
+        # Move main.c to hidden/main.c, and put a different main.c in other/.
+        main_c = "main.c"
+        main_c_hidden = os.path.join("hidden", main_c)
+        other_dir = os.path.join(os.getcwd(), "other")
+        main_c_other = os.path.join(other_dir, main_c)
+        with open(main_c, 'r') as f:
+            original_content = f.read()
+        os.rename(main_c, main_c_hidden)
+        if not os.path.isdir(other_dir):
+            os.mkdir(other_dir)
+        with open(main_c_other, 'w') as f:
+            f.write(original_content.replace('Hello world', 'Hello other', 1))
+
+        def cleanup():
+            os.rename(main_c_hidden, main_c)
+            os.remove(main_c_other)
+            os.rmdir(other_dir)
+        self.addTearDownHook(cleanup)
+
+        # The first target maps the build directory to hidden/.
+        self.runCmd("target create " + exe, CURRENT_EXECUTABLE_SET)
+        self.runCmd("settings set target.source-map %s %s" % (os.getcwd(), os.path.join(os.getcwd(), "hidden")))
+        self.expect("source list -n main", SOURCE_DISPLAYED_CORRECTLY,
+            substrs = ['Hello world'])
+
+        # The second target maps it to other/, and must not get the file the
+        # first target found in the debugger's source file cache.
+        self.runCmd("target create " + exe, CURRENT_EXECUTABLE_SET)
+        self.runCmd("settings set target.source-map %s %s" % (os.getcwd(), other_dir))
+        self.expect("source list -n main", SOURCE_DISPLAYED_CORRECTLY,
+            substrs = ['Hello other'],
+            matching = True)
+        self.expect("source list -n main", SOURCE_DISPLAYED_CORRECTLY,
+            substrs = ['Hello world'],
+            matching = False)
+
+        # And the first target still sees its own file.
+        self.runCmd("target select 0")
+        self.expect("source list -n main", SOURCE_DISPLAYED_CORRECTLY,
+            substrs = ['Hello world'])
+
     def modify_source_file_while_debugging(self):
         """Modify a source file while debugging the executable."""
         exe = os.path.join(os.getcwd(), "a.out")
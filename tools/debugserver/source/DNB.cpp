@@ -1061,6 +1061,22 @@ DNBBreakpointClear (nub_process_t pid, nub_addr_t addr)
     return false; // Failed
 }
 
+nub_bool_t
+DNBBreakpointSetConditions (nub_process_t pid, nub_addr_t addr, const DNBBreakpointCondition *conditions, nub_size_t num_conditions)
+{
+    MachProcessSP procSP;
+    if (GetProcessSP (pid, procSP))
+    {
+        DNBBreakpoint *bp = procSP->Breakpoints().FindByAddress(addr);
+        if (bp && bp->IsBreakpoint())
+        {
+            bp->SetConditions (conditions, num_conditions);
+            return true;
+        }
+    }
+    return false;
+}
+
 
 //----------------------------------------------------------------------
 // Watchpoints
@@ -26,6 +26,8 @@
 
 typedef bool (*DNBShouldCancelCallback) (void *);
 
+class DNBBreakpointCondition;
+
 void            DNBInitialize ();
 void            DNBTerminate ();
 
@@ -133,6 +135,7 @@ const char *    DNBThreadGetInfo                (nub_process_t pid, nub_thread_t
 //----------------------------------------------------------------------
 nub_bool_t      DNBBreakpointSet                (nub_process_t pid, nub_addr_t addr, nub_size_t size, nub_bool_t hardware);
 nub_bool_t      DNBBreakpointClear              (nub_process_t pid, nub_addr_t addr);
+nub_bool_t      DNBBreakpointSetConditions      (nub_process_t pid, nub_addr_t addr, const DNBBreakpointCondition *conditions, nub_size_t num_conditions);
 
 //----------------------------------------------------------------------
 // Watchpoint functions
@@ -18,6 +18,294 @@
 #include <inttypes.h>
 #include "DNBLog.h"
 
+#pragma mark -- DNBBreakpointCondition
+
+// The subset of gdb's agent expression opcodes we evaluate
+enum
+{
+    kAgentOpAdd             = 0x02,
+    kAgentOpSub             = 0x03,
+    kAgentOpMul             = 0x04,
+    kAgentOpLogNot          = 0x0e,
+    kAgentOpBitAnd          = 0x0f,
+    kAgentOpBitOr           = 0x10,
+    kAgentOpBitXor          = 0x11,
+    kAgentOpBitNot          = 0x12,
+    kAgentOpEqual           = 0x13,
+    kAgentOpLessSigned      = 0x14,
+    kAgentOpLessUnsigned    = 0x15,
+    kAgentOpExt             = 0x16,
+    kAgentOpRef8            = 0x17,
+    kAgentOpRef16           = 0x18,
+    kAgentOpRef32           = 0x19,
+    kAgentOpRef64           = 0x1a,
+    kAgentOpIfGoto          = 0x20,
+    kAgentOpGoto            = 0x21,
+    kAgentOpConst8          = 0x22,
+    kAgentOpConst16         = 0x23,
+    kAgentOpConst32         = 0x24,
+    kAgentOpConst64         = 0x25,
+    kAgentOpReg             = 0x26,
+    kAgentOpEnd             = 0x27,
+    kAgentOpDup             = 0x28,
+    kAgentOpPop             = 0x29,
+    kAgentOpZeroExt         = 0x2a,
+    kAgentOpSwap            = 0x2b
+};
+
+static const size_t kAgentMaxStackDepth = 64;
+static const size_t kAgentMaxSteps = 65536;
+
+// Returns the number of operand bytes that follow OPCODE, or -1 if we
+// don't know the opcode.
+static int
+AgentOperandSize (uint8_t opcode)
+{
+    switch (opcode)
+    {
+        case kAgentOpAdd:       case kAgentOpSub:       case kAgentOpMul:
+        case kAgentOpLogNot:    case kAgentOpBitAnd:    case kAgentOpBitOr:
+        case kAgentOpBitXor:    case kAgentOpBitNot:    case kAgentOpEqual:
+        case kAgentOpLessSigned:case kAgentOpLessUnsigned:
+        case kAgentOpRef8:      case kAgentOpRef16:     case kAgentOpRef32:
+        case kAgentOpRef64:     case kAgentOpEnd:       case kAgentOpDup:
+        case kAgentOpPop:       case kAgentOpSwap:
+            return 0;
+        case kAgentOpExt:
+        case kAgentOpZeroExt:
+        case kAgentOpConst8:
+            return 1;
+        case kAgentOpIfGoto:
+        case kAgentOpGoto:
+        case kAgentOpConst16:
+        case kAgentOpReg:
+            return 2;
+        case kAgentOpConst32:
+            return 4;
+        case kAgentOpConst64:
+            return 8;
+    }
+    return -1;
+}
+
+// Operands are encoded big endian
+static uint64_t
+AgentReadOperand (const std::vector<uint8_t> &bytecode, size_t offset, size_t size)
+{
+    uint64_t value = 0;
+    for (size_t i=0; i<size; ++i)
+        value = (value << 8) | bytecode[offset + i];
+    return value;
+}
+
+DNBBreakpointCondition::DNBBreakpointCondition() :
+    m_bytecode(),
+    m_register_map()
+{
+}
+
+DNBBreakpointCondition::~DNBBreakpointCondition()
+{
+}
+
+bool
+DNBBreakpointCondition::SetBytecode (const uint8_t *bytes, nub_size_t size)
+{
+    m_bytecode.assign (bytes, bytes + size);
+    m_register_map.clear();
+
+    bool terminated = false;
+    size_t pc = 0;
+    while (pc < m_bytecode.size())
+    {
+        const uint8_t opcode = m_bytecode[pc++];
+        const int operand_size = AgentOperandSize (opcode);
+        if (operand_size < 0 || pc + operand_size > m_bytecode.size())
+        {
+            m_bytecode.clear();
+            return false;
+        }
+        if (opcode == kAgentOpGoto || opcode == kAgentOpIfGoto)
+        {
+            if (AgentReadOperand (m_bytecode, pc, operand_size) >= m_bytecode.size())
+            {
+                m_bytecode.clear();
+                return false;
+            }
+        }
+        if (opcode == kAgentOpEnd)
+            terminated = true;
+        pc += operand_size;
+    }
+    if (!terminated)
+        m_bytecode.clear();
+    return terminated;
+}
+
+void
+DNBBreakpointCondition::GetRegisterNumbers (std::vector<uint32_t> &regnums) const
+{
+    regnums.clear();
+    size_t pc = 0;
+    while (pc < m_bytecode.size())
+    {
+        const uint8_t opcode = m_bytecode[pc++];
+        const int operand_size = AgentOperandSize (opcode);
+        if (operand_size < 0)
+            break;
+        if (opcode == kAgentOpReg)
+        {
+            const uint32_t regnum = AgentReadOperand (m_bytecode, pc, operand_size);
+            if (std::find (regnums.begin(), regnums.end(), regnum) == regnums.end())
+                regnums.push_back (regnum);
+        }
+        pc += operand_size;
+    }
+}
+
+void
+DNBBreakpointCondition::SetRegisterMapping (uint32_t regnum, uint32_t set, uint32_t reg)
+{
+    m_register_map[regnum] = std::make_pair (set, reg);
+}
+
+bool
+DNBBreakpointCondition::Evaluate (MachProcess *process, nub_thread_t tid, uint64_t &result) const
+{
+    // SetBytecode() validated the opcodes, operand sizes and jump
+    // targets, so only the stack needs checking as we go.
+    std::vector<uint64_t> stack;
+    size_t pc = 0;
+    for (size_t steps = 0; steps < kAgentMaxSteps && pc < m_bytecode.size(); ++steps)
+    {
+        const uint8_t opcode = m_bytecode[pc++];
+        const int operand_size = AgentOperandSize (opcode);
+        const uint64_t operand = AgentReadOperand (m_bytecode, pc, operand_size);
+        pc += operand_size;
+
+        size_t pops = 0;
+        switch (opcode)
+        {
+            case kAgentOpAdd:       case kAgentOpSub:       case kAgentOpMul:
+            case kAgentOpBitAnd:    case kAgentOpBitOr:     case kAgentOpBitXor:
+            case kAgentOpEqual:     case kAgentOpLessSigned:case kAgentOpLessUnsigned:
+            case kAgentOpSwap:
+                pops = 2;
+                break;
+            case kAgentOpLogNot:    case kAgentOpBitNot:    case kAgentOpExt:
+            case kAgentOpZeroExt:   case kAgentOpRef8:      case kAgentOpRef16:
+            case kAgentOpRef32:     case kAgentOpRef64:     case kAgentOpIfGoto:
+            case kAgentOpEnd:       case kAgentOpDup:       case kAgentOpPop:
+                pops = 1;
+                break;
+        }
+        if (stack.size() < pops || stack.size() >= kAgentMaxStackDepth)
+            return false;
+
+        uint64_t value;
+        switch (opcode)
+        {
+            case kAgentOpAdd:   value = stack.back(); stack.pop_back(); stack.back() += value; break;
+            case kAgentOpSub:   value = stack.back(); stack.pop_back(); stack.back() -= value; break;
+            case kAgentOpMul:   value = stack.back(); stack.pop_back(); stack.back() *= value; break;
+            case kAgentOpBitAnd:value = stack.back(); stack.pop_back(); stack.back() &= value; break;
+            case kAgentOpBitOr: value = stack.back(); stack.pop_back(); stack.back() |= value; break;
+            case kAgentOpBitXor:value = stack.back(); stack.pop_back(); stack.back() ^= value; break;
+            case kAgentOpBitNot:stack.back() = ~stack.back(); break;
+            case kAgentOpLogNot:stack.back() = stack.back() == 0; break;
+            case kAgentOpEqual:
+                value = stack.back(); stack.pop_back();
+                stack.back() = stack.back() == value;
+                break;
+            case kAgentOpLessSigned:
+                value = stack.back(); stack.pop_back();
+                stack.back() = (int64_t)stack.back() < (int64_t)value;
+                break;
+            case kAgentOpLessUnsigned:
+                value = stack.back(); stack.pop_back();
+                stack.back() = stack.back() < value;
+                break;
+
+            case kAgentOpExt:
+            case kAgentOpZeroExt:
+                if (operand > 0 && operand < 64)
+                {
+                    const uint64_t mask = (1ull << operand) - 1;
+                    value = stack.back() & mask;
+                    if (opcode == kAgentOpExt && (value & (1ull << (operand - 1))))
+                        value |= ~mask;
+                    stack.back() = value;
+                }
+                break;
+
+            case kAgentOpRef8:
+            case kAgentOpRef16:
+            case kAgentOpRef32:
+            case kAgentOpRef64:
+                {
+                    const nub_size_t byte_size = 1u << (opcode - kAgentOpRef8);
+                    uint8_t buf[8];
+                    if (process->ReadMemory (stack.back(), byte_size, buf) != byte_size)
+                        return false;
+                    switch (byte_size)
+                    {
+                        case 1: stack.back() = buf[0]; break;
+                        case 2: { uint16_t v; ::memcpy (&v, buf, sizeof(v)); stack.back() = v; } break;
+                        case 4: { uint32_t v; ::memcpy (&v, buf, sizeof(v)); stack.back() = v; } break;
+                        case 8: { uint64_t v; ::memcpy (&v, buf, sizeof(v)); stack.back() = v; } break;
+                    }
+                }
+                break;
+
+            case kAgentOpIfGoto:
+                value = stack.back(); stack.pop_back();
+                if (value)
+                    pc = operand;
+                break;
+            case kAgentOpGoto:
+                pc = operand;
+                break;
+
+            case kAgentOpConst8:
+            case kAgentOpConst16:
+            case kAgentOpConst32:
+            case kAgentOpConst64:
+                stack.push_back (operand);
+                break;
+
+            case kAgentOpReg:
+                {
+                    RegisterMap::const_iterator pos = m_register_map.find (operand);
+                    if (pos == m_register_map.end())
+                        return false;
+                    DNBRegisterValue reg_value;
+                    if (!process->GetRegisterValue (tid, pos->second.first, pos->second.second, &reg_value))
+                        return false;
+                    switch (reg_value.info.size)
+                    {
+                        case 1: stack.push_back (reg_value.value.uint8); break;
+                        case 2: stack.push_back (reg_value.value.uint16); break;
+                        case 4: stack.push_back (reg_value.value.uint32); break;
+                        case 8: stack.push_back (reg_value.value.uint64); break;
+                        default: return false;
+                    }
+                }
+                break;
+
+            case kAgentOpEnd:
+                result = stack.back();
+                return true;
+
+            case kAgentOpDup:   stack.push_back (stack.back()); break;
+            case kAgentOpPop:   stack.pop_back(); break;
+            case kAgentOpSwap:  std::swap (stack[stack.size() - 1], stack[stack.size() - 2]); break;
+
+            default:
+                return false;
+        }
+    }
+    return false;
+}
 
 #pragma mark -- DNBBreakpoint
 DNBBreakpoint::DNBBreakpoint(nub_addr_t addr, nub_size_t byte_size, bool hardware) :
@@ -30,7 +318,8 @@ DNBBreakpoint::DNBBreakpoint(nub_addr_t addr, nub_size_t byte_size, bool hardwar
     m_is_watchpoint(0),
     m_watch_read(0),
     m_watch_write(0),
-    m_hw_index(INVALID_NUB_HW_INDEX)
+    m_hw_index(INVALID_NUB_HW_INDEX),
+    m_conditions()
 {
 }
 
@@ -62,6 +351,31 @@ DNBBreakpoint::Dump() const
     }
 }
 
+//----------------------------------------------------------------------
+// Returns true if we should stop at this breakpoint: when it has no
+// conditions, when any of its conditions is true, or when we can't
+// evaluate one of them (the debugger will evaluate it itself).
+//----------------------------------------------------------------------
+bool
+DNBBreakpoint::ConditionsSayStop (MachProcess *process, nub_thread_t tid) const
+{
+    if (m_conditions.empty())
+        return true;
+    const size_t num_conditions = m_conditions.size();
+    for (size_t i=0; i<num_conditions; ++i)
+    {
+        uint64_t result = 0;
+        if (!m_conditions[i].Evaluate (process, tid, result))
+        {
+            DNBLogThreadedIf(LOG_BREAKPOINTS, "DNBBreakpoint::ConditionsSayStop ( tid = 0x%8.8" PRIx64 " ) addr = 0x%8.8llx condition %zu couldn't be evaluated", tid, (uint64_t)m_addr, i);
+            return true;
+        }
+        if (result != 0)
+            return true;
+    }
+    return false;
+}
+
 #pragma mark -- DNBBreakpointList
 
 DNBBreakpointList::DNBBreakpointList()
@@ -23,6 +23,35 @@
 
 class MachProcess;
 
+//----------------------------------------------------------------------
+// A breakpoint condition sent by the debugger along with a "Z0" packet
+// ("Z0,<addr>,<kind>;X<len>,<hex bytes>"), in gdb's agent expression
+// bytecode. The register operands in the bytecode are the debugger's
+// register numbers (the "qRegisterInfo" indexes), so each one must be
+// mapped to a register set and register with SetRegisterMapping()
+// before the condition can be evaluated.
+//----------------------------------------------------------------------
+class DNBBreakpointCondition
+{
+public:
+    DNBBreakpointCondition();
+    ~DNBBreakpointCondition();
+
+    // Returns false if the bytecode contains an opcode we don't support
+    // or isn't terminated.
+    bool        SetBytecode (const uint8_t *bytes, nub_size_t size);
+    const std::vector<uint8_t> &
+                Bytecode () const { return m_bytecode; }
+    void        GetRegisterNumbers (std::vector<uint32_t> &regnums) const;
+    void        SetRegisterMapping (uint32_t regnum, uint32_t set, uint32_t reg);
+    bool        Evaluate (MachProcess *process, nub_thread_t tid, uint64_t &result) const;
+
+private:
+    typedef std::map<uint32_t, std::pair<uint32_t, uint32_t> > RegisterMap;
+    std::vector<uint8_t> m_bytecode;    // The agent expression bytecode
+    RegisterMap m_register_map;         // Debugger register number to (set, reg)
+};
+
 class DNBBreakpoint
 {
 public:
@@ -112,6 +141,12 @@ public:
                         return 0;
                     return --m_retain_count;
                 }
+    void        SetConditions (const DNBBreakpointCondition *conditions, nub_size_t num_conditions)
+                {
+                    m_conditions.assign (conditions, conditions + num_conditions);
+                }
+    bool        HasConditions () const { return !m_conditions.empty(); }
+    bool        ConditionsSayStop (MachProcess *process, nub_thread_t tid) const;
 
 private:
     uint32_t    m_retain_count;     // Each breakpoint is maintained by address and is ref counted in case multiple people set a breakpoint at the same address
@@ -124,6 +159,7 @@ private:
                 m_watch_read:1,     // 1 if we stop when the watched data is read from
                 m_watch_write:1;    // 1 if we stop when the watched data is written to
     uint32_t    m_hw_index;         // The hardware resource index for this breakpoint/watchpoint
+    std::vector<DNBBreakpointCondition> m_conditions; // The conditions from the last Z packet, stop if any are true
 };
 
 
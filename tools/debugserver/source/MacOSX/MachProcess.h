@@ -128,6 +128,8 @@ public:
     bool                    EnableBreakpoint (nub_addr_t addr);
     DNBBreakpointList&      Breakpoints() { return m_breakpoints; }
     const DNBBreakpointList& Breakpoints() const { return m_breakpoints; }
+    bool                    ConditionalBreakpointSaysStop (nub_thread_t tid, const DNBBreakpoint *bp);
+    bool                    SteppedOverConditionalBreakpoint (nub_thread_t tid) const { return tid == m_cond_bp_stepped_tid; }
 
     //----------------------------------------------------------------------
     // Watchpoint functions
@@ -280,6 +282,7 @@ private:
     void                    Clear ();
     void                    ReplyToAllExceptions ();
     void                    PrivateResume ();
+    void                    StepOverConditionalBreakpoint ();
 
     uint32_t                Flags () const { return m_flags; }
     nub_state_t             DoSIGSTOP (bool clear_bps_and_wps, bool allow_running, uint32_t *thread_idx_ptr);
@@ -326,6 +329,11 @@ private:
     void *                      m_image_infos_baton;
     std::string                 m_bundle_id;                 // If we are a SB or BKS process, this will be our bundle ID.
     bool                        m_did_exec;
+    nub_thread_t                m_cond_bp_step_over_tid;    // The thread to step off of a conditional breakpoint whose conditions said not to stop
+    nub_addr_t                  m_cond_bp_step_over_addr;   // The address of that breakpoint
+    bool                        m_cond_bp_stepping;         // True while we are stepping m_cond_bp_step_over_tid over the breakpoint
+    nub_thread_t                m_cond_bp_stepped_tid;      // The thread we just stepped, valid while deciding if we should stop
+    DNBThreadResumeActions      m_cond_bp_saved_actions;    // The thread actions to restore once the step is done
 };
 
 
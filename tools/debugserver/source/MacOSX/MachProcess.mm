@@ -138,7 +138,12 @@ MachProcess::MachProcess() :
     m_name_to_addr_baton(NULL),
     m_image_infos_callback(NULL),
     m_image_infos_baton(NULL),
-    m_did_exec (false)
+    m_did_exec (false),
+    m_cond_bp_step_over_tid (INVALID_NUB_THREAD),
+    m_cond_bp_step_over_addr (INVALID_NUB_ADDRESS),
+    m_cond_bp_stepping (false),
+    m_cond_bp_stepped_tid (INVALID_NUB_THREAD),
+    m_cond_bp_saved_actions ()
 {
     DNBLogThreadedIf(LOG_PROCESS | LOG_VERBOSE, "%s", __PRETTY_FUNCTION__);
 }
@@ -762,6 +767,58 @@ MachProcess::PrivateResume ()
     m_task.Resume();
 }
 
+//----------------------------------------------------------------------
+// Called when thread TID is stopped at breakpoint BP that has conditions
+// from the debugger. Returns true if we should report the stop. If not,
+// we remember the thread so we can step it off of the breakpoint before
+// resuming; other threads at conditional breakpoints will simply hit
+// theirs again.
+//----------------------------------------------------------------------
+bool
+MachProcess::ConditionalBreakpointSaysStop (nub_thread_t tid, const DNBBreakpoint *bp)
+{
+    // If the debugger was stepping this thread, it needs to know we
+    // stopped at a breakpoint no matter what its conditions say.
+    const DNBThreadResumeAction *action = m_thread_actions.GetActionForThread (tid, true);
+    if (action == NULL || action->state != eStateRunning)
+        return true;
+
+    if (bp->ConditionsSayStop (this, tid))
+        return true;
+
+    DNBLogThreadedIf(LOG_BREAKPOINTS, "MachProcess::ConditionalBreakpointSaysStop ( tid = 0x%8.8" PRIx64 " ) conditions at 0x%8.8llx are false", tid, (uint64_t)bp->Address());
+    if (m_cond_bp_step_over_tid == INVALID_NUB_THREAD)
+    {
+        m_cond_bp_step_over_tid = tid;
+        m_cond_bp_step_over_addr = bp->Address();
+    }
+    return false;
+}
+
+//----------------------------------------------------------------------
+// Single step m_cond_bp_step_over_tid off of its breakpoint with all
+// other threads suspended. The breakpoint is put back, and the thread
+// actions restored, when the step completes in
+// ExceptionMessageBundleComplete().
+//----------------------------------------------------------------------
+void
+MachProcess::StepOverConditionalBreakpoint ()
+{
+    DNBLogThreadedIf(LOG_BREAKPOINTS, "MachProcess::StepOverConditionalBreakpoint ( tid = 0x%8.8" PRIx64 ", addr = 0x%8.8llx )", m_cond_bp_step_over_tid, (uint64_t)m_cond_bp_step_over_addr);
+    if (!DisableBreakpoint (m_cond_bp_step_over_addr, false))
+    {
+        // We can't get the thread past the breakpoint, so report the stop.
+        SetState (eStateStopped);
+        return;
+    }
+
+    m_cond_bp_saved_actions = m_thread_actions;
+    m_thread_actions = DNBThreadResumeActions (eStateSuspended, 0);
+    m_thread_actions.AppendAction (m_cond_bp_step_over_tid, eStateStepping);
+    m_cond_bp_stepping = true;
+    PrivateResume ();
+}
+
 DNBBreakpoint *
 MachProcess::CreateBreakpoint(nub_addr_t addr, nub_size_t length, bool hardware)
 {
@@ -1214,8 +1271,24 @@ MachProcess::ExceptionMessageBundleComplete()
         if (DNBLogCheckLogBit(LOG_THREAD))
             m_thread_list.Dump();
 
+        // If we just single stepped a thread off of a conditional breakpoint
+        // put the breakpoint back and restore the thread actions we were
+        // resumed with.
+        if (m_cond_bp_stepping)
+        {
+            m_cond_bp_stepping = false;
+            m_cond_bp_stepped_tid = m_cond_bp_step_over_tid;
+            if (!m_did_exec)
+                EnableBreakpoint (m_cond_bp_step_over_addr);
+            m_thread_actions = m_cond_bp_saved_actions;
+        }
+        m_cond_bp_step_over_tid = INVALID_NUB_THREAD;
+        m_cond_bp_step_over_addr = INVALID_NUB_ADDRESS;
+
         bool step_more = false;
-        if (m_thread_list.ShouldStop(step_more))
+        const bool should_stop = m_thread_list.ShouldStop(step_more);
+        m_cond_bp_stepped_tid = INVALID_NUB_THREAD;
+        if (should_stop)
         {
             // Wait for the eEventProcessRunningStateChanged event to be reset
             // before changing state to stopped to avoid race condition with
@@ -1226,6 +1299,12 @@ MachProcess::ExceptionMessageBundleComplete()
             m_events.WaitForEventsToReset(eEventProcessRunningStateChanged, &timeout);
             SetState(eStateStopped);
         }
+        else if (m_cond_bp_step_over_tid != INVALID_NUB_THREAD)
+        {
+            // A thread hit a conditional breakpoint whose conditions said
+            // not to stop, step it over the breakpoint before resuming.
+            StepOverConditionalBreakpoint ();
+        }
         else
         {
             // Resume without checking our current state.
@@ -420,6 +420,8 @@ MachThread::ShouldStop(bool &step_more)
     {
         // This thread is sitting at a breakpoint, ask the breakpoint
         // if we should be stopping here.
+        if (bp->HasConditions())
+            return m_process->ConditionalBreakpointSaysStop (ThreadID(), bp);
         return true;
     }
     else
@@ -429,6 +431,14 @@ MachThread::ShouldStop(bool &step_more)
             step_more = true;
             return false;
         }
+        if (m_process->SteppedOverConditionalBreakpoint (ThreadID()))
+        {
+            // We stepped this thread off of a conditional breakpoint on our
+            // own, don't report the step unless something else happened.
+            const MachException::Data &exc = GetStopException();
+            if (!exc.IsValid() || exc.IsBreakpoint())
+                return false;
+        }
         // The thread state is used to let us know what the thread was
         // trying to do. MachThread::ThreadWillResume() will set the
         // thread state to various values depending if the thread was
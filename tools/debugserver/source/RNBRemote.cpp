@@ -21,6 +21,7 @@
 #include <sys/sysctl.h>
 
 #include "DNB.h"
+#include "DNBBreakpoint.h"
 #include "DNBLog.h"
 #include "DNBThreadResumeActions.h"
 #include "RNBContext.h"
@@ -172,6 +173,7 @@ RNBRemote::CreatePacketTable  ()
     t.push_back (Packet (query_host_info,               &RNBRemote::HandlePacket_qHostInfo,     NULL, "qHostInfo", "Replies with multiple 'key:value;' tuples appended to each other."));
     t.push_back (Packet (query_gdb_server_version,      &RNBRemote::HandlePacket_qGDBServerVersion,       NULL, "qGDBServerVersion", "Replies with multiple 'key:value;' tuples appended to each other."));
     t.push_back (Packet (query_process_info,            &RNBRemote::HandlePacket_qProcessInfo,     NULL, "qProcessInfo", "Replies with multiple 'key:value;' tuples appended to each other."));
+    t.push_back (Packet (query_supported,               &RNBRemote::HandlePacket_qSupported,       NULL, "qSupported", "Replies with the list of optional features supported by " DEBUGSERVER_PROGRAM_NAME "."));
 //  t.push_back (Packet (query_symbol_lookup,           &RNBRemote::HandlePacket_UNIMPLEMENTED, NULL, "qSymbol", "Notify that host debugger is ready to do symbol lookups"));
     t.push_back (Packet (start_noack_mode,              &RNBRemote::HandlePacket_QStartNoAckMode        , NULL, "QStartNoAckMode", "Request that " DEBUGSERVER_PROGRAM_NAME " stop acking remote protocol packets"));
     t.push_back (Packet (prefix_reg_packets_with_tid,   &RNBRemote::HandlePacket_QThreadSuffixSupported , NULL, "QThreadSuffixSupported", "Check if thread specifc packets (register packets 'g', 'G', 'p', and 'P') support having the thread ID appended to the end of the command"));
@@ -1166,6 +1168,16 @@ RNBRemote::HandlePacket_qShlibInfoAddr (const char *p)
     return SendPacket ("E44");
 }
 
+rnb_err_t
+RNBRemote::HandlePacket_qSupported (const char *p)
+{
+    // We ignore the features the debugger sends us and reply with the
+    // optional features we support. "ConditionalBreakpoints" means "Z0"
+    // packets may have agent expression conditions appended to them
+    // that we evaluate before reporting a breakpoint hit.
+    return SendPacket ("ConditionalBreakpoints+");
+}
+
 rnb_err_t
 RNBRemote::HandlePacket_qStepPacketSupported (const char *p)
 {
@@ -3094,6 +3106,61 @@ RNBRemote::HandlePacket_T (const char *p)
 }
 
 
+//----------------------------------------------------------------------
+// Decode the ";"-separated list of "X<len>,<hex bytes>" conditions at
+// the end of a "Z0" packet, mapping the register numbers in each one
+// from our "qRegisterInfo" numbering to a DNB register set and number.
+//----------------------------------------------------------------------
+bool
+RNBRemote::DecodeBreakpointConditions (const char *p, std::vector<DNBBreakpointCondition> &conditions)
+{
+    if (g_num_reg_entries == 0)
+        InitializeRegisters ();
+
+    conditions.clear();
+    while (*p == 'X')
+    {
+        char *c = NULL;
+        errno = 0;
+        const uint32_t len = strtoul (p + 1, &c, 16);
+        if (errno != 0 || c == p + 1 || *c != ',')
+            return false;
+        p = c + 1;
+
+        std::vector<uint8_t> bytecode;
+        for (uint32_t i=0; i<len; ++i)
+        {
+            if (!isxdigit (p[0]) || !isxdigit (p[1]))
+                return false;
+            char smallbuf[3] = { p[0], p[1], '\0' };
+            bytecode.push_back (strtoul (smallbuf, NULL, 16));
+            p += 2;
+        }
+
+        DNBBreakpointCondition condition;
+        if (bytecode.empty() || !condition.SetBytecode (&bytecode[0], bytecode.size()))
+            return false;
+
+        std::vector<uint32_t> regnums;
+        condition.GetRegisterNumbers (regnums);
+        for (size_t i=0; i<regnums.size(); ++i)
+        {
+            // Only registers that can be read directly, not pseudo registers
+            // that are pieces of other registers.
+            if (regnums[i] >= g_num_reg_entries || g_reg_entries[regnums[i]].nub_info.value_regs != NULL)
+                return false;
+            condition.SetRegisterMapping (regnums[i],
+                                          g_reg_entries[regnums[i]].nub_info.set,
+                                          g_reg_entries[regnums[i]].nub_info.reg);
+        }
+        conditions.push_back (condition);
+
+        if (*p == ';')
+            ++p;
+    }
+    return *p == '\0';
+}
+
 rnb_err_t
 RNBRemote::HandlePacket_z (const char *p)
 {
@@ -3123,6 +3190,7 @@ RNBRemote::HandlePacket_z (const char *p)
     uint32_t byte_size = strtoul (p, &c, 16);
     if (errno != 0 && byte_size == 0)
         return HandlePacket_ILLFORMED (__FILE__, __LINE__, p, "Invalid length in z packet");
+    p = c;
 
     if (packet_cmd == 'Z')
     {
@@ -3132,6 +3200,17 @@ RNBRemote::HandlePacket_z (const char *p)
             case '0':   // set software breakpoint
             case '1':   // set hardware breakpoint
                 {
+                    // The breakpoint may have conditions appended to it in
+                    // agent expression bytecode: ";X<len>,<hex bytes>...".
+                    // Any conditions replace those set by an earlier Z packet
+                    // for the same address.
+                    std::vector<DNBBreakpointCondition> conditions;
+                    if (*p == ';')
+                    {
+                        if (!DecodeBreakpointConditions (p + 1, conditions))
+                            return HandlePacket_ILLFORMED (__FILE__, __LINE__, p, "Invalid condition list in Z packet");
+                    }
+
                     // gdb can send multiple Z packets for the same address and
                     // these calls must be ref counted.
                     bool hardware = (break_type == '1');
@@ -3141,6 +3220,7 @@ RNBRemote::HandlePacket_z (const char *p)
                         // We successfully created a breakpoint, now lets full out
                         // a ref count structure with the breakID and add it to our
                         // map.
+                        DNBBreakpointSetConditions (pid, addr, conditions.empty() ? NULL : &conditions[0], conditions.size());
                         return SendPacket ("OK");
                     }
                     else
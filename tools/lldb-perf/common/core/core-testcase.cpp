@@ -0,0 +1,47 @@
+//===-- core-testcase.cpp ---------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+// The program whose core file lldb-perf-core reads.  It builds a linked
+// list on the heap and then aborts, so run it with core dumps enabled:
+//
+//     ulimit -c unlimited
+//     lldb-perf-core-testcase [NUM_NODES]
+
+#include <stdlib.h>
+#include <string.h>
+
+struct Node
+{
+    unsigned value;
+    char payload[52];
+    Node *next;
+};
+
+Node *g_list_head = NULL;
+unsigned g_num_nodes = 0;
+
+int
+main (int argc, char **argv)
+{
+    g_num_nodes = argc > 1 ? (unsigned)strtoul (argv[1], NULL, 0) : 100000;
+
+    Node **tail = &g_list_head;
+    for (unsigned i = 0; i < g_num_nodes; ++i)
+    {
+        Node *node = new Node;
+        node->value = i;
+        memset (node->payload, 'a' + i % 26, sizeof(node->payload));
+        node->next = NULL;
+        *tail = node;
+        tail = &node->next;
+    }
+
+    abort ();
+    return 0;
+}
@@ -0,0 +1,277 @@
+//===-- lldb-perf-core.cpp --------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb-perf/lib/Timer.h"
+#include "lldb-perf/lib/Metric.h"
+#include "lldb-perf/lib/Measurement.h"
+#include "lldb-perf/lib/Results.h"
+#include "lldb/API/LLDB.h"
+#include <getopt.h>
+#include <string>
+
+using namespace lldb;
+using namespace lldb_perf;
+
+#define NUM_WALKS 5
+
+//----------------------------------------------------------------------
+// Measures reading a core file made by core-testcase.cpp: loading the
+// core, and walking the linked list it left on the heap through SBValues
+// the way an analysis script would.  A core process has no events to
+// wait for, so this doesn't use TestCase.
+//----------------------------------------------------------------------
+class CoreTest
+{
+public:
+    CoreTest () :
+        m_debugger (),
+        m_target (),
+        m_process (),
+        m_time_load_core ([this] () -> void
+                          {
+                              m_target = m_debugger.CreateTarget(m_exe_path.c_str());
+                              m_process = m_target.LoadCore(m_core_path.c_str());
+                          }, "time-load-core", "The time it takes to create the target and load the core file."),
+        m_time_walk_heap ([this] () -> void
+                          {
+                              WalkHeap();
+                          }, "time-walk-heap", "The time it takes to walk the linked list in the core file, reading every node."),
+        m_num_nodes (0),
+        m_num_bytes (0),
+        m_verbose (false),
+        m_exe_path (),
+        m_core_path (),
+        m_out_path ()
+    {
+        SBDebugger::Initialize();
+        m_debugger = SBDebugger::Create(false);
+    }
+
+    ~CoreTest ()
+    {
+        SBDebugger::Destroy(m_debugger);
+        SBDebugger::Terminate();
+    }
+
+    bool
+    Run ()
+    {
+        m_time_load_core();
+        if (!m_process.IsValid())
+        {
+            fprintf (stderr, "error: couldn't load core file '%s'\n", m_core_path.c_str());
+            return false;
+        }
+
+        for (size_t i = 0; i < NUM_WALKS; ++i)
+            m_time_walk_heap();
+
+        if (m_num_nodes == 0)
+        {
+            fprintf (stderr, "error: no list nodes found in the core file, is it from lldb-perf-core-testcase?\n");
+            return false;
+        }
+
+        if (m_verbose)
+        {
+            const double seconds = m_time_walk_heap.GetMetric().GetAverage();
+            printf ("walked %llu nodes (%llu bytes) in %g seconds: %g nodes/s, %g MB/s\n",
+                    (unsigned long long)m_num_nodes, (unsigned long long)m_num_bytes, seconds,
+                    seconds > 0 ? m_num_nodes / seconds : 0.0,
+                    seconds > 0 ? m_num_bytes / seconds / (1024 * 1024) : 0.0);
+        }
+        return true;
+    }
+
+    void
+    WriteResults (Results &results)
+    {
+        Results::Dictionary& results_dict = results.GetDictionary();
+
+        m_time_load_core.WriteAverageAndStandardDeviation(results);
+        m_time_walk_heap.WriteAverageAndStandardDeviation(results);
+        results_dict.AddUnsigned("heap-nodes",
+                                 "The number of list nodes read by each walk of the heap.",
+                                 m_num_nodes);
+        results.Write(m_out_path.empty() ? NULL : m_out_path.c_str());
+    }
+
+    void
+    SetVerbose (bool verbose)
+    {
+        m_verbose = verbose;
+    }
+
+    void
+    SetExecutablePath (const char *path)
+    {
+        m_exe_path = path ? path : "";
+    }
+
+    void
+    SetCorePath (const char *path)
+    {
+        m_core_path = path ? path : "";
+    }
+
+    void
+    SetResultFilePath (const char *path)
+    {
+        m_out_path = path ? path : "";
+    }
+
+    bool
+    HasPaths () const
+    {
+        return !m_exe_path.empty() && !m_core_path.empty();
+    }
+
+private:
+    void
+    WalkHeap ()
+    {
+        m_num_nodes = 0;
+        m_num_bytes = 0;
+        uint64_t checksum = 0;
+        SBValue node_ptr (m_target.FindFirstGlobalVariable("g_list_head"));
+        while (node_ptr.IsValid() && node_ptr.GetValueAsUnsigned(0) != 0)
+        {
+            SBValue node (node_ptr.Dereference());
+            if (!node.IsValid())
+                break;
+            checksum += node.GetChildMemberWithName("value").GetValueAsUnsigned(0);
+            SBData payload (node.GetChildMemberWithName("payload").GetData());
+            SBError error;
+            checksum += payload.GetUnsignedInt8(error, 0);
+            m_num_bytes += node.GetByteSize();
+            ++m_num_nodes;
+            node_ptr = node.GetChildMemberWithName("next");
+        }
+        if (m_verbose)
+            printf ("checksum: 0x%llx\n", (unsigned long long)checksum);
+    }
+
+    SBDebugger m_debugger;
+    SBTarget m_target;
+    SBProcess m_process;
+    TimeMeasurement<std::function<void()>> m_time_load_core;
+    TimeMeasurement<std::function<void()>> m_time_walk_heap;
+    uint64_t m_num_nodes;
+    uint64_t m_num_bytes;
+    bool m_verbose;
+    std::string m_exe_path;
+    std::string m_core_path;
+    std::string m_out_path;
+};
+
+static struct option g_long_options[] = {
+    { "verbose",      no_argument,            NULL, 'v' },
+    { "test-file",    required_argument,      NULL, 't' },
+    { "core-file",    required_argument,      NULL, 'c' },
+    { "out-file",     required_argument,      NULL, 'o' },
+    { NULL,           0,                      NULL,  0  }
+};
+
+int main(int argc, const char * argv[])
+{
+    CoreTest test;
+
+    bool error = false;
+    bool print_help = false;
+    bool done = false;
+
+#if __GLIBC__
+    optind = 0;
+#else
+    optreset = 1;
+    optind = 1;
+#endif
+    while (!done)
+    {
+        int long_options_index = -1;
+        const int short_option = ::getopt_long_only (argc,
+                                                     const_cast<char **>(argv),
+                                                     "vt:c:o:",
+                                                     g_long_options,
+                                                     &long_options_index);
+
+        switch (short_option)
+        {
+            case 0:
+                // Already handled
+                break;
+
+            case -1:
+                done = true;
+                break;
+
+            case '?':
+            case 'h':
+                print_help = true;
+                break;
+
+            case 'v':
+                test.SetVerbose(true);
+                break;
+
+            case 't':
+                test.SetExecutablePath(optarg);
+                break;
+
+            case 'c':
+                test.SetCorePath(optarg);
+                break;
+
+            case 'o':
+                test.SetResultFilePath(optarg);
+                break;
+
+            default:
+                error = true;
+                print_help = true;
+                fprintf (stderr, "error: unrecognized option %c\n", short_option);
+                break;
+        }
+    }
+
+    if (!test.HasPaths())
+    {
+        // --test-file and --core-file are mandatory
+        print_help = true;
+        error = true;
+        fprintf (stderr, "error: the '--test-file=PATH' and '--core-file=PATH' options are mandatory\n");
+    }
+
+    if (print_help)
+    {
+        puts(R"(
+NAME
+    lldb-perf-core -- a tool that measures how fast LLDB reads core files.
+
+SYNOPSIS
+    lldb-perf-core --test-file=PATH --core-file=PATH [--out-file=PATH --verbose]
+
+DESCRIPTION
+    Loads a core file of lldb-perf-core-testcase and walks the linked list it
+    built on the heap, reading each node through the SB API, and writes the
+    times to a JSON file (a plist on Darwin, unless PATH ends in ".json").
+    With --verbose it also prints the nodes and bytes read per second.
+)");
+    }
+    if (error)
+    {
+        exit(1);
+    }
+
+    if (!test.Run())
+        return 1;
+    Results results;
+    test.WriteResults(results);
+    return 0;
+}
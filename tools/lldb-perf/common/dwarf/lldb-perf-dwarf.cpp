@@ -0,0 +1,276 @@
+//===-- lldb-perf-dwarf.cpp -------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb-perf/lib/Timer.h"
+#include "lldb-perf/lib/Metric.h"
+#include "lldb-perf/lib/Measurement.h"
+#include "lldb-perf/lib/Results.h"
+#include "lldb/API/LLDB.h"
+#include <getopt.h>
+#include <string>
+
+using namespace lldb;
+using namespace lldb_perf;
+
+#define NUM_PASSES 5
+
+//----------------------------------------------------------------------
+// Measures decoding the DWARF of a real program: indexing its
+// .debug_info, which reads the abbreviation code and the LEB128
+// attributes of every DIE, and decoding the .debug_line programs of all
+// of its compile units. Most of the numbers in both sections are LEB128,
+// so this is the benchmark for the DataExtractor LEB128 decoders.
+//
+// Each pass uses a new target and drops the modules of the previous one,
+// so nothing is reused from the last pass. Point it at a large program
+// built with debug info (lldb itself works well), and don't set
+// target.cache-path, or the line tables will come from the cache instead
+// of .debug_line.
+//----------------------------------------------------------------------
+class DWARFTest
+{
+public:
+    DWARFTest () :
+        m_debugger (),
+        m_target (),
+        m_time_index_debug_info ([this] () -> void
+                                 {
+                                     // The first name lookup indexes all the DIEs.
+                                     m_target.FindFunctions("main");
+                                 }, "time-index-debug-info", "The time it takes to index the .debug_info of all the modules."),
+        m_time_parse_line_tables ([this] () -> void
+                                  {
+                                      ParseLineTables();
+                                  }, "time-parse-line-tables", "The time it takes to decode the .debug_line tables of all the compile units."),
+        m_num_compile_units (0),
+        m_num_line_entries (0),
+        m_verbose (false),
+        m_exe_path (),
+        m_out_path ()
+    {
+        SBDebugger::Initialize();
+        m_debugger = SBDebugger::Create(false);
+    }
+
+    ~DWARFTest ()
+    {
+        SBDebugger::Destroy(m_debugger);
+        SBDebugger::Terminate();
+    }
+
+    bool
+    Run ()
+    {
+        for (size_t i = 0; i < NUM_PASSES; ++i)
+        {
+            m_target = m_debugger.CreateTarget(m_exe_path.c_str());
+            if (!m_target.IsValid())
+            {
+                fprintf (stderr, "error: couldn't create a target for '%s'\n", m_exe_path.c_str());
+                return false;
+            }
+            m_time_index_debug_info();
+            m_time_parse_line_tables();
+
+            m_debugger.DeleteTarget(m_target);
+            m_target.Clear();
+            // Remove the modules from the global module list so the next
+            // pass parses them again.
+            SBDebugger::MemoryPressureDetected();
+        }
+
+        if (m_num_line_entries == 0)
+        {
+            fprintf (stderr, "error: no line tables found in '%s', was it built with debug info?\n", m_exe_path.c_str());
+            return false;
+        }
+
+        if (m_verbose)
+        {
+            const double seconds = m_time_parse_line_tables.GetMetric().GetAverage();
+            printf ("decoded %llu line entries in %llu compile units in %g seconds: %g entries/s\n",
+                    (unsigned long long)m_num_line_entries, (unsigned long long)m_num_compile_units, seconds,
+                    seconds > 0 ? m_num_line_entries / seconds : 0.0);
+        }
+        return true;
+    }
+
+    void
+    WriteResults (Results &results)
+    {
+        Results::Dictionary& results_dict = results.GetDictionary();
+
+        m_time_index_debug_info.WriteAverageAndStandardDeviation(results);
+        m_time_parse_line_tables.WriteAverageAndStandardDeviation(results);
+        results_dict.AddUnsigned("compile-units",
+                                 "The number of compile units whose line tables were decoded.",
+                                 m_num_compile_units);
+        results_dict.AddUnsigned("line-entries",
+                                 "The number of line table entries decoded by each pass.",
+                                 m_num_line_entries);
+        results.Write(m_out_path.empty() ? NULL : m_out_path.c_str());
+    }
+
+    void
+    SetVerbose (bool verbose)
+    {
+        m_verbose = verbose;
+    }
+
+    void
+    SetExecutablePath (const char *path)
+    {
+        m_exe_path = path ? path : "";
+    }
+
+    void
+    SetResultFilePath (const char *path)
+    {
+        m_out_path = path ? path : "";
+    }
+
+    bool
+    HasPaths () const
+    {
+        return !m_exe_path.empty();
+    }
+
+private:
+    void
+    ParseLineTables ()
+    {
+        m_num_compile_units = 0;
+        m_num_line_entries = 0;
+        const uint32_t num_modules = m_target.GetNumModules();
+        for (uint32_t i = 0; i < num_modules; ++i)
+        {
+            SBModule module (m_target.GetModuleAtIndex(i));
+            const uint32_t num_cus = module.GetNumCompileUnits();
+            for (uint32_t j = 0; j < num_cus; ++j)
+            {
+                SBCompileUnit cu (module.GetCompileUnitAtIndex(j));
+                m_num_line_entries += cu.GetNumLineEntries();
+                ++m_num_compile_units;
+            }
+        }
+    }
+
+    SBDebugger m_debugger;
+    SBTarget m_target;
+    TimeMeasurement<std::function<void()>> m_time_index_debug_info;
+    TimeMeasurement<std::function<void()>> m_time_parse_line_tables;
+    uint64_t m_num_compile_units;
+    uint64_t m_num_line_entries;
+    bool m_verbose;
+    std::string m_exe_path;
+    std::string m_out_path;
+};
+
+static struct option g_long_options[] = {
+    { "verbose",      no_argument,            NULL, 'v' },
+    { "test-file",    required_argument,      NULL, 't' },
+    { "out-file",     required_argument,      NULL, 'o' },
+    { NULL,           0,                      NULL,  0  }
+};
+
+int main(int argc, const char * argv[])
+{
+    DWARFTest test;
+
+    bool error = false;
+    bool print_help = false;
+    bool done = false;
+
+#if __GLIBC__
+    optind = 0;
+#else
+    optreset = 1;
+    optind = 1;
+#endif
+    while (!done)
+    {
+        int long_options_index = -1;
+        const int short_option = ::getopt_long_only (argc,
+                                                     const_cast<char **>(argv),
+                                                     "vt:o:",
+                                                     g_long_options,
+                                                     &long_options_index);
+
+        switch (short_option)
+        {
+            case 0:
+                // Already handled
+                break;
+
+            case -1:
+                done = true;
+                break;
+
+            case '?':
+            case 'h':
+                print_help = true;
+                break;
+
+            case 'v':
+                test.SetVerbose(true);
+                break;
+
+            case 't':
+                test.SetExecutablePath(optarg);
+                break;
+
+            case 'o':
+                test.SetResultFilePath(optarg);
+                break;
+
+            default:
+                error = true;
+                print_help = true;
+                fprintf (stderr, "error: unrecognized option %c\n", short_option);
+                break;
+        }
+    }
+
+    if (!test.HasPaths())
+    {
+        // --test-file is mandatory
+        print_help = true;
+        error = true;
+        fprintf (stderr, "error: the '--test-file=PATH' option is mandatory\n");
+    }
+
+    if (print_help)
+    {
+        puts(R"(
+NAME
+    lldb-perf-dwarf -- a tool that measures how fast LLDB decodes DWARF.
+
+SYNOPSIS
+    lldb-perf-dwarf --test-file=PATH [--out-file=PATH --verbose]
+
+DESCRIPTION
+    Creates a target for the program at PATH, indexes the .debug_info of
+    its modules and decodes the .debug_line tables of all their compile
+    units, a few times over, and writes the times to a JSON file (a plist
+    on Darwin, unless PATH ends in ".json").  Use a large program with
+    debug info, such as lldb itself.  With --verbose it also prints the
+    line entries decoded per second.
+)");
+    }
+    if (error)
+    {
+        exit(1);
+    }
+
+    if (!test.Run())
+        return 1;
+    Results results;
+    test.WriteResults(results);
+    return 0;
+}
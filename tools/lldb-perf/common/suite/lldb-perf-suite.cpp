@@ -0,0 +1,388 @@
+//===-- lldb-perf-suite.cpp -------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb-perf/lib/Timer.h"
+#include "lldb-perf/lib/Metric.h"
+#include "lldb-perf/lib/Measurement.h"
+#include "lldb-perf/lib/Results.h"
+#include "lldb-perf/lib/TestCase.h"
+#include "lldb-perf/lib/Xcode.h"
+#include <getopt.h>
+#include <string>
+
+using namespace lldb_perf;
+
+#define NUM_EXPR_ITERATIONS 5
+#define NUM_STEPS 20
+
+// Functions in suite-testcase.cpp (and one that isn't) to set breakpoints on.
+static const char *g_breakpoint_names[] = {
+    "main",
+    "recurse",
+    "worker_thread",
+    "inspect_containers",
+    "Point::Point",
+    "std::vector<int, std::allocator<int> >::push_back",
+    "no_such_function",
+    NULL
+};
+
+// Expressions to evaluate in inspect_containers.
+static const char *g_expressions[] = {
+    "total * 2",
+    "point.x + point.y",
+    "int_vector.size()",
+    "string_map.size()",
+    NULL
+};
+
+//----------------------------------------------------------------------
+// Measures the operations of a typical debugging session against
+// suite-testcase.cpp: creating the target, indexing its debug info,
+// setting breakpoints by name, backtracing all threads, showing STL
+// containers, evaluating expressions and stepping.
+//----------------------------------------------------------------------
+class SuiteTest : public TestCase
+{
+public:
+    SuiteTest () :
+        TestCase(),
+        m_time_create_target ([this] () -> void
+                              {
+                                  m_memory_change_create_target.Start();
+                                  m_target = m_debugger.CreateTarget(m_exe_path.c_str());
+                                  m_memory_change_create_target.Stop();
+                              }, "time-create-target", "The time it takes to create a target."),
+        m_time_index_debug_info ([this] () -> void
+                                 {
+                                     // The first lookup by name makes the DWARF
+                                     // plug-in index all of the debug info.
+                                     m_memory_change_index_debug_info.Start();
+                                     m_target.FindFunctions("inspect_containers");
+                                     m_memory_change_index_debug_info.Stop();
+                                 }, "time-index-debug-info", "The time it takes to look up a function by name for the first time, which indexes the debug info."),
+        m_time_set_bp_by_name ([this] (const char *name) -> void
+                               {
+                                   SBBreakpoint bp (m_target.BreakpointCreateByName(name));
+                                   m_target.BreakpointDelete(bp.GetID());
+                               }, "time-set-break-by-name", "Elapsed time it takes to set a breakpoint by name."),
+        m_time_backtrace_all ([this] () -> void
+                              {
+                                  Xcode::FetchFrames(m_process, false, false);
+                              }, "time-backtrace-all", "Elapsed time it takes to backtrace all threads for the first time after a stop."),
+        m_time_frame_variable ([this] (SBFrame frame) -> void
+                               {
+                                   Xcode::FetchVariables(frame, 2, false);
+                               }, "time-frame-variable", "Elapsed time it takes to show the STL containers in a frame, two levels deep."),
+        m_expr_first_evaluate ([this] (SBFrame frame) -> void
+                               {
+                                   frame.EvaluateExpression(g_expressions[0]).GetError();
+                               }, "time-expr-first", "Elapsed time it takes to evaluate an expression for the first time."),
+        m_expr_evaluate ([this] (SBFrame frame, const char *expr) -> void
+                         {
+                             frame.EvaluateExpression(expr).GetError();
+                         }, "time-expr", "Elapsed time it takes to evaluate an expression after the first one."),
+        m_time_step (nullptr, "time-step-over", "Elapsed time it takes to step over a line."),
+        m_memory_change_create_target (),
+        m_memory_change_index_debug_info (),
+        m_memory_total (),
+        m_time_launch_stop (),
+        m_time_total (),
+        m_exe_path(),
+        m_out_path()
+    {
+    }
+
+    virtual
+    ~SuiteTest ()
+    {
+    }
+
+    virtual bool
+    Setup (int& argc, const char**& argv)
+    {
+        return !m_exe_path.empty();
+    }
+
+    virtual void
+    TestStep (int counter, ActionWanted &next_action)
+    {
+        if (counter == 0)
+        {
+            m_memory_total.Start();
+            m_time_total.Start();
+
+            m_time_create_target();
+            m_time_index_debug_info();
+            for (size_t i = 0; g_breakpoint_names[i]; ++i)
+                m_time_set_bp_by_name(g_breakpoint_names[i]);
+
+            m_target.BreakpointCreateBySourceRegex("Stop here for the lldb-perf suite", SBFileSpec("suite-testcase.cpp"));
+
+            m_time_launch_stop.Start();
+            const char *exe_argv[] = { m_exe_path.c_str(), NULL };
+            SBLaunchInfo launch_info(exe_argv);
+            Launch (launch_info);
+        }
+        else if (counter == 1)
+        {
+            m_time_launch_stop.Stop();
+
+            m_time_backtrace_all();
+
+            SBFrame frame (m_thread.GetFrameAtIndex(0));
+            m_time_frame_variable(frame);
+
+            m_expr_first_evaluate(frame);
+            for (size_t i = 0; i < NUM_EXPR_ITERATIONS; ++i)
+            {
+                for (size_t j = 0; g_expressions[j]; ++j)
+                    m_expr_evaluate(frame, g_expressions[j]);
+            }
+
+            m_time_step.Start();
+            next_action.StepOver(m_thread);
+        }
+        else if (counter <= NUM_STEPS)
+        {
+            m_time_step.Stop();
+            m_time_step.Start();
+            next_action.StepOver(m_thread);
+        }
+        else
+        {
+            m_time_step.Stop();
+            m_time_total.Stop();
+            m_memory_total.Stop();
+            next_action.Kill();
+        }
+    }
+
+    void
+    WriteResults (Results &results)
+    {
+        Results::Dictionary& results_dict = results.GetDictionary();
+
+        m_time_create_target.WriteAverageAndStandardDeviation(results);
+        results_dict.Add ("memory-change-create-target",
+                          "Memory increase that occurs due to creating the target.",
+                          m_memory_change_create_target.GetDeltaValue().GetResult(NULL, NULL));
+
+        m_time_index_debug_info.WriteAverageAndStandardDeviation(results);
+        results_dict.Add ("memory-change-index-debug-info",
+                          "Memory increase that occurs due to indexing the debug info.",
+                          m_memory_change_index_debug_info.GetDeltaValue().GetResult(NULL, NULL));
+
+        m_time_set_bp_by_name.WriteAverageAndStandardDeviation(results);
+        results_dict.AddDouble("time-launch-stop",
+                               "The time it takes to launch the process and stop at the first breakpoint.",
+                               m_time_launch_stop.GetDeltaValue());
+        m_time_backtrace_all.WriteAverageAndStandardDeviation(results);
+        m_time_frame_variable.WriteAverageAndStandardDeviation(results);
+        m_expr_first_evaluate.WriteAverageAndStandardDeviation(results);
+        m_expr_evaluate.WriteAverageAndStandardDeviation(results);
+        m_time_step.WriteAverageAndStandardDeviation(results);
+
+        results_dict.AddDouble("time-total",
+                               "The time it takes to run the whole suite.",
+                               m_time_total.GetDeltaValue());
+        results_dict.Add ("memory-total",
+                          "The total memory that the current process is using at the end of the suite.",
+                          m_memory_total.GetStopValue().GetResult(NULL, NULL));
+        results.Write(GetResultFilePath());
+    }
+
+    const char *
+    GetExecutablePath () const
+    {
+        if (m_exe_path.empty())
+            return NULL;
+        return m_exe_path.c_str();
+    }
+
+    const char *
+    GetResultFilePath () const
+    {
+        if (m_out_path.empty())
+            return NULL;
+        return m_out_path.c_str();
+    }
+
+    void
+    SetExecutablePath (const char *path)
+    {
+        if (path && path[0])
+            m_exe_path = path;
+        else
+            m_exe_path.clear();
+    }
+
+    void
+    SetResultFilePath (const char *path)
+    {
+        if (path && path[0])
+            m_out_path = path;
+        else
+            m_out_path.clear();
+    }
+
+private:
+    TimeMeasurement<std::function<void()>> m_time_create_target;
+    TimeMeasurement<std::function<void()>> m_time_index_debug_info;
+    TimeMeasurement<std::function<void(const char *)>> m_time_set_bp_by_name;
+    TimeMeasurement<std::function<void()>> m_time_backtrace_all;
+    TimeMeasurement<std::function<void(SBFrame)>> m_time_frame_variable;
+    TimeMeasurement<std::function<void(SBFrame)>> m_expr_first_evaluate;
+    TimeMeasurement<std::function<void(SBFrame, const char *)>> m_expr_evaluate;
+    TimeMeasurement<std::function<void()>> m_time_step;
+    MemoryGauge m_memory_change_create_target;
+    MemoryGauge m_memory_change_index_debug_info;
+    MemoryGauge m_memory_total;
+    TimeGauge m_time_launch_stop;
+    TimeGauge m_time_total;
+    std::string m_exe_path;
+    std::string m_out_path;
+};
+
+static struct option g_long_options[] = {
+    { "verbose",      no_argument,            NULL, 'v' },
+    { "test-file",    required_argument,      NULL, 't' },
+    { "out-file",     required_argument,      NULL, 'o' },
+    { NULL,           0,                      NULL,  0  }
+};
+
+static std::string
+GetShortOptionString (struct option *long_options)
+{
+    std::string option_string;
+    for (int i = 0; long_options[i].name != NULL; ++i)
+    {
+        if (long_options[i].flag == NULL)
+        {
+            option_string.push_back ((char) long_options[i].val);
+            switch (long_options[i].has_arg)
+            {
+                default:
+                case no_argument:
+                    break;
+                case required_argument:
+                    option_string.push_back (':');
+                    break;
+                case optional_argument:
+                    option_string.append (2, ':');
+                    break;
+            }
+        }
+    }
+    return option_string;
+}
+
+int main(int argc, const char * argv[])
+{
+    std::string short_option_string (GetShortOptionString(g_long_options));
+
+    SuiteTest test;
+
+    bool verbose = false;
+    bool error = false;
+    bool print_help = false;
+    bool done = false;
+
+#if __GLIBC__
+    optind = 0;
+#else
+    optreset = 1;
+    optind = 1;
+#endif
+    while (!done)
+    {
+        int long_options_index = -1;
+        const int short_option = ::getopt_long_only (argc,
+                                                     const_cast<char **>(argv),
+                                                     short_option_string.c_str(),
+                                                     g_long_options,
+                                                     &long_options_index);
+
+        switch (short_option)
+        {
+            case 0:
+                // Already handled
+                break;
+
+            case -1:
+                done = true;
+                break;
+
+            case '?':
+            case 'h':
+                print_help = true;
+                break;
+
+            case 'v':
+                verbose = true;
+                break;
+
+            case 't':
+                {
+                    SBFileSpec file(optarg);
+                    if (file.Exists())
+                        test.SetExecutablePath(optarg);
+                    else
+                        fprintf(stderr, "error: file specified in --test-file (-t) option doesn't exist: '%s'\n", optarg);
+                }
+                break;
+
+            case 'o':
+                test.SetResultFilePath(optarg);
+                break;
+
+            default:
+                error = true;
+                print_help = true;
+                fprintf (stderr, "error: unrecognized option %c\n", short_option);
+                break;
+        }
+    }
+
+    if (test.GetExecutablePath() == NULL)
+    {
+        // --test-file is mandatory
+        print_help = true;
+        error = true;
+        fprintf (stderr, "error: the '--test-file=PATH' option is mandatory\n");
+    }
+
+    if (print_help)
+    {
+        puts(R"(
+NAME
+    lldb-perf-suite -- a tool that measures LLDB performance of common debugging operations.
+
+SYNOPSIS
+    lldb-perf-suite --test-file=PATH [--out-file=PATH --verbose]
+
+DESCRIPTION
+    Debugs the program built from suite-testcase.cpp (lldb-perf-suite-testcase),
+    timing target creation, debug info indexing, breakpoints by name, backtraces
+    of all threads, showing STL containers, expressions and stepping, and writes
+    the results to a JSON file (a plist on Darwin, unless PATH ends in ".json").
+    Results of two builds can be compared with compare-results.py.
+)");
+    }
+    if (error)
+    {
+        exit(1);
+    }
+
+    argc -= optind;
+    argv += optind;
+
+    test.SetVerbose(verbose);
+    return TestCase::Run(test, argc, argv);
+}
@@ -0,0 +1,114 @@
+//===-- suite-testcase.cpp --------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+// The program debugged by lldb-perf-suite.  It must be built with debug
+// info and without optimization.  It starts a few threads that block
+// deep in a recursive call, fills some STL containers, and then runs a
+// loop that is stepped over.
+
+#include <stdio.h>
+#include <atomic>
+#include <condition_variable>
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define NUM_WORKER_THREADS 8
+#define WORKER_STACK_DEPTH 24
+
+struct Point
+{
+    Point (int in_x, double in_y, const char *in_name) :
+        x (in_x),
+        y (in_y),
+        name (in_name)
+    {
+    }
+
+    int x;
+    double y;
+    std::string name;
+};
+
+static std::mutex g_mutex;
+static std::condition_variable g_condition;
+static bool g_done = false;
+static std::atomic<int> g_num_waiting (0);
+
+static int
+recurse (int depth, int value)
+{
+    if (depth == 0)
+    {
+        std::unique_lock<std::mutex> lock (g_mutex);
+        ++g_num_waiting;
+        while (!g_done)
+            g_condition.wait (lock);
+        return value;
+    }
+    return recurse (depth - 1, value + depth) + 1;
+}
+
+static void
+worker_thread (int index)
+{
+    recurse (WORKER_STACK_DEPTH + index, index);
+}
+
+static int
+inspect_containers (int count)
+{
+    std::vector<int> int_vector;
+    std::map<int, std::string> string_map;
+    std::list<Point> point_list;
+    std::string long_string;
+    for (int i = 0; i < count; ++i)
+    {
+        int_vector.push_back (i * i);
+        string_map[i] = std::to_string (i);
+        if (i < count / 4)
+            point_list.push_back (Point (i, i / 2.0, "point"));
+        long_string += (char)('a' + i % 26);
+    }
+    Point point (3, 4.5, "origin");
+    int total = (int)int_vector.size() + (int)string_map.size();
+
+    printf ("Stop here for the lldb-perf suite: %d\n", total); // Stop here for the lldb-perf suite.
+    for (int i = 0; i < 64; ++i)
+    {
+        total += i * point.x;
+        total -= (int)point.y;
+        total ^= i;
+    }
+    return total + (int)point_list.size() + (int)long_string.size();
+}
+
+int
+main (int argc, char **argv)
+{
+    std::vector<std::thread> threads;
+    for (int i = 0; i < NUM_WORKER_THREADS; ++i)
+        threads.push_back (std::thread (worker_thread, i));
+    while (g_num_waiting < NUM_WORKER_THREADS)
+        std::this_thread::yield();
+
+    const int result = inspect_containers (1000 * argc);
+
+    {
+        std::lock_guard<std::mutex> lock (g_mutex);
+        g_done = true;
+    }
+    g_condition.notify_all();
+    for (size_t i = 0; i < threads.size(); ++i)
+        threads[i].join();
+    return result == 0 ? 1 : 0;
+}
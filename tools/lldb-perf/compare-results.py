@@ -0,0 +1,86 @@
+#!/usr/bin/env python
+
+#----------------------------------------------------------------------
+# Compares the JSON results of two lldb-perf runs, and exits with a
+# non-zero status if any time or memory measurement got worse by more
+# than a threshold.
+#
+# Usage: compare-results.py [--threshold PERCENT] BASELINE.json NEW.json
+#----------------------------------------------------------------------
+
+import json
+import optparse
+import sys
+
+def flatten(result, name, metrics):
+    '''Turn nested results into a dictionary from dotted names to numbers.
+       Values that have a description are stored as {"description": ...,
+       "value": ...}; those are flattened under their own name.'''
+    if isinstance(result, dict):
+        for key in sorted(result.keys()):
+            if key == 'description':
+                continue
+            if key == 'value':
+                child_name = name
+            elif name:
+                child_name = name + '.' + key
+            else:
+                child_name = key
+            flatten(result[key], child_name, metrics)
+    elif isinstance(result, list):
+        for index, value in enumerate(result):
+            flatten(value, '%s[%u]' % (name, index), metrics)
+    elif isinstance(result, (int, float)) and not isinstance(result, bool):
+        metrics[name] = result
+
+def load_metrics(path):
+    with open(path) as f:
+        metrics = {}
+        flatten(json.load(f), '', metrics)
+        return metrics
+
+def min_delta(name):
+    '''Changes smaller than this are noise, whatever the percentage.'''
+    if name.startswith('memory-'):
+        return 1024 * 1024
+    return 0.001
+
+def main():
+    parser = optparse.OptionParser(usage='usage: %prog [options] BASELINE.json NEW.json')
+    parser.add_option('-t', '--threshold', type='float', dest='threshold', default=10.0,
+                      help='the percentage increase that counts as a regression (default: %default)')
+    (options, args) = parser.parse_args()
+    if len(args) != 2:
+        parser.error('expected two result files')
+
+    baseline = load_metrics(args[0])
+    current = load_metrics(args[1])
+
+    regressions = []
+    print('%-50s %14s %14s %9s' % ('metric', 'baseline', 'new', 'change'))
+    for name in sorted(set(baseline.keys()) | set(current.keys())):
+        if name not in baseline or name not in current:
+            print('%-50s %14s %14s' % (name,
+                                       baseline.get(name, '-'),
+                                       current.get(name, '-')))
+            continue
+        old = baseline[name]
+        new = current[name]
+        if old:
+            change = '%+8.1f%%' % ((new - old) * 100.0 / old)
+        else:
+            change = ''
+        flag = ''
+        # Standard deviations are for judging noise, not for comparing.
+        if not name.endswith('stddev') and new - old > min_delta(name) and new > old * (1.0 + options.threshold / 100.0):
+            regressions.append(name)
+            flag = ' <--'
+        print('%-50s %14.6g %14.6g %9s%s' % (name, old, new, change, flag))
+
+    if regressions:
+        print('\n%u measurement(s) regressed by more than %g%%: %s' % (len(regressions), options.threshold, ', '.join(regressions)))
+        return 1
+    return 0
+
+if __name__ == '__main__':
+    sys.exit(main())
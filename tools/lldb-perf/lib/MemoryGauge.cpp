@@ -11,15 +11,18 @@
 #include "lldb/lldb-forward.h"
 #include <assert.h>
 #include <cmath>
+#include <stdio.h>
+#if defined(__APPLE__)
 #include <mach/mach.h>
 #include <mach/task.h>
 #include <mach/mach_traps.h>
+#endif
 
 using namespace lldb_perf;
 
-MemoryStats::MemoryStats (mach_vm_size_t virtual_size,
-                          mach_vm_size_t resident_size,
-                          mach_vm_size_t max_resident_size) :
+MemoryStats::MemoryStats (uint64_t virtual_size,
+                          uint64_t resident_size,
+                          uint64_t max_resident_size) :
     m_virtual_size (virtual_size),
     m_resident_size (resident_size),
     m_max_resident_size (max_resident_size)
@@ -101,6 +104,7 @@ MemoryStats::GetResult (const char *name, const char *description) const
 MemoryGauge::ValueType
 MemoryGauge::Now ()
 {
+#if defined(__APPLE__)
     task_t task = mach_task_self();
     mach_task_basic_info_data_t taskBasicInfo;
     mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
@@ -108,6 +112,30 @@ MemoryGauge::Now ()
     if (task_info_ret == KERN_SUCCESS) {
         return MemoryStats(taskBasicInfo.virtual_size, taskBasicInfo.resident_size, taskBasicInfo.resident_size_max);
     }
+#elif defined(__linux__)
+    // The sizes we want are in /proc/self/status, in kB:
+    //     VmHWM:     12345 kB    (peak resident size)
+    //     VmRSS:     12000 kB
+    //     VmSize:    45678 kB
+    FILE *status = fopen ("/proc/self/status", "r");
+    if (status)
+    {
+        MemoryStats stats;
+        char line[256];
+        unsigned long long kb;
+        while (fgets (line, sizeof(line), status))
+        {
+            if (sscanf (line, "VmSize: %llu kB", &kb) == 1)
+                stats.SetVirtualSize (kb * 1024);
+            else if (sscanf (line, "VmRSS: %llu kB", &kb) == 1)
+                stats.SetResidentSize (kb * 1024);
+            else if (sscanf (line, "VmHWM: %llu kB", &kb) == 1)
+                stats.SetMaxResidentSize (kb * 1024);
+        }
+        fclose (status);
+        return stats;
+    }
+#endif
     return 0;
 }
 
@@ -13,16 +13,16 @@
 #include "Gauge.h"
 #include "Results.h"
 
-#include <mach/task_info.h>
+#include <stdint.h>
 
 namespace lldb_perf {
 
 class MemoryStats
 {
 public:
-    MemoryStats (mach_vm_size_t virtual_size = 0,
-                 mach_vm_size_t resident_size = 0,
-                 mach_vm_size_t max_resident_size = 0);
+    MemoryStats (uint64_t virtual_size = 0,
+                 uint64_t resident_size = 0,
+                 uint64_t max_resident_size = 0);
     MemoryStats (const MemoryStats& rhs);
     
     MemoryStats&
@@ -43,38 +43,38 @@ public:
     MemoryStats
     operator * (const MemoryStats& rhs);
     
-    mach_vm_size_t
+    uint64_t
     GetVirtualSize () const
     {
         return m_virtual_size;
     }
     
-    mach_vm_size_t
+    uint64_t
     GetResidentSize () const
     {
         return m_resident_size;
     }
     
-    mach_vm_size_t
+    uint64_t
     GetMaxResidentSize () const
     {
         return m_max_resident_size;
     }
     
     void
-    SetVirtualSize (mach_vm_size_t vs)
+    SetVirtualSize (uint64_t vs)
     {
         m_virtual_size = vs;
     }
     
     void
-    SetResidentSize (mach_vm_size_t rs)
+    SetResidentSize (uint64_t rs)
     {
         m_resident_size = rs;
     }
     
     void
-    SetMaxResidentSize (mach_vm_size_t mrs)
+    SetMaxResidentSize (uint64_t mrs)
     {
         m_max_resident_size = mrs;
     }
@@ -82,9 +82,9 @@ public:
     Results::ResultSP
     GetResult (const char *name, const char *description) const;
 private:
-    mach_vm_size_t m_virtual_size;
-    mach_vm_size_t m_resident_size;
-    mach_vm_size_t m_max_resident_size;
+    uint64_t m_virtual_size;
+    uint64_t m_resident_size;
+    uint64_t m_max_resident_size;
 };
     
 class MemoryGauge : public Gauge<MemoryStats>
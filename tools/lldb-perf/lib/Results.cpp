@@ -9,6 +9,8 @@
 
 #include "Results.h"
 #include <assert.h>
+#include <stdio.h>
+#include <string.h>
 
 #ifdef __APPLE__
 #include "CFCMutableArray.h"
@@ -19,6 +21,122 @@
 
 using namespace lldb_perf;
 
+//----------------------------------------------------------------------
+// JSON output. Dictionaries are written with their keys sorted and one
+// value per line, so the results of two runs can be compared with diff
+// or with compare-results.py.
+//----------------------------------------------------------------------
+static void
+WriteJSONString (FILE *out, const char *cstr)
+{
+    fputc ('"', out);
+    for (const char *p = cstr ? cstr : ""; *p; ++p)
+    {
+        const unsigned char ch = *p;
+        switch (ch)
+        {
+            case '"':  fputs ("\\\"", out); break;
+            case '\\': fputs ("\\\\", out); break;
+            case '\n': fputs ("\\n", out); break;
+            case '\t': fputs ("\\t", out); break;
+            default:
+                if (ch < 0x20)
+                    fprintf (out, "\\u%4.4x", ch);
+                else
+                    fputc (ch, out);
+                break;
+        }
+    }
+    fputc ('"', out);
+}
+
+static void
+WriteJSONResult (FILE *out, Results::Result *result, int indent)
+{
+    switch (result->GetType())
+    {
+    case Results::Result::Type::Invalid:
+        fputs ("null", out);
+        break;
+
+    case Results::Result::Type::Array:
+        {
+            bool first = true;
+            fputc ('[', out);
+            result->GetAsArray()->ForEach([out, indent, &first](const Results::ResultSP &value_sp) -> bool
+                                          {
+                                              fprintf (out, "%s\n%*s", first ? "" : ",", indent + 2, "");
+                                              WriteJSONResult (out, value_sp.get(), indent + 2);
+                                              first = false;
+                                              return true;
+                                          });
+            fprintf (out, "\n%*s]", indent, "");
+        }
+        break;
+
+    case Results::Result::Type::Dictionary:
+        {
+            bool first = true;
+            fputc ('{', out);
+            if (result->GetDescription())
+            {
+                fprintf (out, "\n%*s\"description\": ", indent + 2, "");
+                WriteJSONString (out, result->GetDescription());
+                first = false;
+            }
+            result->GetAsDictionary()->ForEach([out, indent, &first](const std::string &key, const Results::ResultSP &value_sp) -> bool
+                                               {
+                                                   fprintf (out, "%s\n%*s", first ? "" : ",", indent + 2, "");
+                                                   WriteJSONString (out, key.c_str());
+                                                   fputs (": ", out);
+                                                   WriteJSONResult (out, value_sp.get(), indent + 2);
+                                                   first = false;
+                                                   return true;
+                                               });
+            fprintf (out, "\n%*s}", indent, "");
+        }
+        break;
+
+    case Results::Result::Type::Double:
+        fprintf (out, "%.9g", result->GetAsDouble()->GetValue());
+        break;
+
+    case Results::Result::Type::String:
+        WriteJSONString (out, result->GetAsString()->GetValue());
+        break;
+
+    case Results::Result::Type::Unsigned:
+        fprintf (out, "%llu", (unsigned long long)result->GetAsUnsigned()->GetValue());
+        break;
+
+    default:
+        assert (!"unhandled result");
+        break;
+    }
+}
+
+void
+Results::WriteJSON (const char *out_path)
+{
+    FILE *out = stdout;
+    if (out_path && out_path[0])
+    {
+        out = fopen (out_path, "w");
+        if (out == NULL)
+        {
+            fprintf (stderr, "error: couldn't open '%s' for writing\n", out_path);
+            return;
+        }
+    }
+    WriteJSONResult (out, &m_results, 0);
+    fputc ('\n', out);
+    if (out != stdout)
+        fclose (out);
+    else
+        fflush (out);
+}
+
+#ifdef __APPLE__
 static void
 AddResultToArray (CFCMutableArray &array, Results::Result *result);
 
@@ -154,9 +272,19 @@ AddResultToDictionary (CFCMutableDictionary &parent_dict, const char *key, Resul
         break;
     }
 }
+#endif // #ifdef __APPLE__
+
 void
 Results::Write (const char *out_path)
 {
+    // Plists are only written on Darwin, and only when they weren't asked
+    // for by name.
+    const size_t out_path_len = out_path ? strlen (out_path) : 0;
+    if (out_path_len >= 5 && strcmp (out_path + out_path_len - 5, ".json") == 0)
+    {
+        WriteJSON (out_path);
+        return;
+    }
 #ifdef __APPLE__
     CFCMutableDictionary dict;
     
@@ -173,6 +301,8 @@ Results::Write (const char *out_path)
     CFURLRef file = CFURLCreateFromFileSystemRepresentation(NULL, (const UInt8*)out_path, strlen(out_path), FALSE);
     
     CFURLWriteDataAndPropertiesToResource(file, xmlData, NULL, NULL);
+#else
+    WriteJSON (out_path);
 #endif
 }
 
@@ -11,6 +11,7 @@
 #define __PerfTestDriver_Results_h__
 
 #include "lldb/lldb-forward.h"
+#include <functional>
 #include <map>
 #include <string>
 #include <vector>
@@ -301,8 +302,16 @@ public:
         return m_results;
     }
 
+    //------------------------------------------------------------------
+    /// Write the results to \a path, or to stdout if \a path is NULL.
+    /// Paths that end in ".json" and all paths on hosts other than
+    /// Darwin get JSON, other paths get an XML plist.
+    //------------------------------------------------------------------
     void
     Write (const char *path);
+
+    void
+    WriteJSON (const char *path);
     
 protected:
     Dictionary m_results;
@@ -0,0 +1,247 @@
+//===-- DataExtractorTest.cpp -----------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "gtest/gtest.h"
+
+#include "lldb/Core/DataExtractor.h"
+
+#include <vector>
+
+using namespace lldb;
+using namespace lldb_private;
+
+namespace {
+
+// GetULEB128, GetSLEB128 and Skip_LEB128 decode numbers with at least 8
+// readable bytes from one word, and the others with a loop.  Each number
+// is decoded both ways: followed by padding, and at the very end of the
+// data.
+const size_t kPadding = 8;
+
+std::vector<uint8_t>
+EncodeULEB128 (uint64_t value)
+{
+    std::vector<uint8_t> bytes;
+    do
+    {
+        uint8_t byte = value & 0x7f;
+        value >>= 7;
+        if (value != 0)
+            byte |= 0x80;
+        bytes.push_back (byte);
+    } while (value != 0);
+    return bytes;
+}
+
+std::vector<uint8_t>
+EncodeSLEB128 (int64_t value)
+{
+    std::vector<uint8_t> bytes;
+    bool more = true;
+    while (more)
+    {
+        uint8_t byte = value & 0x7f;
+        // Arithmetic shift, so negative numbers stay negative.
+        value = value < 0 ? ~(~value >> 7) : value >> 7;
+        if ((value == 0 && (byte & 0x40) == 0) || (value == -1 && (byte & 0x40) != 0))
+            more = false;
+        else
+            byte |= 0x80;
+        bytes.push_back (byte);
+    }
+    return bytes;
+}
+
+DataExtractor
+MakeExtractor (const std::vector<uint8_t> &bytes)
+{
+    return DataExtractor (bytes.empty() ? NULL : &bytes[0], bytes.size(), eByteOrderLittle, 8);
+}
+
+void
+CheckULEB128 (uint64_t value)
+{
+    const std::vector<uint8_t> encoded (EncodeULEB128 (value));
+    for (size_t padding = 0; padding <= kPadding; padding += kPadding)
+    {
+        std::vector<uint8_t> bytes (encoded);
+        bytes.resize (encoded.size() + padding, 0xff);
+        DataExtractor data (MakeExtractor (bytes));
+
+        offset_t offset = 0;
+        EXPECT_EQ (value, data.GetULEB128 (&offset)) << "padding " << padding;
+        EXPECT_EQ (encoded.size(), offset) << "value " << value << ", padding " << padding;
+
+        offset = 0;
+        EXPECT_EQ (encoded.size() - 1, data.Skip_LEB128 (&offset)) << "value " << value << ", padding " << padding;
+        EXPECT_EQ (encoded.size(), offset) << "value " << value << ", padding " << padding;
+    }
+}
+
+void
+CheckSLEB128 (int64_t value)
+{
+    const std::vector<uint8_t> encoded (EncodeSLEB128 (value));
+    for (size_t padding = 0; padding <= kPadding; padding += kPadding)
+    {
+        std::vector<uint8_t> bytes (encoded);
+        bytes.resize (encoded.size() + padding, 0xff);
+        DataExtractor data (MakeExtractor (bytes));
+
+        offset_t offset = 0;
+        EXPECT_EQ (value, data.GetSLEB128 (&offset)) << "padding " << padding;
+        EXPECT_EQ (encoded.size(), offset) << "value " << value << ", padding " << padding;
+
+        offset = 0;
+        EXPECT_EQ (encoded.size() - 1, data.Skip_LEB128 (&offset)) << "value " << value << ", padding " << padding;
+        EXPECT_EQ (encoded.size(), offset) << "value " << value << ", padding " << padding;
+    }
+}
+
+} // namespace
+
+TEST (DataExtractorTest, ULEB128)
+{
+    CheckULEB128 (0);
+    CheckULEB128 (1);
+    CheckULEB128 (127);
+    CheckULEB128 (128);
+    CheckULEB128 (624485);
+    CheckULEB128 (UINT32_MAX);
+    CheckULEB128 (UINT64_MAX);
+}
+
+TEST (DataExtractorTest, ULEB128ByteBoundaries)
+{
+    // The largest and smallest numbers of each length, up to the 10 bytes
+    // of a 64 bit number.
+    for (unsigned bits = 7; bits < 64; bits += 7)
+    {
+        CheckULEB128 ((1ull << bits) - 1);
+        CheckULEB128 (1ull << bits);
+    }
+    CheckULEB128 (1ull << 63);
+}
+
+TEST (DataExtractorTest, ULEB128TenBytes)
+{
+    // 2^63 + 1 takes 10 bytes; the last one has the top bit of the number.
+    const uint8_t bytes[] = { 0x81, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x01 };
+    DataExtractor data (bytes, sizeof(bytes), eByteOrderLittle, 8);
+    offset_t offset = 0;
+    EXPECT_EQ (0x8000000000000001ull, data.GetULEB128 (&offset));
+    EXPECT_EQ (10u, offset);
+}
+
+TEST (DataExtractorTest, SLEB128)
+{
+    CheckSLEB128 (0);
+    CheckSLEB128 (1);
+    CheckSLEB128 (-1);
+    CheckSLEB128 (63);
+    CheckSLEB128 (-64);
+    CheckSLEB128 (64);
+    CheckSLEB128 (-65);
+    CheckSLEB128 (-123456);
+    CheckSLEB128 (INT32_MIN);
+    CheckSLEB128 (INT32_MAX);
+    CheckSLEB128 (INT64_MIN);
+    CheckSLEB128 (INT64_MAX);
+}
+
+TEST (DataExtractorTest, SLEB128SignExtension)
+{
+    // The sign bit of an n byte number is bit 7 * n - 1.  Check the
+    // numbers on either side of each length, where that bit changes.
+    for (unsigned bits = 7; bits < 64; bits += 7)
+    {
+        const int64_t limit = 1ll << (bits - 1);
+        CheckSLEB128 (limit - 1);
+        CheckSLEB128 (limit);
+        CheckSLEB128 (-limit);
+        CheckSLEB128 (-limit - 1);
+    }
+}
+
+TEST (DataExtractorTest, SLEB128Bytes)
+{
+    // -128 is 0x80 0x7f: the sign bit is in the second byte.
+    const uint8_t minus_128[] = { 0x80, 0x7f };
+    DataExtractor data (minus_128, sizeof(minus_128), eByteOrderLittle, 8);
+    offset_t offset = 0;
+    EXPECT_EQ (-128, data.GetSLEB128 (&offset));
+    EXPECT_EQ (2u, offset);
+
+    // 0x40 alone is -64, while 0xc0 0x00 is 64.
+    const uint8_t plus_64[] = { 0xc0, 0x00 };
+    data.SetData (plus_64, sizeof(plus_64), eByteOrderLittle);
+    offset = 0;
+    EXPECT_EQ (64, data.GetSLEB128 (&offset));
+    EXPECT_EQ (2u, offset);
+}
+
+TEST (DataExtractorTest, LEB128Truncated)
+{
+    // A number that runs off the end of the data decodes the bytes that
+    // are there and leaves the offset at the end.
+    const uint8_t bytes[] = { 0x01, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff };
+    for (offset_t length = 2; length <= sizeof(bytes); ++length)
+    {
+        DataExtractor data (bytes, length, eByteOrderLittle, 8);
+        const uint32_t continued = length - 1;
+
+        offset_t offset = 1;
+        const uint64_t value = data.GetULEB128 (&offset);
+        EXPECT_EQ (length, offset);
+        if (continued * 7 < 64)
+        {
+            EXPECT_EQ ((1ull << (continued * 7)) - 1, value) << "length " << length;
+        }
+
+        offset = 1;
+        data.GetSLEB128 (&offset);
+        EXPECT_EQ (length, offset);
+
+        offset = 1;
+        EXPECT_EQ (continued, data.Skip_LEB128 (&offset));
+        EXPECT_EQ (length, offset);
+    }
+}
+
+TEST (DataExtractorTest, LEB128AtEnd)
+{
+    const uint8_t bytes[] = { 0x05 };
+    DataExtractor data (bytes, sizeof(bytes), eByteOrderLittle, 8);
+    offset_t offset = 1;
+    EXPECT_EQ (0u, data.GetULEB128 (&offset));
+    EXPECT_EQ (1u, offset);
+    EXPECT_EQ (0, data.GetSLEB128 (&offset));
+    EXPECT_EQ (1u, offset);
+    EXPECT_EQ (0u, data.Skip_LEB128 (&offset));
+    EXPECT_EQ (1u, offset);
+}
+
+TEST (DataExtractorTest, LEB128Sequence)
+{
+    // Decode a run of numbers of different lengths, the way DWARF has
+    // them, so the word decoder reads across the following numbers.
+    std::vector<uint8_t> bytes;
+    const uint64_t values[] = { 1, 300, 0, 1ull << 40, 127, 128, UINT64_MAX, 5 };
+    const size_t num_values = sizeof(values) / sizeof(values[0]);
+    for (size_t i = 0; i < num_values; ++i)
+    {
+        std::vector<uint8_t> encoded (EncodeULEB128 (values[i]));
+        bytes.insert (bytes.end(), encoded.begin(), encoded.end());
+    }
+    DataExtractor data (MakeExtractor (bytes));
+    offset_t offset = 0;
+    for (size_t i = 0; i < num_values; ++i)
+        EXPECT_EQ (values[i], data.GetULEB128 (&offset)) << "index " << i;
+    EXPECT_EQ (bytes.size(), offset);
+}